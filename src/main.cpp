@@ -8,6 +8,7 @@
 #include <sdm/worlds.hpp>
 
 #include "programs/solve.cpp"
+#include "programs/benchmark.cpp"
 
 using namespace sdm;
 using namespace std;
@@ -34,6 +35,7 @@ void print_help()
             << std::endl;
   std::cout << "Commands:" << std::endl;
   std::cout << "  algorithms\t\tDisplay all available algorithms." << std::endl;
+  std::cout << "  benchmark\t\tSolve a set of instances with several configurations and summarize the performances." << std::endl;
   std::cout << "  formalisms\t\tDisplay all available formalisms." << std::endl;
   std::cout << "  help\t\t\tShow this help message." << std::endl;
   std::cout << "  solve\t\t\tSolve a sequential decision making problem using specified algorithm." << std::endl;
@@ -73,6 +75,11 @@ int main_sdms(int argv, char **args)
     {
       solve(argv, args);
     }
+    // DO BENCHMARK
+    else if (func.compare("benchmark") == 0)
+    {
+      benchmark(argv, args);
+    }
     // DO TEST
     else if (func.compare("test") == 0)
     {
@@ -0,0 +1,401 @@
+#include <cmath>
+#include <ctime>
+#include <chrono>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <experimental/filesystem>
+#include <boost/program_options.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include <sdm/types.hpp>
+#include <sdm/config.hpp>
+#include <sdm/exception.hpp>
+#include <sdm/utils/toml/tomlcpp.hpp>
+
+using namespace sdm;
+using namespace std;
+namespace po = boost::program_options;
+namespace fs = std::experimental::filesystem;
+
+/**
+ * @brief A configuration of the solver (the options given to sdms-solve).
+ */
+struct SolverConfig
+{
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> options;
+};
+
+/**
+ * @brief The measures of a run of the solver.
+ */
+struct RunResult
+{
+    std::string world, config;
+    number horizon, run;
+    int status;
+    double wall_time, cpu_time, peak_rss_mb;
+    double time_to_error, final_error, value_lb, value_ub;
+    unsigned long trials;
+};
+
+std::vector<std::string> splitList(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+std::string getTOMLValue(const std::shared_ptr<toml::Table> &table, const std::string &key)
+{
+    if (auto [okay, value] = table->getString(key); okay)
+        return value;
+    if (auto [okay, value] = table->getBool(key); okay)
+        return value ? "true" : "false";
+    if (auto [okay, value] = table->getInt(key); okay)
+        return std::to_string(value);
+    if (auto [okay, value] = table->getDouble(key); okay)
+    {
+        std::ostringstream str;
+        str << std::setprecision(10) << value;
+        return str.str();
+    }
+    throw sdm::exception::Exception("Unsupported value for option '" + key + "' in benchmark configuration");
+}
+
+/**
+ * @brief Run the solver in a child process and measure its wall-clock time, CPU time and peak RSS.
+ */
+RunResult runSolver(const std::string &solver, const std::vector<std::string> &args, const std::string &log_file)
+{
+    RunResult result = {};
+
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(solver.c_str()));
+    for (const auto &arg : args)
+    {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    auto start_time = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        throw sdm::exception::Exception("Cannot start the solver " + solver);
+    }
+    if (pid == 0)
+    {
+        // Redirect the outputs of the solver in the log file
+        int fd = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0)
+        {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    result.cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    result.peak_rss_mb = usage.ru_maxrss / 1024.; // kilobytes on Linux
+    result.status = WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+    return result;
+}
+
+/**
+ * @brief Read the anytime profile (CSV file written by the logger of the algorithm) of a run.
+ *
+ * The time to error is the time of the first trial whose error is lower than the target error.
+ */
+void readProfile(const std::string &csv_file, double error, RunResult &result)
+{
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+    result.time_to_error = result.final_error = result.value_lb = result.value_ub = NaN;
+    result.trials = 0;
+
+    std::ifstream file(csv_file);
+    std::string line;
+    if (!std::getline(file, line))
+    {
+        return;
+    }
+    std::vector<std::string> columns = splitList(line);
+    auto column = [&columns](const std::string &name) -> int
+    {
+        auto iter = std::find(columns.begin(), columns.end(), name);
+        return (iter != columns.end()) ? iter - columns.begin() : -1;
+    };
+    int col_trial = column("Trial"), col_error = column("Error"), col_lb = column("Value_LB"), col_ub = column("Value_UB"), col_time = column("Time");
+
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> values = splitList(line);
+        if (values.size() != columns.size())
+        {
+            continue;
+        }
+        auto value = [&values](int col, double default_value)
+        { return (col >= 0) ? std::stod(values[col]) : default_value; };
+
+        try
+        {
+            result.trials = value(col_trial, result.trials);
+            result.final_error = value(col_error, NaN);
+            result.value_lb = value(col_lb, NaN);
+            result.value_ub = value(col_ub, NaN);
+            if (std::isnan(result.time_to_error) && (result.final_error <= error))
+            {
+                result.time_to_error = value(col_time, NaN);
+            }
+        }
+        catch (const std::logic_error &)
+        {
+            // Truncated line (e.g. the run was killed while logging)
+        }
+    }
+}
+
+double median(std::vector<double> values)
+{
+    values.erase(std::remove_if(values.begin(), values.end(), [](double v)
+                                { return std::isnan(v); }),
+                 values.end());
+    if (values.empty())
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    std::sort(values.begin(), values.end());
+    return (values.size() % 2 == 1) ? values[values.size() / 2] : (values[values.size() / 2 - 1] + values[values.size() / 2]) / 2;
+}
+
+int benchmark(int argv, char **args)
+{
+    try
+    {
+        std::string config_file, solver, output, worlds_opt, horizons_opt, configs_opt;
+        int repeat;
+        double time_max, error;
+
+        po::options_description options("Options");
+        options.add_options()
+        ("help", "produce help message")
+        ("config,c", po::value<string>(&config_file)->default_value(config::CONFIG_PATH + "benchmark.toml"), "the benchmark configuration (worlds, horizons and solver configurations)")
+        ("solver", po::value<string>(&solver)->default_value(""), "the solver program (default to the 'solve' program next to this one, or sdms-solve)")
+        ("output,o", po::value<string>(&output)->default_value("benchmark"), "the directory where logs, anytime profiles and the summary are written")
+        ("worlds,w", po::value<string>(&worlds_opt)->default_value(""), "the worlds to be solved, separated by commas (override the configuration)")
+        ("horizons,h", po::value<string>(&horizons_opt)->default_value(""), "the planning horizons, separated by commas (override the configuration)")
+        ("configs", po::value<string>(&configs_opt)->default_value(""), "the solver configurations to run, separated by commas (default to all)")
+        ("repeat,r", po::value<int>(&repeat)->default_value(-1), "the number of runs of each instance (override the configuration)")
+        ("time_max", po::value<double>(&time_max)->default_value(-1), "the maximum running time of each run (override the configuration)")
+        ("error,e", po::value<double>(&error)->default_value(-1), "the target error (override the configuration)");
+
+        po::options_description visible("\nUsage:\tsdms-benchmark [CONFIGS]\n\tSDMStudio benchmark [CONFIGS]\n\nSolve a set of instances with several configurations and report time-to-error, wall-clock time, CPU time and peak memory.");
+        visible.add(options);
+
+        po::variables_map vm;
+        try
+        {
+            po::store(po::command_line_parser(argv, args).options(visible).run(), vm);
+            po::notify(vm);
+            if (vm.count("help"))
+            {
+                std::cout << visible << std::endl;
+                return sdm::SUCCESS;
+            }
+        }
+        catch (po::error &e)
+        {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            std::cerr << visible << std::endl;
+            return sdm::ERROR_IN_COMMAND_LINE;
+        }
+
+        // Read the benchmark configuration
+        auto res_parsing = toml::parseFile(config_file);
+        auto table = res_parsing.table;
+        if (!table)
+        {
+            throw sdm::exception::ParsingException(res_parsing.errmsg);
+        }
+
+        std::vector<std::string> worlds = splitList(worlds_opt);
+        if (worlds.empty() && table->getArray("worlds"))
+        {
+            worlds = *table->getArray("worlds")->getStringVector();
+        }
+        std::vector<number> horizons;
+        for (const auto &horizon : splitList(horizons_opt))
+        {
+            horizons.push_back(std::stoi(horizon));
+        }
+        if (horizons.empty() && table->getArray("horizons"))
+        {
+            for (const auto &horizon : *table->getArray("horizons")->getIntVector())
+            {
+                horizons.push_back(horizon);
+            }
+        }
+        if (repeat < 0)
+        {
+            repeat = table->getInt("repeat").first ? table->getInt("repeat").second : 1;
+        }
+        if (time_max < 0)
+        {
+            time_max = table->getDouble("time_max").first ? table->getDouble("time_max").second : 1800;
+        }
+        if (error < 0)
+        {
+            error = table->getDouble("error").first ? table->getDouble("error").second : 0.01;
+        }
+
+        std::vector<SolverConfig> configs;
+        std::vector<std::string> selected_configs = splitList(configs_opt);
+        if (auto configs_table = table->getTable("configs"))
+        {
+            for (const auto &name : configs_table->keys())
+            {
+                if (!selected_configs.empty() && std::find(selected_configs.begin(), selected_configs.end(), name) == selected_configs.end())
+                {
+                    continue;
+                }
+                SolverConfig solver_config{name, {}};
+                auto config_table = configs_table->getTable(name);
+                for (const auto &key : config_table->keys())
+                {
+                    solver_config.options.push_back({key, getTOMLValue(config_table, key)});
+                }
+                configs.push_back(solver_config);
+            }
+        }
+        if (worlds.empty() || horizons.empty() || configs.empty())
+        {
+            std::cerr << config::LOG_SDMS << "Nothing to run (worlds, horizons or configurations are missing in " << config_file << ")" << std::endl;
+            return sdm::ERROR_IN_COMMAND_LINE;
+        }
+
+        // Find the solver
+        if (solver.empty())
+        {
+            auto sibling = fs::path(args[0]).parent_path() / "solve";
+            solver = fs::exists(sibling) ? sibling.string() : "sdms-solve";
+        }
+
+        fs::create_directories(output);
+
+        // Run all instances
+        std::vector<RunResult> results;
+        for (const auto &world : worlds)
+        {
+            for (const auto &horizon : horizons)
+            {
+                for (const auto &solver_config : configs)
+                {
+                    for (int run = 0; run < repeat; run++)
+                    {
+                        std::string run_name = (fs::path(output) / (fs::path(world).stem().string() + "_h" + std::to_string(horizon) + "_" + solver_config.name + "_" + std::to_string(run))).string();
+
+                        std::vector<std::string> solver_args = {"--world", world, "--horizon", std::to_string(horizon), "--error", std::to_string(error), "--time_max", std::to_string(time_max), "--seed", std::to_string(run + 1), "--name", run_name};
+                        for (const auto &[key, value] : solver_config.options)
+                        {
+                            solver_args.push_back("--" + key);
+                            solver_args.push_back(value);
+                        }
+
+                        std::cout << config::LOG_SDMS << "Run " << solver_config.name << " on " << world << " (horizon " << horizon << ", run " << run << ")" << std::flush;
+                        RunResult result = runSolver(solver, solver_args, run_name + ".log");
+                        result.world = world;
+                        result.config = solver_config.name;
+                        result.horizon = horizon;
+                        result.run = run;
+                        readProfile(run_name + ".csv", error, result);
+                        results.push_back(result);
+                        std::cout << " : status " << result.status << ", wall " << result.wall_time << "s, cpu " << result.cpu_time << "s, rss " << result.peak_rss_mb << "MB, time-to-error " << result.time_to_error << "s" << std::endl;
+                    }
+                }
+            }
+        }
+
+        // Write all runs
+        std::ofstream runs_file((fs::path(output) / "runs.csv").string());
+        runs_file << "World,Horizon,Config,Run,Status,WallTime,CPUTime,PeakRSS_MB,TimeToError,FinalError,Value_LB,Value_UB,Trials\n";
+        for (const auto &result : results)
+        {
+            runs_file << result.world << "," << result.horizon << "," << result.config << "," << result.run << "," << result.status << ","
+                      << result.wall_time << "," << result.cpu_time << "," << result.peak_rss_mb << "," << result.time_to_error << ","
+                      << result.final_error << "," << result.value_lb << "," << result.value_ub << "," << result.trials << "\n";
+        }
+
+        // Summarize the runs of each instance (median over runs)
+        std::ofstream summary_file((fs::path(output) / "summary.csv").string());
+        summary_file << "World,Horizon,Config,Runs,Failures,WallTime,CPUTime,PeakRSS_MB,TimeToError,Value_LB,Value_UB\n";
+
+        std::cout << "\n"
+                  << config::LOG_SDMS << "Summary (median over runs, error=" << error << ")\n\n";
+        std::cout << std::left << std::setw(26) << "World" << std::setw(8) << "Horizon" << std::setw(30) << "Config"
+                  << std::right << std::setw(10) << "Runs" << std::setw(12) << "Wall(s)" << std::setw(12) << "CPU(s)" << std::setw(12) << "RSS(MB)"
+                  << std::setw(12) << "TTE(s)" << std::setw(14) << "Value_LB" << std::setw(14) << "Value_UB" << "\n";
+        for (std::size_t i = 0; i < results.size(); i += repeat)
+        {
+            std::vector<double> wall_times, cpu_times, peak_rss, times_to_error, values_lb, values_ub;
+            int failures = 0;
+            for (std::size_t j = i; j < i + repeat; j++)
+            {
+                wall_times.push_back(results[j].wall_time);
+                cpu_times.push_back(results[j].cpu_time);
+                peak_rss.push_back(results[j].peak_rss_mb);
+                times_to_error.push_back(results[j].time_to_error);
+                values_lb.push_back(results[j].value_lb);
+                values_ub.push_back(results[j].value_ub);
+                failures += (results[j].status != 0);
+            }
+            const auto &result = results[i];
+            summary_file << result.world << "," << result.horizon << "," << result.config << "," << repeat << "," << failures << ","
+                         << median(wall_times) << "," << median(cpu_times) << "," << median(peak_rss) << "," << median(times_to_error) << ","
+                         << median(values_lb) << "," << median(values_ub) << "\n";
+            std::cout << std::left << std::setw(26) << result.world << std::setw(8) << result.horizon << std::setw(30) << result.config
+                      << std::right << std::setw(10) << (std::to_string(repeat - failures) + "/" + std::to_string(repeat)) << std::fixed << std::setprecision(3)
+                      << std::setw(12) << median(wall_times) << std::setw(12) << median(cpu_times) << std::setw(12) << median(peak_rss)
+                      << std::setw(12) << median(times_to_error) << std::setw(14) << median(values_lb) << std::setw(14) << median(values_ub) << "\n";
+            std::cout.unsetf(std::ios::floatfield);
+        }
+        std::cout << "\n"
+                  << config::LOG_SDMS << "Results written in " << output << "/runs.csv and " << output << "/summary.csv" << std::endl;
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "Unhandled Exception reached the top of main: " << e.what() << std::endl;
+        return sdm::ERROR_UNHANDLED_EXCEPTION;
+    }
+
+    return sdm::SUCCESS;
+}
+
+#ifndef __main_program__
+#define __main_program__
+int main(int argv, char **args)
+{
+    return benchmark(argv, args);
+}
+#endif
@@ -2,11 +2,12 @@
 #include <cassert>
 #include <sdm/exception.hpp>
 #include <sdm/parser/parser.hpp>
+#include <sdm/parser/compiled_model.hpp>
 
 int main(int argc, char **argv)
 {
 	char const *filename_in; // must be of type .dpomdp
-	char const *filename_out; // must have extension .xml or .json
+	char const *filename_out; // must have extension .xml, .json or .sdmb (compiled model)
 
 	if (argc > 2)
 	{
@@ -23,7 +24,14 @@ int main(int argc, char **argv)
 	try
 	{
 		auto dpomdp_world = sdm::parser::parse_file(filename_in);
-		dpomdp_world->generateFile(filename_out);
+		if (sdm::parser::is_compiled_file(filename_out))
+		{
+			sdm::parser::write_compiled_file(dpomdp_world, filename_out);
+		}
+		else
+		{
+			dpomdp_world->generateFile(filename_out);
+		}
 	}
 	catch (sdm::exception::Exception &e)
 	{
@@ -15,6 +15,8 @@
 #include <sdm/algorithms.hpp>
 #include <sdm/worlds.hpp>
 #include <sdm/core/state/private_occupancy_state.hpp>
+#include <sdm/utils/value_function/action_selection/action_maxplan_base.hpp>
+#include <sdm/utils/linear_programming/lp_problem.hpp>
 #include <sdm/utils/value_function/qfunction/pwlc_qvalue_function.hpp>
 
 using namespace sdm;
@@ -25,6 +27,7 @@ double MAX_RUNNING_TIME = 1800;
 bool quit_flag = false;
 std::string name = "result";
 std::shared_ptr<Algorithm> algorithm;
+bool checkpoint_on_signal = false;
 
 void leave()
 {
@@ -37,21 +40,30 @@ void leave()
 
 void handler(int)
 {
-    leave();
+    // The first signal stops the solver at the end of the current trial, the second one exits immediately
+    if (checkpoint_on_signal && !TSVI::isCheckpointRequested())
+    {
+        TSVI::requestCheckpoint();
+    }
+    else
+    {
+        leave();
+    }
 }
 
 int solve(int argv, char **args)
 {
-    // Handle interrupt signal
+    // Handle interrupt and termination signals (e.g. preemption of jobs on clusters)
     signal(SIGINT, &handler);
+    signal(SIGTERM, &handler);
 
     try
     {
-        std::string world, algo_name, formalism, upper_bound, lower_bound, ub_init, lb_init, type_sampling;
+        std::string world, algo_name, formalism, upper_bound, lower_bound, ub_init, lb_init, type_sampling, checkpoint, resume;
         int trials, memory;
-        number horizon, seed, batch_size, freq_update_lb, freq_update_ub, state_type;
+        number horizon, seed, batch_size, freq_update_lb, freq_update_ub, state_type, num_workers;
         double error, discount, granularity_start, granularity_end, rate_start, rate_end, rate_decay, eps_start, eps_end, eps_decay;
-        double p_b, p_o, p_c;
+        double p_b, p_o, p_c, memory_budget, checkpoint_time;
         bool store_actions, store_states;
         unsigned long long num_samples;
 
@@ -83,6 +95,9 @@ int solve(int argv, char **args)
         ("p_c", po::value<double>(&p_c)->default_value(config::PRECISION_COMPRESSION), "The precision of the compression.")
         ("p_b", po::value<double>(&p_b)->default_value(config::PRECISION_BELIEF), "The precision of beliefs.")
         ("p_o", po::value<double>(&p_o)->default_value(config::PRECISION_OCCUPANCY_STATE), "The precision of occupancy states.")
+        ("num_threads", po::value<number>(&OccupancyState::NUM_THREADS)->default_value(1), "The number of threads used to compute next occupancy states.")
+        ("num_threads_maxplan", po::value<number>(&MaxPlanSelectionBase::NUM_THREADS)->default_value(1), "The number of threads used to go over hyperplanes when selecting greedy actions.")
+        ("lp_solver", po::value<std::string>(&LPBase::LP_SOLVER)->default_value(LPBase::LP_SOLVER), "The solver used for linear programs (simplex or cplex).")
         ("time_max", po::value<double>(&MAX_RUNNING_TIME)->default_value(1800), "The maximum running time.");
 
         po::options_description hsvi_config("HSVI configuration");
@@ -97,8 +112,13 @@ int solve(int argv, char **args)
         ("ub_type_of_resolution", po::value<string>(&type_of_resolution_v2)->default_value("IloIfThen"), "the type of resolution for the upper bound (ex: 'BigM:100' or 'IloIfThen' for LP)")
         ("lb_freq_pruning", po::value<int>(&freq_pruning_v1)->default_value(1), "the pruning frequency for the first value function.")
         ("ub_freq_pruning", po::value<int>(&freq_pruning_v2)->default_value(1), "the pruning frequency for the second value function .")
-        ("lb_type_of_pruning", po::value<string>(&type_of_pruning_v1)->default_value("none"), "the pruning type for the lower bound (ex: 'bounded', 'pairwise', 'none'")
-        ("ub_type_of_pruning", po::value<string>(&type_of_pruning_v2)->default_value("none"), "the pruning type for the upper bound (ex: 'iterative', 'global', 'none'");
+        ("lb_type_of_pruning", po::value<string>(&type_of_pruning_v1)->default_value("none"), "the pruning type for the lower bound (ex: 'bounded', 'pairwise', 'lp', 'none'")
+        ("ub_type_of_pruning", po::value<string>(&type_of_pruning_v2)->default_value("none"), "the pruning type for the upper bound (ex: 'iterative', 'global', 'none'")
+        ("num_workers", po::value<number>(&num_workers)->default_value(1), "the number of trials explored in parallel.")
+        ("memory_budget", po::value<double>(&memory_budget)->default_value(0), "the memory budget (in MB) of the stored states and transitions (0 for no limit).")
+        ("checkpoint", po::value<string>(&checkpoint)->default_value(""), "the file where checkpoints of the bounds are written (at the end, on SIGINT / SIGTERM and periodically).")
+        ("checkpoint_time", po::value<double>(&checkpoint_time)->default_value(0), "the time (in seconds) between two periodic checkpoints (0 for no periodic checkpoint).")
+        ("resume", po::value<string>(&resume)->default_value(""), "the checkpoint from which solving resumes.");
 
         po::options_description pbvi_config("PBVI configuration");
         pbvi_config.add_options()
@@ -109,7 +129,7 @@ int solve(int argv, char **args)
         ("freq_update", po::value<number>(&freq_update_lb), "the update frequency of the lower bound.")
         ("type_of_resolution", po::value<string>(&type_of_resolution_v1), "the type of resolution for the lower bound (ex: 'BigM:100' or 'IloIfThen' for LP)")
         ("freq_pruning", po::value<int>(&freq_pruning_v1), "the pruning frequency for the first value function.")
-        ("type_of_pruning", po::value<string>(&type_of_pruning_v1), "the pruning type for the lower bound (ex: 'bounded', 'pairwise', 'none'");
+        ("type_of_pruning", po::value<string>(&type_of_pruning_v1), "the pruning type for the lower bound (ex: 'bounded', 'pairwise', 'lp', 'none'");
 
         po::options_description qlearning_config("Q-learning configuration");
         qlearning_config.add_options()
@@ -123,6 +143,11 @@ int solve(int argv, char **args)
         ("rate_decay_start_time", po::value<double>(&QLearning::RATE_DECAY_START_TIME)->default_value(43200), "the decaying factor")
         ("rate_decay_duration", po::value<double>(&QLearning::DURATION_RATE_DECAY)->default_value(43200), "the decaying factor")
         ("q_init", po::value<string>(&lb_init), "the q-value function initialization method")
+        ("replay_capacity", po::value<int>(&ExperienceMemory::CAPACITY)->default_value(ExperienceMemory::CAPACITY), "the number of transitions stored at each time step in the experience memory")
+        ("priority_exponent", po::value<double>(&ExperienceMemory::PRIORITY_EXPONENT)->default_value(ExperienceMemory::PRIORITY_EXPONENT), "the exponent of priorities (|td_error| + eps)^alpha in the experience memory (0 for uniform replay)")
+        ("importance_exponent", po::value<double>(&ExperienceMemory::IMPORTANCE_EXPONENT)->default_value(ExperienceMemory::IMPORTANCE_EXPONENT), "the exponent beta of the importance-sampling weights of prioritized replay (1 for a full correction)")
+        ("num_envs", po::value<number>(&QLearning::NUM_ENVS)->default_value(QLearning::NUM_ENVS), "the number of copies of the environment whose episodes are run in lockstep")
+        ("num_threads_envs", po::value<number>(&VectorEnv::NUM_THREADS)->default_value(VectorEnv::NUM_THREADS), "The number of threads used to step the copies of the environment.")
         ("g_start", po::value<double>(&granularity_start)->default_value(oPWLCQ::GRANULARITY_START), "The granularity...")
         ("g_end", po::value<double>(&granularity_end)->default_value(oPWLCQ::GRANULARITY_END), "The granularity...")
         ;
@@ -208,9 +233,34 @@ int solve(int argv, char **args)
                                     freq_pruning_v2,
                                     type_of_pruning_v2);
 
+        if (auto hsvi = std::dynamic_pointer_cast<HSVI>(algorithm))
+        {
+            hsvi->setNumWorkers(num_workers);
+            if (auto belief_mdp = std::dynamic_pointer_cast<BeliefMDPInterface>(hsvi->getWorld()))
+            {
+                belief_mdp->setMemoryBudget(memory_budget * 1024 * 1024);
+            }
+        }
+
         // Initialize algorithm
         algorithm->initialize();
 
+        if (auto tsvi = std::dynamic_pointer_cast<TSVI>(algorithm))
+        {
+            // Resume from a checkpoint
+            if (!resume.empty())
+            {
+                tsvi->loadCheckpoint(resume);
+            }
+            tsvi->setCheckpoint(checkpoint, checkpoint_time);
+            checkpoint_on_signal = true;
+        }
+        else if (!resume.empty() || !checkpoint.empty())
+        {
+            std::cerr << config::LOG_SDMS << "Checkpoints are only available for TSVI-based algorithms (ex: HSVI)" << std::endl;
+            return sdm::ERROR_IN_COMMAND_LINE;
+        }
+
         // Solve the problem
         algorithm->solve();
 
@@ -27,7 +27,6 @@ namespace sdm
                                                                        std::string type_of_resolution_name)
         {
             std::shared_ptr<ActionSelectionInterface> action_selection;
-#ifdef WITH_CPLEX
             Config config = {{"type_of_resolution", type_of_resolution_name},
                              {"value_name", value_name}};
 
@@ -35,9 +34,6 @@ namespace sdm
                 action_selection = sdm::action_selection::registry::make("SawtoothLPSerial", problem, config);
             else
                 action_selection = sdm::action_selection::registry::make("SawtoothLP", problem, config);
-#else
-            throw sdm::exception::Exception("LP is disable. Please install CPLEX and recompile with adequate arguments.");
-#endif
             return action_selection;
         }
 
@@ -66,16 +62,11 @@ namespace sdm
                     action_selection = std::make_shared<ActionSelectionMaxplanWCSP>(problem);
                 else if (value_name.find("lp") != string::npos)
                 {
-#ifdef WITH_CPLEX
                     // action_selection = std::make_shared<ActionSelectionMaxplanLPSerial>(problem);
                     if (isInstanceOf<SerialProblemInterface>(problem))
-                        throw sdm::exception::Exception("LP is disable. Please install CPLEX and recompile with adequate arguments.");
+                        throw sdm::exception::Exception("Maxplan LP is not available for serial problems.");
                     else
                         action_selection = std::make_shared<ActionSelectionMaxplanLP>(problem);
-#else
-                    throw sdm::exception::Exception("LP is disable. Please install CPLEX and recompile with adequate arguments.");
-
-#endif
                 }
                 else
                 {
@@ -91,6 +82,8 @@ namespace sdm
                     type_of_pruning = MaxplanPruning::BOUNDED;
                 else if (type_of_pruning_name == "pairwise")
                     type_of_pruning = MaxplanPruning::PAIRWISE;
+                else if (type_of_pruning_name == "lp")
+                    type_of_pruning = MaxplanPruning::LP;
                 else if (type_of_pruning_name == "none")
                     type_of_pruning = MaxplanPruning::NONE;
                 else
@@ -233,11 +226,7 @@ namespace sdm
             }
             else if (qvalue_name.find("lp") != string::npos)
             {
-#ifdef WITH_CPLEX
                 action_selection = std::make_shared<ActionSelectionMaxplanLP>(problem);
-#else
-                throw sdm::exception::Exception("LP is disable. Please install CPLEX and recompile with adequate arguments.");
-#endif
             }
             else if (qvalue_name.find("serial") != string::npos)
             {
@@ -292,7 +281,7 @@ namespace sdm
                 exploration = std::make_shared<EpsGreedy>(eps_start, eps_end);
 
             // Instanciate the memory
-            std::shared_ptr<ExperienceMemory> experience_memory = std::make_shared<ExperienceMemory>(horizon);
+            std::shared_ptr<ExperienceMemory> experience_memory = std::make_shared<ExperienceMemory>(horizon, ExperienceMemory::CAPACITY, ExperienceMemory::PRIORITY_EXPONENT, ExperienceMemory::IMPORTANCE_EXPONENT);
 
             // Instanciate qvalue function
             std::shared_ptr<QValueFunction> qvalue = makeQValueFunction(problem, qvalue_name, q_init_name);
@@ -374,6 +363,12 @@ namespace sdm
                 omdp->setStateType(state_type);
                 formalism_problem = omdp;
             }
+            else if ((formalism == "dense-occupancy-mdp") || (formalism == "DenseOccupancyMDP") || (formalism == "domdp") || (formalism == "doMDP"))
+            {
+                auto omdp = std::make_shared<DenseOccupancyMDP>(problem, memory, store_state, store_action, batch_size);
+                omdp->setStateType(state_type);
+                formalism_problem = omdp;
+            }
             else if ((formalism == "extensive-mdp") || (formalism == "Extensive-MDP") || (formalism == "ext-MDP") || (formalism == "ext-mdp"))
             {
                 auto serial_mmdp = std::make_shared<SerialMMDP>(problem);
@@ -1,3 +1,5 @@
+#include <thread>
+
 #include <sdm/types.hpp>
 #include <sdm/config.hpp>
 #include <sdm/exception.hpp>
@@ -7,7 +9,9 @@
 #include <sdm/core/state/belief_state.hpp>
 #include <sdm/core/state/occupancy_state.hpp>
 #include <sdm/core/state/private_occupancy_state.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 #include <sdm/utils/value_function/prunable_structure.hpp>
+#include <sdm/utils/value_function/action_selection/action_maxplan_base.hpp>
 #include <sdm/utils/value_function/vfunction/sawtooth_value_function.hpp>
 #include <sdm/utils/value_function/initializer/pomdp_relaxation.hpp>
 
@@ -38,13 +42,105 @@ namespace sdm
         getUpperBound()->initialize();
     }
 
+    void HSVI::solve()
+    {
+        if (this->num_workers_ <= 1)
+        {
+            TSVI::solve();
+            return;
+        }
+
+        printStartInfo();
+        startExecutionTime();
+
+        trial = this->initial_trial_;
+        this->last_checkpoint_time_ = 0;
+        this->stop_workers_ = false;
+
+        std::vector<std::thread> workers;
+        for (number worker_id = 0; worker_id < this->num_workers_; worker_id++)
+        {
+            workers.emplace_back([this, worker_id]()
+                                 { this->runWorker(worker_id); });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+
+        logging(); // Print execution variables in logging output streams
+        printEndInfo();
+
+        if (!this->checkpoint_filename_.empty())
+        {
+            this->saveCheckpoint(this->checkpoint_filename_);
+        }
+    }
+
+    void HSVI::runWorker(number worker_id)
+    {
+        // Workers break ties differently, so that they explore different parts of the tree
+        HSVI::worker_id_ = worker_id;
+        HSVI::worker_generator_.seed(worker_id);
+
+        try
+        {
+            auto initial_state = getWorld()->getInitialState(); // Get the initial node
+            while (!this->stop_workers_)
+            {
+                {
+                    std::lock_guard<std::recursive_mutex> lock(this->serial_mutex_);
+                    if ((trial > 0) && ((excess(initial_state, 0, 0) <= 0) || (trial > num_max_trials) || (time_max < getExecutionTime())))
+                    {
+                        this->stop_workers_ = true;
+                        break;
+                    }
+
+                    // Bounds are only modified under the lock, so that the checkpoint is consistent
+                    if (this->checkpoint())
+                    {
+                        this->stop_workers_ = true;
+                        break;
+                    }
+
+                    initTrial(); // Initialize the trial
+
+                    logging(); // Print execution variables in logging output streams
+
+                    trial++; // Each trial is counted when it starts
+                }
+
+                explore(initial_state, 0, 0); // Explore the tree
+            }
+        }
+        catch (const std::exception &exc)
+        {
+            // Catch anything thrown within try block that derives from std::exception
+            std::cerr << "HSVI::runWorker(..) exception caught: " << exc.what() << std::endl;
+            exit(-1);
+        }
+    }
+
+    void HSVI::setNumWorkers(number num_workers)
+    {
+        this->num_workers_ = std::max<number>(num_workers, 1);
+    }
+
+    number HSVI::getNumWorkers() const
+    {
+        return this->num_workers_;
+    }
+
     bool HSVI::stop(const std::shared_ptr<State> &state, double cost_so_far, number t)
     {
-        return ((excess(state, cost_so_far, t) <= 0) || (trial > num_max_trials));
+        // With several workers, the number of trials is checked by workers before each trial
+        return ((excess(state, cost_so_far, t) <= 0) || ((this->num_workers_ <= 1) && (trial > num_max_trials)));
     }
 
     double HSVI::excess(const std::shared_ptr<State> &state, double cost_so_far, number t)
     {
+        SDMS_TIME_PHASE(EXCESS);
+
         double value_excess;
         try
         {
@@ -71,7 +167,9 @@ namespace sdm
 
                 // Select next action
                 //std::cout << "getting greedy actionand value";
+                std::unique_lock<std::recursive_mutex> lock(this->serial_mutex_);
                 auto [action, value] = getUpperBound()->getGreedyActionAndValue(state, t);
+                lock.unlock();
                 //std::cout << "greedyaction : " << action->str();
                 //std::cout << "succeeded to get action";
                 //std::exit(1);
@@ -80,16 +178,22 @@ namespace sdm
                 {
                     //std::cout << "observation (should be a public one for Pnegi)" << *observation << std::flush;
 
-                    auto next_state = getWorld()->getNextStateAndProba(state, action, observation, t).first;
+                    auto next_state = this->getNextStateAndProba(state, action, observation, t).first;
+                    double reward;
+                    {
+                        std::lock_guard<std::recursive_mutex> reward_lock(this->serial_mutex_);
+                        reward = getWorld()->getReward(state, action, t);
+                    }
                     // Recursive explore
                     //std::cout << "\n next state : " << next_state->str();
-                    explore(next_state, cost_so_far + getWorld()->getDiscount(t) * getWorld()->getReward(state, action, t), t + 1);
+                    explore(next_state, cost_so_far + getWorld()->getDiscount(t) * reward, t + 1);
                 }
                 //std::exit(1);
                 // Update the value function (backward update)
                 this->updateValue(state, t);
             }
             if (t==0){
+                std::lock_guard<std::recursive_mutex> lock(this->serial_mutex_);
                 this->optimum = getUpperBound()->getGreedyActionAndValue(state, t).second;
             }
         /*}
@@ -113,13 +217,17 @@ namespace sdm
         double error, biggest_error = -std::numeric_limits<double>::max();
         std::shared_ptr<Observation> selected_observation;
 
+        // Workers other than the first one sample observations proportionally to their weighted excess
+        std::vector<std::shared_ptr<Observation>> candidate_observations;
+        std::vector<double> candidate_errors;
+
         // Select next observation
         auto observation_space = getWorld()->getObservationSpaceAt(state, action->toAction(), t);
         double prob_obs = 0.0;
         for (const auto &observation : *observation_space)
         {
             // Get the next state and probability
-            auto [next_state, transition_proba] = getWorld()->getNextStateAndProba(state, action->toAction(), observation->toObservation(), t);
+            auto [next_state, transition_proba] = this->getNextStateAndProba(state, action->toAction(), observation->toObservation(), t);
             
             // Compute error correlated to this next state
             error = transition_proba * excess(next_state, 0, t + 1);
@@ -130,11 +238,27 @@ namespace sdm
                 prob_obs = transition_proba;
                 
             }
+            if ((HSVI::worker_id_ > 0) && (error > 0))
+            {
+                candidate_observations.push_back(observation->toObservation());
+                candidate_errors.push_back(error);
+            }
+        }
+        if (!candidate_observations.empty())
+        {
+            std::discrete_distribution<std::size_t> distribution(candidate_errors.begin(), candidate_errors.end());
+            return {candidate_observations[distribution(HSVI::worker_generator_)]};
         }
         //std::cout << "\n hsvi::selected proba obs : " << prob_obs<<std::endl;
         return {selected_observation};
     }
 
+    Pair<std::shared_ptr<State>, double> HSVI::getNextStateAndProba(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t)
+    {
+        std::lock_guard<std::recursive_mutex> lock(this->serial_mutex_);
+        return getWorld()->getNextStateAndProba(state, action, observation, t);
+    }
+
     std::shared_ptr<ValueFunction> HSVI::getLowerBound() const
     {
         return lower_bound;
@@ -148,6 +272,8 @@ namespace sdm
     void HSVI::updateValue(const std::shared_ptr<State> &state, number t)
     {
         // auto [action, value] = this->getUpperBound()->getGreedyActionAndValue(state, t);
+        SDMS_TIME_PHASE(UPDATE_VALUE);
+        std::lock_guard<std::recursive_mutex> lock(this->serial_mutex_);
         this->getUpperBound()->getUpdateOperator()->update(state, /* value, */ t);
         this->getLowerBound()->getUpdateOperator()->update(state, /* action, */ t);
     }
@@ -163,20 +289,35 @@ namespace sdm
             prunable_vf->doPruning(trial);
     }
 
+    void HSVI::writeCheckpoint(boost::archive::binary_oarchive &archive)
+    {
+        std::lock_guard<std::recursive_mutex> lock(this->serial_mutex_);
+        this->getLowerBound()->saveCheckpoint(archive);
+        this->getUpperBound()->saveCheckpoint(archive);
+    }
+
+    void HSVI::readCheckpoint(boost::archive::binary_iarchive &archive)
+    {
+        std::lock_guard<std::recursive_mutex> lock(this->serial_mutex_);
+        this->getLowerBound()->loadCheckpoint(archive);
+        this->getUpperBound()->loadCheckpoint(archive);
+    }
+
     void HSVI::initLogger()
     {
         // ************* Global Logger ****************
         // Text Format for standard output stream
-        std::string format = "\r" + config::LOG_SDMS + "Trial {:<8} Error {:<12.4f} Value_LB {:<12.7f} Value_UB {:<12.7f} Size_LB {:<10} Size_UB {:<10} Time {:<12.4f}";
+        std::string format = "\r" + config::LOG_SDMS + "Trial {:<8} Error {:<12.4f} Value_LB {:<12.7f} Value_UB {:<12.7f} Size_LB {:<10} Size_UB {:<10} Time {:<12.4f} Pruning_LB {:>6} -> {:<6} PruningTime_LB {:<10.4f} Solved_LB {:<10} Skipped_LB {:<10}";
 
         // Titles of logs
-        std::vector<std::string> list_logs{"Trial", "Error", "Value_LB", "Value_UB", "Size_LB", "Size_UB", "Time"};
+        std::vector<std::string> list_logs{"Trial", "Error", "Value_LB", "Value_UB", "Size_LB", "Size_UB", "Time", "SizeBeforePruning_LB", "SizeAfterPruning_LB", "PruningTime_LB", "Solved_LB", "Skipped_LB"};
 
         // Specific logs for belief MDPs
         if (sdm::isInstanceOf<BeliefMDPInterface>(getWorld()))
         {
-            format = format + " NumState {:<8}";
+            format = format + " NumState {:<8} Bytes {:<12}";
             list_logs.push_back("NumState");
+            list_logs.push_back("Bytes");
         }
         format = format + "";
 
@@ -184,7 +325,15 @@ namespace sdm
         auto std_logger = std::make_shared<sdm::StdLogger>(format);
 
         // Build a logger that stores data in a CSV file
+        auto num_logs = list_logs.size();
+        auto instrumentation_logs = instrumentation::getColumnNames();
+        list_logs.insert(list_logs.end(), instrumentation_logs.begin(), instrumentation_logs.end());
         auto csv_logger = std::make_shared<sdm::CSVLogger>(name, list_logs);
+        if (!instrumentation_logs.empty())
+        {
+            // The breakdown of the trial (see instrumentation::flush) is given as a single value
+            csv_logger->setFormat(tools::repeatString("{},", num_logs) + "{}\n");
+        }
 
         // Build a multi logger that combines previous loggers
         this->logger = std::make_shared<sdm::MultiLogger>(std::vector<std::shared_ptr<Logger>>{std_logger, csv_logger});
@@ -193,7 +342,28 @@ namespace sdm
     void HSVI::logging()
     {
         auto initial_state = getWorld()->getInitialState();
-        
+
+        // Calls and time of each phase since the last log (empty if the instrumentation is disabled)
+        std::string breakdown = instrumentation::flush();
+
+        // Statistics of the last pruning of the lower bound
+        size_t size_before_pruning = 0, size_after_pruning = 0;
+        double pruning_time = 0.;
+        if (auto prunable_vf = std::dynamic_pointer_cast<PrunableStructure>(getLowerBound()))
+        {
+            size_before_pruning = prunable_vf->getSizeBeforeLastPruning();
+            size_after_pruning = prunable_vf->getSizeAfterLastPruning();
+            pruning_time = prunable_vf->getLastPruningTime();
+        }
+
+        // Statistics of the hyperplanes gone over when selecting greedy actions for the lower bound
+        unsigned long long num_solved_hyperplanes = 0, num_skipped_hyperplanes = 0;
+        if (auto maxplan_selection = std::dynamic_pointer_cast<MaxPlanSelectionBase>(getLowerBound()->getActionSelection()))
+        {
+            num_solved_hyperplanes = maxplan_selection->getNumSolvedHyperplanes();
+            num_skipped_hyperplanes = maxplan_selection->getNumSkippedHyperplanes();
+        }
+
         if (auto derived = std::dynamic_pointer_cast<BeliefMDPInterface>(getWorld()))
         {
             // Print in loggers some execution variables
@@ -204,7 +374,14 @@ namespace sdm
                         getLowerBound()->getSize(),
                         getUpperBound()->getSize(),
                         getExecutionTime(),
-                        derived->getMDPGraph()->getNumNodes());
+                        size_before_pruning,
+                        size_after_pruning,
+                        pruning_time,
+                        num_solved_hyperplanes,
+                        num_skipped_hyperplanes,
+                        derived->getMDPGraph()->getNumNodes(),
+                        derived->getResidentBytes(),
+                        breakdown);
         }
         else
         {
@@ -215,7 +392,13 @@ namespace sdm
                         -this->agent_id_*(getUpperBound()->getValueAt(initial_state))*4/10,
                         getLowerBound()->getSize(),
                         getUpperBound()->getSize(),
-                        getExecutionTime());
+                        getExecutionTime(),
+                        size_before_pruning,
+                        size_after_pruning,
+                        pruning_time,
+                        num_solved_hyperplanes,
+                        num_skipped_hyperplanes,
+                        breakdown);
         }
     }
 
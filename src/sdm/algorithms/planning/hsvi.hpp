@@ -10,6 +10,9 @@
  */
 #pragma once
 
+#include <mutex>
+#include <atomic>
+#include <random>
 #include <string>
 
 #include <sdm/types.hpp>
@@ -61,6 +64,28 @@ namespace sdm
 		int agent_id_ = 0;
 		void initialize();
 
+		/**
+		 * @brief Planning procedure.
+		 * 
+		 * With several workers, trials are explored in parallel from the initial state. Workers share
+		 * both bounds and the world. Every step that creates histories or states (greedy action
+		 * selections, backups, prunings and transitions of the world) is serialized under one lock,
+		 * while bound evaluations are done concurrently.
+		 */
+		void solve();
+
+		/**
+		 * @brief Set the number of workers exploring trials in parallel.
+		 * 
+		 * @param num_workers the number of workers (1 by default, i.e. the sequential algorithm)
+		 */
+		void setNumWorkers(number num_workers);
+
+		/**
+		 * @brief Get the number of workers exploring trials in parallel.
+		 */
+		number getNumWorkers() const;
+
 		/**
     	 * @brief Check the end of HSVI algo.
     	 * 
@@ -145,6 +170,16 @@ namespace sdm
          */
 		void initTrial();
 
+		/**
+		 * @brief Write both bounds in a checkpoint.
+		 */
+		void writeCheckpoint(boost::archive::binary_oarchive &archive);
+
+		/**
+		 * @brief Read both bounds from a checkpoint.
+		 */
+		void readCheckpoint(boost::archive::binary_iarchive &archive);
+
 		/**
          * @brief Select the list of actions to explore.
          * 
@@ -171,10 +206,40 @@ namespace sdm
 		/** @brief Some variables for the algorithm. */
 		number num_max_trials, lb_update_frequency, ub_update_frequency;
 
-		double time_max, duration;
+		double duration;
 
 		bool keep_same_action_forward_backward;
 
 		std::chrono::high_resolution_clock::time_point start_time, current_time;
+
+		/** @brief The number of workers exploring trials in parallel. */
+		number num_workers_ = 1;
+
+		/** @brief Serialize the greedy action selections, the backups, the prunings and the transitions of workers. */
+		std::recursive_mutex serial_mutex_;
+
+		/** @brief Whether workers must stop (convergence, time limit or maximal number of trials). */
+		std::atomic<bool> stop_workers_{false};
+
+		/** @brief The worker running in the calling thread (0 in the sequential algorithm). */
+		static inline thread_local number worker_id_ = 0;
+
+		/** @brief The generator of the worker running in the calling thread. */
+		static inline thread_local std::mt19937 worker_generator_;
+
+		/**
+		 * @brief Get the next state and its probability (serialized with the other workers).
+		 *
+		 * Transitions expand the histories and create the states shared with greedy action selections and
+		 * backups, so that they are done under the same lock.
+		 */
+		Pair<std::shared_ptr<State>, double> getNextStateAndProba(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t);
+
+		/**
+		 * @brief Run trials until one of the workers reaches the stop criterion.
+		 * 
+		 * @param worker_id the identifier of the worker
+		 */
+		void runWorker(number worker_id);
 	};
 } // namespace sdm
@@ -1,5 +1,10 @@
 
+#include <cstdio>
+
+#include <sdm/config.hpp>
+#include <sdm/exception.hpp>
 #include <sdm/algorithms/planning/tsvi.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 
 namespace sdm
 {
@@ -18,8 +23,10 @@ namespace sdm
     {
         printStartInfo();
         startExecutionTime();
+        instrumentation::reset();
 
-        trial = 0;
+        trial = this->initial_trial_;
+        this->last_checkpoint_time_ = 0;
         auto initial_state = getWorld()->getInitialState(); // Get the initial node
 
         do
@@ -32,10 +39,20 @@ namespace sdm
 
             trial++; // At the end of the exploration, go to the next trial
 
+            if (this->checkpoint())
+            {
+                break; // Stop at the end of the trial if a checkpoint was requested
+            }
+
         } while (!stop(initial_state, 0, 0) && (time_max >= getExecutionTime())); // Do trials until convergence
         logging();                                                                // Print execution variables in logging output streams
         printEndInfo();
 
+        if (!this->checkpoint_filename_.empty())
+        {
+            this->saveCheckpoint(this->checkpoint_filename_);
+        }
+
     }
 
     void TSVI::explore(const std::shared_ptr<State> &state, double cost_so_far, number t)
@@ -78,6 +95,7 @@ namespace sdm
 
     void TSVI::updateValue(const std::shared_ptr<State> &state, number t)
     {
+        SDMS_TIME_PHASE(UPDATE_VALUE);
         getValueFunction()->updateValueAt(state, t);
     }
 
@@ -87,6 +105,94 @@ namespace sdm
 
     void TSVI::save()
     {
+        this->saveCheckpoint(this->getName() + "_checkpoint.bin");
+    }
+
+    void TSVI::saveCheckpoint(std::string filename)
+    {
+        std::string tmp_filename = filename + ".tmp";
+        {
+            std::ofstream ofs(tmp_filename, std::ios::out | std::ios::binary);
+            if (!ofs)
+            {
+                throw sdm::exception::Exception("TSVI::saveCheckpoint : cannot open " + tmp_filename);
+            }
+            boost::archive::binary_oarchive output_archive(ofs);
+
+            std::string algorithm_name = this->getAlgorithmName();
+            number version = TSVI::CHECKPOINT_VERSION, horizon = this->getWorld()->getHorizon();
+            output_archive << algorithm_name << version << horizon << this->trial;
+            this->writeCheckpoint(output_archive);
+        }
+        if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            throw sdm::exception::Exception("TSVI::saveCheckpoint : cannot write " + filename);
+        }
+        std::cout << "\n"
+                  << config::LOG_SDMS << "Checkpoint saved in " << filename << " (trial " << this->trial << ")" << std::endl;
+    }
+
+    void TSVI::loadCheckpoint(std::string filename)
+    {
+        std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+        if (!ifs)
+        {
+            throw sdm::exception::Exception("TSVI::loadCheckpoint : cannot open " + filename);
+        }
+        boost::archive::binary_iarchive input_archive(ifs);
+
+        std::string algorithm_name;
+        number version, horizon;
+        input_archive >> algorithm_name >> version >> horizon;
+        if ((algorithm_name != this->getAlgorithmName()) || (version != TSVI::CHECKPOINT_VERSION))
+        {
+            throw sdm::exception::Exception("TSVI::loadCheckpoint : " + filename + " is not a checkpoint of " + this->getAlgorithmName());
+        }
+        if (horizon != this->getWorld()->getHorizon())
+        {
+            throw sdm::exception::Exception("TSVI::loadCheckpoint : " + filename + " was saved for another planning horizon");
+        }
+        input_archive >> this->initial_trial_;
+        this->readCheckpoint(input_archive);
+        this->trial = this->initial_trial_;
+
+        std::cout << config::LOG_SDMS << "Checkpoint loaded from " << filename << " (trial " << this->initial_trial_ << ")" << std::endl;
+    }
+
+    void TSVI::setCheckpoint(std::string filename, double checkpoint_time)
+    {
+        this->checkpoint_filename_ = filename;
+        this->checkpoint_time_ = checkpoint_time;
+    }
+
+    void TSVI::requestCheckpoint()
+    {
+        TSVI::checkpoint_requested_ = true;
+    }
+
+    bool TSVI::isCheckpointRequested()
+    {
+        return TSVI::checkpoint_requested_;
+    }
+
+    void TSVI::writeCheckpoint(boost::archive::binary_oarchive &archive)
+    {
+        this->getValueFunction()->saveCheckpoint(archive);
+    }
+
+    void TSVI::readCheckpoint(boost::archive::binary_iarchive &archive)
+    {
+        this->getValueFunction()->loadCheckpoint(archive);
+    }
+
+    bool TSVI::checkpoint()
+    {
+        if (!this->checkpoint_filename_.empty() && (this->checkpoint_time_ > 0) && (this->getExecutionTime() - this->last_checkpoint_time_ >= this->checkpoint_time_))
+        {
+            this->saveCheckpoint(this->checkpoint_filename_);
+            this->last_checkpoint_time_ = this->getExecutionTime();
+        }
+        return TSVI::checkpoint_requested_;
     }
 
     std::shared_ptr<ValueFunction> TSVI::getValueFunction()
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <string>
+
 #include <sdm/types.hpp>
 #include <sdm/core/space/space.hpp>
 #include <sdm/algorithms/planning/dp.hpp>
@@ -78,10 +81,54 @@ namespace sdm
         virtual void test();
 
         /**
-         * @brief Save the value function. 
+         * @brief Save the value function (as a checkpoint in file `<name>_checkpoint.bin`).
          */
         virtual void save();
 
+        /**
+         * @brief Save a checkpoint of the algorithm.
+         * 
+         * A checkpoint holds the number of trials and the value functions (binary format). 
+         * It is written in a temporary file first, so that the previous checkpoint remains 
+         * valid if the process is killed while writing.
+         * 
+         * @param filename the file of the checkpoint
+         */
+        virtual void saveCheckpoint(std::string filename);
+
+        /**
+         * @brief Load a checkpoint written by `saveCheckpoint`.
+         * 
+         * The algorithm must be initialized and built on the same problem. A call to `solve()` 
+         * then resumes from the trial of the checkpoint.
+         * 
+         * @param filename the file of the checkpoint
+         */
+        virtual void loadCheckpoint(std::string filename);
+
+        /**
+         * @brief Write checkpoints while solving.
+         * 
+         * Checkpoints are written at the end of `solve()`, when requested (see `requestCheckpoint`) 
+         * and periodically if a period is given.
+         * 
+         * @param filename the file of checkpoints (each checkpoint replaces the previous one)
+         * @param checkpoint_time the time (in seconds) between two periodic checkpoints (0 for no periodic checkpoint)
+         */
+        void setCheckpoint(std::string filename, double checkpoint_time = 0);
+
+        /**
+         * @brief Request solving algorithms to stop at the end of the current trial (and write their checkpoint).
+         * 
+         * This only sets a flag, so it can be called from a signal handler.
+         */
+        static void requestCheckpoint();
+
+        /**
+         * @brief Check whether a checkpoint was requested.
+         */
+        static bool isCheckpointRequested();
+
         /**
          * @brief Get the value function.
          */
@@ -107,6 +154,25 @@ namespace sdm
          */
         virtual void initTrial();
 
+        /**
+         * @brief Write the value functions of the algorithm in a checkpoint.
+         */
+        virtual void writeCheckpoint(boost::archive::binary_oarchive &archive);
+
+        /**
+         * @brief Read the value functions of the algorithm from a checkpoint.
+         */
+        virtual void readCheckpoint(boost::archive::binary_iarchive &archive);
+
+        /**
+         * @brief Write a periodic checkpoint if it is time to.
+         * 
+         * This function must be called between two trials.
+         * 
+         * @return true if a checkpoint was requested (solving must stop)
+         */
+        bool checkpoint();
+
         // -------------------------------------------------------
         // --- Specification of the heuristic search procedure ---
         // -------------------------------------------------------
@@ -144,6 +210,27 @@ namespace sdm
          * @brief The maximum time before stopping the algorithm.
          */
         double time_max;
+
+        /**
+         * @brief The trial from which solving starts (non zero when resuming from a checkpoint).
+         */
+        number initial_trial_ = 0;
+
+        /**
+         * @brief The file of checkpoints (empty for no checkpoint), the time between two periodic checkpoints and the time of the last one.
+         */
+        std::string checkpoint_filename_;
+        double checkpoint_time_ = 0, last_checkpoint_time_ = 0;
+
+        /**
+         * @brief Whether a checkpoint was requested.
+         */
+        static inline std::atomic<bool> checkpoint_requested_{false};
+
+        /**
+         * @brief The version of the format of checkpoints.
+         */
+        static constexpr number CHECKPOINT_VERSION = 1;
     };
 
     using TreeSearchVI = TSVI;
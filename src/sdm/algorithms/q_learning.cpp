@@ -6,6 +6,7 @@
 namespace sdm
 {
     double QLearning::RATE_DECAY_START_TIME = 0, QLearning::DURATION_RATE_DECAY = 0;
+    number QLearning::NUM_ENVS = 1;
 
     QLearning::QLearning(const std::shared_ptr<GymInterface> &env,
                          std::shared_ptr<ExperienceMemoryInterface> experience_memory,
@@ -40,6 +41,11 @@ namespace sdm
         exploration_process->reset(num_episodes_);
         global_step = 0;
         episode = 0;
+
+        if (QLearning::NUM_ENVS > 1)
+        {
+            this->vector_env_ = std::make_shared<VectorEnv>(this->getEnv(), QLearning::NUM_ENVS);
+        }
     }
 
     void QLearning::solve()
@@ -69,6 +75,12 @@ namespace sdm
 
     void QLearning::doEpisode()
     {
+        if (this->vector_env_ != nullptr)
+        {
+            this->doBatchedEpisode();
+            return;
+        }
+
         observation = getEnv()->reset(); // Reset the environment
 
         doEpisodeRecursive(observation, 0);
@@ -110,6 +122,77 @@ namespace sdm
         endStep();
     }
 
+    std::vector<QLearning::TransitionBatch> QLearning::doBatchedRollout()
+    {
+        number num_envs = this->vector_env_->getNumEnvs();
+        std::vector<TransitionBatch> batches;
+
+        auto observations = this->vector_env_->reset();
+        for (number t = 0; !this->vector_env_->isDone() && (t <= this->max_num_steps_by_ep_) && (this->isInfiniteHorizon() || (t < this->horizon_)); t++)
+        {
+            TransitionBatch batch;
+            batch.observations = observations;
+
+            // Action selection following policy and exploration process (the value functions are not thread safe)
+            batch.actions = std::vector<std::shared_ptr<Action>>(num_envs, nullptr);
+            for (number k = 0; k < num_envs; k++)
+            {
+                if (!this->vector_env_->isDone(k))
+                {
+                    batch.actions[k] = this->selectAction(observations[k], t);
+                }
+            }
+
+            // Execute one step in all copies and get next observations and rewards
+            auto [next_observations, rewards, _] = this->vector_env_->step(batch.actions);
+            batch.next_observations = next_observations;
+            batch.rewards = std::vector<double>(num_envs, 0.);
+            for (number k = 0; k < num_envs; k++)
+            {
+                if (batch.actions[k] != nullptr)
+                {
+                    batch.rewards[k] = rewards[k][0];
+                }
+            }
+
+            observations = next_observations;
+            batches.push_back(std::move(batch));
+        }
+        return batches;
+    }
+
+    void QLearning::doBatchedEpisode()
+    {
+        auto batches = this->doBatchedRollout();
+
+        // Backup transitions from the last time step to the first one
+        for (number t = batches.size(); t-- > 0;)
+        {
+            const auto &batch = batches[t];
+            for (number k = 0; k < batch.actions.size(); k++)
+            {
+                if (batch.actions[k] == nullptr)
+                    continue;
+
+                // Compute next greedy action
+                auto [next_greedy_action, _] = this->q_value_->getGreedyActionAndValue(batch.next_observations[k], t + 1);
+
+                // Push experience to memory
+                this->experience_memory_->push(batch.observations[k], batch.actions[k], batch.rewards[k], batch.next_observations[k], next_greedy_action, (this->isInfiniteHorizon() ? 0 : t));
+
+                // Backup and get Q Value Error
+                this->q_value_->updateValueAt(this->learning_rate, (this->isInfiniteHorizon() ? 0 : t));
+
+                endStep();
+            }
+        }
+
+        for (number k = 0; k < this->vector_env_->getNumEnvs(); k++)
+        {
+            endEpisode();
+        }
+    }
+
     void QLearning::endEpisode()
     {
         // Increment episode
@@ -13,6 +13,7 @@
 #include <sdm/types.hpp>
 #include <sdm/public/algorithm.hpp>
 #include <sdm/world/gym_interface.hpp>
+#include <sdm/world/vector_env.hpp>
 #include <sdm/utils/rl/exploration.hpp>
 #include <sdm/utils/logging/logger.hpp>
 #include <sdm/utils/value_function/qvalue_function.hpp>
@@ -73,6 +74,16 @@ namespace sdm
     virtual void doEpisode();
     virtual void doEpisodeRecursive(const std::shared_ptr<State> &observation, number t);
 
+    /**
+     * @brief Execute an episode on each copy of the environment (when NUM_ENVS > 1).
+     *
+     * The copies are stepped in lockstep (see VectorEnv). Once all episodes are done, the
+     * transitions are pushed in the experience memory and backed up from the last time step
+     * to the first one, as in `doEpisodeRecursive`.
+     *
+     */
+    virtual void doBatchedEpisode();
+
     /**
      * @brief Finalize the episode
      *
@@ -170,10 +181,24 @@ namespace sdm
 
     static double RATE_DECAY_START_TIME, DURATION_RATE_DECAY;
 
+    /** @brief The number of copies of the environment whose episodes are run in lockstep. */
+    static number NUM_ENVS;
+
+    /** @brief The transitions of all copies of the environment at a time step (the action is null for copies whose episode was done). */
+    struct TransitionBatch
+    {
+      std::vector<std::shared_ptr<State>> observations, next_observations;
+      std::vector<std::shared_ptr<Action>> actions;
+      std::vector<double> rewards;
+    };
+
   protected:
     /** @brief The problem to be solved */
     std::shared_ptr<GymInterface> env_;
 
+    /** @brief The copies of the problem (null when NUM_ENVS <= 1) */
+    std::shared_ptr<VectorEnv> vector_env_;
+
     /** @brief The experience memory */
     std::shared_ptr<ExperienceMemoryInterface> experience_memory_;
 
@@ -183,6 +208,13 @@ namespace sdm
     /** @brief The exploration process. */
     std::shared_ptr<EpsGreedy> exploration_process;
 
+    /**
+     * @brief Run an episode on each copy of the environment.
+     *
+     * @return the transitions of each time step
+     */
+    std::vector<TransitionBatch> doBatchedRollout();
+
     /** @brief The logger */
     std::shared_ptr<MultiLogger> logger_;
 
@@ -65,6 +65,53 @@ namespace sdm
         endStep();
     }
 
+    void SARSA::doBatchedEpisode()
+    {
+        auto batches = this->doBatchedRollout();
+        number num_envs = this->vector_env_->getNumEnvs();
+
+        // Compute the return of each copy
+        std::vector<double> cumul_rewards(num_envs, 0.0);
+        for (number t = 0; t < batches.size(); t++)
+        {
+            for (number k = 0; k < num_envs; k++)
+            {
+                cumul_rewards[k] += this->mdp->getUnderlyingProblem()->getWeightedDiscount(t) * batches[t].rewards[k];
+            }
+        }
+
+        for (number t = batches.size(); t-- > 0;)
+        {
+            const auto &batch = batches[t];
+            for (number k = 0; k < num_envs; k++)
+            {
+                if (batch.actions[k] == nullptr)
+                    continue;
+
+                // greedy joint decision rule
+                if (cumul_rewards[k] >= this->current)
+                {
+                    this->actors[t] = batch.actions[k];
+                    this->current = cumul_rewards[k];
+                }
+
+                // Push experience to memory
+                this->experience_memory_->push(batch.observations[k], batch.actions[k], batch.rewards[k], batch.next_observations[k], this->actors[t + 1], t);
+
+                // Backup and get Q Value Error
+                this->q_value_->updateValueAt(this->learning_rate, t);
+
+                endStep();
+            }
+        }
+
+        for (number k = 0; k < num_envs; k++)
+        {
+            this->cumul_reward = cumul_rewards[k];
+            endEpisode();
+        }
+    }
+
     void SARSA::endEpisode()
     {
         QLearning::endEpisode();
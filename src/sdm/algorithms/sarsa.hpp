@@ -65,6 +65,14 @@ namespace sdm
      */
     void doEpisodeRecursive(const std::shared_ptr<State> &observation, number t);
 
+    /**
+     * @brief Execute an episode on each copy of the environment (when NUM_ENVS > 1).
+     *
+     * The greedy joint decision rules are those of the copy with the highest return.
+     *
+     */
+    void doBatchedEpisode();
+
     /**
      * @brief Finalize the episode
      *
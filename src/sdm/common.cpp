@@ -1,3 +1,5 @@
+#include <mutex>
+
 #include <sdm/common.hpp>
 namespace sdm
 {
@@ -23,6 +25,13 @@ namespace sdm
             return u;
         }
 
+        std::default_random_engine::result_type global_seed()
+        {
+            static std::mutex seed_mutex;
+            std::lock_guard<std::mutex> lock(seed_mutex);
+            return global_urng()();
+        }
+
         std::string getState(number state)
         {
             std::ostringstream oss;
@@ -19,6 +19,13 @@ namespace sdm
          * @brief Get the random engine. 
          */
         std::default_random_engine &global_urng();
+
+        /**
+         * @brief Draw a seed from the global random engine (safe to call from several threads).
+         *
+         * Generators owned by a thread or an object should be seeded this way, rather than with global_urng()().
+         */
+        std::default_random_engine::result_type global_seed();
         
         std::string getState(number state);
         std::string getAgentActionState(number agent_id, number action, number state);
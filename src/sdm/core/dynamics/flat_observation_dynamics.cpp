@@ -0,0 +1,57 @@
+#include <sdm/core/dynamics/flat_observation_dynamics.hpp>
+
+namespace sdm
+{
+    FlatObservationDynamics::FlatObservationDynamics(const std::shared_ptr<FlatTabularDynamics> &flat_dynamics,
+                                                     Span<std::size_t> row_offsets,
+                                                     Span<ObservationEntry> observation_entries,
+                                                     const std::shared_ptr<const void> &storage)
+        : flat_dynamics_(flat_dynamics), row_offsets_(row_offsets), observation_entries_(observation_entries), storage_(storage)
+    {
+    }
+
+    Span<FlatObservationDynamics::ObservationEntry> FlatObservationDynamics::getObservations(const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state) const
+    {
+        auto action_index = this->flat_dynamics_->getActionIndex(action), next_state_index = this->flat_dynamics_->getStateIndex(next_state);
+        if ((action_index == FlatTabularDynamics::NOT_FOUND) || (next_state_index == FlatTabularDynamics::NOT_FOUND))
+        {
+            return Span<ObservationEntry>();
+        }
+        std::size_t row = (std::size_t)action_index * this->flat_dynamics_->getNumStates() + next_state_index;
+        return Span<ObservationEntry>(this->observation_entries_.data() + this->row_offsets_[row], this->observation_entries_.data() + this->row_offsets_[row + 1]);
+    }
+
+    std::set<std::shared_ptr<Observation>> FlatObservationDynamics::getReachableObservations(const std::shared_ptr<State> &, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, number) const
+    {
+        std::set<std::shared_ptr<Observation>> reachable_observations;
+        for (const auto &entry : this->getObservations(action, next_state))
+        {
+            reachable_observations.insert(this->flat_dynamics_->getObservation(entry.observation));
+        }
+        return reachable_observations;
+    }
+
+    double FlatObservationDynamics::getObservationProbability(const std::shared_ptr<State> &, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, const std::shared_ptr<Observation> &observation, number) const
+    {
+        auto observation_index = this->flat_dynamics_->getObservationIndex(observation);
+        for (const auto &entry : this->getObservations(action, next_state))
+        {
+            if (entry.observation == observation_index)
+            {
+                return entry.probability;
+            }
+        }
+        return 0.;
+    }
+
+    std::shared_ptr<Distribution<std::shared_ptr<Observation>>> FlatObservationDynamics::getNextObservationDistribution(const std::shared_ptr<State> &, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, number)
+    {
+        auto next_observation_distribution = std::make_shared<DiscreteDistribution<std::shared_ptr<Observation>>>();
+        for (const auto &entry : this->getObservations(action, next_state))
+        {
+            next_observation_distribution->setProbability(this->flat_dynamics_->getObservation(entry.observation), entry.probability);
+        }
+        return next_observation_distribution;
+    }
+
+} // namespace sdm
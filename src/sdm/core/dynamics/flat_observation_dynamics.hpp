@@ -0,0 +1,61 @@
+/**
+ * @file flat_observation_dynamics.hpp
+ * @brief Observation dynamics p(z | u, y) read from flat (CSR) tables.
+ * @version 1.0
+ *
+ */
+#pragma once
+
+#include <sdm/types.hpp>
+#include <sdm/core/dynamics/observation_dynamics_interface.hpp>
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
+#include <sdm/utils/struct/span.hpp>
+
+namespace sdm
+{
+    /**
+     * @brief Read-only observation dynamics p(z | u, y) viewed over tables stored elsewhere (e.g. a memory-mapped compiled model).
+     *
+     * The observations z of a pair (u, y) are stored contiguously, the rows being ordered by action, then by next state.
+     * States, actions and observations are numbered as in the flat dynamics of the model.
+     *
+     */
+    class FlatObservationDynamics : public ObservationDynamicsInterface
+    {
+    public:
+        using ObservationEntry = FlatTabularDynamics::ObservationEntry;
+
+        /**
+         * @brief Build a view over existing tables (they are not copied, and must have been checked).
+         *
+         * @param flat_dynamics the flat dynamics of the model (for the identifiers of the items)
+         * @param row_offsets the offsets of the rows of observations (|U| * |Y| + 1 entries)
+         * @param observation_entries the observations of all pairs (u, y)
+         * @param storage the owner of the tables, kept alive as long as the dynamics
+         */
+        FlatObservationDynamics(const std::shared_ptr<FlatTabularDynamics> &flat_dynamics,
+                                Span<std::size_t> row_offsets,
+                                Span<ObservationEntry> observation_entries,
+                                const std::shared_ptr<const void> &storage);
+
+        std::set<std::shared_ptr<Observation>> getReachableObservations(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, number t = 0) const;
+
+        double getObservationProbability(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, const std::shared_ptr<Observation> &observation, number t = 0) const;
+
+        std::shared_ptr<Distribution<std::shared_ptr<Observation>>> getNextObservationDistribution(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, number t = 0);
+
+    protected:
+        std::shared_ptr<FlatTabularDynamics> flat_dynamics_;
+
+        /** @brief The observations of (u, y) are in [row_offsets_[u * |Y| + y], row_offsets_[u * |Y| + y + 1]) */
+        Span<std::size_t> row_offsets_;
+        Span<ObservationEntry> observation_entries_;
+
+        /** @brief The owner of the tables */
+        std::shared_ptr<const void> storage_;
+
+        /** @brief Get the observations of a pair (u, y) (empty for unknown items). */
+        Span<ObservationEntry> getObservations(const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state) const;
+    };
+
+} // namespace sdm
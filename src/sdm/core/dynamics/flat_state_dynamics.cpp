@@ -0,0 +1,47 @@
+#include <vector>
+
+#include <sdm/core/dynamics/flat_state_dynamics.hpp>
+
+namespace sdm
+{
+    FlatStateDynamics::FlatStateDynamics(const std::shared_ptr<FlatTabularDynamics> &flat_dynamics) : flat_dynamics_(flat_dynamics)
+    {
+    }
+
+    std::set<std::shared_ptr<State>> FlatStateDynamics::getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number) const
+    {
+        std::set<std::shared_ptr<State>> reachable_states;
+        for (const auto &successor : this->flat_dynamics_->getSuccessors(this->flat_dynamics_->getStateIndex(state), this->flat_dynamics_->getActionIndex(action)))
+        {
+            reachable_states.insert(this->flat_dynamics_->getState(successor.next_state));
+        }
+        return reachable_states;
+    }
+
+    Span<StateTransition> FlatStateDynamics::getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number) const
+    {
+        thread_local std::vector<StateTransition> transitions;
+        transitions.clear();
+        for (const auto &successor : this->flat_dynamics_->getSuccessors(this->flat_dynamics_->getStateIndex(state), this->flat_dynamics_->getActionIndex(action)))
+        {
+            transitions.push_back({this->flat_dynamics_->getState(successor.next_state), successor.probability});
+        }
+        return Span<StateTransition>(transitions.data(), transitions.size());
+    }
+
+    double FlatStateDynamics::getTransitionProbability(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, number) const
+    {
+        return this->flat_dynamics_->getTransitionProbability(this->flat_dynamics_->getStateIndex(state), this->flat_dynamics_->getActionIndex(action), this->flat_dynamics_->getStateIndex(next_state));
+    }
+
+    std::shared_ptr<Distribution<std::shared_ptr<State>>> FlatStateDynamics::getNextStateDistribution(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number) const
+    {
+        auto next_state_distribution = std::make_shared<DiscreteDistribution<std::shared_ptr<State>>>();
+        for (const auto &successor : this->flat_dynamics_->getSuccessors(this->flat_dynamics_->getStateIndex(state), this->flat_dynamics_->getActionIndex(action)))
+        {
+            next_state_distribution->setProbability(this->flat_dynamics_->getState(successor.next_state), successor.probability);
+        }
+        return next_state_distribution;
+    }
+
+} // namespace sdm
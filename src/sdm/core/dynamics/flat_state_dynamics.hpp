@@ -0,0 +1,48 @@
+/**
+ * @file flat_state_dynamics.hpp
+ * @brief State dynamics p(y | x, u) read from flat (CSR) tabular dynamics.
+ * @version 1.0
+ *
+ */
+#pragma once
+
+#include <sdm/types.hpp>
+#include <sdm/core/dynamics/state_dynamics_interface.hpp>
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
+
+namespace sdm
+{
+    /**
+     * @brief Read-only state dynamics that answer queries from the rows of successors of flat tabular dynamics.
+     *
+     * Nothing is copied from the flat dynamics : a model whose flat dynamics are viewed in place (e.g. a
+     * memory-mapped compiled model) keeps its transitions in the mapped file only.
+     *
+     */
+    class FlatStateDynamics : public StateDynamicsInterface
+    {
+    public:
+        FlatStateDynamics(const std::shared_ptr<FlatTabularDynamics> &flat_dynamics);
+
+        std::set<std::shared_ptr<State>> getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
+
+        /**
+         * @brief Get the list of all reachable states with their probabilities
+         *
+         * The view is over a buffer owned by the calling thread, it is invalidated by the next call in this thread.
+         *
+         * @param state the current state
+         * @param action the current action
+         * @return a view over the pairs (next state, probability)
+         */
+        Span<StateTransition> getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
+
+        double getTransitionProbability(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, number t = 0) const;
+
+        std::shared_ptr<Distribution<std::shared_ptr<State>>> getNextStateDistribution(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
+
+    protected:
+        std::shared_ptr<FlatTabularDynamics> flat_dynamics_;
+    };
+
+} // namespace sdm
@@ -0,0 +1,265 @@
+#include <set>
+#include <algorithm>
+
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
+
+namespace sdm
+{
+    FlatTabularDynamics::FlatTabularDynamics(const std::shared_ptr<Space> &state_space,
+                                             const std::shared_ptr<Space> &action_space,
+                                             const std::shared_ptr<Space> &observation_space,
+                                             const std::shared_ptr<TabularStateDynamics> &state_dynamics,
+                                             const std::shared_ptr<ObservationDynamicsInterface> &observation_dynamics)
+    {
+        this->indexItems(state_space, action_space, observation_space);
+
+        // Build the rows of successors for each pair (x, u)
+        this->owned_row_offsets_.reserve(this->states_.size() * this->actions_.size() + 1);
+        this->owned_row_offsets_.push_back(0);
+        for (const auto &state : this->states_)
+        {
+            for (const auto &action : this->actions_)
+            {
+                std::size_t row_begin = this->owned_successors_.size();
+                for (const auto &transition : state_dynamics->getReachableTransitions(state, action, 0))
+                {
+                    const auto &next_state = transition.next_state;
+                    if (transition.probability <= 0)
+                    {
+                        continue;
+                    }
+
+                    SuccessorEntry successor;
+                    successor.next_state = this->getStateIndex(next_state);
+                    if (successor.next_state == NOT_FOUND)
+                    {
+                        continue;
+                    }
+                    successor.probability = transition.probability;
+                    successor.observations_begin = this->owned_observation_entries_.size();
+
+                    // Tabular observation dynamics throw on (x, u, y) without any observation
+                    std::set<std::shared_ptr<Observation>> reachable_observations;
+                    try
+                    {
+                        reachable_observations = observation_dynamics->getReachableObservations(state, action, next_state, 0);
+                    }
+                    catch (const std::out_of_range &)
+                    {
+                    }
+                    for (const auto &observation : reachable_observations)
+                    {
+                        index_t observation_index = this->getObservationIndex(observation);
+                        double observation_probability = observation_dynamics->getObservationProbability(state, action, next_state, observation, 0);
+                        if ((observation_index != NOT_FOUND) && (observation_probability > 0))
+                        {
+                            this->owned_observation_entries_.push_back({observation_index, observation_probability});
+                        }
+                    }
+                    successor.observations_end = this->owned_observation_entries_.size();
+                    std::sort(this->owned_observation_entries_.begin() + successor.observations_begin, this->owned_observation_entries_.end(),
+                              [](const ObservationEntry &a, const ObservationEntry &b)
+                              { return a.observation < b.observation; });
+
+                    this->owned_successors_.push_back(successor);
+                }
+                std::sort(this->owned_successors_.begin() + row_begin, this->owned_successors_.end(),
+                          [](const SuccessorEntry &a, const SuccessorEntry &b)
+                          { return a.next_state < b.next_state; });
+                this->owned_row_offsets_.push_back(this->owned_successors_.size());
+            }
+        }
+
+        this->row_offsets_ = Span<std::size_t>(this->owned_row_offsets_.data(), this->owned_row_offsets_.size());
+        this->successors_ = Span<SuccessorEntry>(this->owned_successors_.data(), this->owned_successors_.size());
+        this->observation_entries_ = Span<ObservationEntry>(this->owned_observation_entries_.data(), this->owned_observation_entries_.size());
+        this->buildDynamicsTransitions();
+    }
+
+    FlatTabularDynamics::FlatTabularDynamics(const std::shared_ptr<Space> &state_space,
+                                             const std::shared_ptr<Space> &action_space,
+                                             const std::shared_ptr<Space> &observation_space,
+                                             Span<std::size_t> row_offsets,
+                                             Span<SuccessorEntry> successors,
+                                             Span<ObservationEntry> observation_entries,
+                                             const std::shared_ptr<const void> &storage)
+        : row_offsets_(row_offsets), successors_(successors), observation_entries_(observation_entries), storage_(storage)
+    {
+        // The pairs (y, z) are not materialized, they are read from the tables at each query
+        this->indexItems(state_space, action_space, observation_space);
+    }
+
+    void FlatTabularDynamics::indexItems(const std::shared_ptr<Space> &state_space, const std::shared_ptr<Space> &action_space, const std::shared_ptr<Space> &observation_space)
+    {
+        for (const auto &state : *state_space)
+        {
+            this->state_index_.emplace(state->toState(), this->states_.size());
+            this->states_.push_back(state->toState());
+        }
+        for (const auto &action : *action_space)
+        {
+            this->action_index_.emplace(action->toAction(), this->actions_.size());
+            this->actions_.push_back(action->toAction());
+        }
+        for (const auto &observation : *observation_space)
+        {
+            this->observation_index_.emplace(observation->toObservation(), this->observations_.size());
+            this->observations_.push_back(observation->toObservation());
+        }
+    }
+
+    void FlatTabularDynamics::buildDynamicsTransitions()
+    {
+        // Successors are stored row after row, and so are their observations
+        this->row_entry_offsets_.clear();
+        this->dynamics_transitions_.clear();
+        this->row_entry_offsets_.reserve(this->row_offsets_.size());
+        this->dynamics_transitions_.reserve(this->observation_entries_.size());
+        this->row_entry_offsets_.push_back(0);
+        for (std::size_t row = 0; row + 1 < this->row_offsets_.size(); row++)
+        {
+            for (std::size_t k = this->row_offsets_[row]; k < this->row_offsets_[row + 1]; k++)
+            {
+                const auto &successor = this->successors_[k];
+                for (const auto &observation_entry : this->getObservations(successor))
+                {
+                    this->dynamics_transitions_.push_back({this->states_[successor.next_state], this->observations_[observation_entry.observation], successor.probability * observation_entry.probability});
+                }
+            }
+            this->row_entry_offsets_.push_back(this->dynamics_transitions_.size());
+        }
+    }
+
+    number FlatTabularDynamics::getNumStates() const
+    {
+        return this->states_.size();
+    }
+
+    number FlatTabularDynamics::getNumActions() const
+    {
+        return this->actions_.size();
+    }
+
+    number FlatTabularDynamics::getNumObservations() const
+    {
+        return this->observations_.size();
+    }
+
+    FlatTabularDynamics::index_t FlatTabularDynamics::getStateIndex(const std::shared_ptr<State> &state) const
+    {
+        auto iter = this->state_index_.find(state);
+        return (iter == this->state_index_.end()) ? NOT_FOUND : iter->second;
+    }
+
+    FlatTabularDynamics::index_t FlatTabularDynamics::getActionIndex(const std::shared_ptr<Action> &action) const
+    {
+        auto iter = this->action_index_.find(action);
+        return (iter == this->action_index_.end()) ? NOT_FOUND : iter->second;
+    }
+
+    FlatTabularDynamics::index_t FlatTabularDynamics::getObservationIndex(const std::shared_ptr<Observation> &observation) const
+    {
+        auto iter = this->observation_index_.find(observation);
+        return (iter == this->observation_index_.end()) ? NOT_FOUND : iter->second;
+    }
+
+    const std::shared_ptr<State> &FlatTabularDynamics::getState(index_t state) const
+    {
+        return this->states_[state];
+    }
+
+    const std::shared_ptr<Action> &FlatTabularDynamics::getAction(index_t action) const
+    {
+        return this->actions_[action];
+    }
+
+    const std::shared_ptr<Observation> &FlatTabularDynamics::getObservation(index_t observation) const
+    {
+        return this->observations_[observation];
+    }
+
+    Span<FlatTabularDynamics::SuccessorEntry> FlatTabularDynamics::getSuccessors(index_t state, index_t action) const
+    {
+        if ((state >= this->states_.size()) || (action >= this->actions_.size()))
+        {
+            return Span<SuccessorEntry>();
+        }
+        std::size_t row = (std::size_t)state * this->actions_.size() + action;
+        return Span<SuccessorEntry>(this->successors_.data() + this->row_offsets_[row], this->successors_.data() + this->row_offsets_[row + 1]);
+    }
+
+    Span<DynamicsTransition> FlatTabularDynamics::getDynamicsTransitions(index_t state, index_t action) const
+    {
+        if ((state >= this->states_.size()) || (action >= this->actions_.size()))
+        {
+            return Span<DynamicsTransition>();
+        }
+        std::size_t row = (std::size_t)state * this->actions_.size() + action;
+        if (this->row_entry_offsets_.empty())
+        {
+            thread_local std::vector<DynamicsTransition> transitions;
+            transitions.clear();
+            for (std::size_t k = this->row_offsets_[row]; k < this->row_offsets_[row + 1]; k++)
+            {
+                const auto &successor = this->successors_[k];
+                for (const auto &observation_entry : this->getObservations(successor))
+                {
+                    transitions.push_back({this->states_[successor.next_state], this->observations_[observation_entry.observation], successor.probability * observation_entry.probability});
+                }
+            }
+            return Span<DynamicsTransition>(transitions.data(), transitions.size());
+        }
+        return Span<DynamicsTransition>(this->dynamics_transitions_.data() + this->row_entry_offsets_[row], this->dynamics_transitions_.data() + this->row_entry_offsets_[row + 1]);
+    }
+
+    Span<FlatTabularDynamics::ObservationEntry> FlatTabularDynamics::getObservations(const SuccessorEntry &successor) const
+    {
+        return Span<ObservationEntry>(this->observation_entries_.data() + successor.observations_begin, this->observation_entries_.data() + successor.observations_end);
+    }
+
+    double FlatTabularDynamics::getObservationProbability(const SuccessorEntry &successor, index_t observation) const
+    {
+        auto observations = this->getObservations(successor);
+        auto iter = std::lower_bound(observations.begin(), observations.end(), observation,
+                                     [](const ObservationEntry &entry, index_t z)
+                                     { return entry.observation < z; });
+        return ((iter != observations.end()) && (iter->observation == observation)) ? iter->probability : 0.;
+    }
+
+    Span<std::size_t> FlatTabularDynamics::getRowOffsets() const
+    {
+        return this->row_offsets_;
+    }
+
+    Span<FlatTabularDynamics::SuccessorEntry> FlatTabularDynamics::getSuccessorEntries() const
+    {
+        return this->successors_;
+    }
+
+    Span<FlatTabularDynamics::ObservationEntry> FlatTabularDynamics::getObservationEntries() const
+    {
+        return this->observation_entries_;
+    }
+
+    const FlatTabularDynamics::SuccessorEntry *FlatTabularDynamics::findSuccessor(index_t state, index_t action, index_t next_state) const
+    {
+        auto successors = this->getSuccessors(state, action);
+        auto iter = std::lower_bound(successors.begin(), successors.end(), next_state,
+                                     [](const SuccessorEntry &entry, index_t y)
+                                     { return entry.next_state < y; });
+        return ((iter != successors.end()) && (iter->next_state == next_state)) ? iter : nullptr;
+    }
+
+    double FlatTabularDynamics::getTransitionProbability(index_t state, index_t action, index_t next_state) const
+    {
+        auto successor = this->findSuccessor(state, action, next_state);
+        return (successor == nullptr) ? 0. : successor->probability;
+    }
+
+    double FlatTabularDynamics::getDynamics(index_t state, index_t action, index_t next_state, index_t observation) const
+    {
+        auto successor = this->findSuccessor(state, action, next_state);
+        return (successor == nullptr) ? 0. : successor->probability * this->getObservationProbability(*successor, observation);
+    }
+
+} // namespace sdm
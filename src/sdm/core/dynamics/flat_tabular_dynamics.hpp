@@ -0,0 +1,192 @@
+/**
+ * @file flat_tabular_dynamics.hpp
+ * @brief Flat (CSR) representation of the joint dynamics p(y, z | x, u) of a tabular model.
+ * @version 1.0
+ *
+ */
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <sdm/types.hpp>
+#include <sdm/core/space/space.hpp>
+#include <sdm/core/state/state.hpp>
+#include <sdm/core/action/action.hpp>
+#include <sdm/core/observation/observation.hpp>
+#include <sdm/core/dynamics/transitions.hpp>
+#include <sdm/core/dynamics/tabular_state_dynamics.hpp>
+#include <sdm/core/dynamics/observation_dynamics_interface.hpp>
+#include <sdm/utils/struct/span.hpp>
+
+namespace sdm
+{
+    /**
+     * @brief Read-only tabular dynamics indexed by integer state, action and observation identifiers.
+     *
+     * States, actions and observations are numbered in the order of their spaces. For each pair (x, u),
+     * the successors y with p(y | x, u) > 0 are stored contiguously (sorted by identifier) and, for each
+     * successor, the observations z with p(z | x, u, y) > 0 are stored contiguously as well (compressed
+     * sparse rows). Iterating over the reachable transitions thus requires neither allocation nor hash lookup.
+     *
+     * This representation is built once from the tabular dynamics of a stationary model (see POMDP::getFlatDynamics),
+     * or viewed in place over tables stored elsewhere (e.g. a memory-mapped compiled model, see parser::parse_compiled_file).
+     *
+     */
+    class FlatTabularDynamics
+    {
+    public:
+        using index_t = std::uint32_t;
+
+        /** @brief The identifier returned for unknown states, actions or observations. */
+        static constexpr index_t NOT_FOUND = std::numeric_limits<index_t>::max();
+
+        /** @brief An observation z with its probability p(z | x, u, y) */
+        struct ObservationEntry
+        {
+            index_t observation;
+            double probability;
+        };
+
+        /** @brief A next state y with its probability p(y | x, u) and the range of its observations */
+        struct SuccessorEntry
+        {
+            index_t next_state;
+            index_t observations_begin;
+            index_t observations_end;
+            double probability;
+        };
+
+        FlatTabularDynamics(const std::shared_ptr<Space> &state_space,
+                            const std::shared_ptr<Space> &action_space,
+                            const std::shared_ptr<Space> &observation_space,
+                            const std::shared_ptr<TabularStateDynamics> &state_dynamics,
+                            const std::shared_ptr<ObservationDynamicsInterface> &observation_dynamics);
+
+        /**
+         * @brief Build a view over existing tables (they are neither copied nor checked).
+         *
+         * Queries are answered from the tables themselves, nothing is materialized in memory.
+         *
+         * @param state_space the state space (identifiers in the order of the space)
+         * @param action_space the action space
+         * @param observation_space the observation space
+         * @param row_offsets the offsets of the rows of successors (|X| * |U| + 1 entries)
+         * @param successors the successors of all pairs (x, u)
+         * @param observation_entries the observations of all successors
+         * @param storage the owner of the tables, kept alive as long as the dynamics
+         */
+        FlatTabularDynamics(const std::shared_ptr<Space> &state_space,
+                            const std::shared_ptr<Space> &action_space,
+                            const std::shared_ptr<Space> &observation_space,
+                            Span<std::size_t> row_offsets,
+                            Span<SuccessorEntry> successors,
+                            Span<ObservationEntry> observation_entries,
+                            const std::shared_ptr<const void> &storage);
+
+        /** @brief Views over the tables would outlive the tables of a copy. */
+        FlatTabularDynamics(const FlatTabularDynamics &) = delete;
+        FlatTabularDynamics &operator=(const FlatTabularDynamics &) = delete;
+
+        number getNumStates() const;
+        number getNumActions() const;
+        number getNumObservations() const;
+
+        /** @brief Get the identifier of a state (or NOT_FOUND). */
+        index_t getStateIndex(const std::shared_ptr<State> &state) const;
+
+        /** @brief Get the identifier of an action (or NOT_FOUND). */
+        index_t getActionIndex(const std::shared_ptr<Action> &action) const;
+
+        /** @brief Get the identifier of an observation (or NOT_FOUND). */
+        index_t getObservationIndex(const std::shared_ptr<Observation> &observation) const;
+
+        const std::shared_ptr<State> &getState(index_t state) const;
+        const std::shared_ptr<Action> &getAction(index_t action) const;
+        const std::shared_ptr<Observation> &getObservation(index_t observation) const;
+
+        /**
+         * @brief Get the successors of a pair (x, u), sorted by next state identifier.
+         *
+         * @param state the identifier of x
+         * @param action the identifier of u
+         * @return a view over the successors
+         */
+        Span<SuccessorEntry> getSuccessors(index_t state, index_t action) const;
+
+        /**
+         * @brief Get the reachable pairs (y, z) of a pair (x, u) with their probabilities p(y, z | x, u).
+         *
+         * Dynamics built from tabular dynamics return a view over their own storage. Dynamics viewed over
+         * existing tables fill a buffer owned by the calling thread, so the view is invalidated by the next
+         * call in this thread.
+         *
+         * @param state the identifier of x
+         * @param action the identifier of u
+         * @return a view over the transitions
+         */
+        Span<DynamicsTransition> getDynamicsTransitions(index_t state, index_t action) const;
+
+        /**
+         * @brief Get the reachable observations of a successor, sorted by observation identifier.
+         *
+         * @param successor a successor returned by getSuccessors
+         * @return a view over the observations
+         */
+        Span<ObservationEntry> getObservations(const SuccessorEntry &successor) const;
+
+        /** @brief Get p(z | x, u, y) for a successor (x, u, y). */
+        double getObservationProbability(const SuccessorEntry &successor, index_t observation) const;
+
+        /** @brief Get p(y | x, u). */
+        double getTransitionProbability(index_t state, index_t action, index_t next_state) const;
+
+        /** @brief Get p(y, z | x, u). */
+        double getDynamics(index_t state, index_t action, index_t next_state, index_t observation) const;
+
+        /** @brief Get the raw tables (offsets of the rows, successors and observations). */
+        Span<std::size_t> getRowOffsets() const;
+        Span<SuccessorEntry> getSuccessorEntries() const;
+        Span<ObservationEntry> getObservationEntries() const;
+
+    protected:
+        /** @brief Items in order of identifiers */
+        std::vector<std::shared_ptr<State>> states_;
+        std::vector<std::shared_ptr<Action>> actions_;
+        std::vector<std::shared_ptr<Observation>> observations_;
+
+        /** @brief Relations from items to identifiers */
+        std::unordered_map<std::shared_ptr<State>, index_t> state_index_;
+        std::unordered_map<std::shared_ptr<Action>, index_t> action_index_;
+        std::unordered_map<std::shared_ptr<Observation>, index_t> observation_index_;
+
+        /** @brief The successors of (x, u) are in [row_offsets_[x * |A| + u], row_offsets_[x * |A| + u + 1]) */
+        Span<std::size_t> row_offsets_;
+        Span<SuccessorEntry> successors_;
+        Span<ObservationEntry> observation_entries_;
+
+        /** @brief The tables, when built from tabular dynamics */
+        std::vector<std::size_t> owned_row_offsets_;
+        std::vector<SuccessorEntry> owned_successors_;
+        std::vector<ObservationEntry> owned_observation_entries_;
+
+        /** @brief The owner of the tables, when they are stored elsewhere */
+        std::shared_ptr<const void> storage_;
+
+        /** @brief The pairs (y, z) of (x, u) are in [row_entry_offsets_[x * |A| + u], row_entry_offsets_[x * |A| + u + 1]), aligned with observation_entries_ (empty for views) */
+        std::vector<std::size_t> row_entry_offsets_;
+        std::vector<DynamicsTransition> dynamics_transitions_;
+
+        /** @brief Number states, actions and observations in the order of their spaces. */
+        void indexItems(const std::shared_ptr<Space> &state_space, const std::shared_ptr<Space> &action_space, const std::shared_ptr<Space> &observation_space);
+
+        /** @brief Build the pairs (y, z) of each row from the successors and their observations. */
+        void buildDynamicsTransitions();
+
+        /** @brief Find the successor y of (x, u) (or nullptr). */
+        const SuccessorEntry *findSuccessor(index_t state, index_t action, index_t next_state) const;
+    };
+
+} // namespace sdm
@@ -4,6 +4,7 @@
 #include <sdm/core/state/state.hpp>
 #include <sdm/core/action/action.hpp>
 #include <sdm/core/distribution.hpp>
+#include <sdm/core/dynamics/transitions.hpp>
 
 namespace sdm
 {
@@ -26,6 +27,16 @@ namespace sdm
          */
         virtual std::set<std::shared_ptr<State>> getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const = 0;
 
+        /**
+         * @brief Get reachable states from a state given a specific action, together with their probabilities. 
+         * 
+         * @param state the current state
+         * @param action the current action
+         * @param t the timestep
+         * @return a view over the pairs (next state, p(s' | s, a)), valid as long as the dynamics is not modified
+         */
+        virtual Span<StateTransition> getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const = 0;
+
         /**
          * @brief Get the state transition probability (i.e. p(s' | s, a)).
          * 
@@ -6,7 +6,11 @@ namespace sdm
     {
     }
 
-    TabularStateDynamics::TabularStateDynamics(const TabularStateDynamics &copy) : t_model(copy.t_model)
+    TabularStateDynamics::TabularStateDynamics(const TabularStateDynamics &copy)
+        : t_model(copy.t_model),
+          successor_states(copy.successor_states),
+          successor_transitions(copy.successor_transitions),
+          next_states_distrib(copy.next_states_distrib)
     {
     }
 
@@ -16,7 +20,27 @@ namespace sdm
 
     void TabularStateDynamics::setReachablesStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, number)
     {
-        this->successor_states[state][action].insert(next_state);
+        this->updateReachableTransition(state, action, next_state, this->getTransitionProbability(state, action, next_state));
+    }
+
+    void TabularStateDynamics::updateReachableTransition(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, double proba)
+    {
+        auto &transitions = this->successor_transitions[state][action];
+        if (this->successor_states[state][action].insert(next_state).second)
+        {
+            transitions.push_back({next_state, proba});
+        }
+        else
+        {
+            // Only happens when a transition is set several times
+            for (auto &transition : transitions)
+            {
+                if (transition.next_state == next_state)
+                {
+                    transition.probability = proba;
+                }
+            }
+        }
     }
 
     void TabularStateDynamics::updateNextStateDistribution(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, double proba)
@@ -36,18 +60,18 @@ namespace sdm
 
     void TabularStateDynamics::setTransitionProbability(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, double prob, number, bool cumul)
     {
-            // Set reachable state
-            this->setReachablesStates(state, action, next_state);
             if (cumul)
             {
                 double cumul_proba = this->t_model[action].getValueAt(state, next_state) + prob;
                 this->t_model[action].setValueAt(state, next_state, cumul_proba);
                 this->updateNextStateDistribution(state, action, next_state, cumul_proba);
+                this->updateReachableTransition(state, action, next_state, cumul_proba);
             }
             else
             {
                 this->t_model[action].setValueAt(state, next_state, prob);
                 this->updateNextStateDistribution(state, action, next_state, prob);
+                this->updateReachableTransition(state, action, next_state, prob);
             }
     }
 
@@ -57,20 +81,28 @@ namespace sdm
         return (iterator == this->t_model.end()) ? 0. : iterator->second.getValueAt(state, next_state);
     }
 
-    std::set<std::shared_ptr<State>> TabularStateDynamics::getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number) const
-    {   
-        //std::cout << "\n trying to find joint action : " << action;
-        const auto &iterator = this->successor_states.find(state);
-        if (iterator != this->successor_states.end())
+    std::set<std::shared_ptr<State>> TabularStateDynamics::getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const
+    {
+        std::set<std::shared_ptr<State>> reachable_states;
+        for (const auto &transition : this->getReachableTransitions(state, action, t))
+        {
+            reachable_states.insert(transition.next_state);
+        }
+        return reachable_states;
+    }
+
+    Span<StateTransition> TabularStateDynamics::getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number) const
+    {
+        const auto &iterator = this->successor_transitions.find(state);
+        if (iterator != this->successor_transitions.end())
         {
             const auto &iterator2 = iterator->second.find(action);
             if (iterator2 != iterator->second.end())
             {
-                return this->successor_states.at(state).at(action);
+                return Span<StateTransition>(iterator2->second.data(), iterator2->second.size());
             }
         }
-        std::cout << "\n didnt find?";
-        return {};
+        return Span<StateTransition>();
     }
 
     std::shared_ptr<Distribution<std::shared_ptr<State>>> TabularStateDynamics::getNextStateDistribution(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number ) const
@@ -64,6 +64,15 @@ namespace sdm
      */
     std::set<std::shared_ptr<State>> getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
 
+    /**
+     * @brief Get the list of all reachable states with their probabilities
+     * 
+     * @param state the current state
+     * @param action the current action
+     * @return a view over the pairs (next state, probability)
+     */
+    Span<StateTransition> getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
+
     /**
      * @brief Create the Reachable State, i.e. a state and an action will be associated with a next_state
      * 
@@ -86,12 +95,17 @@ namespace sdm
 
     void updateNextStateDistribution(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, double proba);
 
+    void updateReachableTransition(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, double proba);
+
     /** @brief transition and observation matrices */
     std::unordered_map<std::shared_ptr<Action>, matrix_type> t_model;
 
     /** @brief map from state, action pairs to set of next states */
     std::unordered_map<std::shared_ptr<State>, std::unordered_map<std::shared_ptr<Action>, std::set<std::shared_ptr<State>>>> successor_states;
 
+    /** @brief map from state, action pairs to the contiguous list of next states and probabilities */
+    std::unordered_map<std::shared_ptr<State>, std::unordered_map<std::shared_ptr<Action>, std::vector<StateTransition>>> successor_transitions;
+
     /** @brief map from state, action pairs to the distribution over next states */
     std::unordered_map<std::shared_ptr<State>, std::unordered_map<std::shared_ptr<Action>, std::shared_ptr<DiscreteDistribution<std::shared_ptr<State>>>>> next_states_distrib;
   };
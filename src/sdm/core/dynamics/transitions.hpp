@@ -0,0 +1,29 @@
+#pragma once
+
+#include <sdm/types.hpp>
+#include <sdm/core/state/state.hpp>
+#include <sdm/core/observation/observation.hpp>
+#include <sdm/utils/struct/span.hpp>
+
+namespace sdm
+{
+    /**
+     * @brief A reachable next state with its probability (i.e. y and p(y | x, u)).
+     */
+    struct StateTransition
+    {
+        std::shared_ptr<State> next_state;
+        double probability;
+    };
+
+    /**
+     * @brief A reachable pair of next state and observation with its probability (i.e. y, z and p(y, z | x, u)).
+     */
+    struct DynamicsTransition
+    {
+        std::shared_ptr<State> next_state;
+        std::shared_ptr<Observation> observation;
+        double probability;
+    };
+
+} // namespace sdm
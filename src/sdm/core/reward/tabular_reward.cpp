@@ -40,6 +40,11 @@ namespace sdm
     return this->min;
   }
 
+  const CooperativeRewardModel::data_t &CooperativeRewardModel::getRewards() const
+  {
+    return this->rewards_;
+  }
+
   CompetitiveRewardModel::CompetitiveRewardModel() {}
 
   CompetitiveRewardModel::~CompetitiveRewardModel() {}
@@ -89,4 +94,9 @@ namespace sdm
     return this->min.at(agent_id);
   }
 
+  const CompetitiveRewardModel::data_t &CompetitiveRewardModel::getRewards() const
+  {
+    return this->rewards_;
+  }
+
 } // namespace sdm
@@ -30,6 +30,9 @@ namespace sdm
         double getMinReward(number agent_id, number t = 0) const;
         double getMaxReward(number agent_id, number t = 0) const;
 
+        /** @brief Get the rewards that were explicitly set. */
+        const data_t &getRewards() const;
+
         friend std::ostream &operator<<(std::ostream &os, const CooperativeRewardModel &reward_fct)
         {
             os << "<cooperative-reward min=\"" << reward_fct.min << "\" max=\"" << reward_fct.max << "\"> " << std::endl;
@@ -66,6 +69,9 @@ namespace sdm
         double getMinReward(number agent_id, number t = 0) const;
         double getMaxReward(number agent_id, number t = 0) const;
 
+        /** @brief Get the rewards that were explicitly set. */
+        const data_t &getRewards() const;
+
         friend std::ostream &operator<<(std::ostream &os, const CompetitiveRewardModel &reward_fct)
         {
             os << "<competitive-reward> " << std::endl;
@@ -2,6 +2,7 @@
 #include <sdm/config.hpp>
 #include <sdm/exception.hpp>
 #include <sdm/core/state/belief_state.hpp>
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
 #include <sdm/utils/linear_algebra/hyperplane/alpha_vector.hpp>
 #include <sdm/utils/linear_algebra/hyperplane/beta_vector.hpp>
 
@@ -26,7 +27,7 @@ namespace sdm
     }
   }
 
-  Belief::Belief(const Belief &v) : container(v.container)
+  Belief::Belief(const Belief &v) : container(v.container), hash_(v.hash_), hash_precision_(v.hash_precision_)
   {
   }
 
@@ -45,16 +46,38 @@ namespace sdm
     // Create next belief.
     auto next_belief = std::make_shared<Belief>();
     auto pomdp = std::dynamic_pointer_cast<POMDPInterface>(mdp);
-    for (const auto &pair_state_proba : this->container)
+    auto flat_dynamics = pomdp->getFlatDynamics();
+    auto action_index = (flat_dynamics) ? flat_dynamics->getActionIndex(action) : FlatTabularDynamics::NOT_FOUND;
+    auto observation_index = (flat_dynamics) ? flat_dynamics->getObservationIndex(observation) : FlatTabularDynamics::NOT_FOUND;
+    if ((action_index != FlatTabularDynamics::NOT_FOUND) && (observation_index != FlatTabularDynamics::NOT_FOUND))
     {
-      for (const auto &next_state : pomdp->getReachableStates(pair_state_proba.first, action, t))
+      // Fully tabular models : iterate over the flat rows of successors
+      for (const auto &pair_state_proba : this->container)
       {
-        //std::cout << "\n in a reachable state"<<std::endl;
-        double proba = pomdp->getDynamics(pair_state_proba.first, action, next_state, observation, t) * pair_state_proba.second;
+        for (const auto &successor : flat_dynamics->getSuccessors(flat_dynamics->getStateIndex(pair_state_proba.first), action_index))
+        {
+          double proba = successor.probability * flat_dynamics->getObservationProbability(successor, observation_index) * pair_state_proba.second;
 
-        if (proba > 0)
+          if (proba > 0)
+          {
+            next_belief->addProbability(flat_dynamics->getState(successor.next_state), proba);
+          }
+        }
+      }
+    }
+    else
+    {
+      for (const auto &pair_state_proba : this->container)
+      {
+        for (const auto &next_state : pomdp->getReachableStates(pair_state_proba.first, action, t))
         {
-          next_belief->addProbability(next_state, proba);
+          //std::cout << "\n in a reachable state"<<std::endl;
+          double proba = pomdp->getDynamics(pair_state_proba.first, action, next_state, observation, t) * pair_state_proba.second;
+
+          if (proba > 0)
+          {
+            next_belief->addProbability(next_state, proba);
+          }
         }
       }
     }
@@ -93,8 +116,22 @@ namespace sdm
 
   void Belief::setProbability(const std::shared_ptr<State> &state, double proba)
   {
+    // Remove the hash of the previous entry
+    auto iter = this->container.find(state);
+    if (iter != this->container.end())
+    {
+      this->hash_ -= Belief::hashEntry(state, iter->second, this->hash_precision_);
+    }
+
     // Set the new occupancy measure
     this->container.setValueAt(state, proba);
+
+    // Add the hash of the new entry
+    iter = this->container.find(state);
+    if (iter != this->container.end())
+    {
+      this->hash_ += Belief::hashEntry(state, iter->second, this->hash_precision_);
+    }
   }
 
   double Belief::getProbability(const std::shared_ptr<State> &state) const
@@ -109,7 +146,7 @@ namespace sdm
 
   void Belief::addProbability(const std::shared_ptr<State> &state, double proba)
   {
-    this->container.setValueAt(state, this->getProbability(state) + proba);
+    this->setProbability(state, this->getProbability(state) + proba);
   }
 
   std::shared_ptr<State> Belief::sampleState()
@@ -151,7 +188,44 @@ namespace sdm
     {
       precision = Belief::PRECISION;
     }
-    return std::hash<MappedVector<std::shared_ptr<State>>>()(this->container, precision);
+    return this->getHash(precision);
+  }
+
+  std::size_t Belief::hashEntry(const std::shared_ptr<State> &state, double proba, double precision)
+  {
+    std::size_t seed = std::hash<std::shared_ptr<State>>()(state);
+    sdm::hash_combine(seed, lround(proba / precision));
+
+    // Mix the bits, since entries are summed up
+    seed ^= seed >> 33;
+    seed *= 0xff51afd7ed558ccdULL;
+    seed ^= seed >> 33;
+    return seed;
+  }
+
+  std::size_t Belief::getHash(double precision) const
+  {
+    if (precision == this->hash_precision_)
+    {
+      return this->hash_;
+    }
+
+    std::size_t hash = 0;
+    for (const auto &pair_state_proba : this->container)
+    {
+      hash += Belief::hashEntry(pair_state_proba.first, pair_state_proba.second, precision);
+    }
+    return hash;
+  }
+
+  void Belief::computeHash(double precision)
+  {
+    this->hash_ = 0;
+    this->hash_precision_ = precision;
+    for (const auto &pair_state_proba : this->container)
+    {
+      this->hash_ += Belief::hashEntry(pair_state_proba.first, pair_state_proba.second, precision);
+    }
   }
 
   bool Belief::isEqualNorm1(const std::shared_ptr<BeliefInterface> &other, double precision) const
@@ -177,6 +251,12 @@ namespace sdm
     {
       precision = Belief::PRECISION;
     }
+
+    // Beliefs with different supports, or different hashes at the precision of the comparison, are different
+    if ((this->size() != other.size()) || ((precision == this->hash_precision_) && (precision == other.hash_precision_) && (this->hash_ != other.hash_)))
+    {
+      return false;
+    }
     return this->container.isEqual(other.container, precision);
   }
 
@@ -238,6 +318,7 @@ namespace sdm
   void Belief::finalize()
   {
     this->container.finalize();
+    this->computeHash(Belief::PRECISION);
   }
 
   size_t Belief::size() const
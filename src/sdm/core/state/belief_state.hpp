@@ -90,6 +90,34 @@ namespace sdm
 
   protected:
     MappedVector<std::shared_ptr<State>> container;
+
+    /**
+     * @brief The hash of the entries, maintained as probabilities are set.
+     *
+     * The hash is the sum of the hashes of the entries (state, rounded probability), so that it does not
+     * depend on the order of the entries and is updated in constant time. It is recomputed by finalize().
+     */
+    std::size_t hash_ = 0;
+
+    /** @brief The precision used to round probabilities in hash_. */
+    double hash_precision_ = Belief::PRECISION;
+
+    /**
+     * @brief Get the hash of an entry (state, probability rounded at a given precision).
+     */
+    static std::size_t hashEntry(const std::shared_ptr<State> &state, double proba, double precision);
+
+    /**
+     * @brief Get the hash of the entries at a given precision (maintained hash if it is the precision of hash_).
+     */
+    std::size_t getHash(double precision) const;
+
+    /**
+     * @brief Recompute the maintained hash.
+     *
+     * @param precision the precision used to round probabilities
+     */
+    void computeHash(double precision);
   };
 } // namespace sdm
 
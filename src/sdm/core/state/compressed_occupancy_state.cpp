@@ -174,7 +174,12 @@ namespace sdm
     std::shared_ptr<JointHistoryInterface> CompressedOccupancyState::getCompressedJointHistory(const std::shared_ptr<JointHistoryInterface> &joint_history) const
     {
         const auto &labels = this->getJointLabels(joint_history->getIndividualHistories());
-        return this->jhistory_map_.at(labels);
+        auto compressed_joint_history = joint_history->getJointHistory(labels);
+        if (compressed_joint_history == nullptr)
+        {
+            throw sdm::exception::Exception("CompressedOccupancyState::getCompressedJointHistory : no joint history is made of the labels");
+        }
+        return compressed_joint_history;
     }
 
     bool CompressedOccupancyState::areIndividualHistoryLPE(const std::shared_ptr<HistoryInterface> &ihistory_1, const std::shared_ptr<HistoryInterface> &ihistory_2, number agent_identifier)
@@ -196,63 +201,60 @@ namespace sdm
 
         for (int agent_id = 0; agent_id < this->num_agents_; ++agent_id)
         {
-            // Get support (a set of individual histories for agent i)
-            const auto &support_set = this->getIndividualHistories(agent_id);
-            auto &&support = tools::set2vector(support_set);
-
-            // Sort support
-            std::sort(support.begin(), support.end());
-
-            for (auto iter_first = support.begin(); iter_first != support.end();)
+            // Only histories with the same signature need to be checked against each other
+            for (auto &support : this->getCompressionCandidates(agent_id))
             {
-                auto ihistory_label = *iter_first;      // Get the ihistory "label"
-                iter_first = support.erase(iter_first); // Erase the ihistory "label" from the support
-
-                // Set probability of labels
-                for (const auto &joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistories())
+                for (auto iter_first = support.begin(); iter_first != support.end();)
                 {
-                    auto belief = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history);
-                    current_compact_ostate->setProbability(joint_history, belief, previous_compact_ostate->getProbability(joint_history));
-                }
-
-                // For all other individual histories in the support
-                for (auto iter_second = iter_first; iter_second != support.end();)
-                {
-                    // Get the ihistory we want check the equivalence
-                    auto ihistory_one_step_left = *iter_second;
+                    auto ihistory_label = *iter_first;      // Get the ihistory "label"
+                    iter_first = support.erase(iter_first); // Erase the ihistory "label" from the support
 
-                    // Check equivalence between individual histories
-                    if (this->areIndividualHistoryLPE(ihistory_label, ihistory_one_step_left, agent_id))
+                    // Set probability of labels
+                    for (const auto &joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistories())
                     {
-                        // If ihistories are equivalent
-                        // Store the new label
-                        this->updateLabel(agent_id, ihistory_one_step_left, ihistory_label);
+                        auto belief = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history);
+                        current_compact_ostate->setProbability(joint_history, belief, previous_compact_ostate->getProbability(joint_history));
+                    }
 
-                        // Erase unecessary equivalent individual history
-                        iter_second = support.erase(iter_second);
+                    // For all other individual histories in the support
+                    for (auto iter_second = iter_first; iter_second != support.end();)
+                    {
+                        // Get the ihistory we want check the equivalence
+                        auto ihistory_one_step_left = *iter_second;
 
-                        // ----- Update probability of the new compact occupancy state by adding proba of the equivalent ihistory ---
-                        // For all private joint history in the previous compact occupancy state
-                        for (const auto &private_joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getJointHistories())
+                        // Check equivalence between individual histories
+                        if (this->areIndividualHistoryLPE(ihistory_label, ihistory_one_step_left, agent_id))
                         {
-                            // Get the probability of the private occupancy state corresponding to the history that will be deleted
-                            double probability = this->weight_of_private_occupancy_state_[agent_id][ihistory_one_step_left] * previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getProbability(private_joint_history);
-
-                            // Get the partial joint history label
-                            auto partial_jhist = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getPartialJointHistory(private_joint_history);
-
-                            // Get the joint history corresponding to this partial joint history in the private occupancy state of the history label
-                            auto joint_history_from_partial = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistoryFromPartial(partial_jhist);
-
-                            // Update the current compact occupancy state
-                            current_compact_ostate->addProbability(joint_history_from_partial,
-                                                                   previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history_from_partial),
-                                                                   probability);
+                            // If ihistories are equivalent
+                            // Store the new label
+                            this->updateLabel(agent_id, ihistory_one_step_left, ihistory_label);
+
+                            // Erase unecessary equivalent individual history
+                            iter_second = support.erase(iter_second);
+
+                            // ----- Update probability of the new compact occupancy state by adding proba of the equivalent ihistory ---
+                            // For all private joint history in the previous compact occupancy state
+                            for (const auto &private_joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getJointHistories())
+                            {
+                                // Get the probability of the private occupancy state corresponding to the history that will be deleted
+                                double probability = this->weight_of_private_occupancy_state_[agent_id][ihistory_one_step_left] * previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getProbability(private_joint_history);
+
+                                // Get the partial joint history label
+                                auto partial_jhist = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getPartialJointHistory(private_joint_history);
+
+                                // Get the joint history corresponding to this partial joint history in the private occupancy state of the history label
+                                auto joint_history_from_partial = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistoryFromPartial(partial_jhist);
+
+                                // Update the current compact occupancy state
+                                current_compact_ostate->addProbability(joint_history_from_partial,
+                                                                       previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history_from_partial),
+                                                                       probability);
+                            }
+                        }
+                        else
+                        {
+                            iter_second++;
                         }
-                    }
-                    else
-                    {
-                        iter_second++;
                     }
                 }
             }
@@ -261,6 +263,8 @@ namespace sdm
             previous_compact_ostate->private_ihistory_map_ = this->private_ihistory_map_;
             previous_compact_ostate->finalize();
             current_compact_ostate->container.clear();
+            current_compact_ostate->hash_ = 0;
+            current_compact_ostate->canonical_ = false;
         }
 
         // previous_compact_ostate->setFullyUncompressedOccupancy(this->getFullyUncompressedOccupancy());
@@ -280,9 +284,6 @@ namespace sdm
             // Get the corresponding belief
             auto belief = this->getBeliefAt(jhist);
 
-            // Store relation between joint history and list of individual histories
-            this->jhistory_map_.emplace(jhist->getIndividualHistories(), jhist);
-
             // For each agent we update its private occupancy state
             for (number agent_id = 0; agent_id < this->num_agents_; agent_id++)
             {
@@ -0,0 +1,369 @@
+#include <iomanip>
+
+#include <sdm/config.hpp>
+#include <sdm/exception.hpp>
+#include <sdm/core/state/dense_occupancy_state.hpp>
+#include <sdm/core/action/decision_rule.hpp>
+#include <sdm/world/base/pomdp_interface.hpp>
+#include <sdm/utils/linear_algebra/hyperplane/alpha_vector.hpp>
+#include <sdm/utils/linear_algebra/hyperplane/beta_vector.hpp>
+
+namespace sdm
+{
+    DenseOccupancyState::DenseOccupancyState() : DenseOccupancyState(2, 0)
+    {
+    }
+
+    DenseOccupancyState::DenseOccupancyState(number num_agents, number h) : DenseOccupancyState(num_agents, h, COMPRESSED)
+    {
+    }
+
+    DenseOccupancyState::DenseOccupancyState(number num_agents, number h, StateType stateType) : OccupancyState(num_agents, h, stateType)
+    {
+    }
+
+    DenseOccupancyState::DenseOccupancyState(const DenseOccupancyState &copy)
+        : OccupancyState(copy),
+          columns_up_to_date_(copy.columns_up_to_date_),
+          probability_column_(copy.probability_column_),
+          belief_id_column_(copy.belief_id_column_),
+          jhistory_at_row_(copy.jhistory_at_row_),
+          belief_table_(copy.belief_table_),
+          belief_offsets_(copy.belief_offsets_),
+          belief_states_(copy.belief_states_),
+          belief_probabilities_(copy.belief_probabilities_)
+    {
+    }
+
+    DenseOccupancyState::~DenseOccupancyState()
+    {
+    }
+
+    std::shared_ptr<OccupancyState> DenseOccupancyState::make(number h)
+    {
+        return std::make_shared<DenseOccupancyState>(this->num_agents_, h, this->state_type);
+    }
+
+    std::shared_ptr<OccupancyState> DenseOccupancyState::copy()
+    {
+        return std::make_shared<DenseOccupancyState>(*this);
+    }
+
+    // #############################################
+    // ######### MANIPULATE COLUMNS ################
+    // #############################################
+
+    void DenseOccupancyState::setProbability(const std::shared_ptr<State> &joint_history, double proba)
+    {
+        OccupancyState::setProbability(joint_history, proba);
+        this->columns_up_to_date_ = false;
+    }
+
+    void DenseOccupancyState::setBeliefAt(const std::shared_ptr<JointHistoryInterface> &jhistory, const std::shared_ptr<BeliefInterface> &belief)
+    {
+        OccupancyState::setBeliefAt(jhistory, belief);
+        this->columns_up_to_date_ = false;
+    }
+
+    void DenseOccupancyState::normalizeBelief(double norm_1)
+    {
+        bool columns_up_to_date = this->columns_up_to_date_;
+
+        OccupancyState::normalizeBelief(norm_1);
+
+        // Normalizing does not change the support, so the probability column can be rescaled in place
+        if (columns_up_to_date && (norm_1 > 0))
+        {
+            for (auto &probability : this->probability_column_)
+            {
+                probability = probability / norm_1;
+            }
+            this->columns_up_to_date_ = true;
+        }
+    }
+
+    void DenseOccupancyState::finalize()
+    {
+        OccupancyState::finalize();
+        this->setupColumns();
+    }
+
+    void DenseOccupancyState::finalize(bool do_compression)
+    {
+        OccupancyState::finalize(do_compression);
+        this->setupColumns();
+    }
+
+    void DenseOccupancyState::checkColumns()
+    {
+        if (!this->columns_up_to_date_)
+        {
+            this->setupColumns();
+        }
+    }
+
+    void DenseOccupancyState::setupColumns()
+    {
+        std::size_t num_rows = this->container.size();
+
+        this->probability_column_.clear();
+        this->belief_id_column_.clear();
+        this->jhistory_at_row_.clear();
+        this->belief_table_.clear();
+        this->belief_offsets_.clear();
+        this->belief_states_.clear();
+        this->belief_probabilities_.clear();
+
+        this->probability_column_.reserve(num_rows);
+        this->belief_id_column_.reserve(num_rows);
+        this->jhistory_at_row_.reserve(num_rows);
+
+        // Beliefs are shared between rows, we only keep one copy of each of them
+        std::unordered_map<std::shared_ptr<BeliefInterface>, index_t> belief_to_id;
+
+        this->belief_offsets_.push_back(0);
+        for (const auto &pair_jhistory_proba : this->container)
+        {
+            auto joint_history = std::dynamic_pointer_cast<JointHistoryInterface>(pair_jhistory_proba.first);
+            auto belief = this->getBeliefAt(joint_history);
+
+            // Get the identifier of the belief (and flatten it if it is a new one)
+            auto [iterator, inserted] = belief_to_id.emplace(belief, this->belief_table_.size());
+            if (inserted)
+            {
+                this->belief_table_.push_back(belief);
+                if (belief != nullptr)
+                {
+                    for (const auto &state : belief->getStates())
+                    {
+                        this->belief_states_.push_back(state);
+                        this->belief_probabilities_.push_back(belief->getProbability(state));
+                    }
+                }
+                this->belief_offsets_.push_back(this->belief_states_.size());
+            }
+
+            this->probability_column_.push_back(pair_jhistory_proba.second);
+            this->belief_id_column_.push_back(iterator->second);
+            this->jhistory_at_row_.push_back(joint_history);
+        }
+
+        this->columns_up_to_date_ = true;
+    }
+
+    std::size_t DenseOccupancyState::getNumRows() const
+    {
+        return this->probability_column_.size();
+    }
+
+    const std::vector<double> &DenseOccupancyState::getProbabilityColumn() const
+    {
+        return this->probability_column_;
+    }
+
+    const std::vector<DenseOccupancyState::index_t> &DenseOccupancyState::getBeliefIDColumn() const
+    {
+        return this->belief_id_column_;
+    }
+
+    const std::shared_ptr<JointHistoryInterface> &DenseOccupancyState::getJointHistoryAtRow(std::size_t row) const
+    {
+        return this->jhistory_at_row_.at(row);
+    }
+
+    const std::shared_ptr<BeliefInterface> &DenseOccupancyState::getBeliefAtRow(std::size_t row) const
+    {
+        return this->belief_table_.at(this->belief_id_column_.at(row));
+    }
+
+    // #############################################
+    // ######### HOT LOOPS #########################
+    // #############################################
+
+    Pair<std::shared_ptr<State>, double> DenseOccupancyState::computeNext(const std::shared_ptr<MDPInterface> &mdp, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t)
+    {
+        this->checkColumns();
+
+        auto decision_rule = action->toDecisionRule();
+        auto pomdp = std::dynamic_pointer_cast<POMDPInterface>(mdp);
+
+        // Get the joint observations that are compatible with the observation once for all rows
+        std::vector<std::shared_ptr<Observation>> joint_observations;
+        for (const auto &jobs : *pomdp->getObservationSpace(t))
+        {
+            auto joint_observation = jobs->toObservation();
+            if (this->checkCompatibility(joint_observation, observation))
+            {
+                joint_observations.push_back(joint_observation);
+            }
+        }
+
+        // Rows of the next occupancy state. Expanding a joint history always gives the same instance of
+        // the next joint history (see HistoryTrie), so that next joint histories are identified by address.
+        std::unordered_map<const JointHistoryInterface *, index_t> next_row_of_jhistory;
+        std::vector<std::shared_ptr<JointHistoryInterface>> next_jhistories;
+        std::vector<double> next_probabilities;
+        std::vector<std::vector<Pair<std::shared_ptr<BeliefInterface>, double>>> next_weighted_beliefs;
+
+        // List the transitions (row, z_{t+1}) to compute
+        std::vector<std::size_t> rows;
+        std::vector<std::shared_ptr<BeliefInterface>> beliefs;
+        std::vector<std::shared_ptr<Action>> joint_actions;
+        std::vector<std::shared_ptr<Observation>> next_observations;
+        for (std::size_t row = 0; row < this->getNumRows(); row++)
+        {
+            // Apply decision rule and get action
+            auto joint_action = this->applyDR(decision_rule, this->jhistory_at_row_[row]);
+
+            for (const auto &joint_observation : joint_observations)
+            {
+                rows.push_back(row);
+                beliefs.push_back(this->belief_table_[this->belief_id_column_[row]]);
+                joint_actions.push_back(joint_action);
+                next_observations.push_back(joint_observation);
+            }
+        }
+
+        // Get the next beliefs and p(z_{t+1} | b_t, u_t)
+        auto next_beliefs = this->computeNextBeliefs(mdp, beliefs, joint_actions, next_observations, t);
+
+        // Merge transitions in order
+        for (std::size_t i = 0; i < next_beliefs.size(); i++)
+        {
+            const auto &[next_belief, proba_observation] = next_beliefs[i];
+
+            double next_joint_history_probability = this->probability_column_[rows[i]] * proba_observation;
+
+            // If the next history probability is not zero
+            if (next_joint_history_probability > 0)
+            {
+                auto next_joint_history = this->jhistory_at_row_[rows[i]]->expand(next_observations[i])->toJointHistory();
+
+                auto [iterator, inserted] = next_row_of_jhistory.emplace(next_joint_history.get(), next_jhistories.size());
+                if (inserted)
+                {
+                    next_jhistories.push_back(next_joint_history);
+                    next_probabilities.push_back(0.);
+                    next_weighted_beliefs.push_back({});
+                }
+                next_probabilities[iterator->second] += next_joint_history_probability;
+                next_weighted_beliefs[iterator->second].push_back({next_belief->toBelief(), next_joint_history_probability});
+            }
+        }
+
+        // Build the next one step left occupancy state
+        auto next_one_step_left_compressed_occupancy_state = this->make(t + 1);
+        for (std::size_t next_row = 0; next_row < next_jhistories.size(); next_row++)
+        {
+            const auto &weighted_beliefs = next_weighted_beliefs[next_row];
+
+            std::shared_ptr<BeliefInterface> next_belief;
+            if (weighted_beliefs.size() == 1)
+            {
+                next_belief = weighted_beliefs.front().first;
+            }
+            else
+            {
+                // Aggregate all beliefs leading to the same joint history (once, instead of pairwise)
+                auto aggregated_belief = std::make_shared<Belief>();
+                for (const auto &pair_belief_weight : weighted_beliefs)
+                {
+                    for (const auto &state : pair_belief_weight.first->getStates())
+                    {
+                        aggregated_belief->addProbability(state, pair_belief_weight.second * pair_belief_weight.first->getProbability(state));
+                    }
+                }
+                aggregated_belief->finalize();
+                aggregated_belief->normalizeBelief(aggregated_belief->norm_1());
+                next_belief = aggregated_belief;
+            }
+            next_one_step_left_compressed_occupancy_state->setProbability(next_jhistories[next_row], next_belief, next_probabilities[next_row]);
+        }
+
+        return this->finalizeNextState(next_one_step_left_compressed_occupancy_state, t);
+    }
+
+    double DenseOccupancyState::getReward(const std::shared_ptr<MDPInterface> &mdp, const std::shared_ptr<Action> &action, number t)
+    {
+        this->checkColumns();
+
+        double reward = 0.;
+        auto decision_rule = action->toDecisionRule();
+        for (std::size_t row = 0; row < this->getNumRows(); row++)
+        {
+            // Get the action from decision rule
+            auto joint_action = this->applyDR(decision_rule, this->jhistory_at_row_[row]);
+
+            // Update the expected reward
+            reward += this->probability_column_[row] * this->belief_table_[this->belief_id_column_[row]]->getReward(mdp, joint_action, t);
+        }
+        return reward;
+    }
+
+    double DenseOccupancyState::product(const std::shared_ptr<AlphaVector> &alpha)
+    {
+        this->checkColumns();
+
+        double product = 0.0;
+        for (std::size_t row = 0; row < this->getNumRows(); row++)
+        {
+            const auto &joint_history = this->jhistory_at_row_[row];
+            index_t belief_id = this->belief_id_column_[row];
+
+            double product_row = 0.0;
+            for (std::size_t k = this->belief_offsets_[belief_id]; k < this->belief_offsets_[belief_id + 1]; k++)
+            {
+                product_row += this->belief_probabilities_[k] * alpha->getValueAt(this->belief_states_[k], joint_history);
+            }
+            product += this->probability_column_[row] * product_row;
+        }
+        return product;
+    }
+
+    double DenseOccupancyState::product(const std::shared_ptr<BetaVector> &beta, const std::shared_ptr<Action> &action)
+    {
+        this->checkColumns();
+
+        double product = 0.0;
+        auto decision_rule = action->toDecisionRule();
+        for (std::size_t row = 0; row < this->getNumRows(); row++)
+        {
+            const auto &joint_history = this->jhistory_at_row_[row];
+            auto joint_action = this->applyDR(decision_rule, joint_history);
+            index_t belief_id = this->belief_id_column_[row];
+
+            double product_row = 0.0;
+            for (std::size_t k = this->belief_offsets_[belief_id]; k < this->belief_offsets_[belief_id + 1]; k++)
+            {
+                product_row += this->belief_probabilities_[k] * beta->getValueAt(this->belief_states_[k], joint_history, joint_action);
+            }
+            product += this->probability_column_[row] * product_row;
+        }
+        return product;
+    }
+
+    std::string DenseOccupancyState::str() const
+    {
+        if (!this->columns_up_to_date_)
+        {
+            return OccupancyState::str();
+        }
+
+        std::ostringstream res;
+        res << std::setprecision(config::OCCUPANCY_DECIMAL_PRINT) << std::fixed;
+
+        res << "<dense-occupancy-state size=\"" << this->size() << "\" beliefs=\"" << this->belief_table_.size() << "\">\n";
+        for (std::size_t row = 0; row < this->getNumRows(); row++)
+        {
+            res << "\t<probability";
+            res << " row=" << row;
+            res << " joint_history=" << this->jhistory_at_row_[row]->short_str();
+            res << " belief_id=" << this->belief_id_column_[row] << ">\n";
+            res << "\t\t\t" << this->probability_column_[row] << "\n";
+            res << "\t</probability \n";
+        }
+        res << "</dense-occupancy-state>";
+        return res.str();
+    }
+
+} // namespace sdm
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+
+#include <sdm/types.hpp>
+#include <sdm/macros.hpp>
+#include <sdm/core/state/occupancy_state.hpp>
+
+namespace sdm
+{
+
+    /**
+     * @brief An occupancy state whose support is stored as contiguous columns.
+     *
+     * This class has the same semantic as the OccupancyState class. The only difference is
+     * the layout used by the hot loops (i.e. `next`, `getReward` and `product`). Once the
+     * state is finalized, the support is stored as a structure of arrays indexed by rows:
+     *
+     * - the probability column: p(o) for each row ;
+     * - the joint history column: the joint history o ;
+     * - the belief ID column: the index of b(.|o) in the table of distinct beliefs.
+     *
+     * The beliefs themselves are flattened into a pair of arrays (states, probabilities)
+     * delimited by offsets. This avoids the pointer chasing and the hash lookups that are
+     * required when iterating over the joint histories of the OccupancyState class.
+     *
+     */
+    class DenseOccupancyState : public OccupancyState
+    {
+    public:
+        using index_t = std::uint32_t;
+
+        DenseOccupancyState();
+        DenseOccupancyState(number num_agents, number h);
+        DenseOccupancyState(number num_agents, number h, StateType stateType);
+        DenseOccupancyState(const DenseOccupancyState &copy);
+        ~DenseOccupancyState();
+
+        std::shared_ptr<OccupancyState> make(number h);
+        std::shared_ptr<OccupancyState> copy();
+
+        using OccupancyState::setProbability;
+        void setProbability(const std::shared_ptr<State> &joint_history, double proba);
+        void setBeliefAt(const std::shared_ptr<JointHistoryInterface> &jhistory, const std::shared_ptr<BeliefInterface> &belief);
+        void normalizeBelief(double norm_1);
+
+        void finalize();
+        void finalize(bool do_compression);
+
+        double getReward(const std::shared_ptr<MDPInterface> &mdp, const std::shared_ptr<Action> &action, number t);
+
+        double product(const std::shared_ptr<AlphaVector> &alpha);
+        double product(const std::shared_ptr<BetaVector> &beta, const std::shared_ptr<Action> &action);
+
+        /** @brief Get the number of rows (i.e. joint histories) in the support. */
+        std::size_t getNumRows() const;
+
+        /** @brief Get the column of probabilities p(o). */
+        const std::vector<double> &getProbabilityColumn() const;
+
+        /** @brief Get the column of belief identifiers (local to this occupancy state). */
+        const std::vector<index_t> &getBeliefIDColumn() const;
+
+        /** @brief Get the joint history stored at a given row. */
+        const std::shared_ptr<JointHistoryInterface> &getJointHistoryAtRow(std::size_t row) const;
+
+        /** @brief Get the belief stored at a given row. */
+        const std::shared_ptr<BeliefInterface> &getBeliefAtRow(std::size_t row) const;
+
+        std::string str() const;
+
+    protected:
+        /** @brief Whether the columns reflect the content of the occupancy state */
+        bool columns_up_to_date_ = false;
+
+        /** @brief Columns of the occupancy state */
+        std::vector<double> probability_column_;
+        std::vector<index_t> belief_id_column_;
+
+        /** @brief Joint histories stored at each row */
+        std::vector<std::shared_ptr<JointHistoryInterface>> jhistory_at_row_;
+
+        /** @brief Table of distinct beliefs */
+        std::vector<std::shared_ptr<BeliefInterface>> belief_table_;
+
+        /** @brief Flattened beliefs : the support of belief k is in [belief_offsets_[k], belief_offsets_[k+1]) */
+        std::vector<std::size_t> belief_offsets_;
+        std::vector<std::shared_ptr<State>> belief_states_;
+        std::vector<double> belief_probabilities_;
+
+        /** @brief Build the columns from the current content of the occupancy state. */
+        void setupColumns();
+
+        /** @brief Rebuild the columns if the occupancy state was modified since the last build. */
+        void checkColumns();
+
+        Pair<std::shared_ptr<State>, double> computeNext(const std::shared_ptr<MDPInterface> &mdp, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t);
+    };
+} // namespace sdm
+
+DEFINE_STD_HASH(sdm::DenseOccupancyState, sdm::OccupancyState::PRECISION);
@@ -1,17 +1,34 @@
+#include <sdm/exception.hpp>
 #include <sdm/core/state/history_tree.hpp>
 
 namespace sdm
 {
-    HistoryTree::HistoryTree() : Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>()
+    HistoryTree::HistoryTree() : trie_(std::make_shared<HistoryTrie>())
     {
     }
 
-    HistoryTree::HistoryTree(number max_depth) : Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>(max_depth)
+    HistoryTree::HistoryTree(number max_depth) : trie_(std::make_shared<HistoryTrie>(max_depth))
     {
     }
 
-    HistoryTree::HistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item) : Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>(parent, item)
+    HistoryTree::HistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item)
+        : HistoryTree(parent, item, parent->getTrie()->addNode(parent->getID(), item))
     {
+        // Keep track of the handle of the parent, so that the parent can be recovered from the node
+        this->trie_->setHandle(parent->getID(), parent, false);
+    }
+
+    HistoryTree::HistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item, id_type id)
+        : depth_(parent->getDepth() + 1), trie_(parent->getTrie()), id_(id), data_(item)
+    {
+    }
+
+    HistoryTree::~HistoryTree()
+    {
+        if (this->isOrigin() && this->trie_)
+        {
+            this->trie_->releaseHandles();
+        }
     }
 
     std::shared_ptr<HistoryInterface> HistoryTree::getPreviousHistory()
@@ -36,16 +53,18 @@ namespace sdm
 
     std::shared_ptr<HistoryInterface> HistoryTree::expand(const std::shared_ptr<Observation> &observation, const std::shared_ptr<Action> &action, bool backup)
     {
-        //std::cout << "\n expanding with observation" << observation << " and action " << action;
         return this->expand<HistoryTree>(observation, action, backup);
     }
 
-
     std::shared_ptr<HistoryTree> HistoryTree::expandHistoryTree(const std::shared_ptr<Observation> &observation, const std::shared_ptr<Action> &action, bool backup)
     {
         return this->expand<HistoryTree>(observation, action, backup);
     }
 
+    void HistoryTree::initializeChild(const std::shared_ptr<HistoryTree> &, const std::shared_ptr<Observation> &, const std::shared_ptr<Action> &, bool)
+    {
+    }
+
     std::string HistoryTree::short_str() const
     {
         std::ostringstream res;
@@ -60,11 +79,11 @@ namespace sdm
 
             list_items.push_front(this->getData());
 
-            auto chistory = this->getParent();
-            while (chistory != this->origin_.lock())
+            auto node = this->trie_->getParent(this->id_);
+            while ((node != HistoryTrie::ROOT) && (node != HistoryTrie::NONE))
             {
-                list_items.push_front(chistory->getData());
-                chistory = chistory->getParent();
+                list_items.push_front(this->trie_->getItem(node));
+                node = this->trie_->getParent(node);
             }
             res << '(';
             for (auto item_it = list_items.begin(); item_it != list_items.end();)
@@ -96,32 +115,89 @@ namespace sdm
     std::shared_ptr<HistoryTree> HistoryTree::getptr()
     {
         return std::dynamic_pointer_cast<HistoryTree>(Item::getPointer());
-        // return Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>::downcasted_shared_from_this<HistoryTree>();
     }
 
     std::shared_ptr<HistoryTree> HistoryTree::getParent() const
     {
-        return std::static_pointer_cast<HistoryTree>(Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>::getParent());
+        auto parent = this->trie_->getParent(this->id_);
+        return (parent != HistoryTrie::NONE) ? this->trie_->getHandle(parent) : nullptr;
+    }
+
+    void HistoryTree::setParent(std::shared_ptr<HistoryTree> parent)
+    {
+        if (parent == nullptr)
+        {
+            this->trie_->setParent(this->id_, HistoryTrie::NONE);
+        }
+        else
+        {
+            if (parent->getTrie() != this->trie_)
+            {
+                throw sdm::exception::Exception("HistoryTree::setParent : the parent must belong to the same tree");
+            }
+            this->trie_->setParent(this->id_, parent->getID());
+            this->trie_->setHandle(parent->getID(), parent, false);
+        }
+    }
+
+    bool HistoryTree::isOrigin() const
+    {
+        return this->id_ == HistoryTrie::ROOT;
     }
 
     std::shared_ptr<HistoryTree> HistoryTree::getOrigin()
     {
-        return std::static_pointer_cast<HistoryTree>(Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>::getOrigin());
+        return this->isOrigin() ? nullptr : this->trie_->getHandle(HistoryTrie::ROOT);
+    }
+
+    number HistoryTree::getNumChildren() const
+    {
+        return this->trie_->getChildren(this->id_).size();
     }
 
     std::vector<std::shared_ptr<HistoryTree>> HistoryTree::getChildren() const
     {
         std::vector<std::shared_ptr<HistoryTree>> vector;
-        for (const auto &children : Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>::getChildren())
+        for (const auto &child : this->trie_->getChildren(this->id_))
         {
-            vector.push_back(std::static_pointer_cast<HistoryTree>(children));
+            vector.push_back(this->trie_->getHandle(child));
         }
         return vector;
     }
 
     std::shared_ptr<HistoryTree> HistoryTree::getChild(const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &obs_act) const
     {
-        return std::static_pointer_cast<HistoryTree>(Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>::getChild(obs_act));
+        auto child = this->trie_->getChild(this->id_, obs_act);
+        if (child == HistoryTrie::NONE)
+        {
+            throw std::out_of_range("HistoryTree::getChild : the history was never expanded with this item");
+        }
+        return this->trie_->getHandle(child);
+    }
+
+    const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &HistoryTree::getData() const
+    {
+        return this->data_;
+    }
+
+    number HistoryTree::getDepth() const
+    {
+        return this->depth_;
+    }
+
+    number HistoryTree::getMaxDepth() const
+    {
+        return this->trie_->getMaxDepth();
+    }
+
+    HistoryTree::id_type HistoryTree::getID() const
+    {
+        return this->id_;
+    }
+
+    const std::shared_ptr<HistoryTrie> &HistoryTree::getTrie() const
+    {
+        return this->trie_;
     }
 
     template <class Archive>
@@ -131,9 +207,4 @@ namespace sdm
         // archive &boost::serialization::base_object<Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>>(*this);
     }
 
-    const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &HistoryTree::getData() const
-    {
-        return Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>::getData();
-    }
-
-} // namespace sdm
\ No newline at end of file
+} // namespace sdm
@@ -11,9 +11,11 @@
  */
 #pragma once
 
+#include <list>
+
 #include <sdm/core/state/state.hpp>
 #include <sdm/core/action/action.hpp>
-#include <sdm/utils/struct/tree.hpp>
+#include <sdm/core/state/history_trie.hpp>
 #include <sdm/core/state/interface/history_interface.hpp>
 
 namespace sdm
@@ -28,12 +30,14 @@ namespace sdm
      * Let consider nodes above a given node as the list of actions
      * and observations at previous timesteps.
      *
+     * A history tree is a handle over a node of a HistoryTrie, which is shared by all histories of the same origin.
+     *
      */
-    class HistoryTree : virtual public HistoryInterface,
-                        public Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>
+    class HistoryTree : virtual public HistoryInterface
     {
     public:
-        using value_type = typename Tree<Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>>::value_type;
+        using value_type = HistoryTrie::item_type;
+        using id_type = HistoryTrie::id_type;
 
         /**
          *  @brief  Default constructor.
@@ -53,16 +57,28 @@ namespace sdm
          *
          *  @param  parent   the parent tree
          *  @param  item     the item
-         *  @param  backup wheter the node is marked or not
          *
-         *  This constructor builds a tree with a given parent and item.
+         *  This constructor builds a tree with a given parent and item. The new node is not a child of its parent
+         *  (i.e. it is not returned when the parent is expanded).
          */
         HistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item);
 
+        /**
+         *  @brief Construct the handle over an existing node of the trie of the parent.
+         *
+         *  The trie is not used (see HistoryTrie::expandChild), the caller registers the handles.
+         *
+         *  @param  parent   the parent tree
+         *  @param  item     the item
+         *  @param  id       the identifier of the node
+         */
+        HistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item, id_type id);
+
+        virtual ~HistoryTree();
+
         std::shared_ptr<HistoryInterface> getPreviousHistory();
 
         std::shared_ptr<Observation> getLastObservation();
-        
 
         std::shared_ptr<Action> getLastAction();
 
@@ -81,16 +97,29 @@ namespace sdm
 
         std::shared_ptr<HistoryTree> getptr();
         std::shared_ptr<HistoryTree> getParent() const;
-        void setParent(std::shared_ptr<HistoryTree> p){
-            this->parent_=p;
-        }
+        void setParent(std::shared_ptr<HistoryTree> p);
 
+        bool isOrigin() const;
         std::shared_ptr<HistoryTree> getOrigin();
+        number getNumChildren() const;
         std::vector<std::shared_ptr<HistoryTree>> getChildren() const;
         std::shared_ptr<HistoryTree> getChild(const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &obs_act) const;
 
         const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &getData() const;
 
+        number getDepth() const;
+        number getMaxDepth() const;
+
+        /**
+         * @brief Get the identifier of the history in its trie.
+         */
+        id_type getID() const;
+
+        /**
+         * @brief Get the trie of the history.
+         */
+        const std::shared_ptr<HistoryTrie> &getTrie() const;
+
         friend std::ostream &operator<<(std::ostream &os, HistoryTree &i_hist)
         {
             os << i_hist.str();
@@ -100,7 +129,19 @@ namespace sdm
         template <class Archive>
         void serialize(Archive &archive, const unsigned int);
 
+        //! @brief depth of the tree
+        number depth_ = 0;
+
     protected:
+        //! @brief the trie of all histories of the same origin
+        std::shared_ptr<HistoryTrie> trie_;
+
+        //! @brief the node of the history in the trie
+        id_type id_ = HistoryTrie::ROOT;
+
+        //! @brief data of the current node
+        value_type data_;
+
         /**
          *  @brief  Expands the tree using truncated expand method
          *
@@ -117,15 +158,15 @@ namespace sdm
 
             //<! fill in the vector of observation to simulate
             items.push_front(obs_action);
-            auto parent = this;
+            auto node = this->id_;
             while (items.size() < this->getMaxDepth())
             {
-                items.push_front(parent->getData());
-                parent = parent->getParent().get();
+                items.push_front(this->trie_->getItem(node));
+                node = this->trie_->getParent(node);
             }
 
             //<! iteratively expands the base_graph
-            auto trace = parent->getOrigin();
+            auto trace = this->getOrigin();
 
             for (auto it = items.begin(); it != items.end(); ++it)
             {
@@ -149,9 +190,12 @@ namespace sdm
         std::shared_ptr<output> expand(const std::shared_ptr<Observation> &observation, const std::shared_ptr<Action> &action = nullptr, bool backup = true)
         {
             auto obs_action = std::make_pair(observation, action);
-            if (backup && (this->children_.find(obs_action) != this->children_.end()))
+            if (backup)
             {
-                return std::static_pointer_cast<output>(this->getChild(obs_action));
+                if (auto child = this->trie_->findChildHandle(this->id_, obs_action))
+                {
+                    return std::static_pointer_cast<output>(child);
+                }
             }
             if (backup && (this->getDepth() >= this->getMaxDepth()))
             {
@@ -162,16 +206,28 @@ namespace sdm
             }
             if (backup)
             {
-                auto child = std::make_shared<output>(this->getptr(), obs_action);
-                this->children_.emplace(obs_action, child);
-                return child;
+                // The child is built and initialized before other threads can get it
+                return std::static_pointer_cast<output>(this->trie_->expandChild(this->getptr(), obs_action, [&](id_type child_id)
+                                                                                 {
+                                                                                     auto child = std::make_shared<output>(this->getptr(), obs_action, child_id);
+                                                                                     this->initializeChild(child, observation, action, backup);
+                                                                                     return child;
+                                                                                 }));
             }
 
-            return std::make_shared<output>(this->getptr(), obs_action);
+            auto child = std::make_shared<output>(this->getptr(), obs_action);
+            this->initializeChild(child, observation, action, backup);
+            return child;
         }
 
         virtual std::shared_ptr<HistoryTree> expandHistoryTree(const std::shared_ptr<Observation> &observation, const std::shared_ptr<Action> &action = nullptr, bool backup = true);
+
+        /**
+         * @brief Initialize a child built by `expand`, before it is published.
+         *
+         * The trie of the history is locked during the call (see HistoryTrie::expandChild) and must not be used.
+         */
+        virtual void initializeChild(const std::shared_ptr<HistoryTree> &child, const std::shared_ptr<Observation> &observation, const std::shared_ptr<Action> &action, bool backup);
     };
 
 } // namespace sdm
-  // #include <sdm/core/state/history_tree.tpp>
\ No newline at end of file
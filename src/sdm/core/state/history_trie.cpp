@@ -0,0 +1,189 @@
+#include <sdm/exception.hpp>
+#include <sdm/core/state/history_trie.hpp>
+#include <sdm/core/state/history_tree.hpp>
+
+namespace sdm
+{
+    HistoryTrie::HistoryTrie(number max_depth) : max_depth_(max_depth)
+    {
+        // The origin has no item, its symbol is never used
+        this->createNode(NONE, NONE);
+    }
+
+    number HistoryTrie::getMaxDepth() const
+    {
+        return this->max_depth_;
+    }
+
+    std::size_t HistoryTrie::size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(this->mutex_);
+        return this->nodes_.size();
+    }
+
+    std::uint64_t HistoryTrie::getChildKey(id_type node, id_type symbol)
+    {
+        return (std::uint64_t(node) << 32) | symbol;
+    }
+
+    HistoryTrie::id_type HistoryTrie::createNode(id_type parent, id_type symbol)
+    {
+        if (this->nodes_.size() >= NONE)
+        {
+            throw sdm::exception::Exception("HistoryTrie::createNode : too many histories");
+        }
+        this->nodes_.push_back({parent, symbol, NONE, NONE});
+        this->handles_.emplace_back();
+        return static_cast<id_type>(this->nodes_.size() - 1);
+    }
+
+    HistoryTrie::id_type HistoryTrie::getParent(id_type node) const
+    {
+        std::shared_lock<std::shared_mutex> lock(this->mutex_);
+        return this->nodes_[node].parent;
+    }
+
+    void HistoryTrie::setParent(id_type node, id_type parent)
+    {
+        std::unique_lock<std::shared_mutex> lock(this->mutex_);
+        this->nodes_[node].parent = parent;
+    }
+
+    const HistoryTrie::item_type &HistoryTrie::getItem(id_type node) const
+    {
+        id_type symbol;
+        {
+            std::shared_lock<std::shared_mutex> lock(this->mutex_);
+            symbol = this->nodes_[node].symbol;
+        }
+        return this->symbols_.getItem(symbol);
+    }
+
+    HistoryTrie::id_type HistoryTrie::findChildLocked(id_type node, const item_type &item) const
+    {
+        id_type symbol = this->symbols_.findID(item);
+        if (symbol == decltype(symbols_)::NOT_FOUND)
+        {
+            return NONE;
+        }
+        auto iterator = this->children_.find(HistoryTrie::getChildKey(node, symbol));
+        return (iterator != this->children_.end()) ? iterator->second : NONE;
+    }
+
+    HistoryTrie::id_type HistoryTrie::getChild(id_type node, const item_type &item) const
+    {
+        std::shared_lock<std::shared_mutex> lock(this->mutex_);
+        return this->findChildLocked(node, item);
+    }
+
+    std::vector<HistoryTrie::id_type> HistoryTrie::getChildren(id_type node) const
+    {
+        std::shared_lock<std::shared_mutex> lock(this->mutex_);
+        std::vector<id_type> children;
+        for (id_type child = this->nodes_[node].first_child; child != NONE; child = this->nodes_[child].next_sibling)
+        {
+            children.push_back(child);
+        }
+        return children;
+    }
+
+    HistoryTrie::id_type HistoryTrie::addChildLocked(id_type node, id_type symbol)
+    {
+        auto iterator = this->children_.emplace(HistoryTrie::getChildKey(node, symbol), NONE).first;
+        if (iterator->second == NONE)
+        {
+            iterator->second = this->createNode(node, symbol);
+
+            // Link the child to the list of children of its parent
+            this->nodes_[iterator->second].next_sibling = this->nodes_[node].first_child;
+            this->nodes_[node].first_child = iterator->second;
+        }
+        return iterator->second;
+    }
+
+    HistoryTrie::id_type HistoryTrie::addChild(id_type node, const item_type &item)
+    {
+        id_type symbol = this->symbols_.getID(item);
+        std::unique_lock<std::shared_mutex> lock(this->mutex_);
+        return this->addChildLocked(node, symbol);
+    }
+
+    std::shared_ptr<HistoryTree> HistoryTrie::findChildHandle(id_type node, const item_type &item) const
+    {
+        std::shared_lock<std::shared_mutex> lock(this->mutex_);
+        id_type child = this->findChildLocked(node, item);
+        return (child != NONE) ? this->handles_[child].lock() : nullptr;
+    }
+
+    std::shared_ptr<HistoryTree> HistoryTrie::expandChild(const std::shared_ptr<HistoryTree> &parent, const item_type &item, const std::function<std::shared_ptr<HistoryTree>(id_type)> &make_handle)
+    {
+        id_type node = parent->getID(), symbol = this->symbols_.getID(item);
+
+        std::unique_lock<std::shared_mutex> lock(this->mutex_);
+
+        // Another thread may have expanded the node while waiting for the lock
+        id_type child = this->addChildLocked(node, symbol);
+        if (auto handle = this->handles_[child].lock())
+        {
+            return handle;
+        }
+
+        auto handle = make_handle(child);
+
+        // Keep track of the handle of the parent, so that the parent can be recovered from the node
+        this->handles_[node] = parent;
+        this->handles_[child] = handle;
+        this->owned_handles_.push_back(handle);
+        return handle;
+    }
+
+    HistoryTrie::id_type HistoryTrie::addNode(id_type parent, const item_type &item)
+    {
+        id_type symbol = this->symbols_.getID(item);
+        std::unique_lock<std::shared_mutex> lock(this->mutex_);
+        return this->createNode(parent, symbol);
+    }
+
+    std::shared_ptr<HistoryTree> HistoryTrie::getHandle(id_type node) const
+    {
+        std::shared_lock<std::shared_mutex> lock(this->mutex_);
+        return this->handles_[node].lock();
+    }
+
+    void HistoryTrie::setHandle(id_type node, const std::shared_ptr<HistoryTree> &handle, bool owned)
+    {
+        std::unique_lock<std::shared_mutex> lock(this->mutex_);
+        this->handles_[node] = handle;
+        if (owned)
+        {
+            this->owned_handles_.push_back(handle);
+        }
+    }
+
+    void HistoryTrie::releaseHandles()
+    {
+        // Handles are released one after the other, rather than recursively as in a tree of pointers (and
+        // out of the lock, since the destruction of a handle may use the trie)
+        std::vector<std::shared_ptr<HistoryTree>> owned_handles;
+        {
+            std::unique_lock<std::shared_mutex> lock(this->mutex_);
+            owned_handles = std::move(this->owned_handles_);
+            this->owned_handles_.clear();
+        }
+        owned_handles.clear();
+    }
+
+    HistoryTrie::id_type HistoryTrie::getJointNode(const std::vector<id_type> &individual_ids) const
+    {
+        std::shared_lock<std::shared_mutex> lock(this->joint_mutex_);
+        auto iterator = this->joint_nodes_.find(individual_ids);
+        return (iterator != this->joint_nodes_.end()) ? iterator->second : NONE;
+    }
+
+    void HistoryTrie::setJointNode(const std::vector<id_type> &individual_ids, id_type node)
+    {
+        std::unique_lock<std::shared_mutex> lock(this->joint_mutex_);
+        this->joint_nodes_.emplace(individual_ids, node);
+    }
+
+} // namespace sdm
@@ -0,0 +1,199 @@
+/**
+ * @file history_trie.hpp
+ * @brief Arena of the nodes of a history tree
+ *
+ */
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <sdm/types.hpp>
+#include <sdm/core/action/action.hpp>
+#include <sdm/core/observation/observation.hpp>
+#include <sdm/utils/struct/pair.hpp>
+#include <sdm/utils/struct/vector.hpp>
+#include <sdm/utils/struct/concurrent_interning_table.hpp>
+
+namespace sdm
+{
+    class HistoryTree;
+
+    /**
+     * @class HistoryTrie
+     *
+     * @brief The nodes of a history tree, stored in a contiguous arena and identified by 32-bit identifiers.
+     *
+     * Pairs (observation, action) are interned into dense symbols. The children of all nodes are kept in a
+     * single flat table indexed by (node, symbol), so that expanding a history to an existing child neither
+     * allocates nor walks the tree. HistoryTree objects are handles over the nodes of a trie : the trie
+     * keeps the handles of the nodes that were expanded with backup, the origin keeps the trie.
+     *
+     * The trie of joint histories also indexes its nodes by the identifiers of their individual histories.
+     *
+     * All methods are thread safe. The nodes are guarded by a reader-writer lock, so that histories can be
+     * expanded from several threads (e.g. parallel HSVI workers or occupancy state transitions), and the
+     * expansion of a node with an item is atomic : all threads get the same child and the same handle.
+     */
+    class HistoryTrie
+    {
+    public:
+        using id_type = std::uint32_t;
+        using item_type = Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>>;
+
+        /** @brief The identifier of a missing node. */
+        static constexpr id_type NONE = std::numeric_limits<id_type>::max();
+
+        /** @brief The identifier of the origin. */
+        static constexpr id_type ROOT = 0;
+
+        /**
+         * @brief Construct a trie that only contains the origin.
+         *
+         * @param max_depth the maximal depth of histories
+         */
+        HistoryTrie(number max_depth = std::numeric_limits<number>::max());
+
+        number getMaxDepth() const;
+
+        /**
+         * @brief Get the number of nodes of the trie.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Get the parent of a node (NONE for the origin).
+         */
+        id_type getParent(id_type node) const;
+
+        /**
+         * @brief Change the parent of a node (the node is not moved in the child table).
+         */
+        void setParent(id_type node, id_type parent);
+
+        /**
+         * @brief Get the item (observation, action) leading to a node.
+         */
+        const item_type &getItem(id_type node) const;
+
+        /**
+         * @brief Get the child of a node given an item.
+         *
+         * @return the identifier of the child or NONE if the node was never expanded with this item
+         */
+        id_type getChild(id_type node, const item_type &item) const;
+
+        /**
+         * @brief Get the children of a node.
+         */
+        std::vector<id_type> getChildren(id_type node) const;
+
+        /**
+         * @brief Add a child to a node (or get it if it exists).
+         */
+        id_type addChild(id_type node, const item_type &item);
+
+        /**
+         * @brief Get the handle over the child of a node given an item (nullptr if there is none).
+         */
+        std::shared_ptr<HistoryTree> findChildHandle(id_type node, const item_type &item) const;
+
+        /**
+         * @brief Get the handle over the child of a node given an item, the child is added if required.
+         *
+         * The handle of a new child is built by `make_handle` and published once built, so that concurrent
+         * expansions of the same node with the same item all get this handle. The trie is locked while
+         * `make_handle` runs, hence `make_handle` must not use this trie (it may use other tries).
+         *
+         * @param parent the handle over the node to expand (the trie keeps track of it)
+         * @param item the item
+         * @param make_handle builds the handle over the child given its identifier
+         * @return the handle over the child (kept alive by the trie)
+         */
+        std::shared_ptr<HistoryTree> expandChild(const std::shared_ptr<HistoryTree> &parent, const item_type &item, const std::function<std::shared_ptr<HistoryTree>(id_type)> &make_handle);
+
+        /**
+         * @brief Add a node whose parent is given, but that is not a child of its parent (expansion without backup).
+         */
+        id_type addNode(id_type parent, const item_type &item);
+
+        /**
+         * @brief Get the handle over a node (nullptr if there is no living handle).
+         */
+        std::shared_ptr<HistoryTree> getHandle(id_type node) const;
+
+        /**
+         * @brief Set the handle over a node.
+         *
+         * @param node the node
+         * @param handle the handle
+         * @param owned whether the trie keeps the handle alive
+         */
+        void setHandle(id_type node, const std::shared_ptr<HistoryTree> &handle, bool owned);
+
+        /**
+         * @brief Release the handles kept alive by the trie (when the origin is destroyed).
+         */
+        void releaseHandles();
+
+        /**
+         * @brief Get the joint node built from individual histories.
+         *
+         * @param individual_ids the identifiers of the individual histories (in their own tries)
+         * @return the identifier of the joint node or NONE
+         */
+        id_type getJointNode(const std::vector<id_type> &individual_ids) const;
+
+        /**
+         * @brief Index a joint node by the identifiers of its individual histories.
+         */
+        void setJointNode(const std::vector<id_type> &individual_ids, id_type node);
+
+    protected:
+        struct Node
+        {
+            id_type parent, symbol, first_child, next_sibling;
+        };
+
+        number max_depth_;
+
+        /** @brief Guards the nodes, the child table and the handles */
+        mutable std::shared_mutex mutex_;
+
+        /** @brief Guards the index of joint nodes (it can be updated while the nodes are locked) */
+        mutable std::shared_mutex joint_mutex_;
+
+        /** @brief The arena of nodes */
+        std::vector<Node> nodes_;
+
+        /** @brief Dense symbols of the items (observation, action), the references to items are stable */
+        ConcurrentInterningTable<item_type> symbols_;
+
+        /** @brief The flat child table (node, symbol) -> child */
+        std::unordered_map<std::uint64_t, id_type> children_;
+
+        /** @brief The handle of each node, and the handles kept alive by the trie */
+        std::vector<std::weak_ptr<HistoryTree>> handles_;
+        std::vector<std::shared_ptr<HistoryTree>> owned_handles_;
+
+        /** @brief The joint nodes indexed by the identifiers of their individual histories */
+        std::unordered_map<std::vector<id_type>, id_type> joint_nodes_;
+
+        static std::uint64_t getChildKey(id_type node, id_type symbol);
+
+        /** @brief Create a node (the lock must be held exclusively). */
+        id_type createNode(id_type parent, id_type symbol);
+
+        /** @brief Add a child to a node (the lock must be held exclusively). */
+        id_type addChildLocked(id_type node, id_type symbol);
+
+        /** @brief Find the child of a node (the lock must be held). */
+        id_type findChildLocked(id_type node, const item_type &item) const;
+    };
+
+} // namespace sdm
@@ -18,6 +18,11 @@ namespace sdm
 
         virtual Joint<std::shared_ptr<HistoryInterface>> getIndividualHistories() const = 0;
 
+        /**
+         * @brief Get the joint history that is made of given individual histories (nullptr if it does not exist).
+         */
+        virtual std::shared_ptr<JointHistoryInterface> getJointHistory(const Joint<std::shared_ptr<HistoryInterface>> &ihistories) const = 0;
+
         virtual std::shared_ptr<HistoryInterface> expand(const std::shared_ptr<Observation> &observation, const std::shared_ptr<Action> &action = nullptr, bool backup = true) = 0;
 
         virtual std::shared_ptr<JointHistoryInterface> expand(const std::shared_ptr<JointObservation> &joint_observation, const std::shared_ptr<JointAction> &joint_action = nullptr, bool = true) = 0;
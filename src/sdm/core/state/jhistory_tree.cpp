@@ -15,6 +15,7 @@ namespace sdm
             this->addIndividualHistory(std::make_shared<HistoryTree>());
         }
         this->setupDefaultObs(n_agents, sdm::NO_OBSERVATION);
+        this->trie_->setJointNode(JointHistoryTree::getIndividualIDs(*this), this->id_);
     }
 
     JointHistoryTree::JointHistoryTree(number n_agents, number max_depth) : HistoryTree(max_depth)
@@ -24,6 +25,7 @@ namespace sdm
             this->addIndividualHistory(std::make_shared<HistoryTree>(max_depth));
         }
         this->setupDefaultObs(n_agents, sdm::NO_OBSERVATION);
+        this->trie_->setJointNode(JointHistoryTree::getIndividualIDs(*this), this->id_);
     }
 
     JointHistoryTree::JointHistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item) : HistoryTree(parent, item)
@@ -31,9 +33,15 @@ namespace sdm
         this->default_observation_ = std::static_pointer_cast<JointHistoryTree>(parent)->getDefaultObs();
     }
 
+    JointHistoryTree::JointHistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item, id_type id) : HistoryTree(parent, item, id)
+    {
+        this->default_observation_ = std::static_pointer_cast<JointHistoryTree>(parent)->getDefaultObs();
+    }
+
     JointHistoryTree::JointHistoryTree(const Joint<std::shared_ptr<HistoryInterface>> &ihistories) : HistoryTree(), Joint<std::shared_ptr<HistoryInterface>>(ihistories)
     {
         this->setupDefaultObs(ihistories.size(), sdm::NO_OBSERVATION);
+        this->trie_->setJointNode(JointHistoryTree::getIndividualIDs(ihistories), this->id_);
     }
 
     void JointHistoryTree::addIndividualHistory(std::shared_ptr<HistoryInterface> ihist)
@@ -67,16 +75,6 @@ namespace sdm
         if (*joint_observation != *this->default_observation_)
         {
             h_joint = HistoryTree::template expand<JointHistoryTree>(joint_observation, joint_action, backup);
-            if (h_joint->size() == 0)
-            {
-                for (number i = 0; i < this->getNumAgents(); i++)
-                {
-                    if (joint_action != nullptr)
-                        h_joint->addIndividualHistory(this->getIndividualHistory(i)->expand(joint_observation->get(i), joint_action->get(i), backup));
-                    else
-                        h_joint->addIndividualHistory(this->getIndividualHistory(i)->expand(joint_observation->get(i), joint_action, backup));
-                }
-            }
         }
         else
         {
@@ -86,6 +84,24 @@ namespace sdm
         return h_joint;
     }
 
+    void JointHistoryTree::initializeChild(const std::shared_ptr<HistoryTree> &child, const std::shared_ptr<Observation> &observation, const std::shared_ptr<Action> &action, bool backup)
+    {
+        auto h_joint = std::static_pointer_cast<JointHistoryTree>(child);
+        auto joint_observation = std::static_pointer_cast<JointObservation>(observation);
+        auto joint_action = std::static_pointer_cast<JointAction>(action);
+        for (number i = 0; i < this->getNumAgents(); i++)
+        {
+            if (joint_action != nullptr)
+                h_joint->addIndividualHistory(this->getIndividualHistory(i)->expand(joint_observation->get(i), joint_action->get(i), backup));
+            else
+                h_joint->addIndividualHistory(this->getIndividualHistory(i)->expand(joint_observation->get(i), joint_action, backup));
+        }
+        if (backup)
+        {
+            this->trie_->setJointNode(JointHistoryTree::getIndividualIDs(*h_joint), h_joint->getID());
+        }
+    }
+
     std::shared_ptr<HistoryInterface> JointHistoryTree::getIndividualHistory(number ag_id) const
     {
         return this->get(ag_id);
@@ -96,6 +112,51 @@ namespace sdm
         return *this;
     }
 
+    std::vector<JointHistoryTree::id_type> JointHistoryTree::getIndividualIDs(const Joint<std::shared_ptr<HistoryInterface>> &ihistories)
+    {
+        std::vector<id_type> individual_ids;
+        individual_ids.reserve(ihistories.size());
+        for (const auto &ihistory : ihistories)
+        {
+            auto ihistory_tree = dynamic_cast<const HistoryTree *>(ihistory.get());
+            individual_ids.push_back((ihistory_tree != nullptr) ? ihistory_tree->getID() : HistoryTrie::NONE);
+        }
+        return individual_ids;
+    }
+
+    std::shared_ptr<JointHistoryInterface> JointHistoryTree::getJointHistory(const Joint<std::shared_ptr<HistoryInterface>> &ihistories) const
+    {
+        auto node = this->trie_->getJointNode(JointHistoryTree::getIndividualIDs(ihistories));
+        if (node == HistoryTrie::NONE)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<JointHistoryTree> joint_history;
+        if (node == this->id_)
+        {
+            joint_history = std::dynamic_pointer_cast<JointHistoryTree>(std::const_pointer_cast<Item>(this->shared_from_this()));
+        }
+        else
+        {
+            joint_history = std::static_pointer_cast<JointHistoryTree>(this->trie_->getHandle(node));
+        }
+
+        // Identifiers are only unique within the tree of each agent
+        if ((joint_history == nullptr) || (joint_history->size() != ihistories.size()))
+        {
+            return nullptr;
+        }
+        for (number agent_id = 0; agent_id < ihistories.size(); agent_id++)
+        {
+            if (joint_history->get(agent_id) != ihistories[agent_id])
+            {
+                return nullptr;
+            }
+        }
+        return joint_history;
+    }
+
     std::string JointHistoryTree::str() const
     {
         std::ostringstream res;
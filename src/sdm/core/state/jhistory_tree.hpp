@@ -12,6 +12,7 @@
 #pragma once
 
 #include <sdm/core/state/history_tree.hpp>
+#include <sdm/public/boost_serializable.hpp>
 #include <sdm/core/joint.hpp>
 #include <sdm/types.hpp>
 #include <sdm/core/observation/default_observation.hpp>
@@ -67,6 +68,14 @@ namespace sdm
          */
         JointHistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item);
 
+        /**
+         *  @brief  Construct the handle over an existing node of the trie of the parent.
+         *  @param  parent   the parent tree
+         *  @param  item     the item
+         *  @param  id       the identifier of the node
+         */
+        JointHistoryTree(std::shared_ptr<HistoryTree> parent, const Pair<std::shared_ptr<Observation>, std::shared_ptr<Action>> &item, id_type id);
+
         /**
          * @brief Construct a new joint history based on individual histories
          * @warning This will build a well defined Joint<std::shared_ptr<HistoryTree>> structure but wrong HistoryTree<std::shared_ptr<Joint<T>>> !!
@@ -95,6 +104,14 @@ namespace sdm
          */
         Joint<std::shared_ptr<HistoryInterface>> getIndividualHistories() const;
 
+        /**
+         * @brief Get the joint history of the same tree that is made of given individual histories.
+         *
+         * @param ihistories the list of individual histories
+         * @return the joint history or nullptr if it was never built
+         */
+        std::shared_ptr<JointHistoryInterface> getJointHistory(const Joint<std::shared_ptr<HistoryInterface>> &ihistories) const;
+
         std::string str() const;
 
         std::shared_ptr<JointHistoryTree> getptr();
@@ -119,6 +136,11 @@ namespace sdm
     protected:
         void addIndividualHistory(std::shared_ptr<HistoryInterface> ihist);
 
+        /**
+         * @brief Get the identifiers of individual histories in their tries (NONE for other kinds of histories).
+         */
+        static std::vector<id_type> getIndividualIDs(const Joint<std::shared_ptr<HistoryInterface>> &ihistories);
+
         void setupDefaultObs(number num_agents, const std::shared_ptr<Observation> &default_observation = sdm::NO_OBSERVATION);
         std::shared_ptr<JointObservation> default_observation_;
 
@@ -134,6 +156,11 @@ namespace sdm
          */
         std::shared_ptr<JointHistoryTree> expandJointHistoryTree(const std::shared_ptr<JointObservation> &joint_observation, const std::shared_ptr<JointAction> &joint_action = nullptr, bool backup = true);
         virtual std::shared_ptr<HistoryTree> expandHistoryTree(const std::shared_ptr<Observation> &joint_observation, const std::shared_ptr<Action> &joint_action, bool backup);
+
+        /**
+         * @brief Expand the individual histories of a new child, and index the child by their identifiers.
+         */
+        virtual void initializeChild(const std::shared_ptr<HistoryTree> &child, const std::shared_ptr<Observation> &joint_observation, const std::shared_ptr<Action> &joint_action, bool backup);
     };
 
 } // namespace sdm
\ No newline at end of file
@@ -9,12 +9,13 @@
 #include <sdm/core/action/decision_rule.hpp>
 #include <sdm/utils/linear_algebra/hyperplane/alpha_vector.hpp>
 #include <sdm/utils/linear_algebra/hyperplane/beta_vector.hpp>
+#include <sdm/utils/parallel/thread_pool.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 
 namespace sdm
 {
     double OccupancyState::PRECISION = 0.0000000001;// config::PRECISION_OCCUPANCY_STATE;
-
-    RecursiveMap<Joint<std::shared_ptr<HistoryInterface>>, std::shared_ptr<JointHistoryInterface>> OccupancyState::jhistory_map_ = {};
+    number OccupancyState::NUM_THREADS = 1;
 
     OccupancyState::OccupancyState() : OccupancyState(2, 0)
     {
@@ -39,6 +40,7 @@ namespace sdm
 
     OccupancyState::OccupancyState(const OccupancyState &occupancy_state)
         : Belief(occupancy_state),
+          list_joint_histories_(occupancy_state.list_joint_histories_),
           num_agents_(occupancy_state.num_agents_),
           h(occupancy_state.h),
           tuple_of_maps_from_histories_to_private_occupancy_states_(occupancy_state.tuple_of_maps_from_histories_to_private_occupancy_states_),
@@ -49,7 +51,8 @@ namespace sdm
           private_ihistory_map_(occupancy_state.private_ihistory_map_),
           probability_ihistories(occupancy_state.probability_ihistories),
           list_beliefs_(occupancy_state.list_beliefs_),
-          list_joint_histories_(occupancy_state.list_joint_histories_),
+          canonical_support_(occupancy_state.canonical_support_),
+          canonical_(occupancy_state.canonical_),
           all_list_ihistories_(occupancy_state.all_list_ihistories_),
           map_joint_history_to_belief_(occupancy_state.map_joint_history_to_belief_),
           ihistories_to_jhistory_(occupancy_state.ihistories_to_jhistory_),
@@ -94,11 +97,14 @@ namespace sdm
 
     void OccupancyState::setProbability(const std::shared_ptr<State> &joint_history, double proba)
     {
+        this->canonical_ = false;
         Belief::setProbability(joint_history, proba);
     }
 
     void OccupancyState::setProbability(const std::shared_ptr<JointHistoryInterface> &joint_history, const std::shared_ptr<BeliefInterface> &belief, double proba)
     {
+        this->canonical_ = false;
+
         // Set the belief corresponding to a specific joint history
         this->setBeliefAt(joint_history, belief);
 
@@ -163,50 +169,70 @@ namespace sdm
         auto decision_rule = action->toDecisionRule();
         auto pomdp = std::dynamic_pointer_cast<POMDPInterface>(mdp);
 
+        // List the transitions (o_t, u_t, z_{t+1}) to compute
+        std::vector<std::shared_ptr<JointHistoryInterface>> joint_histories;
+        std::vector<std::shared_ptr<BeliefInterface>> beliefs;
+        std::vector<std::shared_ptr<Action>> joint_actions;
+        std::vector<std::shared_ptr<Observation>> joint_observations;
+
         // For each joint history in the support of the fully uncompressed occupancy state
         for (const auto &compressed_joint_history : this->getJointHistories())
         {
-            // Get p(o_t)
-            double proba_history = this->getProbability(compressed_joint_history);
-
             // Get the corresponding belief
             auto belief = this->getBeliefAt(compressed_joint_history);
 
             // Apply decision rule and get action
             auto jaction = this->applyDR(decision_rule, compressed_joint_history); // this->act(compressed_joint_history);
 
-            // For each action that is likely to be taken
-            for (const auto &joint_action : {jaction}) // decision_rule->getDistribution(compressed_joint_history)->getSupport())
+            // For each observation in the space of joint observation
+            for (auto jobs : *pomdp->getObservationSpace(t))
             {
-                // Get p(u_t | o_t)
-                double proba_action = 1; // decision_rule->getProbability(compressed_joint_history, joint_action);
-
-                // For each observation in the space of joint observation
-                for (auto jobs : *pomdp->getObservationSpace(t))
+                auto joint_observation = jobs->toObservation();
+                if (this->checkCompatibility(joint_observation, observation))
                 {
-                    auto joint_observation = jobs->toObservation();
-                    if (this->checkCompatibility(joint_observation, observation))
-                    {
-                        // Get the next belief and p(z_{t+1} | b_t, u_t)
-                        auto [next_belief, proba_observation] = belief->next(mdp, joint_action, joint_observation, t);
+                    joint_histories.push_back(compressed_joint_history);
+                    beliefs.push_back(belief);
+                    joint_actions.push_back(jaction);
+                    joint_observations.push_back(joint_observation);
+                }
+            }
+        }
 
-                        double next_joint_history_probability = proba_history * proba_action * proba_observation;
+        // Get the next beliefs and p(z_{t+1} | b_t, u_t)
+        auto next_beliefs = this->computeNextBeliefs(mdp, beliefs, joint_actions, joint_observations, t);
 
-                        // If the next history probability is not zero
-                        if (next_joint_history_probability > 0)
-                        {
-                            // Update new one step uncompressed occupancy state
-                            std::shared_ptr<JointHistoryInterface> next_compressed_joint_history = compressed_joint_history->expand(joint_observation /*, joint_action*/)->toJointHistory();
-                            this->updateOccupancyStateProba(next_one_step_left_compressed_occupancy_state, next_compressed_joint_history, next_belief->toBelief(), next_joint_history_probability);
-                        }
-                    }
-                }
+        // Merge transitions in order (p(u_t | o_t) = 1 for deterministic decision rules)
+        for (std::size_t i = 0; i < next_beliefs.size(); i++)
+        {
+            const auto &[next_belief, proba_observation] = next_beliefs[i];
+
+            double next_joint_history_probability = this->getProbability(joint_histories[i]) * proba_observation;
+
+            // If the next history probability is not zero
+            if (next_joint_history_probability > 0)
+            {
+                // Update new one step uncompressed occupancy state
+                std::shared_ptr<JointHistoryInterface> next_compressed_joint_history = joint_histories[i]->expand(joint_observations[i] /*, joint_action*/)->toJointHistory();
+                this->updateOccupancyStateProba(next_one_step_left_compressed_occupancy_state, next_compressed_joint_history, next_belief->toBelief(), next_joint_history_probability);
             }
         }
 
         return this->finalizeNextState(next_one_step_left_compressed_occupancy_state, t);
     }
 
+    std::vector<Pair<std::shared_ptr<State>, double>> OccupancyState::computeNextBeliefs(const std::shared_ptr<MDPInterface> &mdp, const std::vector<std::shared_ptr<BeliefInterface>> &beliefs, const std::vector<std::shared_ptr<Action>> &actions, const std::vector<std::shared_ptr<Observation>> &observations, number t) const
+    {
+        std::vector<Pair<std::shared_ptr<State>, double>> next_beliefs(beliefs.size());
+        ThreadPool::get(OccupancyState::NUM_THREADS)->parallel_for(beliefs.size(), [&](std::size_t begin, std::size_t end)
+                                                                   {
+                                                                       for (std::size_t i = begin; i < end; i++)
+                                                                       {
+                                                                           next_beliefs[i] = beliefs[i]->next(mdp, actions[i], observations[i], t);
+                                                                       }
+                                                                   });
+        return next_beliefs;
+    }
+
     Pair<std::shared_ptr<OccupancyStateInterface>, double> OccupancyState::finalizeNextState(const std::shared_ptr<OccupancyStateInterface> &one_step_occupancy_state, number t)
     {
         // Finalize and normalize the one step left occupancy state
@@ -224,10 +250,7 @@ namespace sdm
             std::shared_ptr<OccupancyStateInterface> compressed_occupancy_state;
 
             // Compress the occupancy state
-            //TODO : put compress() again
-            //std::cout << "\n trying to compress";
-            compressed_occupancy_state = one_step_occupancy_state;//->compress();
-            //std::cout << "\n i did the compression";
+            compressed_occupancy_state = one_step_occupancy_state->compress();
             double norm_compressed = compressed_occupancy_state->norm_1();
             compressed_occupancy_state->normalizeBelief(norm_compressed);
             compressed_occupancy_state->setOneStepUncompressedOccupancy(one_step_occupancy_state);
@@ -304,24 +327,7 @@ namespace sdm
         {
             precision = OccupancyState::PRECISION;
         }
-
-        size_t seed = 0;
-        double inverse_of_precision = 1. / precision;
-        std::map<std::shared_ptr<sdm::State>, double> ordered(this->container.begin(), this->container.end());
-        std::vector<int> rounded;
-        for (const auto &pair_jhist_proba : ordered)
-        {
-            sdm::hash_combine(seed, pair_jhist_proba.first);
-            rounded.push_back(lround(inverse_of_precision * pair_jhist_proba.second));
-        }
-        for (const auto &v : rounded)
-        {
-            // Combine the hash of the current vector with the hashes of the previous ones
-            sdm::hash_combine(seed, v);
-        }
-        // sdm::hash_combine(seed, this->h);
-
-        return seed;
+        return this->getHash(precision);
     }
 
     bool OccupancyState::operator==(const OccupancyState &other) const
@@ -364,20 +370,29 @@ namespace sdm
             precision = Belief::PRECISION;
         }
 
-        // if (this->h != other.h)
-        // {
-        //     return false;
-        // }
-
-        // if (this->size() != other.size())
-        // {
-        //     return false;
-        // }
+        // Occupancy states with different supports, or different hashes at the precision of the comparison, are different
+        if ((this->size() != other.size()) || ((precision == this->hash_precision_) && (precision == other.hash_precision_) && (this->hash_ != other.hash_)))
+        {
+            return false;
+        }
 
-        // if (std::abs(this->getDefault() - other.getDefault()) > precision)
-        // {
-        //     return false;
-        // }
+        // Compare the sorted supports entry by entry
+        if (this->canonical_ && other.canonical_)
+        {
+            if (this->canonical_support_.size() != other.canonical_support_.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < this->canonical_support_.size(); i++)
+            {
+                const auto &entry = this->canonical_support_[i], &other_entry = other.canonical_support_[i];
+                if ((entry.joint_history != other_entry.joint_history) || (entry.state != other_entry.state) || (std::abs(entry.probability - other_entry.probability) > precision))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
 
         for (const auto &jhistory : this->getJointHistories())
         {
@@ -606,7 +621,12 @@ namespace sdm
     std::shared_ptr<JointHistoryInterface> OccupancyState::getCompressedJointHistory(const std::shared_ptr<JointHistoryInterface> &joint_history) const
     {
         const auto &labels = this->getJointLabels(joint_history->getIndividualHistories());
-        return this->jhistory_map_.at(labels);
+        auto compressed_joint_history = joint_history->getJointHistory(labels);
+        if (compressed_joint_history == nullptr)
+        {
+            throw sdm::exception::Exception("OccupancyState::getCompressedJointHistory : no joint history is made of the labels");
+        }
+        return compressed_joint_history;
     }
 
     bool OccupancyState::areIndividualHistoryLPE(const std::shared_ptr<HistoryInterface> &ihistory_1, const std::shared_ptr<HistoryInterface> &ihistory_2, number agent_identifier)
@@ -614,6 +634,31 @@ namespace sdm
         return this->getPrivateOccupancyState(agent_identifier, ihistory_1)->check_equivalence(*this->getPrivateOccupancyState(agent_identifier, ihistory_2));
     }
 
+    std::vector<std::vector<std::shared_ptr<HistoryInterface>>> OccupancyState::getCompressionCandidates(number agent_id) const
+    {
+        // Get support (a set of individual histories for agent i)
+        const auto &support_set = this->getIndividualHistories(agent_id);
+        auto &&support = tools::set2vector(support_set);
+
+        // Sort support
+        std::sort(support.begin(), support.end());
+
+        // Bucket individual histories by the signature of their private occupancy state
+        std::vector<std::vector<std::shared_ptr<HistoryInterface>>> candidates;
+        std::unordered_map<std::size_t, std::size_t> position_of_signature;
+        for (const auto &ihistory : support)
+        {
+            std::size_t signature = this->getPrivateOccupancyState(agent_id, ihistory)->getSignature();
+            auto iterator = position_of_signature.emplace(signature, candidates.size()).first;
+            if (iterator->second == candidates.size())
+            {
+                candidates.emplace_back();
+            }
+            candidates[iterator->second].push_back(ihistory);
+        }
+        return candidates;
+    }
+
     /**
      * @brief
      *
@@ -622,69 +667,67 @@ namespace sdm
      */
     std::shared_ptr<OccupancyStateInterface> OccupancyState::compress()
     {
+        SDMS_TIME_PHASE(COMPRESSION);
 
         auto current_compact_ostate = this->make(this->h);
         auto previous_compact_ostate = this->copy();
 
         for (int agent_id = 0; agent_id < this->num_agents_; ++agent_id)
         {
-            // Get support (a set of individual histories for agent i)
-            const auto &support_set = this->getIndividualHistories(agent_id);
-            auto &&support = tools::set2vector(support_set);
-
-            // Sort support
-            std::sort(support.begin(), support.end());
-
-            for (auto iter_first = support.begin(); iter_first != support.end();)
+            // Only histories with the same signature need to be checked against each other
+            for (auto &support : this->getCompressionCandidates(agent_id))
             {
-                auto ihistory_label = *iter_first;      // Get the ihistory "label"
-                iter_first = support.erase(iter_first); // Erase the ihistory "label" from the support
-
-                // Set probability of labels
-                for (const auto &joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistories())
-                {
-                    auto belief = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history);
-                    current_compact_ostate->setProbability(joint_history, belief, previous_compact_ostate->getProbability(joint_history));
-                }
-
-                // For all other individual histories in the support
-                for (auto iter_second = iter_first; iter_second != support.end();)
+                for (auto iter_first = support.begin(); iter_first != support.end();)
                 {
-                    // Get the ihistory we want check the equivalence
-                    auto ihistory_one_step_left = *iter_second;
+                    auto ihistory_label = *iter_first;      // Get the ihistory "label"
+                    iter_first = support.erase(iter_first); // Erase the ihistory "label" from the support
 
-                    // Check equivalence between individual histories
-                    if (this->areIndividualHistoryLPE(ihistory_label, ihistory_one_step_left, agent_id))
+                    // Set probability of labels
+                    for (const auto &joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistories())
                     {
-                        // If ihistories are equivalent
-                        // Store the new label
-                        this->updateLabel(agent_id, ihistory_one_step_left, ihistory_label);
+                        auto belief = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history);
+                        current_compact_ostate->setProbability(joint_history, belief, previous_compact_ostate->getProbability(joint_history));
+                    }
 
-                        // Erase unecessary equivalent individual history
-                        iter_second = support.erase(iter_second);
+                    // For all other individual histories in the support
+                    for (auto iter_second = iter_first; iter_second != support.end();)
+                    {
+                        // Get the ihistory we want check the equivalence
+                        auto ihistory_one_step_left = *iter_second;
 
-                        // ----- Update probability of the new compact occupancy state by adding proba of the equivalent ihistory ---
-                        // For all private joint history in the previous compact occupancy state
-                        for (const auto &private_joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getJointHistories())
+                        // Check equivalence between individual histories
+                        if (this->areIndividualHistoryLPE(ihistory_label, ihistory_one_step_left, agent_id))
                         {
-                            // Get the probability of the private occupancy state corresponding to the history that will be deleted
-                            double probability = this->weight_of_private_occupancy_state_[agent_id][ihistory_one_step_left] * previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getProbability(private_joint_history);
-
-                            // Get the partial joint history label
-                            auto partial_jhist = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getPartialJointHistory(private_joint_history);
-
-                            // Get the joint history corresponding to this partial joint history in the private occupancy state of the history label
-                            auto joint_history_from_partial = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistoryFromPartial(partial_jhist);
-
-                            // Update the current compact occupancy state
-                            current_compact_ostate->addProbability(joint_history_from_partial,
-                                                                   previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history_from_partial),
-                                                                   probability);
+                            // If ihistories are equivalent
+                            // Store the new label
+                            this->updateLabel(agent_id, ihistory_one_step_left, ihistory_label);
+
+                            // Erase unecessary equivalent individual history
+                            iter_second = support.erase(iter_second);
+
+                            // ----- Update probability of the new compact occupancy state by adding proba of the equivalent ihistory ---
+                            // For all private joint history in the previous compact occupancy state
+                            for (const auto &private_joint_history : previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getJointHistories())
+                            {
+                                // Get the probability of the private occupancy state corresponding to the history that will be deleted
+                                double probability = this->weight_of_private_occupancy_state_[agent_id][ihistory_one_step_left] * previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getProbability(private_joint_history);
+
+                                // Get the partial joint history label
+                                auto partial_jhist = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_one_step_left)->getPartialJointHistory(private_joint_history);
+
+                                // Get the joint history corresponding to this partial joint history in the private occupancy state of the history label
+                                auto joint_history_from_partial = previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getJointHistoryFromPartial(partial_jhist);
+
+                                // Update the current compact occupancy state
+                                current_compact_ostate->addProbability(joint_history_from_partial,
+                                                                       previous_compact_ostate->getPrivateOccupancyState(agent_id, ihistory_label)->getBeliefAt(joint_history_from_partial),
+                                                                       probability);
+                            }
+                        }
+                        else
+                        {
+                            iter_second++;
                         }
-                    }
-                    else
-                    {
-                        iter_second++;
                     }
                 }
             }
@@ -693,6 +736,8 @@ namespace sdm
             previous_compact_ostate->private_ihistory_map_ = this->private_ihistory_map_;
             previous_compact_ostate->finalize();
             current_compact_ostate->container.clear();
+            current_compact_ostate->hash_ = 0;
+            current_compact_ostate->canonical_ = false;
         }
 
         // previous_compact_ostate->setFullyUncompressedOccupancy(this->getFullyUncompressedOccupancy());
@@ -712,9 +757,6 @@ namespace sdm
             // Get the corresponding belief
             auto belief = this->getBeliefAt(jhist);
 
-            // Store relation between joint history and list of individual histories
-            this->jhistory_map_.emplace(jhist->getIndividualHistories(), jhist);
-
             // For each agent we update its private occupancy state
             for (number agent_id = 0; agent_id < this->num_agents_; agent_id++)
             {
@@ -749,10 +791,12 @@ namespace sdm
 
     void OccupancyState::finalize()
     {
-        Belief::finalize();
+        this->container.finalize();
+        this->computeHash(OccupancyState::PRECISION);
         this->setup();
         this->setupPrivateOccupancyStates();
         this->setProbabilityOverIndividualHistories();
+        this->setupCanonicalSupport();
     }
 
     void OccupancyState::finalize(bool do_compression)
@@ -763,11 +807,49 @@ namespace sdm
         }
         else
         {
-            Belief::finalize();
+            this->container.finalize();
+            this->computeHash(OccupancyState::PRECISION);
             this->setup();
+            this->setupCanonicalSupport();
+        }
+    }
+
+    void OccupancyState::normalizeBelief(double norm_1)
+    {
+        bool canonical = this->canonical_;
+
+        Belief::normalizeBelief(norm_1);
+
+        // Normalizing does not change the support, so the canonical support can be rescaled in place
+        if (canonical && (norm_1 > 0))
+        {
+            for (auto &entry : this->canonical_support_)
+            {
+                entry.probability = entry.probability / norm_1;
+            }
+            this->canonical_ = true;
         }
     }
 
+    void OccupancyState::setupCanonicalSupport()
+    {
+        this->canonical_support_.clear();
+        for (const auto &pair_jhist_proba : this->container)
+        {
+            auto belief = this->getBeliefAt(pair_jhist_proba.first->toHistory()->toJointHistory());
+            if (belief != nullptr)
+            {
+                for (const auto &state : belief->getStates())
+                {
+                    this->canonical_support_.push_back({pair_jhist_proba.first.get(), state.get(), pair_jhist_proba.second * belief->getProbability(state)});
+                }
+            }
+        }
+        std::sort(this->canonical_support_.begin(), this->canonical_support_.end(), [](const CanonicalEntry &left, const CanonicalEntry &right)
+                  { return std::less<const State *>()(left.joint_history, right.joint_history) || ((left.joint_history == right.joint_history) && std::less<const State *>()(left.state, right.state)); });
+        this->canonical_ = true;
+    }
+
     void OccupancyState::normalize()
     {
         double sum = this->norm_1();
@@ -880,12 +962,15 @@ namespace sdm
         // The new one step left occupancy state
         auto next_one_step_left_compressed_occupancy_state = this->make(t + 1);
 
+        // List the transitions (o_t, u_t, z_{t+1}) to compute
+        std::vector<std::shared_ptr<JointHistoryInterface>> joint_histories, compressed_joint_histories;
+        std::vector<std::shared_ptr<BeliefInterface>> beliefs;
+        std::vector<std::shared_ptr<Action>> joint_actions;
+        std::vector<std::shared_ptr<Observation>> joint_observations;
+
         // For each joint history in the support of the fully uncompressed occupancy state
         for (const auto &joint_history : fully_uncompressed_occupancy_state->getJointHistories())
         {
-            // Get p(o_t)
-            double proba_history = fully_uncompressed_occupancy_state->getProbability(joint_history);
-
             // Get compressed joint history
             auto compressed_joint_history = this->getCompressedJointHistory(joint_history);
 
@@ -895,40 +980,45 @@ namespace sdm
             // Get the corresponding belief
             std::shared_ptr<BeliefInterface> belief = fully_uncompressed_occupancy_state->getBeliefAt(joint_history);
 
-            // For each action that is likely to be taken
-            for (const auto &joint_action : {jaction}) // decision_rule->getDistribution(compressed_joint_history)->getSupport())
+            // For each observation in the space of joint observation
+            for (auto jobs : *pomdp->getObservationSpace(t))
             {
-                // Get p(u_t | o_t)
-                double proba_action = 1; // decision_rule->getProbability(compressed_joint_history, joint_action);
-
-                // For each observation in the space of joint observation
-                for (auto jobs : *pomdp->getObservationSpace(t))
+                auto joint_observation = jobs->toObservation();
+                if (this->checkCompatibility(joint_observation, observation))
                 {
-                    auto joint_observation = jobs->toObservation();
-                    if (this->checkCompatibility(joint_observation, observation))
-                    {
-                        // Get the next belief and p(z_{t+1} | b_t, u_t)
-                        auto [next_belief, proba_observation] = belief->next(mdp, joint_action, joint_observation, t);
+                    joint_histories.push_back(joint_history);
+                    compressed_joint_histories.push_back(compressed_joint_history);
+                    beliefs.push_back(belief);
+                    joint_actions.push_back(jaction);
+                    joint_observations.push_back(joint_observation);
+                }
+            }
+        }
 
-                        double next_joint_history_probability = proba_history * proba_action * proba_observation;
+        // Get the next beliefs and p(z_{t+1} | b_t, u_t)
+        auto next_beliefs = this->computeNextBeliefs(mdp, beliefs, joint_actions, joint_observations, t);
 
-                        // If the next history probability is not zero
-                        if (next_joint_history_probability > 0)
-                        {
-                            std::shared_ptr<JointHistoryInterface> next_joint_history = joint_history->expand(joint_observation /*, joint_action*/)->toJointHistory();
+        // Merge transitions in order (p(u_t | o_t) = 1 for deterministic decision rules)
+        for (std::size_t i = 0; i < next_beliefs.size(); i++)
+        {
+            const auto &[next_belief, proba_observation] = next_beliefs[i];
 
-                            // Update new fully uncompressed occupancy state
-                            this->updateOccupancyStateProba(next_fully_uncompressed_occupancy_state, next_joint_history, next_belief->toBelief(), next_joint_history_probability);
+            double next_joint_history_probability = fully_uncompressed_occupancy_state->getProbability(joint_histories[i]) * proba_observation;
 
-                            // Update new one step uncompressed occupancy state
-                            std::shared_ptr<JointHistoryInterface> next_compressed_joint_history = compressed_joint_history->expand(joint_observation /*, joint_action*/)->toJointHistory();
-                            this->updateOccupancyStateProba(next_one_step_left_compressed_occupancy_state, next_compressed_joint_history, next_belief->toBelief(), next_joint_history_probability);
+            // If the next history probability is not zero
+            if (next_joint_history_probability > 0)
+            {
+                std::shared_ptr<JointHistoryInterface> next_joint_history = joint_histories[i]->expand(joint_observations[i] /*, joint_action*/)->toJointHistory();
 
-                            // Update next history labels
-                            next_one_step_left_compressed_occupancy_state->updateJointLabels(next_joint_history->getIndividualHistories(), next_compressed_joint_history->getIndividualHistories());
-                        }
-                    }
-                }
+                // Update new fully uncompressed occupancy state
+                this->updateOccupancyStateProba(next_fully_uncompressed_occupancy_state, next_joint_history, next_belief->toBelief(), next_joint_history_probability);
+
+                // Update new one step uncompressed occupancy state
+                std::shared_ptr<JointHistoryInterface> next_compressed_joint_history = compressed_joint_histories[i]->expand(joint_observations[i] /*, joint_action*/)->toJointHistory();
+                this->updateOccupancyStateProba(next_one_step_left_compressed_occupancy_state, next_compressed_joint_history, next_belief->toBelief(), next_joint_history_probability);
+
+                // Update next history labels
+                next_one_step_left_compressed_occupancy_state->updateJointLabels(next_joint_history->getIndividualHistories(), next_compressed_joint_history->getIndividualHistories());
             }
         }
 
@@ -946,7 +1036,7 @@ namespace sdm
         std::shared_ptr<OccupancyStateInterface> compressed_occupancy_state;
 
         // Compress the occupancy state
-        compressed_occupancy_state = one_step_occupancy_state;//->compress();
+        compressed_occupancy_state = one_step_occupancy_state->compress();
 
         double norm_compressed = compressed_occupancy_state->norm_1();
         compressed_occupancy_state->normalizeBelief(norm_compressed);
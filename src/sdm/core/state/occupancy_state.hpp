@@ -30,6 +30,9 @@ namespace sdm
     public:
         static double PRECISION;
 
+        /** @brief The number of threads used to compute the next occupancy states (1 means sequential) */
+        static number NUM_THREADS;
+
         OccupancyState();
         OccupancyState(number num_agents, number h);
         OccupancyState(number num_agents, number h, StateType stateType);
@@ -108,6 +111,8 @@ namespace sdm
         virtual void finalize();
         virtual void finalize(bool do_compression);
 
+        void normalizeBelief(double norm_1);
+
         /**
          * @brief Get the fully uncompressed occupancy state.
          */
@@ -179,6 +184,15 @@ namespace sdm
          */
         virtual bool areIndividualHistoryLPE(const std::shared_ptr<HistoryInterface> &, const std::shared_ptr<HistoryInterface> &, number);
 
+        /**
+         * @brief Split the (sorted) support of an agent into classes of individual histories whose private occupancy
+         * states have the same signature. Only histories of the same class can be probabilistically equivalent.
+         *
+         * @param agent_id the agent
+         * @return the classes, in order of their first individual history
+         */
+        std::vector<std::vector<std::shared_ptr<HistoryInterface>>> getCompressionCandidates(number agent_id) const;
+
         /**
          * @brief Compression for occupancy states based on belief state representation.
          * To be in this representation, the type 'TState' have to be a derivation of the interface BeliefState.
@@ -217,8 +231,6 @@ namespace sdm
 
         virtual std::shared_ptr<JointHistoryInterface> getJointHistory(std::shared_ptr<JointHistoryInterface> candidate_jhistory);
 
-        /** @brief Keep relation between list of individual histories and joint histories */
-        static RecursiveMap<Joint<std::shared_ptr<HistoryInterface>>, std::shared_ptr<JointHistoryInterface>> jhistory_map_;
 
 
         /**
@@ -252,6 +264,27 @@ namespace sdm
          */
         std::set<std::shared_ptr<BeliefInterface>> list_beliefs_;
 
+        /** @brief An entry (o, x, p(o,x)) of the support. */
+        struct CanonicalEntry
+        {
+            const State *joint_history;
+            const State *state;
+            double probability;
+        };
+
+        /**
+         * @brief The entries of the support sorted by addresses of (o, x), so that occupancy states are compared with a single pass.
+         *
+         * It is built by finalize() and is not valid (canonical_ is false) once the occupancy state is modified.
+         */
+        std::vector<CanonicalEntry> canonical_support_;
+        bool canonical_ = false;
+
+        /**
+         * @brief Build the canonical support.
+         */
+        void setupCanonicalSupport();
+
         /**
          * @brief tuple of private history spaces, one private history space per agent
          */
@@ -268,6 +301,15 @@ namespace sdm
         std::unordered_map<number, std::unordered_map<std::shared_ptr<HistoryInterface>, std::set<std::shared_ptr<JointHistoryInterface>>>> ihistories_to_jhistory_;
 
         virtual Pair<std::shared_ptr<State>, double> computeNext(const std::shared_ptr<MDPInterface> &mdp, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t);
+
+        /**
+         * @brief Compute the next belief of each triple (belief, action, observation).
+         *
+         * Triples are processed by NUM_THREADS threads. The i-th result is the output of `beliefs[i]->next(mdp, actions[i], observations[i], t)`
+         * whatever the scheduling. Merging the results in order thus gives the same occupancy state as the sequential computation.
+         */
+        virtual std::vector<Pair<std::shared_ptr<State>, double>> computeNextBeliefs(const std::shared_ptr<MDPInterface> &mdp, const std::vector<std::shared_ptr<BeliefInterface>> &beliefs, const std::vector<std::shared_ptr<Action>> &actions, const std::vector<std::shared_ptr<Observation>> &observations, number t) const;
+
         virtual Pair<std::shared_ptr<State>, double> computeNextKeepAll(const std::shared_ptr<MDPInterface> &mdp, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t);
         virtual Pair<std::shared_ptr<OccupancyStateInterface>, double> finalizeKeepAll(const std::shared_ptr<OccupancyStateInterface> &one_step_occupancy_state, const std::shared_ptr<OccupancyStateInterface> &fully_uncompressed_occupancy_state, number t);
 
@@ -143,4 +143,21 @@ namespace sdm
         return true;
     }
 
+    std::size_t PrivateOccupancyState::getSignature(double precision) const
+    {
+        // Sum the hashes of entries, so that the signature does not depend on the order of the support
+        std::size_t signature = this->size();
+        for (const auto &pair_partial_jhistory : this->map_partial_to_jhist)
+        {
+            std::size_t partial_hash = std::hash<Joint<std::shared_ptr<HistoryInterface>>>()(pair_partial_jhistory.first);
+            for (const auto &state : this->getBeliefAt(pair_partial_jhistory.second)->getStates())
+            {
+                std::size_t seed = partial_hash;
+                sdm::hash_combine(seed, Belief::hashEntry(state, this->getProbability(pair_partial_jhistory.second, state), precision));
+                signature += seed;
+            }
+        }
+        return signature;
+    }
+
 } // namespace sdm
@@ -52,6 +52,18 @@ namespace sdm
          */
         bool check_equivalence(const PrivateOccupancyState &) const;
 
+        /**
+         * @brief Get a signature of the private occupancy state, i.e. a hash of the probabilities p(o^{-i}, x | o^{i})
+         * rounded to a given precision that does not depend on the history o^{i} itself.
+         *
+         * Equivalent private occupancy states have the same signature, unless one of their probabilities is rounded
+         * differently (distinct signatures only miss a merge, they never merge non equivalent states).
+         *
+         * @param precision the precision of the rounding
+         * @return the signature
+         */
+        std::size_t getSignature(double precision = PrivateOccupancyState::PRECISION_COMPRESSION) const;
+
         std::string str() const;
 
     protected:
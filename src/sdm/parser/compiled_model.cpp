@@ -0,0 +1,524 @@
+#include <regex>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <sdm/exception.hpp>
+#include <sdm/world/posg.hpp>
+#include <sdm/core/reward/tabular_reward.hpp>
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
+#include <sdm/core/dynamics/flat_state_dynamics.hpp>
+#include <sdm/core/dynamics/flat_observation_dynamics.hpp>
+#include <sdm/parser/compiled_model.hpp>
+#include <sdm/core/state/base_state.hpp>
+#include <sdm/core/action/base_action.hpp>
+#include <sdm/core/observation/base_observation.hpp>
+#include <sdm/parser/encoders/space_encoders.hpp>
+
+namespace sdm
+{
+  namespace parser
+  {
+    namespace
+    {
+      using index_t = FlatTabularDynamics::index_t;
+      using SuccessorEntry = FlatTabularDynamics::SuccessorEntry;
+      using ObservationEntry = FlatTabularDynamics::ObservationEntry;
+
+      static_assert(std::is_trivially_copyable<SuccessorEntry>::value && std::is_trivially_copyable<ObservationEntry>::value,
+                    "flat dynamics must be stored as raw bytes");
+
+      constexpr char MAGIC[4] = {'S', 'D', 'M', 'B'};
+      constexpr std::uint32_t VERSION = 1;
+      constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+      enum ModelKind : std::uint32_t
+      {
+        DECPOMDP_MODEL,
+        POSG_MODEL
+      };
+
+      /** @brief The sections of a compiled model, in the order of the file. */
+      enum Section : std::uint32_t
+      {
+        DIMENSIONS,          // number of actions of each agent, then number of observations of each agent (uint32)
+        NAMES,               // names of states, actions of each agent, observations of each agent (uint32 size + characters)
+        START,               // p(x) for each state (double)
+        REWARDS,             // rewards that were explicitly set (RewardEntry)
+        ROW_OFFSETS,         // flat dynamics : offsets of the rows (std::size_t)
+        SUCCESSORS,          // flat dynamics : successors (SuccessorEntry)
+        OBSERVATIONS,        // flat dynamics : observations of the successors (ObservationEntry)
+        OBSERVATION_OFFSETS, // observation model : offsets of the rows (u, y) (std::size_t)
+        OBSERVATION_MODEL,   // observation model : p(z | u, y) (ObservationEntry)
+        NUM_SECTIONS
+      };
+
+      struct SectionEntry
+      {
+        std::uint64_t offset, size;
+      };
+
+      struct Header
+      {
+        char magic[4];
+        std::uint32_t version, byte_order, word_size;
+        std::uint32_t kind, criterion, num_agents, num_states;
+        std::uint32_t num_actions, num_observations;
+        double discount;
+        SectionEntry sections[NUM_SECTIONS];
+      };
+
+      /** @brief The reward r_i(x, u) of an agent (agent 0 for cooperative models). */
+      struct RewardEntry
+      {
+        index_t state, action, agent;
+        double reward;
+      };
+
+      /**
+       * @brief A file mapped read-only in memory (the mapping is shared between processes).
+       */
+      class MappedFile
+      {
+      public:
+        MappedFile(const std::string &filename)
+        {
+          int fd = ::open(filename.c_str(), O_RDONLY);
+          if (fd < 0)
+          {
+            throw sdm::exception::FileNotFoundException(filename);
+          }
+          struct stat status;
+          if (::fstat(fd, &status) < 0)
+          {
+            ::close(fd);
+            throw sdm::exception::Exception("Cannot read the compiled model " + filename);
+          }
+          this->size_ = status.st_size;
+          this->data_ = (this->size_ > 0) ? ::mmap(nullptr, this->size_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+          ::close(fd);
+          if (this->data_ == MAP_FAILED)
+          {
+            throw sdm::exception::Exception("Cannot map the compiled model " + filename);
+          }
+        }
+
+        ~MappedFile()
+        {
+          ::munmap(this->data_, this->size_);
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const char *data() const { return static_cast<const char *>(this->data_); }
+        std::size_t size() const { return this->size_; }
+
+      protected:
+        void *data_;
+        std::size_t size_;
+      };
+
+      template <typename T>
+      Span<T> getSection(const MappedFile &file, const Header &header, Section section)
+      {
+        const auto &entry = header.sections[section];
+        if ((entry.offset % alignof(T) != 0) || (entry.size % sizeof(T) != 0) || (entry.offset > file.size()) || (entry.size > file.size() - entry.offset))
+        {
+          throw sdm::exception::Exception("Corrupted compiled model (section " + std::to_string(section) + ")");
+        }
+        return Span<T>(reinterpret_cast<const T *>(file.data() + entry.offset), entry.size / sizeof(T));
+      }
+
+      /**
+       * @brief Write the sections of a compiled model one after the other (each section is aligned on 8 bytes).
+       */
+      class SectionWriter
+      {
+      public:
+        SectionWriter(const std::string &filename, Header &header) : file_(filename, std::ios::binary), header_(header)
+        {
+          if (!this->file_)
+          {
+            throw sdm::exception::Exception("Cannot write the compiled model " + filename);
+          }
+          // The header is written at the end, when the sections are known
+          this->file_.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+          this->position_ = sizeof(Header);
+        }
+
+        void write(Section section, const void *data, std::size_t size)
+        {
+          static const char padding[8] = {};
+          std::size_t aligned_position = (this->position_ + 7) / 8 * 8;
+          this->file_.write(padding, aligned_position - this->position_);
+          this->file_.write(static_cast<const char *>(data), size);
+          this->header_.sections[section] = {aligned_position, size};
+          this->position_ = aligned_position + size;
+        }
+
+        template <typename T>
+        void write(Section section, const std::vector<T> &values)
+        {
+          this->write(section, values.data(), values.size() * sizeof(T));
+        }
+
+        void close()
+        {
+          this->file_.seekp(0);
+          this->file_.write(reinterpret_cast<const char *>(&this->header_), sizeof(Header));
+          this->file_.close();
+          if (!this->file_)
+          {
+            throw sdm::exception::Exception("Cannot write the compiled model");
+          }
+        }
+
+      protected:
+        std::ofstream file_;
+        Header &header_;
+        std::size_t position_;
+      };
+
+      void appendName(std::vector<char> &names, const std::string &name)
+      {
+        std::uint32_t size = name.size();
+        names.insert(names.end(), reinterpret_cast<const char *>(&size), reinterpret_cast<const char *>(&size) + sizeof(size));
+        names.insert(names.end(), name.begin(), name.end());
+      }
+
+      /**
+       * @brief Check the offsets of the rows of a CSR table : one more offset than rows, starting at 0,
+       * non-decreasing and ending at the number of entries.
+       */
+      void checkRowOffsets(Span<std::size_t> row_offsets, std::size_t num_rows, std::size_t num_entries, const std::string &table)
+      {
+        if ((row_offsets.size() != num_rows + 1) || (row_offsets[0] != 0) || (row_offsets[num_rows] != num_entries))
+        {
+          throw sdm::exception::Exception("Corrupted compiled model (" + table + ")");
+        }
+        for (std::size_t row = 0; row < num_rows; row++)
+        {
+          if ((row_offsets[row] > row_offsets[row + 1]) || (row_offsets[row + 1] > num_entries))
+          {
+            throw sdm::exception::Exception("Corrupted compiled model (" + table + ")");
+          }
+        }
+      }
+
+      std::vector<std::string> readNames(Span<char> names, std::size_t &position, std::size_t num_names)
+      {
+        std::vector<std::string> list_names;
+        for (std::size_t i = 0; i < num_names; i++)
+        {
+          std::uint32_t size;
+          if (position + sizeof(size) > names.size())
+          {
+            throw sdm::exception::Exception("Corrupted compiled model (names)");
+          }
+          std::memcpy(&size, names.data() + position, sizeof(size));
+          position += sizeof(size);
+          if (position + size > names.size())
+          {
+            throw sdm::exception::Exception("Corrupted compiled model (names)");
+          }
+          list_names.emplace_back(names.data() + position, size);
+          position += size;
+        }
+        return list_names;
+      }
+    } // namespace
+
+    bool is_compiled_file(const std::string &filename)
+    {
+      return regex_match(filename, std::regex(".*\\.sdmb$")) || regex_match(filename, std::regex(".*\\.SDMB$"));
+    }
+
+    void write_compiled_file(const std::shared_ptr<MPOMDP> &model, const std::string &filename)
+    {
+      std::shared_ptr<POMDP> pomdp = model;
+      auto state_space = std::dynamic_pointer_cast<DiscreteSpace>(pomdp->getStateSpace());
+      auto action_space = std::dynamic_pointer_cast<MultiDiscreteSpace>(pomdp->getActionSpace());
+      auto observation_space = std::dynamic_pointer_cast<MultiDiscreteSpace>(pomdp->getObservationSpace());
+      auto flat_dynamics = model->getFlatDynamics();
+      auto observation_dynamics = model->getObservationDynamics();
+      auto start_distribution = std::dynamic_pointer_cast<DiscreteDistribution<std::shared_ptr<State>>>(model->getStartDistribution());
+      if (!state_space || !action_space || !observation_space || !flat_dynamics || !observation_dynamics || !start_distribution)
+      {
+        throw sdm::exception::Exception("Only models parsed from .dpomdp or .posg files can be compiled.");
+      }
+
+      Header header = {};
+      std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+      header.version = VERSION;
+      header.byte_order = BYTE_ORDER_MARK;
+      header.word_size = sizeof(std::size_t);
+      header.kind = (std::dynamic_pointer_cast<POSG>(model) != nullptr) ? POSG_MODEL : DECPOMDP_MODEL;
+      header.criterion = model->getCriterion();
+      header.num_agents = model->getNumAgents();
+      header.num_states = flat_dynamics->getNumStates();
+      header.num_actions = flat_dynamics->getNumActions();
+      header.num_observations = flat_dynamics->getNumObservations();
+      header.discount = model->getDiscount();
+
+      SectionWriter writer(filename, header);
+
+      // Dimensions and names
+      std::vector<std::uint32_t> dimensions;
+      std::vector<char> names;
+      for (const auto &state : *state_space)
+      {
+        appendName(names, state->str());
+      }
+      for (const auto &space : std::vector<std::shared_ptr<MultiDiscreteSpace>>{action_space, observation_space})
+      {
+        for (number agent_id = 0; agent_id < space->getNumSpaces(); agent_id++)
+        {
+          auto individual_space = std::static_pointer_cast<DiscreteSpace>(space->getSpace(agent_id));
+          dimensions.push_back(individual_space->getNumItems());
+          for (const auto &item : *individual_space)
+          {
+            appendName(names, item->str());
+          }
+        }
+      }
+      writer.write(DIMENSIONS, dimensions);
+      writer.write(NAMES, names);
+
+      // Initial distribution
+      std::vector<double> start(header.num_states);
+      for (index_t state = 0; state < header.num_states; state++)
+      {
+        start[state] = start_distribution->getProbability(flat_dynamics->getState(state));
+      }
+      writer.write(START, start);
+
+      // Rewards
+      std::vector<RewardEntry> rewards;
+      if (auto cooperative_rewards = std::dynamic_pointer_cast<CooperativeRewardModel>(model->getRewardSpace()))
+      {
+        for (const auto &[state, row] : cooperative_rewards->getRewards())
+        {
+          for (const auto &[action, reward] : row)
+          {
+            rewards.push_back({flat_dynamics->getStateIndex(state), flat_dynamics->getActionIndex(action), 0, reward});
+          }
+        }
+      }
+      else if (auto competitive_rewards = std::dynamic_pointer_cast<CompetitiveRewardModel>(model->getRewardSpace()))
+      {
+        for (const auto &[state, row] : competitive_rewards->getRewards())
+        {
+          for (const auto &[action, agent_rewards] : row)
+          {
+            for (index_t agent_id = 0; agent_id < agent_rewards.size(); agent_id++)
+            {
+              rewards.push_back({flat_dynamics->getStateIndex(state), flat_dynamics->getActionIndex(action), agent_id, agent_rewards[agent_id]});
+            }
+          }
+        }
+      }
+      else
+      {
+        throw sdm::exception::Exception("Only models with tabular rewards can be compiled.");
+      }
+      std::sort(rewards.begin(), rewards.end(), [](const RewardEntry &a, const RewardEntry &b)
+                { return std::tie(a.state, a.action, a.agent) < std::tie(b.state, b.action, b.agent); });
+      writer.write(REWARDS, rewards);
+
+      // Flat dynamics
+      auto row_offsets = flat_dynamics->getRowOffsets();
+      auto successors = flat_dynamics->getSuccessorEntries();
+      auto observations = flat_dynamics->getObservationEntries();
+      writer.write(ROW_OFFSETS, row_offsets.data(), row_offsets.size() * sizeof(std::size_t));
+      writer.write(SUCCESSORS, successors.data(), successors.size() * sizeof(SuccessorEntry));
+      writer.write(OBSERVATIONS, observations.data(), observations.size() * sizeof(ObservationEntry));
+
+      // Observation model p(z | u, y) (including pairs (u, y) that are not reachable)
+      std::vector<std::size_t> observation_offsets = {0};
+      std::vector<ObservationEntry> observation_model;
+      for (index_t action = 0; action < header.num_actions; action++)
+      {
+        for (index_t next_state = 0; next_state < header.num_states; next_state++)
+        {
+          const auto &u = flat_dynamics->getAction(action);
+          const auto &y = flat_dynamics->getState(next_state);
+          try
+          {
+            for (const auto &z : observation_dynamics->getReachableObservations(y, u, y, 0))
+            {
+              observation_model.push_back({flat_dynamics->getObservationIndex(z), observation_dynamics->getObservationProbability(y, u, y, z, 0)});
+            }
+          }
+          catch (const std::out_of_range &)
+          {
+          }
+          observation_offsets.push_back(observation_model.size());
+        }
+      }
+      writer.write(OBSERVATION_OFFSETS, observation_offsets);
+      writer.write(OBSERVATION_MODEL, observation_model);
+
+      writer.close();
+    }
+
+    std::shared_ptr<MPOMDP> parse_compiled_file(const std::string &filename, Config config)
+    {
+      auto file = std::make_shared<MappedFile>(filename);
+
+      // Check the header
+      if (file->size() < sizeof(Header))
+      {
+        throw sdm::exception::Exception("Corrupted compiled model " + filename);
+      }
+      Header header;
+      std::memcpy(&header, file->data(), sizeof(Header));
+      if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+      {
+        throw sdm::exception::Exception(filename + " is not a compiled model");
+      }
+      if (header.version != VERSION)
+      {
+        throw sdm::exception::Exception("Unsupported version of compiled model (" + std::to_string(header.version) + ") in " + filename);
+      }
+      if ((header.byte_order != BYTE_ORDER_MARK) || (header.word_size != sizeof(std::size_t)))
+      {
+        throw sdm::exception::Exception(filename + " was compiled on another architecture");
+      }
+
+      // Spaces
+      auto dimensions = getSection<std::uint32_t>(*file, header, DIMENSIONS);
+      auto names = getSection<char>(*file, header, NAMES);
+      if (dimensions.size() != 2 * header.num_agents)
+      {
+        throw sdm::exception::Exception("Corrupted compiled model (dimensions)");
+      }
+      std::size_t position = 0;
+      auto state_names = readNames(names, position, header.num_states);
+      std::vector<std::vector<std::string>> action_names, observation_names;
+      for (number agent_id = 0; agent_id < header.num_agents; agent_id++)
+      {
+        action_names.push_back(readNames(names, position, dimensions[agent_id]));
+      }
+      for (number agent_id = 0; agent_id < header.num_agents; agent_id++)
+      {
+        observation_names.push_back(readNames(names, position, dimensions[header.num_agents + agent_id]));
+      }
+
+      std::shared_ptr<DiscreteSpace> state_space = ast::discrete_space_encoder<StringState>()(state_names);
+      std::shared_ptr<MultiDiscreteSpace> action_space = ast::multi_discrete_space_encoder<StringAction>()(action_names);
+      std::shared_ptr<MultiDiscreteSpace> observation_space = ast::multi_discrete_space_encoder<StringObservation>()(observation_names);
+
+      // Flat dynamics (viewed in place, the tables are checked since queries do not check bounds)
+      auto row_offsets = getSection<std::size_t>(*file, header, ROW_OFFSETS);
+      auto successors = getSection<SuccessorEntry>(*file, header, SUCCESSORS);
+      auto observations = getSection<ObservationEntry>(*file, header, OBSERVATIONS);
+      checkRowOffsets(row_offsets, std::size_t(header.num_states) * header.num_actions, successors.size(), "flat dynamics");
+      for (std::size_t row = 0; row + 1 < row_offsets.size(); row++)
+      {
+        for (std::size_t k = row_offsets[row]; k < row_offsets[row + 1]; k++)
+        {
+          // Successors are sorted by next state, and their observations by observation (queries use binary searches)
+          const auto &successor = successors[k];
+          if ((successor.next_state >= header.num_states) || ((k > row_offsets[row]) && (successors[k - 1].next_state >= successor.next_state)) ||
+              (successor.observations_begin > successor.observations_end) || (successor.observations_end > observations.size()))
+          {
+            throw sdm::exception::Exception("Corrupted compiled model (flat dynamics)");
+          }
+          for (std::size_t i = successor.observations_begin; i < successor.observations_end; i++)
+          {
+            if ((observations[i].observation >= header.num_observations) || ((i > successor.observations_begin) && (observations[i - 1].observation >= observations[i].observation)))
+            {
+              throw sdm::exception::Exception("Corrupted compiled model (flat dynamics)");
+            }
+          }
+        }
+      }
+      auto flat_dynamics = std::make_shared<FlatTabularDynamics>(state_space, action_space, observation_space, row_offsets, successors, observations, file);
+      if ((flat_dynamics->getNumStates() != header.num_states) || (flat_dynamics->getNumActions() != header.num_actions) || (flat_dynamics->getNumObservations() != header.num_observations))
+      {
+        throw sdm::exception::Exception("Corrupted compiled model (dimensions)");
+      }
+
+      // Initial distribution
+      auto start = getSection<double>(*file, header, START);
+      auto start_distribution = std::make_shared<DiscreteDistribution<std::shared_ptr<State>>>();
+      for (index_t state = 0; state < start.size() && state < header.num_states; state++)
+      {
+        start_distribution->setProbability(flat_dynamics->getState(state), start[state]);
+      }
+
+      // Rewards (entries are sorted by state, action and agent)
+      auto reward_entries = getSection<RewardEntry>(*file, header, REWARDS);
+      std::shared_ptr<RewardModel> rewards;
+      auto check_reward = [&header](const RewardEntry &entry)
+      {
+        if ((entry.state >= header.num_states) || (entry.action >= header.num_actions) || (entry.agent >= header.num_agents))
+        {
+          throw sdm::exception::Exception("Corrupted compiled model (rewards)");
+        }
+      };
+      if (header.kind == POSG_MODEL)
+      {
+        auto competitive_rewards = std::make_shared<CompetitiveRewardModel>();
+        for (std::size_t i = 0; i < reward_entries.size();)
+        {
+          const auto &entry = reward_entries[i];
+          check_reward(entry);
+          std::vector<double> agent_rewards(header.num_agents, 0.);
+          for (; (i < reward_entries.size()) && (reward_entries[i].state == entry.state) && (reward_entries[i].action == entry.action); i++)
+          {
+            check_reward(reward_entries[i]);
+            agent_rewards[reward_entries[i].agent] = reward_entries[i].reward;
+          }
+          competitive_rewards->setReward(flat_dynamics->getState(entry.state), flat_dynamics->getAction(entry.action), agent_rewards);
+        }
+        rewards = competitive_rewards;
+      }
+      else
+      {
+        auto cooperative_rewards = std::make_shared<CooperativeRewardModel>();
+        for (const auto &entry : reward_entries)
+        {
+          check_reward(entry);
+          cooperative_rewards->setReward(flat_dynamics->getState(entry.state), flat_dynamics->getAction(entry.action), 0, entry.reward);
+        }
+        rewards = cooperative_rewards;
+      }
+
+      // State and observation dynamics (viewed in place as well)
+      auto state_dynamics = std::make_shared<FlatStateDynamics>(flat_dynamics);
+      auto observation_offsets = getSection<std::size_t>(*file, header, OBSERVATION_OFFSETS);
+      auto observation_model = getSection<ObservationEntry>(*file, header, OBSERVATION_MODEL);
+      checkRowOffsets(observation_offsets, std::size_t(header.num_actions) * header.num_states, observation_model.size(), "observation model");
+      for (const auto &entry : observation_model)
+      {
+        if (entry.observation >= header.num_observations)
+        {
+          throw sdm::exception::Exception("Corrupted compiled model (observation model)");
+        }
+      }
+      auto observation_dynamics = std::make_shared<FlatObservationDynamics>(flat_dynamics, observation_offsets, observation_model, file);
+
+      std::shared_ptr<MPOMDP> model;
+      if (header.kind == POSG_MODEL)
+      {
+        model = std::make_shared<POSG>(state_space, action_space, observation_space, rewards, state_dynamics, observation_dynamics, start_distribution, 0, header.discount, (Criterion)header.criterion);
+      }
+      else
+      {
+        model = std::make_shared<DecPOMDP>(state_space, action_space, observation_space, rewards, state_dynamics, observation_dynamics, start_distribution, 0, header.discount, (Criterion)header.criterion);
+      }
+      model->setFlatDynamics(flat_dynamics);
+      model->configure(config);
+      return model;
+    }
+
+  } // namespace parser
+} // namespace sdm
@@ -0,0 +1,51 @@
+/**
+ * @file compiled_model.hpp
+ * @brief Compiled (binary) format of parsed Dec-POMDP / POSG instances.
+ *
+ * A compiled model (extension .sdmb) holds the tables of a tabular model : the names of states, actions and
+ * observations, the initial distribution, the rewards, the observation model and the flat (CSR) dynamics.
+ * Loading a compiled model does not parse anything. The file is memory-mapped read-only, and the transitions
+ * (state dynamics, observation model and flat dynamics) are read in place rather than copied, so that concurrent
+ * solver processes share the same pages. The tables are checked when the model is loaded.
+ *
+ * A compiled model is specific to the architecture (byte order and word size) that wrote it.
+ */
+#pragma once
+
+#include <string>
+#include <memory>
+
+#include <sdm/utils/config.hpp>
+#include <sdm/world/mpomdp.hpp>
+
+namespace sdm
+{
+  namespace parser
+  {
+    /**
+     * @brief Check if a file is a compiled model (given its extension).
+     */
+    bool is_compiled_file(const std::string &filename);
+
+    /**
+     * @brief Write a compiled model.
+     *
+     * Only models parsed from .dpomdp and .posg files (i.e. with tabular dynamics and rewards) can be compiled.
+     *
+     * @param model the model
+     * @param filename the file (.sdmb)
+     */
+    void write_compiled_file(const std::shared_ptr<MPOMDP> &model, const std::string &filename);
+
+    /**
+     * @brief Load a compiled model.
+     *
+     * @param filename the file (.sdmb)
+     * @param config the configuration of the model
+     * @return the model (a DecPOMDP or a POSG)
+     * @throw sdm::exception::Exception if the file is corrupted (e.g. offsets or indices out of range)
+     */
+    std::shared_ptr<MPOMDP> parse_compiled_file(const std::string &filename, Config config = {});
+
+  } // namespace parser
+} // namespace sdm
@@ -80,6 +80,10 @@ namespace sdm
 
         auto parsed_model = std::make_shared<sdm::DecPOMDP>(state_space, action_space, obs_space, rewards, state_dynamics, obs_dynamics, start_distribution, 0, ast.discount_param, (Criterion)(ast.value_param == "reward"));
 
+        // Encodes the flat representation of the dynamics (used by belief updates and backups)
+        flat_dynamics_encoder flat_encoder(state_space, action_space, obs_space);
+        parsed_model->setFlatDynamics(flat_encoder.encode(state_dynamics, obs_dynamics));
+
 #ifdef VERBOSE
         std::cout << "Print model" << std::endl;
         std::cout << parsed_model << std::endl;
@@ -138,6 +142,10 @@ namespace sdm
 
         auto parsed_model = std::make_shared<sdm::POSG>(state_space, action_space, obs_space, rewards, state_dynamics, obs_dynamics, start_distribution, 0, ast.discount_param, (Criterion)(ast.value_param == "reward"));
 
+        // Encodes the flat representation of the dynamics (used by belief updates and backups)
+        flat_dynamics_encoder flat_encoder(state_space, action_space, obs_space);
+        parsed_model->setFlatDynamics(flat_encoder.encode(state_dynamics, obs_dynamics));
+
 #ifdef VERBOSE
         std::cout << "Print model" << std::endl;
         std::cout << parsed_model << std::endl;
@@ -221,5 +221,21 @@ namespace sdm
             }
             return dynamics;
         }
+
+        // ################################################################
+        // ############ FLAT DYNAMICS ENCODER #############################
+        // ################################################################
+
+        flat_dynamics_encoder::flat_dynamics_encoder(const std::shared_ptr<DiscreteSpace> &state_space, const std::shared_ptr<MultiDiscreteSpace> &action_space, const std::shared_ptr<MultiDiscreteSpace> &obs_space)
+        {
+            this->state_space_ = state_space;
+            this->action_space_ = action_space;
+            this->obs_space_ = obs_space;
+        }
+
+        std::shared_ptr<FlatTabularDynamics> flat_dynamics_encoder::encode(const std::shared_ptr<TabularStateDynamics> &state_dynamics, const std::shared_ptr<ObservationDynamicsInterface> &obs_dynamics)
+        {
+            return std::make_shared<FlatTabularDynamics>(this->state_space_, this->action_space_, this->obs_space_, state_dynamics, obs_dynamics);
+        }
     } // namespace ast
 } // namespace sdm
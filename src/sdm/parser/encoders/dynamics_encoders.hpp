@@ -7,6 +7,7 @@
 #include <sdm/core/space/multi_discrete_space.hpp>
 #include <sdm/core/dynamics/tabular_state_dynamics.hpp>
 #include <sdm/core/dynamics/tabular_observation_dynamics_AS.hpp>
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
 
 #include <sdm/parser/encoders/item_encoders.hpp>
 #include <sdm/parser/encoders/struct_encoders.hpp>
@@ -93,6 +94,21 @@ namespace sdm
             std::shared_ptr<TabularObservationDynamicsAS> encode(const observation_t &observs, std::shared_ptr<StateDynamicsInterface> state_dynamics);
         };
 
+        /**
+         * @brief encodes the state and observation dynamics into flat dynamics (i.e. FlatTabularDynamics class)
+         */
+        class flat_dynamics_encoder
+        {
+        protected:
+            std::shared_ptr<DiscreteSpace> state_space_;
+            std::shared_ptr<MultiDiscreteSpace> action_space_;
+            std::shared_ptr<MultiDiscreteSpace> obs_space_;
+
+        public:
+            flat_dynamics_encoder(const std::shared_ptr<DiscreteSpace> &state_space, const std::shared_ptr<MultiDiscreteSpace> &action_space, const std::shared_ptr<MultiDiscreteSpace> &obs_space);
+            std::shared_ptr<FlatTabularDynamics> encode(const std::shared_ptr<TabularStateDynamics> &state_dynamics, const std::shared_ptr<ObservationDynamicsInterface> &obs_dynamics);
+        };
+
     } // namespace ast
 
 } // namespace sdm
@@ -8,6 +8,7 @@ Copyright (C) 2016 Jilles Steeve Dibangoye
 #include <sdm/parser/config.hpp>
 #include <sdm/parser/printer.hpp>
 #include <sdm/parser/encoder.hpp>
+#include <sdm/parser/compiled_model.hpp>
 #include <sdm/parser/parser_def.hpp>
 #include <sdm/parser/ast_adapted.hpp>
 
@@ -47,6 +48,10 @@ namespace sdm
       {
         return std::make_shared<NetworkedDistributedPOMDP>(filename);
       }
+      else if (is_compiled_file(filename))
+      {
+        return parse_compiled_file(filename, config);
+      }
       else if (regex_match(filename, std::regex(".*\\.posg$")) || regex_match(filename, std::regex(".*\\.POSG$")))
       {
         auto posg = parsePOSG(filename.c_str());
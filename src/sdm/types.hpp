@@ -111,13 +111,15 @@ namespace sdm
     {
       PAIRWISE,
       BOUNDED,
-      NONE
+      NONE,
+      LP
     };
 
     const std::unordered_map<std::string, MaxplanPruning::Type> TYPE_MAP = {
         {"PAIRWISE", MaxplanPruning::PAIRWISE},
         {"BOUNDED", MaxplanPruning::BOUNDED},
         {"NONE", MaxplanPruning::NONE},
+        {"LP", MaxplanPruning::LP},
     };
   }
 
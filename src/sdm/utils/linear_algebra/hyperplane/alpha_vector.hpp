@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include <sdm/macros.hpp>
 #include <sdm/exception.hpp>
 #include <sdm/utils/linear_algebra/hyperplane/hyperplane.hpp>
@@ -20,6 +22,18 @@ namespace sdm
 
         double getValueAt(const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &o, const std::shared_ptr<Action> &u) const;
         void setValueAt(const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &o, const std::shared_ptr<Action> &u, double value);
+
+        /**
+         * @brief Go over all values that are explicitly stored (all other pairs (x,o) take the default value).
+         *
+         * @param callback the function called with each state, history and value
+         */
+        virtual void forEachValue(const std::function<void(const std::shared_ptr<State> &, const std::shared_ptr<HistoryInterface> &, double)> &callback) const = 0;
+
+        /**
+         * @brief Get the value of pairs (x,o) that are not explicitly stored.
+         */
+        double getDefaultValue() const { return this->default_value; }
     };
 }
 
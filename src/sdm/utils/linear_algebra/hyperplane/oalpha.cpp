@@ -43,21 +43,27 @@ namespace sdm
         // Compute \beta_t(x,o,u) = R(x,u) + \gamma \sum_{y, z} p^{uz}_{xy} \alpha_{t+1}(y, (o,u,z))
         double next_expected_value = 0.0;
 
-        // Go over all hidden state reachable next state
-        for (const auto &y : pomdp->getReachableStates(x, u, t))
+        // Go over all reachable pairs of next state and observation
+        for (const auto &transition : pomdp->getReachableDynamics(x, u, t))
         {
-            // Go over all observation reachable observation
-            for (const auto &z : pomdp->getReachableObservations(x, u, y, t))
-            {
-                // Determine the best next hyperplan for the next belief and compute the dynamics and probability of this best next hyperplan
-                next_expected_value += this->getValueAt(y, o->expand(z)) * pomdp->getDynamics(x, u, y, z, t);
-            }
+            next_expected_value += this->getValueAt(transition.next_state, o->expand(transition.observation)) * transition.probability;
         }
         auto res = pomdp->getReward(x, u, t) + pomdp->getDiscount(t) * next_expected_value;
 
         return res;
     }
 
+    void oAlpha::forEachValue(const std::function<void(const std::shared_ptr<State> &, const std::shared_ptr<HistoryInterface> &, double)> &callback) const
+    {
+        for (const auto &o_balpha : this->repr)
+        {
+            for (const auto &x_value : o_balpha.second)
+            {
+                callback(x_value.first, o_balpha.first, x_value.second);
+            }
+        }
+    }
+
     size_t oAlpha::hash(double precision) const
     {
         if (precision < 0)
@@ -16,6 +16,7 @@ namespace sdm
         double getValueAt(const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &o) const;
         void setValueAt(const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &o, double value);
         double getBetaValueAt(const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &, const std::shared_ptr<Action> &u, const std::shared_ptr<POMDPInterface> &pomdp, number t);
+        void forEachValue(const std::function<void(const std::shared_ptr<State> &, const std::shared_ptr<HistoryInterface> &, double)> &callback) const;
 
         size_t hash(double precision) const;
         
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <sdm/exception.hpp>
+#include <sdm/utils/linear_algebra/packed_vector.hpp>
+#include <sdm/core/state/interface/belief_interface.hpp>
+#include <sdm/core/state/interface/occupancy_state_interface.hpp>
+
+namespace sdm
+{
+    PackedIndexSpace::PackedIndexSpace()
+    {
+    }
+
+    PackedIndexSpace::PackedIndexSpace(const PackedIndexSpace &copy)
+    {
+        // Pairs are never released, interning them in the order of their indices gives the same indices
+        for (std::size_t index = 0; index < copy.size(); index++)
+        {
+            this->table_.getID(copy.table_.getItem(index));
+        }
+    }
+
+    PackedAlphaVector PackedIndexSpace::pack(const std::shared_ptr<AlphaVector> &alpha)
+    {
+        // Index all explicit entries of the alpha vector
+        std::vector<Pair<index_type, double>> entries;
+        alpha->forEachValue([this, &entries](const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &o, double value)
+                            { entries.push_back({this->table_.getID({o, x}), value}); });
+        std::sort(entries.begin(), entries.end());
+
+        PackedAlphaVector packed_alpha;
+        packed_alpha.default_value = alpha->getDefaultValue();
+        if (entries.empty())
+        {
+            return packed_alpha;
+        }
+
+        std::size_t span = std::size_t(entries.back().first) - entries.front().first + 1;
+        if (span <= DENSITY * entries.size() + 64 && span <= std::size_t(std::numeric_limits<std::int32_t>::max()))
+        {
+            // Dense window over [first index, last index]
+            packed_alpha.offset = entries.front().first;
+            packed_alpha.values.assign(span, packed_alpha.default_value);
+            for (const auto &entry : entries)
+            {
+                packed_alpha.values[entry.first - packed_alpha.offset] = entry.second;
+            }
+        }
+        else
+        {
+            packed_alpha.sparse_indices.reserve(entries.size());
+            packed_alpha.values.reserve(entries.size());
+            for (const auto &entry : entries)
+            {
+                packed_alpha.sparse_indices.push_back(entry.first);
+                packed_alpha.values.push_back(entry.second);
+            }
+        }
+        return packed_alpha;
+    }
+
+    PackedState PackedIndexSpace::pack(const std::shared_ptr<State> &state) const
+    {
+        return PackedIndexSpace::packWith(state, [this](const key_type &key)
+                                           { return this->table_.findID(key); });
+    }
+
+    PackedState PackedIndexSpace::insert(const std::shared_ptr<State> &state)
+    {
+        return PackedIndexSpace::packWith(state, [this](const key_type &key)
+                                           { return this->table_.getID(key); });
+    }
+
+    template <typename TGetIndex>
+    PackedState PackedIndexSpace::packWith(const std::shared_ptr<State> &state, TGetIndex get_index)
+    {
+        PackedState packed_state;
+        std::vector<Pair<index_type, double>> entries;
+
+        auto add_entry = [&get_index, &packed_state, &entries](const std::shared_ptr<HistoryInterface> &o, const std::shared_ptr<State> &x, double weight)
+        {
+            index_type index = get_index({o, x});
+            if (index == decltype(table_)::NOT_FOUND)
+            {
+                packed_state.unknown_weight += weight;
+            }
+            else
+            {
+                entries.push_back({index, weight});
+            }
+        };
+
+        if (auto occupancy_state = std::dynamic_pointer_cast<OccupancyStateInterface>(state))
+        {
+            for (const auto &jhistory : occupancy_state->getJointHistories())
+            {
+                for (const auto &x : occupancy_state->getBeliefAt(jhistory)->getStates())
+                {
+                    add_entry(jhistory, x, occupancy_state->getProbability(jhistory, x));
+                }
+            }
+        }
+        else if (auto belief = std::dynamic_pointer_cast<BeliefInterface>(state))
+        {
+            for (const auto &x : belief->getStates())
+            {
+                add_entry(nullptr, x, belief->getProbability(x));
+            }
+        }
+        else
+        {
+            throw sdm::exception::TypeError("TypeError : state must derived from belief");
+        }
+
+        std::sort(entries.begin(), entries.end());
+        packed_state.indices.reserve(entries.size());
+        packed_state.weights.reserve(entries.size());
+        packed_state.weight_prefix.reserve(entries.size() + 1);
+        packed_state.weight_prefix.push_back(0.);
+        for (const auto &entry : entries)
+        {
+            packed_state.indices.push_back(entry.first);
+            packed_state.weights.push_back(entry.second);
+            packed_state.weight_prefix.push_back(packed_state.weight_prefix.back() + entry.second);
+        }
+        return packed_state;
+    }
+
+    std::size_t PackedIndexSpace::size() const
+    {
+        return this->table_.size();
+    }
+
+    namespace packed
+    {
+        double gatherDot(const std::uint32_t *indices, const double *weights, std::size_t n, const double *values, std::uint32_t offset)
+        {
+            double sum = 0.;
+            std::size_t i = 0;
+
+#if defined(__AVX512F__)
+            __m512d sum_512 = _mm512_setzero_pd();
+            __m256i offset_512 = _mm256_set1_epi32(static_cast<int>(offset));
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i positions = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i)), offset_512);
+                __m512d gathered = _mm512_i32gather_pd(positions, values, sizeof(double));
+                sum_512 = _mm512_fmadd_pd(_mm512_loadu_pd(weights + i), gathered, sum_512);
+            }
+            sum += _mm512_reduce_add_pd(sum_512);
+#endif
+
+#if defined(__AVX2__)
+            __m256d sum_256 = _mm256_setzero_pd();
+            __m128i offset_256 = _mm_set1_epi32(static_cast<int>(offset));
+            for (; i + 4 <= n; i += 4)
+            {
+                __m128i positions = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i)), offset_256);
+                __m256d gathered = _mm256_i32gather_pd(values, positions, sizeof(double));
+#if defined(__FMA__)
+                sum_256 = _mm256_fmadd_pd(_mm256_loadu_pd(weights + i), gathered, sum_256);
+#else
+                sum_256 = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(weights + i), gathered), sum_256);
+#endif
+            }
+            __m128d sum_128 = _mm_add_pd(_mm256_castpd256_pd128(sum_256), _mm256_extractf128_pd(sum_256, 1));
+            sum += _mm_cvtsd_f64(_mm_add_sd(sum_128, _mm_unpackhi_pd(sum_128, sum_128)));
+#endif
+
+            for (; i < n; i++)
+            {
+                sum += weights[i] * values[indices[i] - offset];
+            }
+            return sum;
+        }
+
+        double valueAt(const PackedAlphaVector &alpha, std::uint32_t index)
+        {
+            if (alpha.isSparse())
+            {
+                auto iter = std::lower_bound(alpha.sparse_indices.begin(), alpha.sparse_indices.end(), index);
+                return ((iter != alpha.sparse_indices.end()) && (*iter == index)) ? alpha.values[iter - alpha.sparse_indices.begin()] : alpha.default_value;
+            }
+            return ((index >= alpha.offset) && (index - alpha.offset < alpha.values.size())) ? alpha.values[index - alpha.offset] : alpha.default_value;
+        }
+
+        double product(const PackedState &state, const PackedAlphaVector &alpha)
+        {
+            if (alpha.isSparse())
+            {
+                // Both index lists are sorted : merge them
+                double sum = 0.;
+                std::size_t i = 0, j = 0;
+                while (i < state.indices.size() && j < alpha.sparse_indices.size())
+                {
+                    if (state.indices[i] < alpha.sparse_indices[j])
+                    {
+                        i++;
+                    }
+                    else if (alpha.sparse_indices[j] < state.indices[i])
+                    {
+                        j++;
+                    }
+                    else
+                    {
+                        sum += state.weights[i] * (alpha.values[j] - alpha.default_value);
+                        i++;
+                        j++;
+                    }
+                }
+                return sum + alpha.default_value * state.getTotalWeight();
+            }
+
+            // Entries of the state inside the dense window of the alpha vector
+            auto begin = std::lower_bound(state.indices.begin(), state.indices.end(), alpha.offset);
+            auto end = std::lower_bound(begin, state.indices.end(), std::size_t(alpha.offset) + alpha.values.size());
+            std::size_t first = begin - state.indices.begin(), last = end - state.indices.begin();
+
+            double window_weight = state.weight_prefix[last] - state.weight_prefix[first];
+            double window_sum = gatherDot(state.indices.data() + first, state.weights.data() + first, last - first, alpha.values.data(), alpha.offset);
+            return window_sum + alpha.default_value * (state.getTotalWeight() - window_weight);
+        }
+
+        Pair<long, double> argmax(const PackedState &state, const std::vector<PackedAlphaVector> &alphas)
+        {
+            Pair<long, double> best = {-1, -std::numeric_limits<double>::max()};
+            for (std::size_t k = 0; k < alphas.size(); k++)
+            {
+                double value = product(state, alphas[k]);
+                if (best.second < value)
+                {
+                    best = {long(k), value};
+                }
+            }
+            return best;
+        }
+    } // namespace packed
+
+} // namespace sdm
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include <sdm/types.hpp>
+#include <sdm/core/state/state.hpp>
+#include <sdm/core/state/interface/history_interface.hpp>
+#include <sdm/utils/struct/pair.hpp>
+#include <sdm/utils/struct/aligned_allocator.hpp>
+#include <sdm/utils/struct/concurrent_interning_table.hpp>
+#include <sdm/utils/linear_algebra/hyperplane/alpha_vector.hpp>
+
+namespace sdm
+{
+    template <typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    /**
+     * @brief A state (occupancy state or belief) packed over the indices of a PackedIndexSpace.
+     *
+     * Entries are sorted by index. The weight of an entry (o,x) is the probability p(o,x). Pairs (o,x) that are
+     * unknown to the index space are not stored in any packed alpha vector, so they always take the default value
+     * and only their total weight is kept.
+     */
+    struct PackedState
+    {
+        std::vector<std::uint32_t> indices;
+        AlignedVector<double> weights;
+
+        /** @brief weight_prefix[i] is the sum of the i first weights. */
+        std::vector<double> weight_prefix;
+
+        /** @brief The total weight of pairs (o,x) that are unknown to the index space. */
+        double unknown_weight = 0.;
+
+        double getTotalWeight() const { return this->weight_prefix.back() + this->unknown_weight; }
+    };
+
+    /**
+     * @brief An alpha vector packed over the indices of a PackedIndexSpace.
+     *
+     * In general, values of indices [offset, offset + values.size()) are stored in a dense window (pairs that are not
+     * explicitly stored in the alpha vector take the default value). When explicit entries are too scattered
+     * for a window, only these entries are kept (sorted by index in sparse_indices, values in values).
+     */
+    struct PackedAlphaVector
+    {
+        std::uint32_t offset = 0;
+        AlignedVector<double> values;
+        std::vector<std::uint32_t> sparse_indices;
+        double default_value = 0.;
+
+        bool isSparse() const { return !this->sparse_indices.empty(); }
+    };
+
+    /**
+     * @class PackedIndexSpace
+     *
+     * @brief Dense indices shared by the states and alpha vectors of a value function (at a given time step).
+     *
+     * Each pair (o,x) stored in an alpha vector gets an index, so that the product between a state and all
+     * alpha vectors can be computed with gathers over contiguous arrays rather than hash lookups.
+     * Packing an alpha vector adds its pairs to the index space, packing a state never does. The index
+     * space can be shared and extended concurrently.
+     */
+    class PackedIndexSpace
+    {
+    public:
+        using index_type = std::uint32_t;
+        using key_type = Pair<std::shared_ptr<HistoryInterface>, std::shared_ptr<State>>;
+
+        PackedIndexSpace();
+
+        /**
+         * @brief Copy an index space, pairs (o,x) keep their index. The copied space must not be extended meanwhile.
+         */
+        PackedIndexSpace(const PackedIndexSpace &copy);
+
+        /**
+         * @brief Pack an alpha vector (its pairs (o,x) are added to the index space).
+         */
+        PackedAlphaVector pack(const std::shared_ptr<AlphaVector> &alpha);
+
+        /**
+         * @brief Pack an occupancy state or a belief.
+         */
+        PackedState pack(const std::shared_ptr<State> &state) const;
+
+        /**
+         * @brief Pack an occupancy state or a belief, adding its pairs (o,x) to the index space.
+         */
+        PackedState insert(const std::shared_ptr<State> &state);
+
+        /**
+         * @brief Get the number of indices.
+         */
+        std::size_t size() const;
+
+    protected:
+        /** @brief Dense windows are only used if at least one index of 1 / DENSITY in the window is explicit. */
+        static constexpr std::size_t DENSITY = 4;
+
+        ConcurrentInterningTable<key_type> table_;
+
+        /**
+         * @brief Pack a state given the index of each pair (o,x) (NOT_FOUND for unknown pairs).
+         */
+        template <typename TGetIndex>
+        static PackedState packWith(const std::shared_ptr<State> &state, TGetIndex get_index);
+    };
+
+    namespace packed
+    {
+        /**
+         * @brief Compute sum_i weights[i] * values[indices[i] - offset].
+         *
+         * Uses AVX-512 or AVX2 gathers when the library is compiled for these instruction sets.
+         */
+        double gatherDot(const std::uint32_t *indices, const double *weights, std::size_t n, const double *values, std::uint32_t offset);
+
+        /**
+         * @brief Get the value of a packed alpha vector at an index.
+         */
+        double valueAt(const PackedAlphaVector &alpha, std::uint32_t index);
+
+        /**
+         * @brief Get the product between a packed state and a packed alpha vector.
+         */
+        double product(const PackedState &state, const PackedAlphaVector &alpha);
+
+        /**
+         * @brief Get the position of the alpha vector maximizing the product with a state, and the maximal product.
+         *
+         * @return the pair (position, product), the position is -1 if there is no alpha vector
+         */
+        Pair<long, double> argmax(const PackedState &state, const std::vector<PackedAlphaVector> &alphas);
+    } // namespace packed
+
+} // namespace sdm
@@ -0,0 +1,132 @@
+#ifdef WITH_CPLEX
+
+#include <cmath>
+#include <sdm/exception.hpp>
+#include <sdm/utils/linear_programming/cplex_lp_solver.hpp>
+
+namespace sdm
+{
+    CplexLPSolver::CplexLPSolver() : model_(env_), variables_(env_), constraints_(env_), objective_(IloMaximize(env_))
+    {
+        this->model_.add(this->objective_);
+    }
+
+    CplexLPSolver::~CplexLPSolver()
+    {
+        this->env_.end();
+    }
+
+    IloNum CplexLPSolver::toCplex(double bound)
+    {
+        return std::isinf(bound) ? ((bound > 0) ? IloInfinity : -IloInfinity) : bound;
+    }
+
+    std::size_t CplexLPSolver::addVariable(const std::string &name, double lower_bound, double upper_bound, bool is_integer)
+    {
+        IloNumVar variable(this->env_, toCplex(lower_bound), toCplex(upper_bound), is_integer ? ILOINT : ILOFLOAT, name.c_str());
+        this->variables_.add(variable);
+        this->model_.add(variable);
+        return this->variables_.getSize() - 1;
+    }
+
+    std::size_t CplexLPSolver::addConstraint(const std::vector<Pair<std::size_t, double>> &coefficients, double lower_bound, double upper_bound)
+    {
+        IloRange range(this->env_, toCplex(lower_bound), toCplex(upper_bound));
+        for (const auto &coefficient : coefficients)
+        {
+            range.setLinearCoef(this->variables_[coefficient.first], coefficient.second);
+        }
+        this->constraints_.add(range);
+        this->model_.add(range);
+        return this->constraints_.getSize() - 1;
+    }
+
+    void CplexLPSolver::addIndicatorConstraint(std::size_t indicator, const std::vector<Pair<std::size_t, double>> &coefficients, double upper_bound)
+    {
+        IloExpr expr(this->env_);
+        for (const auto &coefficient : coefficients)
+        {
+            expr += coefficient.second * this->variables_[coefficient.first];
+        }
+        this->model_.add(IloIfThen(this->env_, this->variables_[indicator] >= 1, expr <= upper_bound));
+        expr.end();
+        this->num_indicators_++;
+    }
+
+    void CplexLPSolver::setObjectiveCoefficient(std::size_t variable, double coefficient)
+    {
+        this->objective_.setLinearCoef(this->variables_[variable], coefficient);
+    }
+
+    void CplexLPSolver::setVariableBounds(std::size_t variable, double lower_bound, double upper_bound)
+    {
+        this->variables_[variable].setBounds(toCplex(lower_bound), toCplex(upper_bound));
+    }
+
+    void CplexLPSolver::setConstraintBounds(std::size_t constraint, double lower_bound, double upper_bound)
+    {
+        this->constraints_[constraint].setBounds(toCplex(lower_bound), toCplex(upper_bound));
+    }
+
+    bool CplexLPSolver::maximize()
+    {
+        try
+        {
+            if (!this->extracted_)
+            {
+                this->cplex_ = IloCplex(this->model_);
+                this->cplex_.setOut(this->env_.getNullStream());
+                this->cplex_.setWarning(this->env_.getNullStream());
+                this->extracted_ = true;
+            }
+
+            this->solution_.clear();
+            if (!this->cplex_.solve())
+            {
+                return false;
+            }
+            this->objective_value_ = this->cplex_.getObjValue();
+
+            IloNumArray values(this->env_);
+            this->cplex_.getValues(values, this->variables_);
+            for (IloInt v = 0; v < values.getSize(); v++)
+            {
+                this->solution_.push_back(values[v]);
+            }
+            values.end();
+            return true;
+        }
+        catch (IloException &e)
+        {
+            std::cerr << "Concert exception caught: " << e << std::endl;
+        }
+        return false;
+    }
+
+    double CplexLPSolver::getObjectiveValue() const
+    {
+        return this->objective_value_;
+    }
+
+    double CplexLPSolver::getValue(std::size_t variable) const
+    {
+        if (this->solution_.empty())
+        {
+            throw sdm::exception::Exception("CplexLPSolver::getValue : no solution was found");
+        }
+        return this->solution_.at(variable);
+    }
+
+    std::size_t CplexLPSolver::getNumVariables() const
+    {
+        return this->variables_.getSize();
+    }
+
+    std::size_t CplexLPSolver::getNumConstraints() const
+    {
+        return this->constraints_.getSize() + this->num_indicators_;
+    }
+
+} // namespace sdm
+
+#endif
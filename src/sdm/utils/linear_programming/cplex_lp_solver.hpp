@@ -0,0 +1,58 @@
+#ifdef WITH_CPLEX
+
+#pragma once
+
+#include <ilcplex/ilocplex.h>
+#include <sdm/utils/linear_programming/lp_solver_interface.hpp>
+
+namespace sdm
+{
+    /**
+     * @class CplexLPSolver
+     *
+     * @brief Solve (mixed integer) linear programs with CPLEX.
+     *
+     * The model is extracted once, later modifications are tracked by CPLEX which restarts from
+     * the previous resolution.
+     */
+    class CplexLPSolver : public LPSolverInterface
+    {
+    public:
+        CplexLPSolver();
+        CplexLPSolver(const CplexLPSolver &) = delete;
+        ~CplexLPSolver();
+
+        std::size_t addVariable(const std::string &name, double lower_bound, double upper_bound, bool is_integer = false);
+        std::size_t addConstraint(const std::vector<Pair<std::size_t, double>> &coefficients, double lower_bound, double upper_bound);
+        void addIndicatorConstraint(std::size_t indicator, const std::vector<Pair<std::size_t, double>> &coefficients, double upper_bound);
+
+        void setObjectiveCoefficient(std::size_t variable, double coefficient);
+        void setVariableBounds(std::size_t variable, double lower_bound, double upper_bound);
+        void setConstraintBounds(std::size_t constraint, double lower_bound, double upper_bound);
+
+        bool maximize();
+
+        double getObjectiveValue() const;
+        double getValue(std::size_t variable) const;
+
+        std::size_t getNumVariables() const;
+        std::size_t getNumConstraints() const;
+
+    protected:
+        IloEnv env_;
+        IloModel model_;
+        IloNumVarArray variables_;
+        IloRangeArray constraints_;
+        IloObjective objective_;
+        IloCplex cplex_;
+        bool extracted_ = false;
+        std::size_t num_indicators_ = 0;
+
+        double objective_value_ = 0.;
+        std::vector<double> solution_;
+
+        static IloNum toCplex(double bound);
+    };
+} // namespace sdm
+
+#endif
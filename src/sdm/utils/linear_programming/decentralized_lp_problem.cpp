@@ -1,4 +1,3 @@
-#ifdef WITH_CPLEX
 #include <sdm/utils/linear_programming/decentralized_lp_problem.hpp>
 #include <sdm/core/action/joint_det_decision_rule.hpp>
 #include <sdm/core/state/interface/occupancy_state_interface.hpp>
@@ -9,7 +8,7 @@ namespace sdm
     DecentralizedLP::DecentralizedLP() {}
     DecentralizedLP::DecentralizedLP(const std::shared_ptr<SolvableByDP> &world) : IndividualLP(world) {}
 
-    void DecentralizedLP::createVariables(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, IloEnv &env, IloNumVarArray &var, number &index, number t)
+    void DecentralizedLP::createVariables(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, LPSolverInterface &lp, number t)
     {
         //Create Joint Decentralized Variable
         auto occupancy_state = state->toOccupancyState();
@@ -24,19 +23,18 @@ namespace sdm
             {
                 //< 0.b Build variables a(u|o)
                 VarName = this->getVarNameJointHistoryDecisionRule(action->toAction(), joint_history);
-                var.add(IloBoolVar(env, 0.0, 1.0, VarName.c_str()));
-                this->setNumber(VarName, index++);
+                this->setNumber(VarName, lp.addVariable(VarName, 0.0, 1.0, true));
             }
         }
 
         for (auto agent = 0; agent < getWorld()->getUnderlyingProblem()->getNumAgents(); ++agent)
         {
             //Create Individual Decentralized Variable
-            IndividualLP::createVariables(vf, state, env, var, index, t, agent);
+            IndividualLP::createVariables(vf, state, lp, t, agent);
         }
     }
 
-    void DecentralizedLP::createConstraints(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    void DecentralizedLP::createConstraints(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, LPSolverInterface &lp, number t)
     {
         auto underlying_problem = getWorld()->getUnderlyingProblem();
 
@@ -54,21 +52,20 @@ namespace sdm
                 auto joint_action = std::static_pointer_cast<JointAction>(action->toAction());
 
                 //<! 3.a set constraint a(u|o) >= \sum_i a_i(u_i|o_i) + 1 - n
-                con.add(IloRange(env, 1 - underlying_problem->getNumAgents(), +IloInfinity));
+                std::vector<Pair<std::size_t, double>> coefficients;
                 //<! 3.a.1 get variable a(u|o)
                 recover = this->getNumber(this->getVarNameJointHistoryDecisionRule(action->toAction(), jhistory->toJointHistory()));
                 //<! 3.a.2 set coefficient of variable a(u|o)
-                con[index].setLinearCoef(var[recover], +1.0);
+                coefficients.push_back({recover, +1.0});
 
                 for (number agent = 0; agent < underlying_problem->getNumAgents(); ++agent)
                 {
                     //<! 3.a.3 get variables a_i(u_i|o_i)
                     recover = this->getNumber(this->getVarNameIndividualHistoryDecisionRule(joint_action->get(agent), jhistory->getIndividualHistory(agent), agent));
                     //<! 3.a.4 set coefficient of variable a_i(u_i|o_i)
-                    con[index].setLinearCoef(var[recover], -1.0);
+                    coefficients.push_back({recover, -1.0});
                 } // for all agent
-                //<! increment constraints
-                index++;
+                lp.addConstraint(coefficients, 1.0 - underlying_problem->getNumAgents(), LPSolverInterface::INF);
             } // for all u
         }     // for all o
 
@@ -85,18 +82,12 @@ namespace sdm
                 // Go over agent
                 for (number agent = 0; agent < underlying_problem->getNumAgents(); ++agent)
                 {
-                    // set constraint range
-                    con.add(IloRange(env, -IloInfinity, 0.0));
                     //<! 3.b.1 get variable a(u|o)
-                    recover = this->getNumber(this->getVarNameJointHistoryDecisionRule(joint_action, jhistory));
-                    //<! 3.b.2 set coefficient of variable a(u|o)
-                    con[index].setLinearCoef(var[recover], +1.0);
+                    std::size_t joint_variable = this->getNumber(this->getVarNameJointHistoryDecisionRule(joint_action, jhistory));
                     //<! 3.b.3 get variable a_i(u_i|o_i) action
-                    recover = this->getNumber(this->getVarNameIndividualHistoryDecisionRule(joint_action->get(agent), jhistory->getIndividualHistory(agent), agent));
-                    //<! 3.b.4 set coefficient of variable a_i(u_i|o_i)
-                    con[index].setLinearCoef(var[recover], -1.0);
-                    //<! increment constraints
-                    index++;
+                    std::size_t individual_variable = this->getNumber(this->getVarNameIndividualHistoryDecisionRule(joint_action->get(agent), jhistory->getIndividualHistory(agent), agent));
+                    //<! 3.b.2 and 3.b.4 set coefficients of variables a(u|o) and a_i(u_i|o_i)
+                    lp.addConstraint({{joint_variable, +1.0}, {individual_variable, -1.0}}, -LPSolverInterface::INF, 0.0);
                 } // for all agent
             }     // for all u
         }         // for all o
@@ -104,23 +95,21 @@ namespace sdm
         for (number agent = 0; agent < underlying_problem->getNumAgents(); ++agent)
         {
             //Create Individual Decentralized Constraints
-            IndividualLP::createConstraints(vf, state, env, model, con, var, index, t, agent);
+            IndividualLP::createConstraints(vf, state, lp, t, agent);
         }
     }
 
-    std::shared_ptr<Action> DecentralizedLP::getVariableResult(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, const IloCplex &cplex, const IloNumVarArray &var, number t)
+    std::shared_ptr<Action> DecentralizedLP::getVariableResult(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, const LPSolverInterface &lp, number t)
     {
         std::vector<std::shared_ptr<DecisionRule>> actions;
 
         //Determine the element useful for create a JointDeterminiticDecisionRule
         for (number agent = 0; agent < this->getWorld()->getUnderlyingProblem()->getNumAgents(); agent++)
         {
-            actions.push_back(std::dynamic_pointer_cast<DeterministicDecisionRule>(IndividualLP::getVariableResult(vf, state, cplex, var, t, agent)));
+            actions.push_back(std::dynamic_pointer_cast<DeterministicDecisionRule>(IndividualLP::getVariableResult(vf, state, lp, t, agent)));
         }
         
         //Create the JointDeterminiticDecisionRule
         return std::make_shared<JointDeterministicDecisionRule>(actions, this->getWorld()->getUnderlyingProblem()->getActionSpace(t));
     }
 }
-
-#endif
@@ -1,5 +1,3 @@
-#ifdef WITH_CPLEX
-
 #pragma once
 
 #include <sdm/utils/linear_programming/individual_lp_problem.hpp>
@@ -17,35 +15,28 @@ namespace sdm
          * @brief Create the variable which will be used to resolve the LP
          * 
          * @param occupancy_state 
-         * @param env 
-         * @param var 
+         * @param lp 
          * @param t 
          */
-        void createVariables(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, IloEnv &env, IloNumVarArray &var,number &index, number t);
+        void createVariables(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t);
         
         /**
          * @brief Create the constraints of the LP
          * 
          * @param occupancy_state 
-         * @param env 
-         * @param con 
-         * @param var 
-         * @param index 
+         * @param lp 
          * @param t 
          */
-        void createConstraints(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State>& occupancy_state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t);
+        void createConstraints(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State>& occupancy_state, LPSolverInterface &lp, number t);
 
         /**
          * @brief Get the result of the variable created
          * 
          * @param occupancy_state 
-         * @param cplex 
-         * @param var 
+         * @param lp 
          * @param t 
          * @return std::shared_ptr<Action> 
          */
-        std::shared_ptr<Action> getVariableResult(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state,const IloCplex &cplex, const IloNumVarArray &var, number t);
+        std::shared_ptr<Action> getVariableResult(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, const LPSolverInterface &lp, number t);
     };
 }
-
-#endif
\ No newline at end of file
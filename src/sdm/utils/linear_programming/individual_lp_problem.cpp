@@ -1,4 +1,3 @@
-#ifdef WITH_CPLEX
 #include <sdm/utils/linear_programming/decentralized_lp_problem.hpp>
 
 #include <sdm/world/base/mmdp_interface.hpp>
@@ -13,7 +12,7 @@ namespace sdm
     IndividualLP::IndividualLP(const std::shared_ptr<SolvableByDP>& world) : LPBase(world) {}
 
 
-    void IndividualLP::createVariables(const std::shared_ptr<ValueFunctionInterface>&,const std::shared_ptr<State> &state, IloEnv &env, IloNumVarArray &var, number &index, number t, number agent_id)
+    void IndividualLP::createVariables(const std::shared_ptr<ValueFunctionInterface>&,const std::shared_ptr<State> &state, LPSolverInterface &lp, number t, number agent_id)
     {
         auto underlying_problem = std::dynamic_pointer_cast<MMDPInterface>(this->world_->getUnderlyingProblem());
         auto occupancy_state = state->toOccupancyState();
@@ -29,13 +28,12 @@ namespace sdm
             {
                 //<! 0.c Build variables a_i(u_i|o_i)
                 VarName = this->getVarNameIndividualHistoryDecisionRule(serial_action->toAction(), indiv_history, agent_id);
-                var.add(IloBoolVar(env, 0.0, 1.0, VarName.c_str()));
-                this->setNumber(VarName, index++);
+                this->setNumber(VarName, lp.addVariable(VarName, 0.0, 1.0, true));
             }
         }
     }
 
-    void IndividualLP::createConstraints(const std::shared_ptr<ValueFunctionInterface>&, const std::shared_ptr<State> &state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t, number agent_id)
+    void IndividualLP::createConstraints(const std::shared_ptr<ValueFunctionInterface>&, const std::shared_ptr<State> &state, LPSolverInterface &lp, number t, number agent_id)
     {
         auto underlying_problem = std::dynamic_pointer_cast<MMDPInterface>(this->world_->getUnderlyingProblem());
         auto occupancy_state = state->toOccupancyState();
@@ -46,18 +44,17 @@ namespace sdm
         for (const auto& indiv_history : occupancy_state->getIndividualHistories(agent_id))
         {
             //<! 4.a set constraint  \sum_{u_i} a_i(u_i|o_i) = 1
-            con.add(IloRange(env, 1.0, 1.0));
+            std::vector<Pair<std::size_t, double>> coefficients;
             for (const auto& serial_action : *underlying_problem->getActionSpace(agent_id,t))
             {
                 recover = this->getNumber(this->getVarNameIndividualHistoryDecisionRule(serial_action->toAction(), indiv_history, agent_id));
-                con[index].setLinearCoef(var[recover], +1.0);
+                coefficients.push_back({recover, +1.0});
             }
-            //<! increment constraints
-            index++;
+            lp.addConstraint(coefficients, 1.0, 1.0);
         }
     }
 
-    std::shared_ptr<Action> IndividualLP::getVariableResult(const std::shared_ptr<ValueFunctionInterface>&, const std::shared_ptr<State> &state,const IloCplex &cplex, const IloNumVarArray &var, number t, number agent_id)
+    std::shared_ptr<Action> IndividualLP::getVariableResult(const std::shared_ptr<ValueFunctionInterface>&, const std::shared_ptr<State> &state, const LPSolverInterface &lp, number t, number agent_id)
     {
         number index = 0;
         std::vector<std::shared_ptr<Item>> actions;
@@ -77,7 +74,7 @@ namespace sdm
                 index = this->getNumber(this->getVarNameIndividualHistoryDecisionRule(action->toAction(), ihistory, agent_id));
                 
                 // Add the variable in the vector only if the variable is true
-                if( cplex.getValue(var[index]) + .5 >= 1 )
+                if( lp.getValue(index) + .5 >= 1 )
                 {
                     actions.push_back(action);
                 }
@@ -88,4 +85,3 @@ namespace sdm
 
 
 }
-#endif
\ No newline at end of file
@@ -1,5 +1,3 @@
-#ifdef WITH_CPLEX
-
 #pragma once
 
 #include <sdm/utils/linear_programming/lp_problem.hpp>
@@ -17,36 +15,32 @@ namespace sdm
          * @brief Create the variable which will be used to resolve the LP
          * 
          * @param occupancy_state 
-         * @param env 
-         * @param var 
+         * @param lp 
          * @param t 
+         * @param agent_id 
          */
-        void createVariables(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, IloEnv &env, IloNumVarArray &var,number &index, number t, number agent_id);
+        void createVariables(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t, number agent_id);
         
         /**
          * @brief Create the constraints of the LP
          * 
          * @param occupancy_state 
-         * @param env 
-         * @param con 
-         * @param var 
-         * @param index 
+         * @param lp 
          * @param t 
+         * @param agent_id 
          */
-        void createConstraints(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State>& occupancy_state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t, number agent_id);
+        void createConstraints(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State>& occupancy_state, LPSolverInterface &lp, number t, number agent_id);
 
         /**
          * @brief Get the result of the variable created
          * 
          * @param occupancy_state 
-         * @param cplex 
-         * @param var 
+         * @param lp 
          * @param t 
+         * @param agent_id 
          * @return std::shared_ptr<Action> 
          */
-        std::shared_ptr<Action> getVariableResult(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state,const IloCplex &cplex, const IloNumVarArray &var, number t, number agent_id);
+        std::shared_ptr<Action> getVariableResult(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, const LPSolverInterface &lp, number t, number agent_id);
 
     };
 }
-
-#endif
\ No newline at end of file
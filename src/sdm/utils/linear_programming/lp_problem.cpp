@@ -1,10 +1,16 @@
-#ifdef WITH_CPLEX
-
-#include <ilcplex/ilocplex.h>
+#include <sdm/exception.hpp>
 #include <sdm/utils/linear_programming/lp_problem.hpp>
+#include <sdm/utils/linear_programming/simplex_lp_solver.hpp>
+#include <sdm/utils/linear_programming/cplex_lp_solver.hpp>
 
 namespace sdm
 {
+#ifdef WITH_CPLEX
+    std::string LPBase::LP_SOLVER = "cplex";
+#else
+    std::string LPBase::LP_SOLVER = "simplex";
+#endif
+
     LPBase::LPBase() {}
 
     LPBase::LPBase(const std::shared_ptr<SolvableByDP> &world) : world_(world) {}
@@ -16,80 +22,74 @@ namespace sdm
         return this->world_;
     }
 
-    Pair<std::shared_ptr<Action>, double> LPBase::createLP(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, number t)
+    std::shared_ptr<LPSolverInterface> LPBase::makeSolver(const std::string &name)
     {
-        number index = 0;
-
-        // clear the set of variable names
-        this->variables.clear();
-
-        //<! greedy decision, initialization
-        std::shared_ptr<Action> action;
-        double value;
-
-        IloEnv env;
-        try
+        if (name == "simplex")
         {
-            IloModel model(env);
-
-            // Init the model
-            IloRangeArray constraints(env);
-            IloNumVarArray variables(env);
-
-            IloObjective obj = IloMaximize(env);
-
-            ///////  BEGIN CORE CPLEX Code  ///////
-
-            // Create all Variable of the LP problem
-            this->createVariables(vf, state, env, variables, index, t);
-
-            // Create the objective function of the LP problem
-            this->createObjectiveFunction(vf, state, variables, obj, t);
+            return std::make_shared<SimplexLPSolver>();
+        }
+#ifdef WITH_CPLEX
+        if (name == "cplex")
+        {
+            return std::make_shared<CplexLPSolver>();
+        }
+#endif
+        throw sdm::exception::Exception("LP solver \"" + name + "\" is not available. Available LP solvers are : {\"simplex\"" +
+#ifdef WITH_CPLEX
+                                        std::string(" \"cplex\"") +
+#endif
+                                        "}");
+    }
 
-            index = 0;
+    bool LPBase::isModelReusable(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &, number) const
+    {
+        return false;
+    }
 
-            // Create all Constraints of the LP problem
-            this->createConstraints(vf, state, env, model, constraints, variables, index, t);
+    Pair<std::shared_ptr<Action>, double> LPBase::createLP(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, number t)
+    {
+        bool is_model_reused = (this->lp_ != nullptr) && this->isModelReusable(vf, state, t);
+        if (!is_model_reused)
+        {
+            this->buildModel(vf, state, t);
+        }
 
-            ///////  END CORE  CPLEX Code ///////
-            model.add(obj);
-            model.add(constraints);
-            IloCplex cplex(model);
-            cplex.setOut(env.getNullStream());
-            cplex.setWarning(env.getNullStream());
+        // Create the objective function of the LP problem
+        this->createObjectiveFunction(vf, state, *this->lp_, t);
 
-            // Optimize the problem and obtain solution
-            if (!cplex.solve())
-            {
-                env.error() << "Failed to optimize MILP" << std::endl;
-                cplex.exportModel("lb_bellman_op.lp");
-                system("cat lb_bellman_op.lp");
-            }
-            else
-            {
-                value = cplex.getObjValue();
-                action = this->getVariableResult(vf, state, cplex, variables, t);
-                // if (t >= 2)
-                // {
-                //     cplex.exportModel("lb_bellman_op.lp");
-                //     system("cat lb_bellman_op.lp");
-                // }
-            }
-        }
-        catch (IloException &e)
+        // Optimize the problem, a reused model is solved again from scratch if its warm start fails
+        bool is_solved = this->lp_->maximize();
+        if (!is_solved && is_model_reused)
         {
-            std::cerr << "Concert exception caught: " << e << std::endl;
+            this->buildModel(vf, state, t);
+            this->createObjectiveFunction(vf, state, *this->lp_, t);
+            is_solved = this->lp_->maximize();
         }
-        catch (const std::exception &exc)
+        if (!is_solved)
         {
-            // catch anything thrown within try block that derives from std::exception
-            std::cerr << "Non-Concert exception caught: " << exc.what() << std::endl;
+            this->lp_ = nullptr;
+            throw sdm::exception::Exception("LPBase::createLP : failed to optimize the linear program at time step " + std::to_string(t));
         }
 
-        env.end();
-
+        double value = this->lp_->getObjectiveValue();
+        std::shared_ptr<Action> action = this->getVariableResult(vf, state, *this->lp_, t);
         return std::make_pair(action, value);
     }
-}
 
-#endif
\ No newline at end of file
+    void LPBase::buildModel(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, number t)
+    {
+        // clear the set of variable names
+        this->variables.clear();
+
+        this->lp_ = LPBase::makeSolver();
+        this->lp_value_function_ = vf;
+        this->lp_state_ = state;
+        this->lp_time_step_ = t;
+
+        // Create all Variable of the LP problem
+        this->createVariables(vf, state, *this->lp_, t);
+
+        // Create all Constraints of the LP problem
+        this->createConstraints(vf, state, *this->lp_, t);
+    }
+}
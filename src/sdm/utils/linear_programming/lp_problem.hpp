@@ -1,4 +1,3 @@
-#ifdef WITH_CPLEX
 #pragma once
 #include <sdm/world/solvable_by_hsvi.hpp>
 #include <sdm/utils/linear_programming/variable_naming.hpp>
@@ -9,6 +8,11 @@ namespace sdm
     class LPBase : public LPInterface, public VarNaming
     {
     public:
+        /**
+         * @brief The name of the solver used for linear programs ("simplex" or "cplex").
+         */
+        static std::string LP_SOLVER;
+
         LPBase();
         LPBase(const std::shared_ptr<SolvableByDP> &);
         ~LPBase();
@@ -24,14 +28,43 @@ namespace sdm
          * @param occupancy_state the occupancy state
          * @param t the time step
          * @return the decision rule 
+         * @throw sdm::exception::Exception if the linear program cannot be solved
          */
         Pair<std::shared_ptr<Action>, double> createLP(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, number t);
 
+        /**
+         * @brief Create a solver for linear programs.
+         *
+         * @param name the name of the solver
+         */
+        static std::shared_ptr<LPSolverInterface> makeSolver(const std::string &name = LPBase::LP_SOLVER);
+
     protected:
         /**
          * @brief The world
          */
         std::shared_ptr<SolvableByDP> world_;
+
+        /**
+         * @brief The model built by the last call to createLP and what it was built for.
+         *
+         * The value function owns its action selection (hence this object), so that it is only observed.
+         */
+        std::shared_ptr<LPSolverInterface> lp_;
+        std::weak_ptr<ValueFunctionInterface> lp_value_function_;
+        std::shared_ptr<State> lp_state_;
+        number lp_time_step_ = 0;
+
+        /**
+         * @brief Build a new model (variables and constraints) for the linear program of a state.
+         */
+        void buildModel(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, number t);
+
+        /**
+         * @brief Whether the variables and constraints of the last model are those of the linear program of a state.
+         *
+         * In that case, only the objective function is written again and the solver restarts from its last resolution.
+         */
+        virtual bool isModelReusable(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, number t) const;
     };
 }
-#endif
\ No newline at end of file
@@ -1,11 +1,9 @@
-#ifdef WITH_CPLEX
-
 #pragma once
 
-#include <ilcplex/ilocplex.h>
 #include <sdm/core/action/action.hpp>
 #include <sdm/core/state/state.hpp>
 #include <sdm/utils/value_function/value_function.hpp>
+#include <sdm/utils/linear_programming/lp_solver_interface.hpp>
 
 
 namespace sdm
@@ -27,45 +25,37 @@ namespace sdm
          * @brief Create the variable which will be used to resolve the LP
          * 
          * @param occupancy_state 
-         * @param env 
-         * @param var 
+         * @param lp 
          * @param t 
          */
-        virtual void createVariables(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, IloEnv &env, IloNumVarArray &var,number &index, number t) = 0;
+        virtual void createVariables(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t) = 0;
         
         /**
          * @brief Create a Objective Constraint of the LP
          * 
          * @param occupancy_state 
-         * @param var 
-         * @param obj 
+         * @param lp 
          * @param t 
          */
-        virtual void createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, IloNumVarArray &var, IloObjective &obj, number t) = 0;
+        virtual void createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t) = 0;
         
         /**
          * @brief Create the constraints of the LP
          * 
          * @param occupancy_state 
-         * @param env 
-         * @param con 
-         * @param var 
-         * @param index 
+         * @param lp 
          * @param t 
          */
-        virtual void createConstraints(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State>& occupancy_state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t) = 0;
+        virtual void createConstraints(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State>& occupancy_state, LPSolverInterface &lp, number t) = 0;
 
         /**
          * @brief Get the result of the variable created
          * 
          * @param occupancy_state 
-         * @param cplex 
-         * @param var 
+         * @param lp 
          * @param t 
          * @return std::shared_ptr<Action> 
          */
-        virtual std::shared_ptr<Action> getVariableResult(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state,const IloCplex &cplex, const IloNumVarArray &var, number t) =0;
+        virtual std::shared_ptr<Action> getVariableResult(const std::shared_ptr<ValueFunctionInterface>&vf, const std::shared_ptr<State> &occupancy_state, const LPSolverInterface &lp, number t) =0;
     };
 }
-
-#endif
\ No newline at end of file
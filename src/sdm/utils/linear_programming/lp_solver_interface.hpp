@@ -0,0 +1,92 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <sdm/utils/struct/pair.hpp>
+
+namespace sdm
+{
+    /**
+     * @class LPSolverInterface
+     *
+     * @brief A (mixed integer) linear program that is solved by some backend.
+     *
+     * The model is persistent : once built, objective coefficients and bounds can be modified and
+     * the program solved again. Backends use this to warm-start from the previous resolution.
+     */
+    class LPSolverInterface
+    {
+    public:
+        static constexpr double INF = std::numeric_limits<double>::infinity();
+
+        virtual ~LPSolverInterface() {}
+
+        /**
+         * @brief Add a variable to the model.
+         *
+         * @param name the name of the variable
+         * @param lower_bound the lower bound (can be -INF)
+         * @param upper_bound the upper bound (can be +INF)
+         * @param is_integer whether the variable must take an integer value
+         * @return the index of the variable
+         */
+        virtual std::size_t addVariable(const std::string &name, double lower_bound, double upper_bound, bool is_integer = false) = 0;
+
+        /**
+         * @brief Add a constraint lower_bound <= sum_i coefficient_i * x_i <= upper_bound.
+         *
+         * @param coefficients the pairs (variable, coefficient)
+         * @param lower_bound the lower bound (can be -INF)
+         * @param upper_bound the upper bound (can be +INF)
+         * @return the index of the constraint
+         */
+        virtual std::size_t addConstraint(const std::vector<Pair<std::size_t, double>> &coefficients, double lower_bound, double upper_bound) = 0;
+
+        /**
+         * @brief Add a constraint sum_i coefficient_i * x_i <= upper_bound that only holds when a binary variable is set to 1.
+         *
+         * @param indicator the binary variable
+         * @param coefficients the pairs (variable, coefficient)
+         * @param upper_bound the upper bound
+         */
+        virtual void addIndicatorConstraint(std::size_t indicator, const std::vector<Pair<std::size_t, double>> &coefficients, double upper_bound) = 0;
+
+        /**
+         * @brief Set the coefficient of a variable in the objective function (0 by default).
+         */
+        virtual void setObjectiveCoefficient(std::size_t variable, double coefficient) = 0;
+
+        /**
+         * @brief Set the bounds of a variable.
+         */
+        virtual void setVariableBounds(std::size_t variable, double lower_bound, double upper_bound) = 0;
+
+        /**
+         * @brief Set the bounds of a constraint.
+         */
+        virtual void setConstraintBounds(std::size_t constraint, double lower_bound, double upper_bound) = 0;
+
+        /**
+         * @brief Maximize the objective function.
+         *
+         * @return true if an optimal solution was found
+         */
+        virtual bool maximize() = 0;
+
+        /**
+         * @brief Get the value of the objective function at the solution of the last resolution.
+         */
+        virtual double getObjectiveValue() const = 0;
+
+        /**
+         * @brief Get the value of a variable in the solution of the last resolution.
+         */
+        virtual double getValue(std::size_t variable) const = 0;
+
+        virtual std::size_t getNumVariables() const = 0;
+        virtual std::size_t getNumConstraints() const = 0;
+    };
+} // namespace sdm
@@ -0,0 +1,257 @@
+#include <cmath>
+#include <algorithm>
+
+#include <sdm/exception.hpp>
+#include <sdm/utils/linear_programming/simplex_lp_solver.hpp>
+
+namespace sdm
+{
+    SimplexLPSolver::SimplexLPSolver(double precision) : precision_(precision), simplex_(precision)
+    {
+    }
+
+    std::size_t SimplexLPSolver::addVariable(const std::string &, double lower_bound, double upper_bound, bool is_integer)
+    {
+        this->variables_.push_back({lower_bound, upper_bound, 0., is_integer});
+        this->indicators_by_variable_.emplace_back();
+        this->model_changed_ = true;
+        return this->variables_.size() - 1;
+    }
+
+    std::size_t SimplexLPSolver::addConstraint(const std::vector<Pair<std::size_t, double>> &coefficients, double lower_bound, double upper_bound)
+    {
+        this->constraints_.push_back({coefficients, lower_bound, upper_bound, NONE, NONE});
+        this->model_changed_ = true;
+        return this->constraints_.size() - 1;
+    }
+
+    void SimplexLPSolver::addIndicatorConstraint(std::size_t indicator, const std::vector<Pair<std::size_t, double>> &coefficients, double upper_bound)
+    {
+        this->indicators_by_variable_.at(indicator).push_back(this->indicators_.size());
+        this->indicators_.push_back({indicator, coefficients, upper_bound, NONE});
+        this->model_changed_ = true;
+    }
+
+    void SimplexLPSolver::setObjectiveCoefficient(std::size_t variable, double coefficient)
+    {
+        this->variables_.at(variable).objective = coefficient;
+        if (!this->model_changed_)
+        {
+            this->simplex_.setObjective(variable, coefficient);
+        }
+    }
+
+    void SimplexLPSolver::setVariableBounds(std::size_t variable, double lower_bound, double upper_bound)
+    {
+        this->variables_.at(variable).lower_bound = lower_bound;
+        this->variables_.at(variable).upper_bound = upper_bound;
+        if (!this->model_changed_)
+        {
+            this->setNodeBounds(variable, lower_bound, upper_bound);
+        }
+    }
+
+    void SimplexLPSolver::setConstraintBounds(std::size_t constraint, double lower_bound, double upper_bound)
+    {
+        auto &current = this->constraints_.at(constraint);
+        bool same_rows = ((current.lower_bound == current.upper_bound) == (lower_bound == upper_bound)) &&
+                         (std::isfinite(current.lower_bound) == std::isfinite(lower_bound)) &&
+                         (std::isfinite(current.upper_bound) == std::isfinite(upper_bound));
+        current.lower_bound = lower_bound;
+        current.upper_bound = upper_bound;
+
+        if (!same_rows)
+        {
+            this->model_changed_ = true;
+        }
+        else if (!this->model_changed_)
+        {
+            if (current.lower_row != NONE)
+            {
+                this->simplex_.setRhs(current.lower_row, lower_bound);
+            }
+            if (current.upper_row != NONE)
+            {
+                this->simplex_.setRhs(current.upper_row, upper_bound);
+            }
+        }
+    }
+
+    void SimplexLPSolver::buildSimplex()
+    {
+        this->simplex_ = SimplexSolver(this->precision_);
+        this->node_bounds_.clear();
+        for (const auto &variable : this->variables_)
+        {
+            this->simplex_.addVariable(variable.objective, variable.lower_bound, variable.upper_bound);
+            this->node_bounds_.push_back({variable.lower_bound, variable.upper_bound});
+        }
+
+        std::size_t num_rows = 0;
+        for (auto &constraint : this->constraints_)
+        {
+            constraint.lower_row = constraint.upper_row = NONE;
+            if (constraint.lower_bound == constraint.upper_bound)
+            {
+                this->simplex_.addConstraint(constraint.coefficients, SimplexSolver::EQUAL, constraint.lower_bound);
+                constraint.lower_row = constraint.upper_row = num_rows++;
+                continue;
+            }
+            if (std::isfinite(constraint.lower_bound))
+            {
+                this->simplex_.addConstraint(constraint.coefficients, SimplexSolver::GREATER_EQUAL, constraint.lower_bound);
+                constraint.lower_row = num_rows++;
+            }
+            if (std::isfinite(constraint.upper_bound))
+            {
+                this->simplex_.addConstraint(constraint.coefficients, SimplexSolver::LESS_EQUAL, constraint.upper_bound);
+                constraint.upper_row = num_rows++;
+            }
+        }
+
+        for (auto &indicator : this->indicators_)
+        {
+            bool enforced = (this->variables_[indicator.indicator].lower_bound >= 1. - INTEGRALITY);
+            indicator.slack = this->simplex_.addVariable(0., 0., enforced ? 0. : INF);
+            auto coefficients = indicator.coefficients;
+            coefficients.push_back({indicator.slack, -1.});
+            this->simplex_.addConstraint(coefficients, SimplexSolver::LESS_EQUAL, indicator.upper_bound);
+        }
+        this->model_changed_ = false;
+    }
+
+    void SimplexLPSolver::setNodeBounds(std::size_t variable, double lower_bound, double upper_bound)
+    {
+        this->node_bounds_[variable] = {lower_bound, upper_bound};
+        this->simplex_.setBounds(variable, lower_bound, upper_bound);
+
+        bool enforced = (lower_bound >= 1. - INTEGRALITY);
+        for (const auto &i : this->indicators_by_variable_[variable])
+        {
+            this->simplex_.setBounds(this->indicators_[i].slack, 0., enforced ? 0. : INF);
+        }
+    }
+
+    bool SimplexLPSolver::maximize()
+    {
+        if (this->model_changed_)
+        {
+            this->buildSimplex();
+        }
+        this->solution_.clear();
+        this->num_nodes_ = 0;
+        this->branch();
+        return !this->solution_.empty();
+    }
+
+    void SimplexLPSolver::branch()
+    {
+        this->num_nodes_++;
+        if (this->simplex_.maximize() != SimplexSolver::OPTIMAL)
+        {
+            return;
+        }
+
+        // Prune nodes whose relaxation cannot improve the best solution
+        double bound = this->simplex_.getObjectiveValue();
+        if (!this->solution_.empty() && (bound <= this->objective_value_ + this->precision_ * std::max(1., std::abs(this->objective_value_))))
+        {
+            return;
+        }
+
+        // Branch on the most fractional integer variable
+        std::size_t branching = NONE;
+        double value = 0., down = 0., up = 1., largest_fraction = INTEGRALITY;
+        for (std::size_t v = 0; v < this->variables_.size(); v++)
+        {
+            if (this->variables_[v].is_integer)
+            {
+                double x = this->simplex_.getValue(v), fraction = std::abs(x - std::round(x));
+                if (fraction > largest_fraction)
+                {
+                    branching = v;
+                    value = x;
+                    largest_fraction = fraction;
+                }
+            }
+        }
+        if (branching != NONE)
+        {
+            down = std::floor(value);
+            up = std::ceil(value);
+        }
+        else
+        {
+            // Otherwise branch on the binary variable of a violated indicator constraint
+            for (const auto &indicator : this->indicators_)
+            {
+                if ((this->simplex_.getValue(indicator.indicator) > INTEGRALITY) && (this->simplex_.getValue(indicator.slack) > this->precision_ * std::max(1., std::abs(indicator.upper_bound))))
+                {
+                    branching = indicator.indicator;
+                    value = this->simplex_.getValue(branching);
+                    break;
+                }
+            }
+        }
+
+        if (branching == NONE)
+        {
+            // The relaxation is a solution of the program
+            this->objective_value_ = bound;
+            this->solution_.resize(this->variables_.size());
+            for (std::size_t v = 0; v < this->variables_.size(); v++)
+            {
+                this->solution_[v] = this->simplex_.getValue(v);
+            }
+            return;
+        }
+
+        // Explore the closest side first
+        auto bounds = this->node_bounds_[branching];
+        bool up_first = (value - down > 0.5);
+        for (bool up_side : {up_first, !up_first})
+        {
+            if (up_side && (up <= bounds.second))
+            {
+                this->setNodeBounds(branching, up, bounds.second);
+                this->branch();
+            }
+            else if (!up_side && (down >= bounds.first))
+            {
+                this->setNodeBounds(branching, bounds.first, down);
+                this->branch();
+            }
+        }
+        this->setNodeBounds(branching, bounds.first, bounds.second);
+    }
+
+    double SimplexLPSolver::getObjectiveValue() const
+    {
+        return this->objective_value_;
+    }
+
+    double SimplexLPSolver::getValue(std::size_t variable) const
+    {
+        if (this->solution_.empty())
+        {
+            throw sdm::exception::Exception("SimplexLPSolver::getValue : no solution was found");
+        }
+        return this->solution_.at(variable);
+    }
+
+    std::size_t SimplexLPSolver::getNumVariables() const
+    {
+        return this->variables_.size();
+    }
+
+    std::size_t SimplexLPSolver::getNumConstraints() const
+    {
+        return this->constraints_.size() + this->indicators_.size();
+    }
+
+    std::size_t SimplexLPSolver::getNumNodes() const
+    {
+        return this->num_nodes_;
+    }
+
+} // namespace sdm
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+
+#include <sdm/utils/linear_programming/simplex_solver.hpp>
+#include <sdm/utils/linear_programming/lp_solver_interface.hpp>
+
+namespace sdm
+{
+    /**
+     * @class SimplexLPSolver
+     *
+     * @brief Solve (mixed integer) linear programs with the self-contained SimplexSolver.
+     *
+     * Integer variables and indicator constraints are handled by a depth-first branch and bound.
+     * Each node only changes bounds of variables, so that its relaxation is warm-started from the
+     * basis of the previously solved node. The same holds between two calls to maximize() as long
+     * as only objective coefficients and bounds are modified.
+     *
+     * An indicator constraint a.x <= b is relaxed into a.x - s <= b with a slack s >= 0 that is
+     * fixed to zero once the binary variable is fixed to 1.
+     */
+    class SimplexLPSolver : public LPSolverInterface
+    {
+    public:
+        SimplexLPSolver(double precision = 1e-9);
+
+        std::size_t addVariable(const std::string &name, double lower_bound, double upper_bound, bool is_integer = false);
+        std::size_t addConstraint(const std::vector<Pair<std::size_t, double>> &coefficients, double lower_bound, double upper_bound);
+        void addIndicatorConstraint(std::size_t indicator, const std::vector<Pair<std::size_t, double>> &coefficients, double upper_bound);
+
+        void setObjectiveCoefficient(std::size_t variable, double coefficient);
+        void setVariableBounds(std::size_t variable, double lower_bound, double upper_bound);
+        void setConstraintBounds(std::size_t constraint, double lower_bound, double upper_bound);
+
+        bool maximize();
+
+        double getObjectiveValue() const;
+        double getValue(std::size_t variable) const;
+
+        std::size_t getNumVariables() const;
+        std::size_t getNumConstraints() const;
+
+        /**
+         * @brief Get the number of nodes of the branch and bound during the last resolution.
+         */
+        std::size_t getNumNodes() const;
+
+    protected:
+        static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+        /** @brief Values closer than this to an integer are considered integer. */
+        static constexpr double INTEGRALITY = 1e-6;
+
+        struct Variable
+        {
+            double lower_bound, upper_bound, objective;
+            bool is_integer;
+        };
+
+        /** @brief Each finite side of a constraint is a row of the simplex (the same row for an equality). */
+        struct Constraint
+        {
+            std::vector<Pair<std::size_t, double>> coefficients;
+            double lower_bound, upper_bound;
+            std::size_t lower_row, upper_row;
+        };
+
+        struct Indicator
+        {
+            std::size_t indicator;
+            std::vector<Pair<std::size_t, double>> coefficients;
+            double upper_bound;
+            std::size_t slack;
+        };
+
+        double precision_;
+
+        std::vector<Variable> variables_;
+        std::vector<Constraint> constraints_;
+        std::vector<Indicator> indicators_;
+
+        /** @brief The indicator constraints of each variable. */
+        std::vector<std::vector<std::size_t>> indicators_by_variable_;
+
+        SimplexSolver simplex_;
+        bool model_changed_ = true;
+
+        // Bounds of variables at the current node of the branch and bound
+        std::vector<Pair<double, double>> node_bounds_;
+
+        // Best solution found
+        double objective_value_ = 0.;
+        std::vector<double> solution_;
+        std::size_t num_nodes_ = 0;
+
+        /**
+         * @brief Build the simplex from the model.
+         */
+        void buildSimplex();
+
+        /**
+         * @brief Set bounds of a variable in the current node (and enforce its indicator constraints if fixed to 1).
+         */
+        void setNodeBounds(std::size_t variable, double lower_bound, double upper_bound);
+
+        /**
+         * @brief Explore the subtree of the current node.
+         */
+        void branch();
+    };
+} // namespace sdm
@@ -0,0 +1,518 @@
+#include <cmath>
+#include <algorithm>
+
+#include <sdm/exception.hpp>
+#include <sdm/utils/linear_programming/simplex_solver.hpp>
+
+namespace sdm
+{
+    SimplexSolver::SimplexSolver(double precision, std::size_t max_iterations) : precision_(precision), max_iterations_(max_iterations)
+    {
+    }
+
+    std::size_t SimplexSolver::addVariable(double objective, double lower_bound, double upper_bound)
+    {
+        if (lower_bound > upper_bound)
+        {
+            throw sdm::exception::Exception("SimplexSolver::addVariable : lower bound greater than upper bound");
+        }
+        this->variables_.push_back({objective, lower_bound, upper_bound});
+        this->structure_changed_ = true;
+        return this->variables_.size() - 1;
+    }
+
+    void SimplexSolver::addConstraint(const std::vector<Pair<std::size_t, double>> &coefficients, Sense sense, double rhs)
+    {
+        for (const auto &coefficient : coefficients)
+        {
+            if (coefficient.first >= this->variables_.size())
+            {
+                throw sdm::exception::Exception("SimplexSolver::addConstraint : unknown variable " + std::to_string(coefficient.first));
+            }
+        }
+        this->constraints_.push_back({coefficients, sense, rhs});
+        this->structure_changed_ = true;
+    }
+
+    void SimplexSolver::setObjective(std::size_t variable, double objective)
+    {
+        this->variables_.at(variable).objective = objective;
+    }
+
+    void SimplexSolver::setBounds(std::size_t variable, double lower_bound, double upper_bound)
+    {
+        if (lower_bound > upper_bound)
+        {
+            throw sdm::exception::Exception("SimplexSolver::setBounds : lower bound greater than upper bound");
+        }
+        auto &current = this->variables_.at(variable);
+        if ((std::isfinite(current.lower_bound) != std::isfinite(lower_bound)) || (std::isfinite(current.upper_bound) != std::isfinite(upper_bound)))
+        {
+            this->structure_changed_ = true;
+        }
+        current.lower_bound = lower_bound;
+        current.upper_bound = upper_bound;
+    }
+
+    void SimplexSolver::setRhs(std::size_t constraint, double rhs)
+    {
+        this->constraints_.at(constraint).rhs = rhs;
+    }
+
+    double &SimplexSolver::at(std::size_t row, std::size_t column)
+    {
+        return this->tableau_[row * (this->num_columns_ + 1) + column];
+    }
+
+    void SimplexSolver::pivot(std::size_t row, std::size_t column)
+    {
+        std::size_t stride = this->num_columns_ + 1;
+        double *pivot_row = &this->tableau_[row * stride];
+        double pivot_value = pivot_row[column];
+        for (std::size_t j = 0; j < stride; j++)
+        {
+            pivot_row[j] /= pivot_value;
+        }
+
+        // The reduced costs (last row) are updated as any other row
+        for (std::size_t i = 0; i <= this->num_rows_; i++)
+        {
+            double *current_row = &this->tableau_[i * stride];
+            double factor = current_row[column];
+            if (i == row || factor == 0.)
+            {
+                continue;
+            }
+            for (std::size_t j = 0; j < stride; j++)
+            {
+                current_row[j] -= factor * pivot_row[j];
+            }
+        }
+        this->basis_[row] = column;
+    }
+
+    void SimplexSolver::computeReducedCosts(const std::vector<double> &costs)
+    {
+        // z_j = sum_i c_{B(i)} T[i][j] - c_j, the last entry is the value of the objective
+        for (std::size_t j = 0; j <= this->num_columns_; j++)
+        {
+            double value = (j < this->num_columns_) ? -costs[j] : 0.;
+            for (std::size_t i = 0; i < this->num_rows_; i++)
+            {
+                value += costs[this->basis_[i]] * this->at(i, j);
+            }
+            this->at(this->num_rows_, j) = value;
+        }
+    }
+
+    SimplexSolver::Status SimplexSolver::optimize(std::size_t num_allowed_columns)
+    {
+        std::size_t num_degenerate_pivots = 0;
+        while (true)
+        {
+            bool use_bland = (num_degenerate_pivots > 50);
+
+            // Choose the entering column
+            std::size_t entering = num_allowed_columns;
+            double best_reduced_cost = -this->precision_;
+            for (std::size_t j = 0; j < num_allowed_columns; j++)
+            {
+                double reduced_cost = this->at(this->num_rows_, j);
+                if (reduced_cost < best_reduced_cost)
+                {
+                    entering = j;
+                    best_reduced_cost = reduced_cost;
+                    if (use_bland)
+                        break;
+                }
+            }
+            if (entering == num_allowed_columns)
+            {
+                return OPTIMAL;
+            }
+
+            // Choose the leaving row (ratio test)
+            std::size_t leaving = this->num_rows_;
+            double best_ratio = INF;
+            for (std::size_t i = 0; i < this->num_rows_; i++)
+            {
+                double coefficient = this->at(i, entering);
+                if (coefficient > this->precision_)
+                {
+                    double ratio = this->at(i, this->num_columns_) / coefficient;
+                    if ((ratio < best_ratio - this->precision_) || ((ratio < best_ratio + this->precision_) && (leaving < this->num_rows_) && (this->basis_[i] < this->basis_[leaving])))
+                    {
+                        leaving = i;
+                        best_ratio = ratio;
+                    }
+                }
+            }
+            if (leaving == this->num_rows_)
+            {
+                return UNBOUNDED;
+            }
+
+            if (++this->num_iterations_ > this->max_iterations_)
+            {
+                throw sdm::exception::Exception("SimplexSolver::maximize : maximal number of iterations reached");
+            }
+            num_degenerate_pivots = (best_ratio <= this->precision_) ? num_degenerate_pivots + 1 : 0;
+            this->pivot(leaving, entering);
+        }
+    }
+
+    std::vector<SimplexSolver::Constraint> SimplexSolver::buildRows(std::size_t &num_structural_columns)
+    {
+        // Write each variable with non-negative columns
+        this->mappings_.clear();
+        std::vector<Constraint> rows;
+        num_structural_columns = 0;
+        for (const auto &variable : this->variables_)
+        {
+            ColumnMapping mapping;
+            if (std::isfinite(variable.lower_bound))
+            {
+                // x = lb + y
+                mapping = {variable.lower_bound, {{num_structural_columns++, 1.}}};
+                if (std::isfinite(variable.upper_bound))
+                {
+                    rows.push_back({{mapping.columns[0]}, LESS_EQUAL, variable.upper_bound - variable.lower_bound});
+                }
+            }
+            else if (std::isfinite(variable.upper_bound))
+            {
+                // x = ub - y
+                mapping = {variable.upper_bound, {{num_structural_columns++, -1.}}};
+            }
+            else
+            {
+                // x = y+ - y-
+                mapping = {0., {{num_structural_columns, 1.}, {num_structural_columns + 1, -1.}}};
+                num_structural_columns += 2;
+            }
+            this->mappings_.push_back(mapping);
+        }
+
+        // Write constraints over columns
+        for (const auto &constraint : this->constraints_)
+        {
+            Constraint row{{}, constraint.sense, constraint.rhs};
+            for (const auto &coefficient : constraint.coefficients)
+            {
+                const auto &mapping = this->mappings_[coefficient.first];
+                row.rhs -= coefficient.second * mapping.offset;
+                for (const auto &column : mapping.columns)
+                {
+                    row.coefficients.push_back({column.first, coefficient.second * column.second});
+                }
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    std::vector<double> SimplexSolver::buildCosts(double &constant) const
+    {
+        std::vector<double> costs(this->num_columns_, 0.);
+        constant = 0.;
+        for (std::size_t v = 0; v < this->variables_.size(); v++)
+        {
+            constant += this->variables_[v].objective * this->mappings_[v].offset;
+            for (const auto &column : this->mappings_[v].columns)
+            {
+                costs[column.first] += this->variables_[v].objective * column.second;
+            }
+        }
+        return costs;
+    }
+
+    void SimplexSolver::storeSolution(double constant)
+    {
+        this->column_values_.assign(this->num_columns_, 0.);
+        for (std::size_t i = 0; i < this->num_rows_; i++)
+        {
+            this->column_values_[this->basis_[i]] = this->at(i, this->num_columns_);
+        }
+        this->objective_value_ = this->at(this->num_rows_, this->num_columns_) + constant;
+    }
+
+    SimplexSolver::Status SimplexSolver::maximize()
+    {
+        this->num_iterations_ = 0;
+
+        Status status;
+        this->warm_started_ = this->warmStart(status);
+        if (!this->warm_started_)
+        {
+            status = this->coldStart();
+        }
+        return status;
+    }
+
+    SimplexSolver::Status SimplexSolver::coldStart()
+    {
+        this->has_basis_ = false;
+        this->num_warm_starts_ = 0;
+
+        std::size_t num_structural_columns;
+        std::vector<Constraint> rows = this->buildRows(num_structural_columns);
+
+        // Make right hand sides non-negative
+        std::size_t num_slacks = 0, num_artificials = 0;
+        this->row_signs_.assign(rows.size(), 1.);
+        for (std::size_t i = 0; i < rows.size(); i++)
+        {
+            auto &row = rows[i];
+            if (row.rhs < 0)
+            {
+                row.rhs = -row.rhs;
+                for (auto &coefficient : row.coefficients)
+                {
+                    coefficient.second = -coefficient.second;
+                }
+                row.sense = (row.sense == LESS_EQUAL) ? GREATER_EQUAL : ((row.sense == GREATER_EQUAL) ? LESS_EQUAL : EQUAL);
+                this->row_signs_[i] = -1.;
+            }
+            num_slacks += (row.sense != EQUAL);
+            num_artificials += (row.sense != LESS_EQUAL);
+        }
+
+        // Build the tableau : [structural columns | slack columns | artificial columns | rhs]
+        this->num_rows_ = rows.size();
+        this->num_columns_ = num_structural_columns + num_slacks + num_artificials;
+        this->first_artificial_ = num_structural_columns + num_slacks;
+        this->tableau_.assign((this->num_rows_ + 1) * (this->num_columns_ + 1), 0.);
+        this->basis_.assign(this->num_rows_, 0);
+        this->row_rhs_.assign(this->num_rows_, 0.);
+        this->identity_columns_.assign(this->num_rows_, 0);
+
+        std::size_t slack = num_structural_columns, artificial = this->first_artificial_;
+        for (std::size_t i = 0; i < this->num_rows_; i++)
+        {
+            for (const auto &coefficient : rows[i].coefficients)
+            {
+                this->at(i, coefficient.first) += coefficient.second;
+            }
+            this->at(i, this->num_columns_) = rows[i].rhs;
+            this->row_rhs_[i] = rows[i].rhs;
+            if (rows[i].sense == LESS_EQUAL)
+            {
+                this->at(i, slack) = 1.;
+                this->basis_[i] = slack++;
+            }
+            else
+            {
+                if (rows[i].sense == GREATER_EQUAL)
+                {
+                    this->at(i, slack++) = -1.;
+                }
+                this->at(i, artificial) = 1.;
+                this->basis_[i] = artificial++;
+            }
+            this->identity_columns_[i] = this->basis_[i];
+        }
+        this->structure_changed_ = false;
+
+        // Phase 1 : find a feasible basis by minimizing the sum of artificial variables
+        if (num_artificials > 0)
+        {
+            std::vector<double> costs(this->num_columns_, 0.);
+            for (std::size_t j = this->first_artificial_; j < this->num_columns_; j++)
+            {
+                costs[j] = -1.;
+            }
+            this->computeReducedCosts(costs);
+            this->optimize(this->num_columns_);
+            if (this->at(this->num_rows_, this->num_columns_) < -this->precision_ * std::max(1., double(this->num_rows_)))
+            {
+                return INFEASIBLE;
+            }
+
+            // Drive remaining artificial variables (at zero) out of the basis
+            for (std::size_t i = 0; i < this->num_rows_; i++)
+            {
+                if (this->basis_[i] >= this->first_artificial_)
+                {
+                    for (std::size_t j = 0; j < this->first_artificial_; j++)
+                    {
+                        if (std::abs(this->at(i, j)) > this->precision_)
+                        {
+                            this->pivot(i, j);
+                            break;
+                        }
+                    }
+                    // Otherwise the row is redundant and its artificial variable stays at zero
+                }
+            }
+        }
+        this->has_basis_ = true;
+
+        // Phase 2 : optimize the objective function over non-artificial columns
+        double constant;
+        this->computeReducedCosts(this->buildCosts(constant));
+        Status status = this->optimize(this->first_artificial_);
+        if (status == OPTIMAL)
+        {
+            this->storeSolution(constant);
+        }
+        return status;
+    }
+
+    bool SimplexSolver::warmStart(Status &status)
+    {
+        if (!this->has_basis_ || this->structure_changed_ || this->num_warm_starts_ >= MAX_WARM_STARTS)
+        {
+            return false;
+        }
+
+        // Move right hand sides : B^-1 (b' - b) is read in the columns of the initial identity
+        std::size_t num_structural_columns;
+        std::vector<Constraint> rows = this->buildRows(num_structural_columns);
+        for (std::size_t i = 0; i < this->num_rows_; i++)
+        {
+            double delta = this->row_signs_[i] * rows[i].rhs - this->row_rhs_[i];
+            if (delta != 0.)
+            {
+                std::size_t column = this->identity_columns_[i];
+                for (std::size_t r = 0; r < this->num_rows_; r++)
+                {
+                    this->at(r, this->num_columns_) += delta * this->at(r, column);
+                }
+                this->row_rhs_[i] += delta;
+            }
+        }
+
+        bool primal_feasible = true;
+        for (std::size_t r = 0; r < this->num_rows_; r++)
+        {
+            double &rhs = this->at(r, this->num_columns_);
+            if ((this->basis_[r] >= this->first_artificial_) && (std::abs(rhs) > this->precision_))
+            {
+                // A redundant row became inconsistent
+                return false;
+            }
+            if (rhs < -this->precision_)
+            {
+                primal_feasible = false;
+            }
+            else if (rhs < 0.)
+            {
+                rhs = 0.;
+            }
+        }
+
+        double constant;
+        this->computeReducedCosts(this->buildCosts(constant));
+        if (!primal_feasible)
+        {
+            // The dual simplex needs reduced costs of the last basis to remain optimal for the new objective
+            for (std::size_t j = 0; j < this->first_artificial_; j++)
+            {
+                if (this->at(this->num_rows_, j) < -this->precision_)
+                {
+                    return false;
+                }
+            }
+            if (this->dualOptimize() == INFEASIBLE)
+            {
+                this->num_warm_starts_++;
+                status = INFEASIBLE;
+                return true;
+            }
+        }
+
+        this->num_warm_starts_++;
+        status = this->optimize(this->first_artificial_);
+        if (status == OPTIMAL)
+        {
+            this->storeSolution(constant);
+        }
+        return true;
+    }
+
+    SimplexSolver::Status SimplexSolver::dualOptimize()
+    {
+        while (true)
+        {
+            // Choose the leaving row (most negative right hand side)
+            std::size_t leaving = this->num_rows_;
+            double most_negative = -this->precision_;
+            for (std::size_t i = 0; i < this->num_rows_; i++)
+            {
+                if (this->at(i, this->num_columns_) < most_negative)
+                {
+                    leaving = i;
+                    most_negative = this->at(i, this->num_columns_);
+                }
+            }
+            if (leaving == this->num_rows_)
+            {
+                return OPTIMAL;
+            }
+
+            // Choose the entering column (ratio test over reduced costs)
+            std::size_t entering = this->first_artificial_;
+            double best_ratio = INF;
+            for (std::size_t j = 0; j < this->first_artificial_; j++)
+            {
+                double coefficient = this->at(leaving, j);
+                if (coefficient < -this->precision_)
+                {
+                    double ratio = std::max(0., this->at(this->num_rows_, j)) / -coefficient;
+                    if (ratio < best_ratio)
+                    {
+                        entering = j;
+                        best_ratio = ratio;
+                    }
+                }
+            }
+            if (entering == this->first_artificial_)
+            {
+                return INFEASIBLE;
+            }
+
+            if (++this->num_iterations_ > this->max_iterations_)
+            {
+                throw sdm::exception::Exception("SimplexSolver::maximize : maximal number of iterations reached");
+            }
+            this->pivot(leaving, entering);
+        }
+    }
+
+    double SimplexSolver::getObjectiveValue() const
+    {
+        return this->objective_value_;
+    }
+
+    double SimplexSolver::getValue(std::size_t variable) const
+    {
+        const auto &mapping = this->mappings_.at(variable);
+        double value = mapping.offset;
+        for (const auto &column : mapping.columns)
+        {
+            value += column.second * this->column_values_.at(column.first);
+        }
+        return value;
+    }
+
+    std::size_t SimplexSolver::getNumVariables() const
+    {
+        return this->variables_.size();
+    }
+
+    std::size_t SimplexSolver::getNumConstraints() const
+    {
+        return this->constraints_.size();
+    }
+
+    std::size_t SimplexSolver::getNumIterations() const
+    {
+        return this->num_iterations_;
+    }
+
+    bool SimplexSolver::isWarmStarted() const
+    {
+        return this->warm_started_;
+    }
+
+} // namespace sdm
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstddef>
+
+#include <sdm/types.hpp>
+#include <sdm/utils/struct/pair.hpp>
+
+namespace sdm
+{
+    /**
+     * @class SimplexSolver
+     *
+     * @brief A self-contained linear program solver (dense two-phase primal simplex).
+     *
+     * This solver does not depend on any third party library, so that linear programs can be solved
+     * even when SDM'Studio is built without CPLEX. It is meant for the small and dense programs
+     * that arise when manipulating hyperplanes (e.g. dominance checks during pruning).
+     *
+     * Variables can have any (possibly infinite) lower and upper bounds. Pivots follow Dantzig's
+     * rule and switch to Bland's rule on long sequences of degenerate pivots to avoid cycling.
+     *
+     * The program can be modified between two resolutions. As long as only objective coefficients,
+     * finite bounds and right hand sides change, the next resolution is warm-started from the last
+     * basis : primal simplex if the basis remains feasible, dual simplex otherwise.
+     */
+    class SimplexSolver
+    {
+    public:
+        static constexpr double INF = std::numeric_limits<double>::infinity();
+
+        enum Sense
+        {
+            LESS_EQUAL,
+            GREATER_EQUAL,
+            EQUAL
+        };
+
+        enum Status
+        {
+            OPTIMAL,
+            INFEASIBLE,
+            UNBOUNDED
+        };
+
+        SimplexSolver(double precision = 1e-9, std::size_t max_iterations = 100000);
+
+        /**
+         * @brief Add a variable to the program.
+         *
+         * @param objective the coefficient of the variable in the objective function
+         * @param lower_bound the lower bound of the variable (can be -INF)
+         * @param upper_bound the upper bound of the variable (can be +INF)
+         * @return the index of the variable
+         */
+        std::size_t addVariable(double objective = 0., double lower_bound = 0., double upper_bound = INF);
+
+        /**
+         * @brief Add a constraint sum_i coefficient_i * x_i (<=, >=, =) rhs.
+         *
+         * @param coefficients the pairs (variable, coefficient)
+         * @param sense the sense of the constraint
+         * @param rhs the right hand side
+         */
+        void addConstraint(const std::vector<Pair<std::size_t, double>> &coefficients, Sense sense, double rhs);
+
+        /**
+         * @brief Set the coefficient of a variable in the objective function.
+         */
+        void setObjective(std::size_t variable, double objective);
+
+        /**
+         * @brief Set the bounds of a variable.
+         *
+         * Making a bound finite or infinite changes the structure of the program, so that the next
+         * resolution will not be warm-started.
+         */
+        void setBounds(std::size_t variable, double lower_bound, double upper_bound);
+
+        /**
+         * @brief Set the right hand side of a constraint.
+         */
+        void setRhs(std::size_t constraint, double rhs);
+
+        /**
+         * @brief Maximize the objective function under the constraints.
+         *
+         * @return the status of the resolution
+         */
+        Status maximize();
+
+        /**
+         * @brief Get the value of the objective function at the solution found by the last resolution.
+         */
+        double getObjectiveValue() const;
+
+        /**
+         * @brief Get the value of a variable in the solution found by the last resolution.
+         */
+        double getValue(std::size_t variable) const;
+
+        std::size_t getNumVariables() const;
+        std::size_t getNumConstraints() const;
+
+        /**
+         * @brief Get the number of pivots of the last resolution.
+         */
+        std::size_t getNumIterations() const;
+
+        /**
+         * @brief Whether the last resolution started from the basis of the previous one.
+         */
+        bool isWarmStarted() const;
+
+    protected:
+        struct Variable
+        {
+            double objective, lower_bound, upper_bound;
+        };
+
+        struct Constraint
+        {
+            std::vector<Pair<std::size_t, double>> coefficients;
+            Sense sense;
+            double rhs;
+        };
+
+        /** @brief Each variable x is written offset + sum_k sign_k * y_k where columns y_k are non-negative. */
+        struct ColumnMapping
+        {
+            double offset;
+            std::vector<Pair<std::size_t, double>> columns;
+        };
+
+        /** @brief The tableau is rebuilt after this number of successive warm starts (to bound numerical drift). */
+        static constexpr std::size_t MAX_WARM_STARTS = 100;
+
+        double precision_;
+        std::size_t max_iterations_, num_iterations_ = 0;
+
+        std::vector<Variable> variables_;
+        std::vector<Constraint> constraints_;
+
+        // Resolution data
+        std::vector<ColumnMapping> mappings_;
+        std::size_t num_rows_ = 0, num_columns_ = 0, first_artificial_ = 0;
+        std::vector<double> tableau_;
+        std::vector<std::size_t> basis_;
+        std::vector<double> column_values_;
+        double objective_value_ = 0.;
+
+        // Warm start data : the sign applied to each row, its right hand side in the tableau and the
+        // column that was the identity in the initial tableau (it now holds the inverse of the basis)
+        bool structure_changed_ = true, has_basis_ = false, warm_started_ = false;
+        std::size_t num_warm_starts_ = 0;
+        std::vector<double> row_signs_, row_rhs_;
+        std::vector<std::size_t> identity_columns_;
+
+        double &at(std::size_t row, std::size_t column);
+        void pivot(std::size_t row, std::size_t column);
+        void computeReducedCosts(const std::vector<double> &costs);
+        Status optimize(std::size_t num_allowed_columns);
+        Status dualOptimize();
+
+        /**
+         * @brief Write variables with non-negative columns (mappings_) and get the rows of the tableau.
+         */
+        std::vector<Constraint> buildRows(std::size_t &num_structural_columns);
+
+        /**
+         * @brief Get the costs of columns in the objective function and its constant part.
+         */
+        std::vector<double> buildCosts(double &constant) const;
+
+        Status coldStart();
+        bool warmStart(Status &status);
+        void storeSolution(double constant);
+    };
+
+} // namespace sdm
@@ -0,0 +1,69 @@
+#include <sstream>
+
+#include <sdm/utils/logging/instrumentation.hpp>
+
+namespace sdm
+{
+    namespace instrumentation
+    {
+        Statistics STATISTICS;
+
+        namespace
+        {
+            const std::array<std::string, NUM_PHASES> PHASE_NAMES = {"NextState", "ComputeNextState", "GreedyAction", "SolveProgram", "UpdateValue", "Excess", "Pruning", "Compression"};
+            const std::array<std::string, NUM_COUNTERS> COUNTER_NAMES = {"NextStateCacheHits", "StatesCreated"};
+        }
+
+        std::vector<std::string> getColumnNames()
+        {
+            std::vector<std::string> column_names;
+            if (ENABLED)
+            {
+                for (const auto &phase_name : PHASE_NAMES)
+                {
+                    column_names.push_back("Calls_" + phase_name);
+                    column_names.push_back("Time_" + phase_name);
+                }
+                for (const auto &counter_name : COUNTER_NAMES)
+                {
+                    column_names.push_back(counter_name);
+                }
+            }
+            return column_names;
+        }
+
+        std::string flush(const std::string &separator)
+        {
+            if (!ENABLED)
+            {
+                return "";
+            }
+            std::ostringstream values;
+            for (int phase = 0; phase < NUM_PHASES; phase++)
+            {
+                values << ((phase > 0) ? separator : "")
+                       << STATISTICS.calls[phase].exchange(0, std::memory_order_relaxed) << separator
+                       << STATISTICS.nanoseconds[phase].exchange(0, std::memory_order_relaxed) / 1e9;
+            }
+            for (int counter = 0; counter < NUM_COUNTERS; counter++)
+            {
+                values << separator << STATISTICS.counters[counter].exchange(0, std::memory_order_relaxed);
+            }
+            return values.str();
+        }
+
+        void reset()
+        {
+            for (int phase = 0; phase < NUM_PHASES; phase++)
+            {
+                STATISTICS.calls[phase].store(0, std::memory_order_relaxed);
+                STATISTICS.nanoseconds[phase].store(0, std::memory_order_relaxed);
+            }
+            for (int counter = 0; counter < NUM_COUNTERS; counter++)
+            {
+                STATISTICS.counters[counter].store(0, std::memory_order_relaxed);
+            }
+        }
+
+    } // namespace instrumentation
+} // namespace sdm
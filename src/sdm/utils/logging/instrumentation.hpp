@@ -0,0 +1,132 @@
+/**
+ * @file instrumentation.hpp
+ * @brief Counters and scoped timers for the hot paths of the solvers.
+ * @version 1.0
+ *
+ * Instrumentation is compiled out unless SDMS is built with the option SDMS_INSTRUMENTATION.
+ * When enabled, each instrumented phase records its number of calls and its (inclusive)
+ * time, and each counter records a number of events. HSVI writes the values accumulated
+ * since its previous log as extra columns of its CSV file (i.e. one breakdown per trial).
+ *
+ * ```cpp
+ * void MyClass::myHotFunction()
+ * {
+ *     SDMS_TIME_PHASE(UPDATE_VALUE);
+ *     ...
+ *     SDMS_COUNT(STATES_CREATED);
+ * }
+ * ```
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace sdm
+{
+    namespace instrumentation
+    {
+#ifdef SDMS_INSTRUMENTATION
+        constexpr bool ENABLED = true;
+#else
+        constexpr bool ENABLED = false;
+#endif
+
+        /** @brief The timed phases (a phase includes the phases it calls). */
+        enum Phase : int
+        {
+            NEXT_STATE,         // BaseBeliefMDP::getNextStateAndProba
+            COMPUTE_NEXT_STATE, // BaseBeliefMDP::computeNextStateAndProbability (i.e. next states that are not cached)
+            GREEDY_ACTION,      // action selection (getGreedyActionAndValue)
+            SOLVE_PROGRAM,      // WCSP / LP solved by the action selection
+            UPDATE_VALUE,       // update of the bounds
+            EXCESS,             // HSVI::excess
+            PRUNING,            // pruning of the bounds
+            COMPRESSION,        // OccupancyState::compress
+            NUM_PHASES
+        };
+
+        /** @brief The counted events. */
+        enum Counter : int
+        {
+            NEXT_STATE_CACHE_HITS, // next states found in the graph of the belief MDP
+            STATES_CREATED,        // states stored in the belief MDP
+            NUM_COUNTERS
+        };
+
+        /** @brief The statistics accumulated since the last flush. */
+        struct Statistics
+        {
+            std::array<std::atomic<std::uint64_t>, NUM_PHASES> calls{};
+            std::array<std::atomic<std::uint64_t>, NUM_PHASES> nanoseconds{};
+            std::array<std::atomic<std::uint64_t>, NUM_COUNTERS> counters{};
+        };
+
+        extern Statistics STATISTICS;
+
+        inline void count(Counter counter, std::uint64_t value = 1)
+        {
+            STATISTICS.counters[counter].fetch_add(value, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record a call to a phase and its duration (from construction to destruction).
+         */
+        class ScopedTimer
+        {
+        public:
+            explicit ScopedTimer(Phase phase) : phase_(phase), start_(std::chrono::steady_clock::now())
+            {
+            }
+
+            ~ScopedTimer()
+            {
+                auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start_).count();
+                STATISTICS.calls[this->phase_].fetch_add(1, std::memory_order_relaxed);
+                STATISTICS.nanoseconds[this->phase_].fetch_add(duration, std::memory_order_relaxed);
+            }
+
+            ScopedTimer(const ScopedTimer &) = delete;
+            ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        protected:
+            Phase phase_;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * @brief Get the names of the columns of the statistics (empty if instrumentation is disabled).
+         *
+         * For each phase, the number of calls (Calls_<Phase>) and the time in seconds (Time_<Phase>), then the counters.
+         */
+        std::vector<std::string> getColumnNames();
+
+        /**
+         * @brief Get the statistics accumulated since the last flush (in the order of the columns) and reset them.
+         *
+         * @param separator the separator of values
+         * @return the statistics (empty if instrumentation is disabled)
+         */
+        std::string flush(const std::string &separator = ",");
+
+        /**
+         * @brief Reset all statistics.
+         */
+        void reset();
+
+    } // namespace instrumentation
+} // namespace sdm
+
+#ifdef SDMS_INSTRUMENTATION
+#define SDMS_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define SDMS_INSTRUMENTATION_CONCAT(a, b) SDMS_INSTRUMENTATION_CONCAT_(a, b)
+#define SDMS_TIME_PHASE(phase) sdm::instrumentation::ScopedTimer SDMS_INSTRUMENTATION_CONCAT(sdms_scoped_timer_, __LINE__)(sdm::instrumentation::phase)
+#define SDMS_COUNT(counter) sdm::instrumentation::count(sdm::instrumentation::counter)
+#else
+#define SDMS_TIME_PHASE(phase)
+#define SDMS_COUNT(counter)
+#endif
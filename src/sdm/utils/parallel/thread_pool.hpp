@@ -0,0 +1,194 @@
+/**
+ * @file thread_pool.hpp
+ * @brief A minimal pool of worker threads used to parallelize the hot loops of SDMS.
+ * @version 1.0
+ *
+ */
+#pragma once
+
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <future>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include <sdm/types.hpp>
+
+namespace sdm
+{
+    /**
+     * @class ThreadPool
+     *
+     * @brief A fixed-size pool of worker threads.
+     *
+     * Tasks are executed in FIFO order by the workers. The function `parallel_for` splits
+     * a range of items into contiguous shards (one per worker) and blocks until all shards
+     * are processed. Shards only depend on the number of items and on the number of threads,
+     * so callers that write results at the index of each item and merge them in order obtain
+     * results that do not depend on the scheduling.
+     *
+     * When `parallel_for` is called from one of the workers of a pool, the range is processed
+     * in the calling thread. This prevents dead locks when parallel sections are nested.
+     *
+     * Basic Usage:
+     *
+     * ```cpp
+     * std::vector<double> squares(100);
+     * ThreadPool::get(4)->parallel_for(squares.size(), [&](std::size_t begin, std::size_t end) {
+     *     for (std::size_t i = begin; i < end; i++)
+     *         squares[i] = i * i;
+     * });
+     * ```
+     *
+     */
+    class ThreadPool
+    {
+    public:
+        ThreadPool(number num_threads) : num_threads_(std::max<number>(num_threads, 1))
+        {
+            for (number i = 0; i < this->num_threads_; i++)
+            {
+                this->workers_.emplace_back([this]()
+                                            { this->work(); });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex_);
+                this->stop_ = true;
+            }
+            this->condition_.notify_all();
+            for (auto &worker : this->workers_)
+            {
+                worker.join();
+            }
+        }
+
+        /** @brief Get the number of workers. */
+        number getNumThreads() const
+        {
+            return this->num_threads_;
+        }
+
+        /**
+         * @brief Submit a task to the pool.
+         *
+         * @param task the task
+         * @return a future that becomes ready when the task is done (it rethrows the exception raised by the task if any)
+         */
+        std::future<void> submit(std::function<void()> task)
+        {
+            auto packaged_task = std::make_shared<std::packaged_task<void()>>(std::move(task));
+            std::future<void> result = packaged_task->get_future();
+            {
+                std::unique_lock<std::mutex> lock(this->mutex_);
+                this->tasks_.emplace([packaged_task]()
+                                     { (*packaged_task)(); });
+            }
+            this->condition_.notify_one();
+            return result;
+        }
+
+        /**
+         * @brief Process the range [0, num_items) by contiguous shards.
+         *
+         * @param num_items the number of items
+         * @param function the function applied on each shard [begin, end)
+         */
+        void parallel_for(std::size_t num_items, const std::function<void(std::size_t, std::size_t)> &function)
+        {
+            if ((num_items == 0))
+            {
+                return;
+            }
+            if ((this->num_threads_ == 1) || (num_items == 1) || ThreadPool::isWorkerThread())
+            {
+                function(0, num_items);
+                return;
+            }
+
+            std::size_t num_shards = std::min<std::size_t>(this->num_threads_, num_items);
+            std::vector<std::future<void>> futures;
+            futures.reserve(num_shards);
+            for (std::size_t shard = 0; shard < num_shards; shard++)
+            {
+                std::size_t begin = (shard * num_items) / num_shards, end = ((shard + 1) * num_items) / num_shards;
+                futures.push_back(this->submit([&function, begin, end]()
+                                               { function(begin, end); }));
+            }
+            // Wait for all shards before rethrowing, shards reference local data
+            for (auto &future : futures)
+            {
+                future.wait();
+            }
+            for (auto &future : futures)
+            {
+                future.get();
+            }
+        }
+
+        /**
+         * @brief Get a pool shared by the whole process with the requested number of workers.
+         *
+         * Pools are created lazily and kept alive until the end of the program.
+         */
+        static std::shared_ptr<ThreadPool> get(number num_threads)
+        {
+            static std::mutex pools_mutex;
+            static std::unordered_map<number, std::shared_ptr<ThreadPool>> pools;
+
+            std::unique_lock<std::mutex> lock(pools_mutex);
+            auto &pool = pools[num_threads];
+            if (pool == nullptr)
+            {
+                pool = std::make_shared<ThreadPool>(num_threads);
+            }
+            return pool;
+        }
+
+        /** @brief Check whether the calling thread is a worker of a pool. */
+        static bool isWorkerThread()
+        {
+            return ThreadPool::is_worker_thread_;
+        }
+
+    protected:
+        number num_threads_;
+        bool stop_ = false;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::vector<std::thread> workers_;
+        std::queue<std::function<void()>> tasks_;
+
+        static inline thread_local bool is_worker_thread_ = false;
+
+        void work()
+        {
+            ThreadPool::is_worker_thread_ = true;
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex_);
+                    this->condition_.wait(lock, [this]()
+                                          { return this->stop_ || !this->tasks_.empty(); });
+                    if (this->stop_ && this->tasks_.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(this->tasks_.front());
+                    this->tasks_.pop();
+                }
+                task();
+            }
+        }
+    };
+
+} // namespace sdm
@@ -1,44 +1,166 @@
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
 #include <sdm/types.hpp>
+#include <sdm/common.hpp>
+#include <sdm/exception.hpp>
 #include <sdm/utils/rl/experience_memory.hpp>
-#include <experimental/algorithm>
 
 namespace sdm
 {
+    int ExperienceMemory::CAPACITY = 1;
+    double ExperienceMemory::PRIORITY_EXPONENT = 0., ExperienceMemory::IMPORTANCE_EXPONENT = 1., ExperienceMemory::PRIORITY_EPSILON = 0.000001;
 
-    ExperienceMemory::ExperienceMemory(number horizon, int capacity)
+    ExperienceMemory::ExperienceMemory(number horizon, int capacity, double priority_exponent, double importance_exponent)
+        : horizon_((horizon == 0) ? 1 : horizon), capacity_(std::max(capacity, 1)), priority_exponent_(priority_exponent), importance_exponent_(importance_exponent)
     {
-        this->experience_memory_ = std::vector<std::vector<sars_transition>>((horizon == 0) ? 1 : horizon);
-        this->positions_ = std::vector<number>((horizon == 0) ? 1 : horizon, 0);
-        this->capacity_ = capacity;
+        this->positions_ = std::vector<std::size_t>(this->horizon_, 0);
+        this->sizes_ = std::vector<std::size_t>(this->horizon_, 0);
+
+        // Preallocate all transitions
+        this->states_.resize(this->horizon_ * this->capacity_);
+        this->actions_.resize(this->horizon_ * this->capacity_);
+        this->rewards_.resize(this->horizon_ * this->capacity_);
+        this->next_states_.resize(this->horizon_ * this->capacity_);
+        this->next_actions_.resize(this->horizon_ * this->capacity_);
+
+        if (this->isPrioritized())
+        {
+            this->priorities_ = std::vector<SumTree>(this->horizon_, SumTree(this->capacity_));
+            this->max_priorities_ = std::vector<double>(this->horizon_, 1.);
+        }
     }
 
-    void ExperienceMemory::push(const std::shared_ptr<State> &observation, const std::shared_ptr<Action> &action, const double reward, const std::shared_ptr<State> &next_observation, const std::shared_ptr<Action> &next_action, number step)
+    std::mt19937 &ExperienceMemory::getGenerator()
     {
-        assert(step < this->experience_memory_.size());
+        // Generators are seeded from the global one, so that runs with the same seed sample the same transitions
+        thread_local std::mt19937 generator(common::global_seed());
+        return generator;
+    }
 
-        if (this->experience_memory_[step].size() < capacity_)
+    double ExperienceMemory::getWeight(number step, std::size_t index) const
+    {
+        if (!this->isPrioritized())
         {
-            this->experience_memory_[step].push_back(std::make_tuple(observation, action, reward, next_observation, next_action));
+            return 1.;
         }
-        else
+        // (N * P(i))^-beta / max_j (N * P(j))^-beta = (p_i / p_min)^-beta
+        const auto &priorities = this->priorities_[step];
+        return std::pow(priorities.getPriority(index) / priorities.getMin(), -this->importance_exponent_);
+    }
+
+    void ExperienceMemory::push(const std::shared_ptr<State> &observation, const std::shared_ptr<Action> &action, const double reward, const std::shared_ptr<State> &next_observation, const std::shared_ptr<Action> &next_action, number step)
+    {
+        assert(step < this->horizon_);
+
+        std::size_t position = this->positions_[step], index = step * this->capacity_ + position;
+        this->states_[index] = observation;
+        this->actions_[index] = action;
+        this->rewards_[index] = reward;
+        this->next_states_[index] = next_observation;
+        this->next_actions_[index] = next_action;
+
+        if (this->isPrioritized())
         {
-            this->experience_memory_[step][this->positions_[step]] = std::make_tuple(observation, action, reward, next_observation, next_action);
+            this->priorities_[step].setPriority(position, this->max_priorities_[step]);
         }
-        this->positions_[step] = (this->positions_[step] + 1) % this->capacity_;
+        this->positions_[step] = (position + 1) % this->capacity_;
+        this->sizes_[step] = std::min(this->sizes_[step] + 1, this->capacity_);
     }
 
     std::vector<ExperienceMemory::sars_transition> ExperienceMemory::sample(number step, int n)
     {
-        assert(step < this->experience_memory_.size());
+        std::vector<std::size_t> indices;
+        this->sampleIndices(step, n, indices);
 
         std::vector<sars_transition> out;
-        std::experimental::sample(this->experience_memory_[step].begin(), this->experience_memory_[step].end(), std::back_inserter(out), n, std::mt19937{std::random_device{}()});
+        for (const auto &index : indices)
+        {
+            out.push_back(this->get(step, index));
+        }
         return out;
     }
 
+    void ExperienceMemory::sampleIndices(number step, int n, std::vector<std::size_t> &indices)
+    {
+        assert(step < this->horizon_);
+
+        indices.clear();
+        if (this->sizes_[step] == 0)
+        {
+            return;
+        }
+
+        auto &generator = ExperienceMemory::getGenerator();
+        if (this->isPrioritized())
+        {
+            const auto &priorities = this->priorities_[step];
+            double segment = priorities.getTotal() / n;
+            std::uniform_real_distribution<double> distribution(0., 1.);
+            for (int k = 0; k < n; k++)
+            {
+                indices.push_back(priorities.find((k + distribution(generator)) * segment));
+            }
+        }
+        else
+        {
+            std::uniform_int_distribution<std::size_t> distribution(0, this->sizes_[step] - 1);
+            for (int k = 0; k < n; k++)
+            {
+                indices.push_back(distribution(generator));
+            }
+        }
+    }
+
+    void ExperienceMemory::sampleIndices(number step, int n, std::vector<std::size_t> &indices, std::vector<double> &weights)
+    {
+        this->sampleIndices(step, n, indices);
+
+        weights.clear();
+        for (const auto &index : indices)
+        {
+            weights.push_back(this->getWeight(step, index));
+        }
+    }
+
+    std::size_t ExperienceMemory::sampleIndex(number step)
+    {
+        thread_local std::vector<std::size_t> indices;
+        this->sampleIndices(step, 1, indices);
+        if (indices.empty())
+        {
+            throw sdm::exception::Exception("ExperienceMemory::sampleIndex : no transition was pushed at time step " + std::to_string(step));
+        }
+        return indices[0];
+    }
+
+    std::size_t ExperienceMemory::sampleIndex(number step, double &weight)
+    {
+        auto index = this->sampleIndex(step);
+        weight = this->getWeight(step, index);
+        return index;
+    }
+
+    ExperienceMemory::sars_reference ExperienceMemory::get(number step, std::size_t index) const
+    {
+        std::size_t i = step * this->capacity_ + index;
+        return sars_reference(this->states_[i], this->actions_[i], this->rewards_[i], this->next_states_[i], this->next_actions_[i]);
+    }
+
+    void ExperienceMemory::updatePriority(number step, std::size_t index, double td_error)
+    {
+        if (this->isPrioritized())
+        {
+            double priority = std::pow(std::abs(td_error) + ExperienceMemory::PRIORITY_EPSILON, this->priority_exponent_);
+            this->priorities_[step].setPriority(index, priority);
+            this->max_priorities_[step] = std::max(this->max_priorities_[step], priority);
+        }
+    }
+
     int ExperienceMemory::size()
     {
-        return this->experience_memory_[0].size();
+        return this->sizes_[0];
     }
 
     int ExperienceMemory::getCapacity() const
@@ -46,4 +168,19 @@ namespace sdm
         return this->capacity_;
     }
 
-} // namespace sdm
\ No newline at end of file
+    bool ExperienceMemory::isPrioritized() const
+    {
+        return this->priority_exponent_ > 0.;
+    }
+
+    double ExperienceMemory::getImportanceExponent() const
+    {
+        return this->importance_exponent_;
+    }
+
+    void ExperienceMemory::setImportanceExponent(double importance_exponent)
+    {
+        this->importance_exponent_ = importance_exponent;
+    }
+
+} // namespace sdm
@@ -4,28 +4,94 @@
 #include <math.h>
 #include <iterator>
 #include <utility>
+#include <sdm/utils/rl/sum_tree.hpp>
 #include <sdm/utils/rl/experience_memory_interface.hpp>
 
 namespace sdm
 {
 
+    /**
+     * @brief A replay memory of transitions for each time step.
+     *
+     * Transitions are stored in preallocated ring buffers (one array per item of the transitions, i.e.
+     * structure of arrays), the oldest transition being replaced once the capacity is reached.
+     *
+     * Transitions are sampled uniformly, or proportionally to the priority (|td_error| + eps)^alpha
+     * of their last update when the priority exponent alpha is positive (prioritized replay). New
+     * transitions get the highest priority seen so far, so that they are replayed at least once.
+     *
+     * Prioritized sampling is corrected with the importance-sampling weights (N * P(i))^-beta, normalized
+     * by their maximum over the memory, i.e. (p_i / p_min)^-beta. The importance exponent beta is usually
+     * annealed up to 1 (full correction) along the training.
+     */
     class ExperienceMemory : public ExperienceMemoryInterface
     {
     protected:
-        number capacity_;
-        std::vector<number> positions_;
-        std::vector<std::vector<sars_transition>> experience_memory_;
+        std::size_t horizon_, capacity_;
+        double priority_exponent_, importance_exponent_;
+        std::vector<std::size_t> positions_, sizes_;
+
+        // Items of the transition stored in position i of time step t are at index t * capacity + i
+        std::vector<std::shared_ptr<State>> states_, next_states_;
+        std::vector<std::shared_ptr<Action>> actions_, next_actions_;
+        std::vector<double> rewards_;
+
+        std::vector<SumTree> priorities_;
+        std::vector<double> max_priorities_;
+
+        /** @brief Get the random generator of the current thread. */
+        static std::mt19937 &getGenerator();
+
+        /** @brief Get the importance-sampling weight of a stored transition. */
+        double getWeight(number t, std::size_t index) const;
 
     public:
-        ExperienceMemory(number horizon, int capacity = 1);
+        /** @brief The default capacity, priority exponent and importance exponent of experience memories. */
+        static int CAPACITY;
+        static double PRIORITY_EXPONENT, IMPORTANCE_EXPONENT;
+
+        /** @brief The priority of transitions whose temporal difference error is zero. */
+        static double PRIORITY_EPSILON;
+
+        ExperienceMemory(number horizon, int capacity = 1, double priority_exponent = 0., double importance_exponent = 1.);
 
         void push(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const double reward, const std::shared_ptr<State> &next_state, const std::shared_ptr<Action> &next_action, number t);
 
         std::vector<sars_transition> sample(number t, int n = 1);
 
+        /**
+         * @brief Sample the indices of a mini-batch of transitions (with replacement).
+         *
+         * With prioritized replay, the indices are drawn from n strata of equal priority mass.
+         */
+        void sampleIndices(number t, int n, std::vector<std::size_t> &indices);
+
+        void sampleIndices(number t, int n, std::vector<std::size_t> &indices, std::vector<double> &weights);
+
+        /**
+         * @brief Sample the index of a transition.
+         */
+        std::size_t sampleIndex(number t);
+
+        /**
+         * @brief Sample the index of a transition, with its importance-sampling weight.
+         */
+        std::size_t sampleIndex(number t, double &weight);
+
+        sars_reference get(number t, std::size_t index) const;
+
+        void updatePriority(number t, std::size_t index, double td_error);
+
         int size();
 
         int getCapacity() const;
 
+        bool isPrioritized() const;
+
+        /** @brief Get the importance exponent beta. */
+        double getImportanceExponent() const;
+
+        /** @brief Set the importance exponent beta (e.g. to anneal it). */
+        void setImportanceExponent(double importance_exponent);
     };
-} // namespace sdm
\ No newline at end of file
+} // namespace sdm
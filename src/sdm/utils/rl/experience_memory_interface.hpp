@@ -1,6 +1,7 @@
 #pragma once
 
 #include <tuple>
+#include <vector>
 
 #include <sdm/core/state/state.hpp>
 #include <sdm/core/action/action.hpp>
@@ -11,9 +12,45 @@ namespace sdm
   {
     public:
       using sars_transition = std::tuple<std::shared_ptr<State>, std::shared_ptr<Action>, double, std::shared_ptr<State>, std::shared_ptr<Action>>;
+
+      /** @brief A transition stored in the memory (references to the stored items, valid until the next push) */
+      using sars_reference = std::tuple<const std::shared_ptr<State> &, const std::shared_ptr<Action> &, double, const std::shared_ptr<State> &, const std::shared_ptr<Action> &>;
+
       virtual ~ExperienceMemoryInterface(){}
       virtual void push(const std::shared_ptr<State>& state, const std::shared_ptr<Action>& action, const double reward, const std::shared_ptr<State>& next_state, const std::shared_ptr<Action>& next_action, number t) = 0;
       virtual std::vector<sars_transition> sample(number t, int n = 1) = 0;
+
+      /**
+       * @brief Sample the indices of a mini-batch of transitions (the transitions are not copied).
+       *
+       * @param t the time step
+       * @param n the size of the mini-batch
+       * @param indices the sampled indices (see get)
+       */
+      virtual void sampleIndices(number t, int n, std::vector<std::size_t> &indices) = 0;
+
+      /**
+       * @brief Sample the indices of a mini-batch of transitions, with the importance-sampling weights of the transitions.
+       *
+       * The updates of a transition should be scaled by its weight, which corrects the bias of non-uniform sampling.
+       *
+       * @param t the time step
+       * @param n the size of the mini-batch
+       * @param indices the sampled indices (see get)
+       * @param weights the weights of the sampled transitions (in (0, 1], all 1 with uniform sampling)
+       */
+      virtual void sampleIndices(number t, int n, std::vector<std::size_t> &indices, std::vector<double> &weights) = 0;
+
+      /**
+       * @brief Get a stored transition.
+       */
+      virtual sars_reference get(number t, std::size_t index) const = 0;
+
+      /**
+       * @brief Update the priority of a stored transition given its last temporal difference error.
+       */
+      virtual void updatePriority(number t, std::size_t index, double td_error) = 0;
+
       virtual int size() = 0;
   };
-}
\ No newline at end of file
+}
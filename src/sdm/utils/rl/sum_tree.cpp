@@ -0,0 +1,71 @@
+#include <limits>
+#include <algorithm>
+
+#include <sdm/utils/rl/sum_tree.hpp>
+
+namespace sdm
+{
+    SumTree::SumTree(std::size_t capacity) : capacity_(capacity), num_leaves_(1)
+    {
+        while (this->num_leaves_ < capacity)
+        {
+            this->num_leaves_ *= 2;
+        }
+        this->tree_ = std::vector<double>(2 * this->num_leaves_, 0.);
+        this->min_tree_ = std::vector<double>(2 * this->num_leaves_, std::numeric_limits<double>::infinity());
+    }
+
+    std::size_t SumTree::getCapacity() const
+    {
+        return this->capacity_;
+    }
+
+    void SumTree::setPriority(std::size_t index, double priority)
+    {
+        std::size_t node = this->num_leaves_ + index;
+        this->tree_[node] = priority;
+        this->min_tree_[node] = priority;
+
+        // Sums are computed again from the children (rather than updated with the difference) to avoid drifts
+        for (node /= 2; node >= 1; node /= 2)
+        {
+            this->tree_[node] = this->tree_[2 * node] + this->tree_[2 * node + 1];
+            this->min_tree_[node] = std::min(this->min_tree_[2 * node], this->min_tree_[2 * node + 1]);
+        }
+    }
+
+    double SumTree::getPriority(std::size_t index) const
+    {
+        return this->tree_[this->num_leaves_ + index];
+    }
+
+    double SumTree::getTotal() const
+    {
+        return this->tree_[1];
+    }
+
+    double SumTree::getMin() const
+    {
+        return this->min_tree_[1];
+    }
+
+    std::size_t SumTree::find(double value) const
+    {
+        std::size_t node = 1;
+        while (node < this->num_leaves_)
+        {
+            if ((value < this->tree_[2 * node]) || (this->tree_[2 * node + 1] <= 0.))
+            {
+                node = 2 * node;
+            }
+            else
+            {
+                value -= this->tree_[2 * node];
+                node = 2 * node + 1;
+            }
+        }
+        // Rounding errors may lead past the last leaf with a positive priority
+        std::size_t index = node - this->num_leaves_;
+        return (index < this->capacity_) ? index : this->capacity_ - 1;
+    }
+} // namespace sdm
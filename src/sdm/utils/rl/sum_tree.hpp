@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace sdm
+{
+    /**
+     * @brief A binary tree whose leaves are priorities and whose nodes are the sums of their children.
+     *
+     * Setting a priority and finding the leaf of a given prefix sum both take O(log n), so that
+     * items can be sampled proportionally to their priorities. The tree is stored in a single
+     * array (the children of node i are 2i and 2i+1, the leaves start at the first power of two
+     * greater than or equal to the capacity). The minimum of the priorities that were set is kept
+     * the same way (in a second tree).
+     */
+    class SumTree
+    {
+    public:
+        SumTree(std::size_t capacity = 1);
+
+        /** @brief Get the number of leaves. */
+        std::size_t getCapacity() const;
+
+        /** @brief Set the priority of a leaf. */
+        void setPriority(std::size_t index, double priority);
+
+        /** @brief Get the priority of a leaf. */
+        double getPriority(std::size_t index) const;
+
+        /** @brief Get the sum of all priorities. */
+        double getTotal() const;
+
+        /** @brief Get the smallest priority that was set (infinity if none was). */
+        double getMin() const;
+
+        /**
+         * @brief Find the leaf where the prefix sum of priorities reaches a given value.
+         *
+         * @param value a value in [0, getTotal())
+         * @return the index of the leaf
+         */
+        std::size_t find(double value) const;
+
+    protected:
+        std::size_t capacity_, num_leaves_;
+        std::vector<double> tree_, min_tree_;
+    };
+} // namespace sdm
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+
+namespace sdm
+{
+
+    /**
+     * @class AlignedAllocator
+     *
+     * @brief An allocator returning memory aligned on a given boundary (a cache line by default).
+     *
+     * Used for arrays that are read by vectorized kernels, so that loads never cross a cache line.
+     *
+     * @tparam T the type of items
+     * @tparam ALIGNMENT the alignment in bytes (a power of two)
+     *
+     */
+    template <typename T, std::size_t ALIGNMENT = 64>
+    class AlignedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, ALIGNMENT>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, ALIGNMENT> &) noexcept {}
+
+        T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(ALIGNMENT)));
+        }
+
+        void deallocate(T *pointer, std::size_t) noexcept
+        {
+            ::operator delete(pointer, std::align_val_t(ALIGNMENT));
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, ALIGNMENT> &) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, ALIGNMENT> &) const noexcept { return false; }
+    };
+
+} // namespace sdm
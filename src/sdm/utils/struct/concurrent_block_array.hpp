@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include <sdm/types.hpp>
+
+namespace sdm
+{
+
+    /**
+     * @class ConcurrentBlockArray
+     *
+     * @brief An unbounded array whose items never move, and that can be extended concurrently.
+     *
+     * Items are stored in blocks of geometrically increasing sizes (block k holds 2^(6 + k) items).
+     * Blocks are allocated the first time one of their items is accessed, so that any index can be
+     * accessed without resizing. Accesses to distinct items from distinct threads are safe; accesses
+     * to the same item must be synchronized by the caller (or the item must be atomic).
+     *
+     * @tparam T the type of items (must be default constructible, items are value-initialized)
+     *
+     */
+    template <typename T>
+    class ConcurrentBlockArray
+    {
+    public:
+        ConcurrentBlockArray();
+        ConcurrentBlockArray(const ConcurrentBlockArray &) = delete;
+        ConcurrentBlockArray &operator=(const ConcurrentBlockArray &) = delete;
+        ~ConcurrentBlockArray();
+
+        /** @brief Get the item at an index, the block of the item is allocated if required. */
+        T &at(std::uint32_t index);
+
+        /** @brief Get the item at an index, or nullptr if the block of the item was never allocated. */
+        T *find(std::uint32_t index) const;
+
+        /** @brief Release all blocks. Must not be called concurrently with other methods. */
+        void clear();
+
+    protected:
+        static constexpr std::size_t FIRST_BLOCK_BITS = 6;
+        static constexpr std::size_t NUM_BLOCKS = 33 - FIRST_BLOCK_BITS;
+
+        std::array<std::atomic<T *>, NUM_BLOCKS> blocks_;
+
+        /** @brief Get the block of an index and its offset in this block. */
+        static void locate(std::uint32_t index, std::size_t &block, std::size_t &offset);
+    };
+
+} // namespace sdm
+
+#include <sdm/utils/struct/concurrent_block_array.tpp>
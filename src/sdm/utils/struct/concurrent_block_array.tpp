@@ -0,0 +1,78 @@
+#include <sdm/utils/struct/concurrent_block_array.hpp>
+
+namespace sdm
+{
+    template <typename T>
+    ConcurrentBlockArray<T>::ConcurrentBlockArray()
+    {
+        for (auto &block : this->blocks_)
+        {
+            block.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    ConcurrentBlockArray<T>::~ConcurrentBlockArray()
+    {
+        for (auto &block : this->blocks_)
+        {
+            delete[] block.load(std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    void ConcurrentBlockArray<T>::locate(std::uint32_t index, std::size_t &block, std::size_t &offset)
+    {
+        std::size_t shifted = std::size_t(index) + (std::size_t(1) << FIRST_BLOCK_BITS);
+        std::size_t msb = 0;
+        while ((shifted >> (msb + 1)) != 0)
+        {
+            msb++;
+        }
+        block = msb - FIRST_BLOCK_BITS;
+        offset = shifted - (std::size_t(1) << msb);
+    }
+
+    template <typename T>
+    T &ConcurrentBlockArray<T>::at(std::uint32_t index)
+    {
+        std::size_t block, offset;
+        this->locate(index, block, offset);
+
+        T *items = this->blocks_[block].load(std::memory_order_acquire);
+        if (items == nullptr)
+        {
+            // Several threads may allocate the same block, only the first one publishes it
+            T *new_items = new T[std::size_t(1) << (FIRST_BLOCK_BITS + block)]();
+            if (this->blocks_[block].compare_exchange_strong(items, new_items, std::memory_order_acq_rel))
+            {
+                items = new_items;
+            }
+            else
+            {
+                delete[] new_items;
+            }
+        }
+        return items[offset];
+    }
+
+    template <typename T>
+    T *ConcurrentBlockArray<T>::find(std::uint32_t index) const
+    {
+        std::size_t block, offset;
+        this->locate(index, block, offset);
+
+        T *items = this->blocks_[block].load(std::memory_order_acquire);
+        return (items == nullptr) ? nullptr : items + offset;
+    }
+
+    template <typename T>
+    void ConcurrentBlockArray<T>::clear()
+    {
+        for (auto &block : this->blocks_)
+        {
+            delete[] block.exchange(nullptr);
+        }
+    }
+
+} // namespace sdm
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <sdm/types.hpp>
+#include <sdm/exception.hpp>
+#include <sdm/utils/struct/concurrent_block_array.hpp>
+
+namespace sdm
+{
+
+    /**
+     * @class ConcurrentInterningTable
+     *
+     * @brief A thread-safe structure that assigns a unique and dense integer identifier to each item.
+     *
+     * This is the concurrent counterpart of InterningTable. Items are distributed over shards
+     * according to their hash, and each shard is protected by its own reader-writer lock, so that
+     * lookups of different threads never block each other and insertions only block the lookups
+     * of the same shard. The hash of an item is computed once per call.
+     *
+     * Identifiers are given in order of insertion (0, 1, 2, ...) and are never reused. The items are
+     * stored in a ConcurrentBlockArray and never moved, hence the references returned by `getItem`
+     * remain valid until the table is destroyed or cleared.
+     *
+     * @tparam TItem the type of items to intern (must be default constructible)
+     * @tparam THash the hash function of items
+     * @tparam TEqual the equality function of items
+     *
+     * Basic Usage:
+     *
+     * ```cpp
+     * ConcurrentInterningTable<std::string> table;
+     * table.getID("a"); // OUTPUT : 0
+     * table.getID("b"); // OUTPUT : 1
+     * table.getID("a"); // OUTPUT : 0
+     * table.getItem(1); // OUTPUT : "b"
+     * ```
+     *
+     */
+    template <typename TItem, typename THash = std::hash<TItem>, typename TEqual = std::equal_to<TItem>>
+    class ConcurrentInterningTable
+    {
+    public:
+        using id_type = std::uint32_t;
+
+        /** @brief The identifier returned when an item was never interned. */
+        static constexpr id_type NOT_FOUND = std::numeric_limits<id_type>::max();
+
+        ConcurrentInterningTable(const THash &hash = THash(), const TEqual &equal = TEqual());
+        ConcurrentInterningTable(const ConcurrentInterningTable &) = delete;
+        ConcurrentInterningTable &operator=(const ConcurrentInterningTable &) = delete;
+
+        /**
+         * @brief Get the identifier of an item. The item is interned if it was not yet.
+         *
+         * @param item the item
+         * @return the identifier of the item
+         */
+        id_type getID(const TItem &item);
+
+        /**
+         * @brief Get the identifier of an item without interning it.
+         *
+         * @param item the item
+         * @return the identifier of the item or NOT_FOUND
+         */
+        id_type findID(const TItem &item) const;
+
+        /**
+         * @brief Get the item associated to an identifier.
+         *
+         * The identifier must have been returned by `getID` or `findID`.
+         *
+         * @param id the identifier
+         * @return the item
+         */
+        const TItem &getItem(id_type id) const;
+
+        /**
+         * @brief Release an item. The item is reset to its default value and its identifier is not given again.
+         *
+         * The caller must ensure that no other thread reads the item while it is released.
+         *
+         * @param id the identifier
+         */
+        void release(id_type id);
+
+        /** @brief Get the number of identifiers given so far (including released ones). */
+        std::size_t size() const;
+
+        /** @brief Remove all interned items. Must not be called concurrently with other methods. */
+        void clear();
+
+    protected:
+        static constexpr std::size_t NUM_SHARDS = 64;
+
+        struct Shard
+        {
+            mutable std::shared_mutex mutex;
+
+            /** @brief Relation from the hash of an item to the identifiers of items with that hash */
+            std::unordered_multimap<std::size_t, id_type> hash_to_ids;
+        };
+
+        THash hash_;
+        TEqual equal_;
+
+        std::array<Shard, NUM_SHARDS> shards_;
+
+        /** @brief The number of identifiers given so far */
+        std::atomic<id_type> num_items_;
+
+        /** @brief Relation from identifier to item */
+        ConcurrentBlockArray<TItem> items_;
+
+        Shard &getShard(std::size_t hash);
+        const Shard &getShard(std::size_t hash) const;
+
+        /** @brief Find the identifier of an item in a shard (the lock of the shard must be held). */
+        id_type findInShard(const Shard &shard, std::size_t hash, const TItem &item) const;
+    };
+
+} // namespace sdm
+
+#include <sdm/utils/struct/concurrent_interning_table.tpp>
@@ -0,0 +1,131 @@
+#include <sdm/utils/struct/concurrent_interning_table.hpp>
+
+namespace sdm
+{
+    template <typename TItem, typename THash, typename TEqual>
+    ConcurrentInterningTable<TItem, THash, TEqual>::ConcurrentInterningTable(const THash &hash, const TEqual &equal)
+        : hash_(hash), equal_(equal), num_items_(0)
+    {
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    typename ConcurrentInterningTable<TItem, THash, TEqual>::Shard &ConcurrentInterningTable<TItem, THash, TEqual>::getShard(std::size_t hash)
+    {
+        return this->shards_[(hash ^ (hash >> 17)) % NUM_SHARDS];
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    const typename ConcurrentInterningTable<TItem, THash, TEqual>::Shard &ConcurrentInterningTable<TItem, THash, TEqual>::getShard(std::size_t hash) const
+    {
+        return this->shards_[(hash ^ (hash >> 17)) % NUM_SHARDS];
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    typename ConcurrentInterningTable<TItem, THash, TEqual>::id_type ConcurrentInterningTable<TItem, THash, TEqual>::findInShard(const Shard &shard, std::size_t hash, const TItem &item) const
+    {
+        auto range = shard.hash_to_ids.equal_range(hash);
+        for (auto iterator = range.first; iterator != range.second; ++iterator)
+        {
+            if (this->equal_(this->getItem(iterator->second), item))
+            {
+                return iterator->second;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    typename ConcurrentInterningTable<TItem, THash, TEqual>::id_type ConcurrentInterningTable<TItem, THash, TEqual>::getID(const TItem &item)
+    {
+        std::size_t hash = this->hash_(item);
+        Shard &shard = this->getShard(hash);
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            id_type id = this->findInShard(shard, hash, item);
+            if (id != NOT_FOUND)
+            {
+                return id;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // The item may have been interned while waiting for the lock
+        id_type id = this->findInShard(shard, hash, item);
+        if (id != NOT_FOUND)
+        {
+            return id;
+        }
+        id = this->num_items_.fetch_add(1, std::memory_order_relaxed);
+        if (id == NOT_FOUND)
+        {
+            throw sdm::exception::Exception("ConcurrentInterningTable::getID : too many items");
+        }
+        // The item is stored before its identifier is published in the shard
+        this->items_.at(id) = item;
+        shard.hash_to_ids.emplace(hash, id);
+        return id;
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    typename ConcurrentInterningTable<TItem, THash, TEqual>::id_type ConcurrentInterningTable<TItem, THash, TEqual>::findID(const TItem &item) const
+    {
+        std::size_t hash = this->hash_(item);
+        const Shard &shard = this->getShard(hash);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return this->findInShard(shard, hash, item);
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    const TItem &ConcurrentInterningTable<TItem, THash, TEqual>::getItem(id_type id) const
+    {
+        if (id >= this->num_items_.load(std::memory_order_relaxed))
+        {
+            throw sdm::exception::Exception("ConcurrentInterningTable::getItem : unknown identifier " + std::to_string(id));
+        }
+        return *this->items_.find(id);
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    void ConcurrentInterningTable<TItem, THash, TEqual>::release(id_type id)
+    {
+        if (id >= this->num_items_.load(std::memory_order_relaxed))
+        {
+            throw sdm::exception::Exception("ConcurrentInterningTable::release : unknown identifier " + std::to_string(id));
+        }
+        TItem &item = *this->items_.find(id);
+        std::size_t hash = this->hash_(item);
+        Shard &shard = this->getShard(hash);
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto range = shard.hash_to_ids.equal_range(hash);
+            for (auto iterator = range.first; iterator != range.second; ++iterator)
+            {
+                if (iterator->second == id)
+                {
+                    shard.hash_to_ids.erase(iterator);
+                    break;
+                }
+            }
+        }
+        item = TItem();
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    std::size_t ConcurrentInterningTable<TItem, THash, TEqual>::size() const
+    {
+        return this->num_items_.load(std::memory_order_relaxed);
+    }
+
+    template <typename TItem, typename THash, typename TEqual>
+    void ConcurrentInterningTable<TItem, THash, TEqual>::clear()
+    {
+        for (auto &shard : this->shards_)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.hash_to_ids.clear();
+        }
+        this->items_.clear();
+        this->num_items_.store(0);
+    }
+
+} // namespace sdm
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <sdm/types.hpp>
+
+namespace sdm
+{
+
+    /**
+     * @class ConcurrentMap
+     *
+     * @brief A thread-safe associative container.
+     *
+     * Keys are distributed over shards according to their hash, and each shard is protected by its own
+     * reader-writer lock. Lookups only take the shared lock of one shard.
+     *
+     * @tparam TKey the type of keys
+     * @tparam TValue the type of values (copied out of the map on lookup)
+     * @tparam THash the hash function of keys
+     *
+     */
+    template <typename TKey, typename TValue, typename THash = std::hash<TKey>>
+    class ConcurrentMap
+    {
+    public:
+        ConcurrentMap(const THash &hash = THash());
+        ConcurrentMap(const ConcurrentMap &) = delete;
+        ConcurrentMap &operator=(const ConcurrentMap &) = delete;
+
+        /**
+         * @brief Get the value associated to a key.
+         *
+         * @param key the key
+         * @param value the value (only assigned if the key is in the map)
+         * @return true if the key is in the map
+         */
+        bool find(const TKey &key, TValue &value) const;
+
+        /**
+         * @brief Associate a value to a key if the key is not yet in the map.
+         *
+         * @param key the key
+         * @param value the value
+         * @return true if the value was inserted
+         */
+        bool insert(const TKey &key, const TValue &value);
+
+        /**
+         * @brief Associate a value to a key, the previous value (if any) is replaced.
+         *
+         * @param key the key
+         * @param value the value
+         */
+        void assign(const TKey &key, const TValue &value);
+
+        /**
+         * @brief Remove a key from the map.
+         *
+         * @param key the key
+         * @return true if the key was in the map
+         */
+        bool erase(const TKey &key);
+
+        /** @brief Get the number of keys in the map. */
+        std::size_t size() const;
+
+        /** @brief Remove all keys from the map. */
+        void clear();
+
+    protected:
+        static constexpr std::size_t NUM_SHARDS = 64;
+
+        struct Shard
+        {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<TKey, TValue, THash> map;
+        };
+
+        THash hash_;
+        std::array<Shard, NUM_SHARDS> shards_;
+
+        Shard &getShard(const TKey &key);
+        const Shard &getShard(const TKey &key) const;
+    };
+
+} // namespace sdm
+
+#include <sdm/utils/struct/concurrent_map.tpp>
@@ -0,0 +1,84 @@
+#include <sdm/utils/struct/concurrent_map.hpp>
+
+namespace sdm
+{
+    template <typename TKey, typename TValue, typename THash>
+    ConcurrentMap<TKey, TValue, THash>::ConcurrentMap(const THash &hash) : hash_(hash)
+    {
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    typename ConcurrentMap<TKey, TValue, THash>::Shard &ConcurrentMap<TKey, TValue, THash>::getShard(const TKey &key)
+    {
+        std::size_t hash = this->hash_(key);
+        return this->shards_[(hash ^ (hash >> 17)) % NUM_SHARDS];
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    const typename ConcurrentMap<TKey, TValue, THash>::Shard &ConcurrentMap<TKey, TValue, THash>::getShard(const TKey &key) const
+    {
+        std::size_t hash = this->hash_(key);
+        return this->shards_[(hash ^ (hash >> 17)) % NUM_SHARDS];
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    bool ConcurrentMap<TKey, TValue, THash>::find(const TKey &key, TValue &value) const
+    {
+        const Shard &shard = this->getShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto iterator = shard.map.find(key);
+        if (iterator == shard.map.end())
+        {
+            return false;
+        }
+        value = iterator->second;
+        return true;
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    bool ConcurrentMap<TKey, TValue, THash>::insert(const TKey &key, const TValue &value)
+    {
+        Shard &shard = this->getShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.map.emplace(key, value).second;
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    void ConcurrentMap<TKey, TValue, THash>::assign(const TKey &key, const TValue &value)
+    {
+        Shard &shard = this->getShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.map.insert_or_assign(key, value);
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    bool ConcurrentMap<TKey, TValue, THash>::erase(const TKey &key)
+    {
+        Shard &shard = this->getShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.map.erase(key) > 0;
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    std::size_t ConcurrentMap<TKey, TValue, THash>::size() const
+    {
+        std::size_t size = 0;
+        for (const auto &shard : this->shards_)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            size += shard.map.size();
+        }
+        return size;
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    void ConcurrentMap<TKey, TValue, THash>::clear()
+    {
+        for (auto &shard : this->shards_)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.map.clear();
+        }
+    }
+
+} // namespace sdm
@@ -70,6 +70,15 @@ namespace sdm
          */
         void addNode(const TNode &node_value);
 
+        /**
+         * @brief Remove a node from the graph.
+         *
+         * The edges that lead to this node are kept but do not lead to any successor anymore.
+         *
+         * @param node_value the value of the node
+         */
+        void removeNode(const TNode &node_value);
+
         /**
          * @brief Get the number of node.
          */
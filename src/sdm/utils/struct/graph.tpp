@@ -31,6 +31,12 @@ namespace sdm
         }
     }
 
+    template <typename TNode, typename TEdge>
+    void Graph<TNode, TEdge>::removeNode(const TNode &node_value)
+    {
+        this->node_space_.erase(node_value);
+    }
+
     template <typename TNode, typename TEdge>
     number Graph<TNode, TEdge>::getNumNodes() const
     {
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <sdm/types.hpp>
+#include <sdm/exception.hpp>
+
+namespace sdm
+{
+
+    /**
+     * @class InterningTable
+     *
+     * @brief A structure that assigns a unique and dense integer identifier to each item.
+     *
+     * Identifiers are given in order of insertion (0, 1, 2, ...) and are never reused, so they can
+     * safely be used as indexes in contiguous arrays.
+     *
+     * @tparam TItem the type of items to intern (must be hashable)
+     *
+     * Basic Usage:
+     *
+     * ```cpp
+     * InterningTable<std::string> table;
+     * table.getID("a"); // OUTPUT : 0
+     * table.getID("b"); // OUTPUT : 1
+     * table.getID("a"); // OUTPUT : 0
+     * table.getItem(1); // OUTPUT : "b"
+     * ```
+     *
+     */
+    template <typename TItem>
+    class InterningTable
+    {
+    public:
+        using id_type = std::uint32_t;
+
+        /** @brief The identifier returned when an item was never interned. */
+        static constexpr id_type NOT_FOUND = std::numeric_limits<id_type>::max();
+
+        InterningTable();
+
+        /**
+         * @brief Get the identifier of an item. The item is interned if it was not yet.
+         *
+         * @param item the item
+         * @return the identifier of the item
+         */
+        id_type getID(const TItem &item);
+
+        /**
+         * @brief Get the identifier of an item without interning it.
+         *
+         * @param item the item
+         * @return the identifier of the item or NOT_FOUND
+         */
+        id_type findID(const TItem &item) const;
+
+        /**
+         * @brief Get the item associated to an identifier.
+         *
+         * @param id the identifier
+         * @return the item
+         */
+        const TItem &getItem(id_type id) const;
+
+        /** @brief Get the number of interned items. */
+        std::size_t size() const;
+
+        /** @brief Remove all interned items. */
+        void clear();
+
+    protected:
+        /** @brief Relation from item to identifier */
+        std::unordered_map<TItem, id_type> item_to_id_;
+
+        /** @brief Relation from identifier to item */
+        std::vector<TItem> id_to_item_;
+    };
+
+} // namespace sdm
+
+#include <sdm/utils/struct/interning_table.tpp>
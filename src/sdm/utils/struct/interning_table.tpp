@@ -0,0 +1,54 @@
+#include <sdm/utils/struct/interning_table.hpp>
+
+namespace sdm
+{
+    template <typename TItem>
+    InterningTable<TItem>::InterningTable()
+    {
+    }
+
+    template <typename TItem>
+    typename InterningTable<TItem>::id_type InterningTable<TItem>::getID(const TItem &item)
+    {
+        auto iterator = this->item_to_id_.find(item);
+        if (iterator != this->item_to_id_.end())
+        {
+            return iterator->second;
+        }
+        id_type id = static_cast<id_type>(this->id_to_item_.size());
+        this->item_to_id_.emplace(item, id);
+        this->id_to_item_.push_back(item);
+        return id;
+    }
+
+    template <typename TItem>
+    typename InterningTable<TItem>::id_type InterningTable<TItem>::findID(const TItem &item) const
+    {
+        auto iterator = this->item_to_id_.find(item);
+        return (iterator != this->item_to_id_.end()) ? iterator->second : NOT_FOUND;
+    }
+
+    template <typename TItem>
+    const TItem &InterningTable<TItem>::getItem(id_type id) const
+    {
+        if (id >= this->id_to_item_.size())
+        {
+            throw sdm::exception::Exception("InterningTable::getItem : unknown identifier " + std::to_string(id));
+        }
+        return this->id_to_item_[id];
+    }
+
+    template <typename TItem>
+    std::size_t InterningTable<TItem>::size() const
+    {
+        return this->id_to_item_.size();
+    }
+
+    template <typename TItem>
+    void InterningTable<TItem>::clear()
+    {
+        this->item_to_id_.clear();
+        this->id_to_item_.clear();
+    }
+
+} // namespace sdm
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+namespace sdm
+{
+
+    /**
+     * @class Span
+     *
+     * @brief A non-owning view over a contiguous sequence of items.
+     *
+     * The view is only valid as long as the underlying storage is neither modified nor destroyed.
+     *
+     * @tparam T the type of items
+     */
+    template <typename T>
+    class Span
+    {
+    public:
+        using value_type = T;
+        using iterator = const T *;
+
+        Span() : data_(nullptr), size_(0) {}
+        Span(const T *data, std::size_t size) : data_(data), size_(size) {}
+        Span(const T *begin, const T *end) : data_(begin), size_(end - begin) {}
+
+        iterator begin() const { return this->data_; }
+        iterator end() const { return this->data_ + this->size_; }
+
+        const T *data() const { return this->data_; }
+        std::size_t size() const { return this->size_; }
+        bool empty() const { return this->size_ == 0; }
+
+        const T &operator[](std::size_t i) const { return this->data_[i]; }
+
+    protected:
+        const T *data_;
+        std::size_t size_;
+    };
+
+} // namespace sdm
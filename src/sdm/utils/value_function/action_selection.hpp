@@ -22,7 +22,7 @@
 
 
 //  ------------------------------------------------------------------------
-// |          INCLUDE CPLEX ACTION SELECTION IMPLEMENTATIONS                |
+// |            INCLUDE LP ACTION SELECTION IMPLEMENTATIONS                 |
 //  ------------------------------------------------------------------------
 
 #include <sdm/utils/value_function/action_selection/lp/action_maxplan_lp.hpp>
@@ -1,12 +1,18 @@
+#include <numeric>
 
 #include <sdm/utils/value_function/action_selection/action_maxplan_base.hpp>
 #include <sdm/utils/value_function/value_function_interface.hpp>
 #include <sdm/utils/value_function/pwlc_value_function_interface.hpp>
 #include <sdm/core/state/interface/occupancy_state_interface.hpp>
+#include <sdm/world/base/pomdp_interface.hpp>
+#include <sdm/utils/parallel/thread_pool.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 
 namespace sdm
 {
 
+    number MaxPlanSelectionBase::NUM_THREADS = 1;
+
     MaxPlanSelectionBase::MaxPlanSelectionBase()
     {
     }
@@ -17,28 +23,134 @@ namespace sdm
 
     Pair<std::shared_ptr<Action>, double> MaxPlanSelectionBase::getGreedyActionAndValue(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, number t)
     {
+        SDMS_TIME_PHASE(GREEDY_ACTION);
+
         // Cast the generic value function into a piece-wise linear convex value function.
         this->pwlc_vf = std::dynamic_pointer_cast<PWLCValueFunctionInterface>(vf);
-        std::shared_ptr<State> ref_state = state;
+        auto pwlc_vf = this->pwlc_vf.lock();
+        auto hyperplanes = pwlc_vf->getHyperplanesAt(state, t + 1);
+        auto pool = ThreadPool::get(MaxPlanSelectionBase::NUM_THREADS);
+
+        // Create the successors of the joint histories once, so that workers only look them up
+        this->expandSuccessors(state, t);
+
+        // Compute an upper bound on the value of each hyperplan
+        std::vector<double> upper_bounds(hyperplanes.size());
+        pool->parallel_for(hyperplanes.size(), [&](std::size_t begin, std::size_t end)
+                           {
+                               for (std::size_t k = begin; k < end; k++)
+                               {
+                                   upper_bounds[k] = this->getUpperBound(pwlc_vf, state, hyperplanes[k], t);
+                               }
+                           });
 
-        // Instanciate return variables
+        // Go over the most promising hyperplanes first, so that the best value found quickly rules out the others
+        std::vector<std::size_t> order(hyperplanes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&upper_bounds](std::size_t k1, std::size_t k2)
+                         { return upper_bounds[k1] > upper_bounds[k2]; });
+
+        // Instanciate return variables (ties are broken in favor of the first hyperplane, whatever the scheduling)
+        std::mutex max_mutex;
         std::shared_ptr<Action> max_decision_rule;
         double max_value = -std::numeric_limits<double>::max();
+        std::size_t max_position = hyperplanes.size();
+
+        // Each thread takes the next hyperplan in the order
+        std::atomic<std::size_t> next_rank(0);
+        pool->parallel_for(pool->getNumThreads(), [&](std::size_t, std::size_t)
+                           {
+                               std::size_t rank;
+                               while ((rank = next_rank++) < order.size())
+                               {
+                                   std::size_t k = order[rank];
+                                   {
+                                       std::lock_guard<std::mutex> lock(max_mutex);
+                                       if ((upper_bounds[k] < max_value) || ((upper_bounds[k] == max_value) && (k > max_position)))
+                                       {
+                                           this->num_skipped_hyperplanes_++;
+                                           continue;
+                                       }
+                                   }
+
+                                   // Compute the greedy action and value for a given hyperplan
+                                   Pair<std::shared_ptr<Action>, double> pair_action_value;
+                                   {
+                                       std::lock_guard<std::mutex> lock(this->solve_mutex_);
+                                       SDMS_TIME_PHASE(SOLVE_PROGRAM);
+                                       pair_action_value = this->computeGreedyActionAndValue(pwlc_vf, state, hyperplanes[k], t);
+                                   }
+                                   this->num_solved_hyperplanes_++;
+
+                                   // Select the Best Action
+                                   std::lock_guard<std::mutex> lock(max_mutex);
+                                   if ((pair_action_value.second > max_value) || ((pair_action_value.second == max_value) && (k < max_position)))
+                                   {
+                                       max_decision_rule = pair_action_value.first;
+                                       max_value = pair_action_value.second;
+                                       max_position = k;
+                                   }
+                               }
+                           });
 
-        // Go over all hyperplan in the Support
-        for (const auto &hyperplane : this->pwlc_vf.lock()->getHyperplanesAt(ref_state, t + 1))
+        return {max_decision_rule, max_value};
+    }
+
+    double MaxPlanSelectionBase::getUpperBound(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &hyperplane, number t)
+    {
+        auto occupancy_state = std::dynamic_pointer_cast<OccupancyStateInterface>(state);
+        if (occupancy_state == nullptr)
         {
-            // Compute the greedy action and value for a given hyperplan
-            auto pair_action_value = this->computeGreedyActionAndValue(this->pwlc_vf.lock(), ref_state, hyperplane, t);
+            return std::numeric_limits<double>::max();
+        }
 
-            // Select the Best Action
-            if (pair_action_value.second > max_value)
+        // Compute \sum_{o} \max_{u} w(o,u)
+        double upper_bound = 0.0;
+        for (const auto &joint_history : occupancy_state->getJointHistories())
+        {
+            double max_weight = std::numeric_limits<double>::lowest();
+            for (const auto &action : *this->getWorld()->getUnderlyingProblem()->getActionSpace(t))
             {
-                max_decision_rule = pair_action_value.first;
-                max_value = pair_action_value.second;
+                max_weight = std::max(max_weight, this->getWeight(vf, occupancy_state, joint_history, action->toAction(), hyperplane, t));
             }
+            upper_bound += max_weight;
         }
-        return {max_decision_rule, max_value};
+        return upper_bound;
+    }
+
+    void MaxPlanSelectionBase::expandSuccessors(const std::shared_ptr<State> &state, number t)
+    {
+        auto occupancy_state = std::dynamic_pointer_cast<OccupancyStateInterface>(state);
+        auto pomdp = std::dynamic_pointer_cast<POMDPInterface>(this->getWorld()->getUnderlyingProblem());
+        if ((occupancy_state == nullptr) || (pomdp == nullptr))
+        {
+            return;
+        }
+
+        // Go over the pairs (o, z) used by the beta values of all hyperplanes
+        for (const auto &joint_history : occupancy_state->getJointHistories())
+        {
+            for (const auto &x : occupancy_state->getBeliefAt(joint_history)->getStates())
+            {
+                for (const auto &action : *pomdp->getActionSpace(t))
+                {
+                    for (const auto &transition : pomdp->getReachableDynamics(x, action->toAction(), t))
+                    {
+                        joint_history->expand(transition.observation);
+                    }
+                }
+            }
+        }
+    }
+
+    unsigned long long MaxPlanSelectionBase::getNumSolvedHyperplanes() const
+    {
+        return this->num_solved_hyperplanes_;
+    }
+
+    unsigned long long MaxPlanSelectionBase::getNumSkippedHyperplanes() const
+    {
+        return this->num_skipped_hyperplanes_;
     }
 
     double MaxPlanSelectionBase::getWeight(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<JointHistoryInterface> &joint_history, const std::shared_ptr<Action> &action, const std::shared_ptr<Hyperplane> &hyperplane, number t)
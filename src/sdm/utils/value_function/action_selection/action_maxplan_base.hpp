@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <atomic>
+
 #include <sdm/utils/config.hpp>
 #include <sdm/core/state/interface/belief_interface.hpp>
 #include <sdm/utils/value_function/action_selection/action_selection_base.hpp>
@@ -14,6 +17,11 @@ namespace sdm
     class MaxPlanSelectionBase : public ActionSelectionBase
     {
     public:
+        /**
+         * @brief The number of threads used to go over the hyperplanes.
+         */
+        static number NUM_THREADS;
+
         MaxPlanSelectionBase();
         MaxPlanSelectionBase(const std::shared_ptr<SolvableByDP> &world);
 
@@ -27,9 +35,56 @@ namespace sdm
          */
         Pair<std::shared_ptr<Action>, double> getGreedyActionAndValue(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, number t);
 
+        /**
+         * @brief Get the number of hyperplanes for which the greedy action was computed.
+         */
+        unsigned long long getNumSolvedHyperplanes() const;
+
+        /**
+         * @brief Get the number of hyperplanes skipped because their upper bound could not beat the best value found.
+         */
+        unsigned long long getNumSkippedHyperplanes() const;
+
     protected:
         std::weak_ptr<PWLCValueFunctionInterface> pwlc_vf;
 
+        /**
+         * @brief Statistics of the hyperplanes gone over.
+         */
+        std::atomic<unsigned long long> num_solved_hyperplanes_{0}, num_skipped_hyperplanes_{0};
+
+        /**
+         * @brief Serialize calls to computeGreedyActionAndValue.
+         *
+         * The WCSP and LP selections reuse one model (and ToulBar2 one global state) from a hyperplane to the
+         * next, so exact solves run one at a time : only the bounds, the scheduling and the skipping are parallel.
+         */
+        std::mutex solve_mutex_;
+
+        /**
+         * @brief Get an upper bound on the value returned by computeGreedyActionAndValue for a given hyperplane.
+         *
+         * The default bound relaxes the decentralized problem : each joint history gets the joint action
+         * maximizing its weight, i.e. \sum_{o} \max_{u} w(o,u). The bound of a state that is not an occupancy state is infinite.
+         *
+         * @param vf the value function
+         * @param state the state
+         * @param hyperplane the next hyperplane
+         * @param t the time step
+         * @return the upper bound
+         */
+        virtual double getUpperBound(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &hyperplane, number t);
+
+        /**
+         * @brief Expand, before the hyperplanes are gone over in parallel, the joint histories reached from an occupancy state.
+         *
+         * Expansions are thread-safe, but workers then only look up existing children of the history trie.
+         *
+         * @param state the state
+         * @param t the time step
+         */
+        void expandSuccessors(const std::shared_ptr<State> &state, number t);
+
         /**
          * @brief Compute the greedy action and corresponding value for a specific next hyperplan (saved in the temporary representation).
          *
@@ -46,6 +46,11 @@ namespace sdm
         return std::make_pair(decision_rule, decision_rule_value);
     }
 
+    double ActionSelectionMaxplanSerial::getUpperBound(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &, const std::shared_ptr<Hyperplane> &, number)
+    {
+        return std::numeric_limits<double>::max();
+    }
+
     Pair<std::shared_ptr<Action>, double> ActionSelectionMaxplanSerial::selectBestAction(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyState> &occupancy_state, const std::shared_ptr<Hyperplane> &next_hyperplane, const std::shared_ptr<HistoryInterface> &ihistory, number t)
     {
         std::shared_ptr<Action> best_action;
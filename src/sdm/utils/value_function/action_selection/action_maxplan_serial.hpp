@@ -28,6 +28,11 @@ namespace sdm
         double evaluateAction(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyState> &private_occupancy_state, const std::shared_ptr<Action> &action, const std::shared_ptr<Hyperplane> &next_hyperplane, number t);
 
     protected:
+        /**
+         * @brief Serial decision rules are computed in closed form, so hyperplanes are never skipped.
+         */
+        double getUpperBound(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &hyperplane, number t);
+
         std::shared_ptr<SerialProblemInterface> getSerialProblem() const;
         std::shared_ptr<SerialProblemInterface> serial_mpomdp;
     };
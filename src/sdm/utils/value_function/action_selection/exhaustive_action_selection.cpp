@@ -1,5 +1,6 @@
 #include <sdm/utils/value_function/action_selection/exhaustive_action_selection.hpp>
 #include <sdm/utils/value_function/value_function_interface.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 
 namespace sdm
 {
@@ -9,6 +10,8 @@ namespace sdm
 
     Pair<std::shared_ptr<Action>, double> ExhaustiveActionSelection::getGreedyActionAndValue(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<State> &state, number t)
     {
+        SDMS_TIME_PHASE(GREEDY_ACTION);
+
         std::shared_ptr<Action> best_action;
         double max = -std::numeric_limits<double>::max(), tmp;
 
@@ -1,4 +1,3 @@
-#ifdef WITH_CPLEX
 #include <sdm/utils/value_function/action_selection/lp/action_maxplan_lp.hpp>
 #include <sdm/utils/value_function/pwlc_value_function_interface.hpp>
 
@@ -21,7 +20,12 @@ namespace sdm
         return this->createLP(vf, state, t);
     }
 
-    void ActionSelectionMaxplanLP::createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<State> &state, IloNumVarArray &var, IloObjective &obj, number t)
+    bool ActionSelectionMaxplanLP::isModelReusable(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, number t) const
+    {
+        return (vf == this->lp_value_function_.lock()) && (state == this->lp_state_) && (t == this->lp_time_step_);
+    }
+
+    void ActionSelectionMaxplanLP::createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<State> &state, LPSolverInterface &lp, number t)
     {
         auto mpomdp = MaxPlanSelectionBase::getWorld()->getUnderlyingProblem();
         auto occupancy_state = state->toOccupancyState();
@@ -42,10 +46,8 @@ namespace sdm
                 recover = this->getNumber(this->getVarNameJointHistoryDecisionRule(action->toAction(), joint_history));
 
                 //<! 1.c set coefficient of variable a(u|o) i.e., s(x,o)  [ r(x,u) + \gamma \sum_{x_,z_} P(x_,z_|x,u) * \hyperplan_i(x_,o_)  ]
-                obj.setLinearCoef(var[recover], weight);
+                lp.setObjectiveCoefficient(recover, weight);
             } // for all u
         }     // for all o
     }
 }
-
-#endif
\ No newline at end of file
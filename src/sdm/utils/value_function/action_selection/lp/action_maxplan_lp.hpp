@@ -1,5 +1,3 @@
-#ifdef WITH_CPLEX
-
 #pragma once
 
 #include <sdm/utils/linear_programming/decentralized_lp_problem.hpp>
@@ -17,17 +15,19 @@ namespace sdm
          * @brief Create a Objective Constraint of the LP
          *
          * @param occupancy_state
-         * @param var
-         * @param obj
+         * @param lp
          * @param t
          */
-        void createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, IloNumVarArray &var, IloObjective &obj, number t);
+        void createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t);
 
     protected:
         Pair<std::shared_ptr<Action>, double> computeGreedyActionAndValue(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &hyperplane, number t);
 
+        /**
+         * @brief Hyperplanes only change the objective function : the model of a state is kept while going over hyperplanes.
+         */
+        bool isModelReusable(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, number t) const;
+
         std::shared_ptr<Hyperplane> current_hyperplane;
     };
 }
-
-#endif
\ No newline at end of file
@@ -1,4 +1,3 @@
-#ifdef WITH_CPLEX
 #include <sdm/utils/value_function/action_selection/lp/action_sawtooth_lp.hpp>
 #include <sdm/core/state/interface/occupancy_state_interface.hpp>
 #include <sdm/core/state/private_occupancy_state.hpp>
@@ -6,6 +5,7 @@
 
 #include <sdm/world/base/mpomdp_interface.hpp>
 #include <sdm/world/occupancy_mdp.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 
 namespace sdm
 {
@@ -36,26 +36,27 @@ namespace sdm
 
     Pair<std::shared_ptr<Action>, double> ActionSelectionSawtoothLP::getGreedyActionAndValue(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &one_step_uncompressed_state, number t)
     {
+        SDMS_TIME_PHASE(GREEDY_ACTION);
         this->sawtooth_vf = std::dynamic_pointer_cast<SawtoothValueFunction>(vf);
 
+        SDMS_TIME_PHASE(SOLVE_PROGRAM);
         auto result = this->createLP(vf, one_step_uncompressed_state->toOccupancyState()->getCompressedOccupancy(), t);
         return result;
     }
 
-    void ActionSelectionSawtoothLP::createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &, IloNumVarArray &var, IloObjective &obj, number)
+    void ActionSelectionSawtoothLP::createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &, LPSolverInterface &lp, number)
     {
         // <! 1.a get variable v
         auto recover = this->getNumber(this->getVarNameWeight(0));
-        obj.setLinearCoef(var[recover], 1);
+        lp.setObjectiveCoefficient(recover, 1);
     }
 
-    void ActionSelectionSawtoothLP::createVariables(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &state, IloEnv &env, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLP::createVariables(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &state, LPSolverInterface &lp, number t)
     {
 
         //<! 0.b Build variables v_0 = objective variable!
         std::string VarName = this->getVarNameWeight(0);
-        var.add(IloNumVar(env, -IloInfinity, IloInfinity, VarName.c_str()));
-        this->setNumber(VarName, index++);
+        this->setNumber(VarName, lp.addVariable(VarName, -LPSolverInterface::INF, LPSolverInterface::INF));
 
         //<! Define variables \omega_k(x',o')
         // Go over all Point Set in t+1
@@ -72,19 +73,18 @@ namespace sdm
                 {
                     // <! \omega_k(x',o')
                     VarName = this->getVarNameWeightedStateJointHistory(s_k, next_state, next_jhistory);
-                    var.add(IloBoolVar(env, 0, 1, VarName.c_str()));
-                    this->setNumber(VarName, index++);
+                    this->setNumber(VarName, lp.addVariable(VarName, 0, 1, true));
                 }
             }
         }
 
         // Create Decentralized Variables
-        DecentralizedLP::createVariables(getSawtoothValueFunction(), state, env, var, index, t);
+        DecentralizedLP::createVariables(getSawtoothValueFunction(), state, lp, t);
     }
 
     //<!  Build sawtooth constraints v - \sum_{u} a(u|o) * Q(k,s,o,u,y,z, diff, t  ) + \omega_k(y,<o,z>)*M <= M,  \forall k, y,<o,z>
     //<!  Build sawtooth constraints  Q(k,s,o,u,y,z, diff, t ) = (v_k - V_k) \frac{\sum_{x} s(x,o) * p(x,u,z,y)}}{s_k(y,<o,z>)},  \forall a(u|o)
-    void ActionSelectionSawtoothLP::createConstraints(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &occupancy_state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLP::createConstraints(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t)
     {
         assert(getSawtoothValueFunction()->getInitFunction() != nullptr);
 
@@ -93,7 +93,7 @@ namespace sdm
         bool is_empty = getSawtoothValueFunction()->getRepresentation(t + 1).empty();
         if (is_empty)
         {
-            this->createInitialConstraints(compressed_occupancy_state, env, con, var, index, t);
+            this->createInitialConstraints(compressed_occupancy_state, lp, t);
         }
         else
         {
@@ -115,23 +115,23 @@ namespace sdm
                         switch (this->current_type_of_resolution_)
                         {
                         case TypeOfResolution::BigM:
-                            this->createSawtoothBigM(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, env, con, var, index, t);
+                            this->createSawtoothBigM(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, lp, t);
                             break;
                         case TypeOfResolution::IloIfThenResolution:
-                            this->createSawtoothIloIfThen(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, env, model, var, t);
+                            this->createSawtoothIloIfThen(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, lp, t);
                             break;
                         }
                     }
                 }
             }
 
-            this->createOmegaConstraints(env, con, var, index, t);
+            this->createOmegaConstraints(lp, t);
         }
 
-        DecentralizedLP::createConstraints(getSawtoothValueFunction(), occupancy_state, env, model, con, var, index, t);
+        DecentralizedLP::createConstraints(getSawtoothValueFunction(), occupancy_state, lp, t);
     }
 
-    void ActionSelectionSawtoothLP::createOmegaConstraints(IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLP::createOmegaConstraints(LPSolverInterface &lp, number t)
     {
         number recover = 0;
         // Go over all points in the point set at t+1
@@ -140,7 +140,7 @@ namespace sdm
             const auto &s_k = point_k.first->toOccupancyState();
 
             // Build constraint \sum{x',o'} \omega_k(x',o') = 1
-            con.add(IloRange(env, 1.0, 1.0));
+            std::vector<Pair<std::size_t, double>> coefficients;
 
             // Go over all Joint History Next
             for (const auto &next_jhistory : s_k->getJointHistories())
@@ -151,22 +151,21 @@ namespace sdm
                     // <! \omega_k(x',o')
                     auto VarName = this->getVarNameWeightedStateJointHistory(s_k, next_state, next_jhistory);
                     recover = this->getNumber(VarName);
-                    con[index].setLinearCoef(var[recover], +1.0);
+                    coefficients.push_back({recover, +1.0});
                 }
             }
-            index++;
+            lp.addConstraint(coefficients, 1.0, 1.0);
         }
     }
 
-    void ActionSelectionSawtoothLP::createInitialConstraints(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLP::createInitialConstraints(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, LPSolverInterface &lp, number t)
     {
         auto underlying_problem = ActionSelectionBase::getWorld()->getUnderlyingProblem();
         auto relaxation = std::static_pointer_cast<RelaxedValueFunction>(getSawtoothValueFunction()->getInitFunction());
         number recover = 0;
         double coef;
 
-        con.add(IloRange(env, -IloInfinity, 0));
-        con[index].setLinearCoef(var[this->getNumber(this->getVarNameWeight(0))], +1.0);
+        std::vector<Pair<std::size_t, double>> coefficients = {{this->getNumber(this->getVarNameWeight(0)), +1.0}};
 
         // Go over all actions
         for (const auto &u : *underlying_problem->getActionSpace(t))
@@ -179,10 +178,10 @@ namespace sdm
                 //<! 1.c.4 get variable a(u|o) and set constant
                 recover = this->getNumber(this->getVarNameJointHistoryDecisionRule(action, joint_history));
 
-                con[index].setLinearCoef(var[recover], -coef);
+                coefficients.push_back({recover, -coef});
             }
         }
-        index++;
+        lp.addConstraint(coefficients, -LPSolverInterface::INF, 0);
     }
 
     // double getQRelaxation()
@@ -190,7 +189,7 @@ namespace sdm
     //     return oMDP->getReward(state, action, t) + oMDP->getDiscount(t) * sawtooth_vf->getInitFunction()->operator()(next_state, t + 1);
     // }
 
-    void ActionSelectionSawtoothLP::createSawtoothBigM(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLP::createSawtoothBigM(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, LPSolverInterface &lp, number t)
     {
         auto underlying_problem = ActionSelectionBase::getWorld()->getUnderlyingProblem();
         auto oMDP = std::dynamic_pointer_cast<BeliefMDPInterface>(ActionSelectionBase::getWorld());
@@ -199,8 +198,7 @@ namespace sdm
         double coef, ratio, difference = this->sawtooth_vf->getValueAt(s_k, t + 1) - this->sawtooth_vf->getRelaxedValueAt(s_k, t + 1);
         ;
 
-        con.add(IloRange(env, -IloInfinity, this->bigM_value_));
-        con[index].setLinearCoef(var[this->getNumber(this->getVarNameWeight(0))], +1.0);
+        std::vector<Pair<std::size_t, double>> coefficients = {{this->getNumber(this->getVarNameWeight(0)), +1.0}};
 
         // Go over all actions
         for (const auto &u : *underlying_problem->getActionSpace(t))
@@ -217,17 +215,17 @@ namespace sdm
                 //<! 1.c.4 get variable a(u|o) and set constant
                 recover = this->getNumber(this->getVarNameJointHistoryDecisionRule(action, joint_history));
 
-                con[index].setLinearCoef(var[recover], -coef);
+                coefficients.push_back({recover, -coef});
             }
         }
         // <! \omega_k(x',o') * BigM
         recover = this->getNumber(this->getVarNameWeightedStateJointHistory(s_k, next_state, next_joint_history));
-        con[index].setLinearCoef(var[recover], this->bigM_value_);
+        coefficients.push_back({recover, double(this->bigM_value_)});
 
-        index++;
+        lp.addConstraint(coefficients, -LPSolverInterface::INF, this->bigM_value_);
     }
 
-    void ActionSelectionSawtoothLP::createSawtoothIloIfThen(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, IloEnv &env, IloModel &model, IloNumVarArray &var, number t)
+    void ActionSelectionSawtoothLP::createSawtoothIloIfThen(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, LPSolverInterface &lp, number t)
     {
         auto underlying_problem = ActionSelectionBase::getWorld()->getUnderlyingProblem();
         auto oMDP = std::dynamic_pointer_cast<BeliefMDPInterface>(ActionSelectionBase::getWorld());
@@ -235,9 +233,8 @@ namespace sdm
         number recover = 0;
         double coef, ratio, difference = this->sawtooth_vf->getValueAt(s_k, t + 1) - this->sawtooth_vf->getRelaxedValueAt(s_k, t + 1);
 
-        IloExpr expr(env);
         //<! 1.c.1 get variable v and set coefficient of variable v
-        expr = var[this->getNumber(this->getVarNameWeight(0))];
+        std::vector<Pair<std::size_t, double>> coefficients = {{this->getNumber(this->getVarNameWeight(0)), +1.0}};
 
         // Go over all actions
         for (const auto &u : *underlying_problem->getActionSpace(t))
@@ -251,13 +248,13 @@ namespace sdm
 
                 ratio = this->computeRatio(oMDP, belief, joint_history, action, /* witness point */ s_k, /* support of witness point */ next_state, next_joint_history, /* to be kept */ next_observation, t);
                 coef = occupancy_state->getProbability(joint_history) * (relaxation->getQValueAt(belief, action, t) + difference * ratio);
-                expr -= var[recover] * coef;
+                coefficients.push_back({recover, -coef});
             }
         }
 
         // <! get variable \omega_k(x',o')
         recover = this->getNumber(this->getVarNameWeightedStateJointHistory(s_k, next_state, next_joint_history));
-        model.add(IloIfThen(env, var[recover] > 0, expr <= 0));
+        lp.addIndicatorConstraint(recover, coefficients, 0);
     }
 
     double ActionSelectionSawtoothLP::computeRatio(const std::shared_ptr<BeliefMDPInterface> &oMDP,
@@ -288,5 +285,3 @@ namespace sdm
         return this->sawtooth_vf;
     }
 }
-
-#endif
\ No newline at end of file
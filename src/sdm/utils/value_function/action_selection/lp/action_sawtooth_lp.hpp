@@ -1,4 +1,3 @@
-#ifdef WITH_CPLEX
 #pragma once
 
 #include <sdm/utils/linear_programming/decentralized_lp_problem.hpp>
@@ -30,39 +29,30 @@ namespace sdm
          *
          * @param const std::shared_ptr<ValueFunction>& vf : Value function
          * @param const std::shared_ptr<State> & occupancy_state : current state
-         * @param IloEnv & : env
-         * @param IloNumVarArray & : var
-         * @param double& index
+         * @param LPSolverInterface & : lp
          * @param number t : Time Step
          */
-        virtual void createVariables(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, IloEnv &env, IloNumVarArray &var, number &index, number t);
+        virtual void createVariables(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t);
 
         /**
          * @brief Create the constraints of the LP
          *
          * @param const std::shared_ptr<ValueFunction>& vf : Value function
          * @param const std::shared_ptr<State> & occupancy_state : current state
-         * @param IloEnv & : env
-         * @param IloModel & : var
-         * @param IloRangeArray& : model
-         * @param IloRangeArray &con
-         * @param IloNumVarArray &var
-         * @param double& index
+         * @param LPSolverInterface & : lp
          * @param number t : Time Step
          */
-        virtual void createConstraints(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t);
+        virtual void createConstraints(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t);
 
         /**
          * @brief Create a Objective Constraint of the LP
          *
          * @param const std::shared_ptr<ValueFunctionInterface>& vf : Value function
          * @param const std::shared_ptr<State> & occupancy_state : current state
-         * @param IloModel & : var
-         * @param IloObjective& : obj
-         * @param double& index
+         * @param LPSolverInterface & : lp
          * @param number t : Time Step
          */
-        virtual void createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, IloNumVarArray &var, IloObjective &obj, number t);
+        virtual void createObjectiveFunction(const std::shared_ptr<ValueFunctionInterface> &vf, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t);
 
         std::shared_ptr<SawtoothValueFunction> getSawtoothValueFunction() const;
 
@@ -99,16 +89,13 @@ namespace sdm
          * @param next_state the next state
          * @param next_joint_history the next history
          * @param next_observation the next observation
-         * @param env CPLEX environment
-         * @param con CPLEX constraints
-         * @param var CPLEX variables
-         * @param index index of the constraint
+         * @param lp the linear program
          * @param t the time step
          */
-        virtual void createSawtoothBigM(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &next_occupancy_state, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t);
+        virtual void createSawtoothBigM(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &next_occupancy_state, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, LPSolverInterface &lp, number t);
 
         /**
-         * @brief Create constraints based on IloIfThen method
+         * @brief Create constraints based on indicator constraints (IloIfThen method)
          *
          * @param value_function the sawtooth value function
          * @param occupancy_state the current one step uncompressed occupancy state
@@ -116,16 +103,14 @@ namespace sdm
          * @param next_state the next state
          * @param next_joint_history the next history
          * @param next_observation the next observation
-         * @param env CPLEX environment
-         * @param model CPLEX model
-         * @param var CPLEX variables
+         * @param lp the linear program
          * @param t the time step
          */
-        virtual void createSawtoothIloIfThen(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &next_occupancy_state, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, IloEnv &env, IloModel &model, IloNumVarArray &var, number t);
+        virtual void createSawtoothIloIfThen(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &next_occupancy_state, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, LPSolverInterface &lp, number t);
 
-        virtual void createInitialConstraints(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t);
+        virtual void createInitialConstraints(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, LPSolverInterface &lp, number t);
 
-        virtual void createOmegaConstraints(IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t);
+        virtual void createOmegaConstraints(LPSolverInterface &lp, number t);
 
         virtual std::shared_ptr<JointObservation> determineNextJointObservation(const std::shared_ptr<JointHistoryInterface> &, number t);
 
@@ -136,5 +121,3 @@ namespace sdm
                             const std::shared_ptr<Observation> &observation, number t);
     };
 }
-
-#endif
\ No newline at end of file
@@ -1,4 +1,3 @@
-#ifdef WITH_CPLEX
 #include <sdm/utils/value_function/action_selection/lp/action_sawtooth_lp_serial.hpp>
 #include <sdm/core/state/interface/occupancy_state_interface.hpp>
 #include <sdm/core/state/private_occupancy_state.hpp>
@@ -35,12 +34,11 @@ namespace sdm
         return this->serial_oMDP;
     }
 
-    void ActionSelectionSawtoothLPSerial::createVariables(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &state, IloEnv &env, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLPSerial::createVariables(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &state, LPSolverInterface &lp, number t)
     {
         //<! 0.b Build variables v_0 = objective variable!
         std::string VarName = this->getVarNameWeight(0);
-        var.add(IloNumVar(env, -IloInfinity, IloInfinity, VarName.c_str()));
-        this->setNumber(VarName, index++);
+        this->setNumber(VarName, lp.addVariable(VarName, -LPSolverInterface::INF, LPSolverInterface::INF));
 
         //<! Define variables \omega_k(x',o')
         // Go over all Point Set in t+1
@@ -56,16 +54,15 @@ namespace sdm
                 {
                     // <! \omega_k(x',o')
                     VarName = this->getVarNameWeightedStateJointHistory(s_k, next_state, next_jhistory);
-                    var.add(IloBoolVar(env, 0, 1, VarName.c_str()));
-                    this->setNumber(VarName, index++);
+                    this->setNumber(VarName, lp.addVariable(VarName, 0, 1, true));
                 }
             }
         }
         // Create Individual Variables
-        IndividualLP::createVariables(getSawtoothValueFunction(), state, env, var, index, t, this->getSerialOccupancyMDP()->getAgentId(t));
+        IndividualLP::createVariables(getSawtoothValueFunction(), state, lp, t, this->getSerialOccupancyMDP()->getAgentId(t));
     }
 
-    void ActionSelectionSawtoothLPSerial::createConstraints(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &occupancy_state, IloEnv &env, IloModel &model, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLPSerial::createConstraints(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &occupancy_state, LPSolverInterface &lp, number t)
     {
         assert(getSawtoothValueFunction()->getInitFunction() != nullptr);
 
@@ -73,7 +70,7 @@ namespace sdm
 
         if (getSawtoothValueFunction()->getSupport(t + 1).empty())
         {
-            this->createInitialConstraints(compressed_occupancy_state, env, con, var, index, t);
+            this->createInitialConstraints(compressed_occupancy_state, lp, t);
         }
         else
         {
@@ -95,29 +92,29 @@ namespace sdm
                         switch (this->current_type_of_resolution_)
                         {
                         case TypeOfResolution::BigM:
-                            this->createSawtoothBigM(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, env, con, var, index, t);
+                            this->createSawtoothBigM(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, lp, t);
                             break;
                         case TypeOfResolution::IloIfThenResolution:
-                            this->createSawtoothIloIfThen(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, env, model, var, t);
+                            this->createSawtoothIloIfThen(compressed_occupancy_state, s_k, next_state, next_jhistory, next_joint_observation, lp, t);
                             break;
                         }
                     }
                 }
             }
 
-            this->createOmegaConstraints(env, con, var, index, t);
+            this->createOmegaConstraints(lp, t);
         }
         // Create Individual Constraints
-        IndividualLP::createConstraints(getSawtoothValueFunction(), occupancy_state, env, model, con, var, index, t, this->getSerialOccupancyMDP()->getAgentId(t));
+        IndividualLP::createConstraints(getSawtoothValueFunction(), occupancy_state, lp, t, this->getSerialOccupancyMDP()->getAgentId(t));
     }
 
-    std::shared_ptr<Action> ActionSelectionSawtoothLPSerial::getVariableResult(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &state, const IloCplex &cplex, const IloNumVarArray &var, number t)
+    std::shared_ptr<Action> ActionSelectionSawtoothLPSerial::getVariableResult(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &state, const LPSolverInterface &lp, number t)
     {
         // Determine the element useful for create a DeterminiticDecisionRule
-        return IndividualLP::getVariableResult(getSawtoothValueFunction(), state, cplex, var, t, this->getSerialOccupancyMDP()->getAgentId(t));
+        return IndividualLP::getVariableResult(getSawtoothValueFunction(), state, lp, t, this->getSerialOccupancyMDP()->getAgentId(t));
     }
 
-    void ActionSelectionSawtoothLPSerial::createInitialConstraints(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    void ActionSelectionSawtoothLPSerial::createInitialConstraints(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, LPSolverInterface &lp, number t)
     {
         auto serial_mpomdp = this->getSerialOccupancyMDP()->getUnderlyingSerialMPOMDP();
         auto relaxation = std::static_pointer_cast<RelaxedValueFunction>(getSawtoothValueFunction()->getInitFunction());
@@ -127,8 +124,7 @@ namespace sdm
         number agent_id = this->getSerialOccupancyMDP()->getAgentId(t);
         auto compressed_occupancy_state = std::dynamic_pointer_cast<OccupancyState>(occupancy_state);
 
-        con.add(IloRange(env, -IloInfinity, 0));
-        con[index].setLinearCoef(var[this->getNumber(this->getVarNameWeight(0))], +1.0);
+        std::vector<Pair<std::size_t, double>> coefficients = {{this->getNumber(this->getVarNameWeight(0)), +1.0}};
 
         // Go over all actions
         for (const auto &u : *serial_mpomdp->getActionSpace(t))
@@ -144,14 +140,14 @@ namespace sdm
                 {
                     Qrelaxation += compressed_occupancy_state->getProbability(joint_history) * relaxation->getQValueAt(compressed_occupancy_state->getBeliefAt(joint_history), action, t);
                 }
-                con[index].setLinearCoef(var[recover], -Qrelaxation);
+                coefficients.push_back({recover, -Qrelaxation});
             }
         }
-        index++;
+        lp.addConstraint(coefficients, -LPSolverInterface::INF, 0);
     }
 
-    // void ActionSelectionSawtoothLPSerial::createSawtoothBigM(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &, const std::shared_ptr<JointHistoryInterface> &, const std::shared_ptr<State> &, const std::shared_ptr<Observation> &, const std::shared_ptr<JointHistoryInterface> &, const std::shared_ptr<State> &, double, double, IloEnv &, IloRangeArray &, IloNumVarArray &, number &, number)
-    void ActionSelectionSawtoothLPSerial::createSawtoothBigM(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, IloEnv &env, IloRangeArray &con, IloNumVarArray &var, number &index, number t)
+    // void ActionSelectionSawtoothLPSerial::createSawtoothBigM(const std::shared_ptr<ValueFunctionInterface> &, const std::shared_ptr<State> &, const std::shared_ptr<JointHistoryInterface> &, const std::shared_ptr<State> &, const std::shared_ptr<Observation> &, const std::shared_ptr<JointHistoryInterface> &, const std::shared_ptr<State> &, double, double, LPSolverInterface &, number)
+    void ActionSelectionSawtoothLPSerial::createSawtoothBigM(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, LPSolverInterface &lp, number t)
     {
         throw sdm::exception::NotImplementedException("NotImplementedException raised in ActionSelectionSawtoothLPSerial::createSawtoothBigM");
         // try
@@ -189,7 +185,7 @@ namespace sdm
         // }
     }
 
-    void ActionSelectionSawtoothLPSerial::createSawtoothIloIfThen(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, IloEnv &env, IloModel &model, IloNumVarArray &var, number t)
+    void ActionSelectionSawtoothLPSerial::createSawtoothIloIfThen(const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<OccupancyStateInterface> &s_k, const std::shared_ptr<State> &next_state, const std::shared_ptr<JointHistoryInterface> &next_joint_history, const std::shared_ptr<Observation> &next_observation, LPSolverInterface &lp, number t)
     {
         auto serial_mpomdp = this->getSerialOccupancyMDP()->getUnderlyingSerialMPOMDP();
         auto relaxation = std::static_pointer_cast<RelaxedValueFunction>(sawtooth_vf->getInitFunction());
@@ -200,9 +196,8 @@ namespace sdm
         number agent_id = this->getSerialOccupancyMDP()->getAgentId(t);
         auto compressed_occupancy_state = std::dynamic_pointer_cast<OccupancyState>(occupancy_state);
 
-        IloExpr expr(env);
         //<! 1.c.1 get variable v and set coefficient of variable v
-        expr = var[this->getNumber(this->getVarNameWeight(0))];
+        std::vector<Pair<std::size_t, double>> coefficients = {{this->getNumber(this->getVarNameWeight(0)), +1.0}};
 
         // Go over all actions
         for (const auto &u : *serial_mpomdp->getActionSpace(t))
@@ -220,13 +215,13 @@ namespace sdm
                     coef += compressed_occupancy_state->getProbability(joint_history) * (relaxation->getQValueAt(belief, action, t) + difference * ratio);
                 }
                 //<! 1.c.4 get variable a(u|o) and set constant
-                expr -= var[recover] * coef;
+                coefficients.push_back({recover, -coef});
             }
         }
 
         // <! get variable \omega_k(x',o')
         recover = this->getNumber(this->getVarNameWeightedStateJointHistory(s_k, next_state, next_joint_history));
-        model.add(IloIfThen(env, var[recover] > 0, expr <= 0));
+        lp.addIndicatorConstraint(recover, coefficients, 0);
     }
 
     std::shared_ptr<JointObservation> ActionSelectionSawtoothLPSerial::determineNextJointObservation(const std::shared_ptr<JointHistoryInterface> &next_joint_history, number t)
@@ -234,5 +229,3 @@ namespace sdm
         return (this->getSerialOccupancyMDP()->isLastAgent(t)) ? std::static_pointer_cast<JointObservation>(next_joint_history->getLastObservation()) : this->getSerialOccupancyMDP()->getDefaultObservation();
     }
 }
-
-#endif
\ No newline at end of file
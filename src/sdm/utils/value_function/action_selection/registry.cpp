@@ -6,11 +6,9 @@ SDMS_REGISTRY(action_selection)
 SDMS_REGISTER("Exhaustive", ExhaustiveActionSelection)
 SDMS_REGISTER("MaxplanSerial", ActionSelectionMaxplanSerial)
 SDMS_REGISTER("MaxplanWCSP", ActionSelectionMaxplanWCSP)
-#ifdef WITH_CPLEX
 SDMS_REGISTER("MaxplanLP", ActionSelectionMaxplanLP)
 SDMS_REGISTER("SawtoothLP", ActionSelectionSawtoothLP)
 SDMS_REGISTER("SawtoothLPSerial", ActionSelectionSawtoothLPSerial)
-#endif
 SDMS_END_REGISTRY()
 
 namespace sdm
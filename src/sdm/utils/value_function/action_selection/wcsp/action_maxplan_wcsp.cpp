@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <sdm/utils/value_function/action_selection/wcsp/action_maxplan_wcsp.hpp>
 #include <sdm/utils/value_function/pwlc_value_function_interface.hpp>
 
@@ -6,6 +8,10 @@
 #include <sdm/world/occupancy_mdp.hpp>
 
 #include <sdm/core/action/base_action.hpp>
+#include <sdm/core/action/joint_det_decision_rule.hpp>
+#include <sdm/exception.hpp>
+
+#include "core/tb2wcsp.hpp"
 
 namespace sdm
 {
@@ -14,7 +20,7 @@ namespace sdm
     ActionSelectionMaxplanWCSP::ActionSelectionMaxplanWCSP(const std::shared_ptr<SolvableByDP> &world, Config config) : MaxPlanSelectionBase(world)
     {
         this->occupancy_mdp = std::dynamic_pointer_cast<OccupancyMDP>(getWorld());
-        this->underlying_problem = std::dynamic_pointer_cast<MMDPInterface>(this->occupancy_mdp->getUnderlyingMPOMDP());
+        this->underlying_problem = std::dynamic_pointer_cast<MMDPInterface>(getWorld()->getUnderlyingProblem());
     }
 
     Pair<std::shared_ptr<Action>, double> ActionSelectionMaxplanWCSP::computeGreedyActionAndValue(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &hyperplane, number t)
@@ -24,107 +30,242 @@ namespace sdm
 
     Pair<std::shared_ptr<Action>, double> ActionSelectionMaxplanWCSP::createAndSolveWCSP(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &hyperplane, number t)
     {
-        this->variables.clear();
-
         auto occupancy_state = state->toOccupancyState();
+        const auto &structure = this->getStructure(state, t);
 
-        this->determineMaxValue(value_function, occupancy_state, hyperplane, t);
-
-        number index;
-
-        double value;
-        std::shared_ptr<DecisionRule> decision_rule;
+        // Only cost tables depend on the hyperplane
+        this->computeCosts(value_function, occupancy_state, hyperplane, t);
 
         tb2init();              // must be call before setting specific ToulBar2 options and creating a model
         ToulBar2::verbose = -1; // change to 0 or higher values to see more trace information
 
-        // create a problem with multiple variables
-        std::shared_ptr<WeightedCSPSolver> wcsp_solver = std::shared_ptr<WeightedCSPSolver>(WeightedCSPSolver::makeWeightedCSPSolver(MAX_COST));
-
+        // ToulBar2 modifies the cost network during the search, so the network is posted again from the stored structure
+        std::unique_ptr<WeightedCSPSolver> wcsp_solver(WeightedCSPSolver::makeWeightedCSPSolver(MAX_COST));
+        auto wcsp = wcsp_solver->getWCSP();
 
         // building variables a^i(u^i|o^i) for each agent i
-        for (number agent = 0; agent < underlying_problem->getNumAgents(); ++agent)
+        for (number agent = 0; agent < structure->individual_histories.size(); ++agent)
         {
-            for (const auto &ihistory : occupancy_state->getIndividualHistories(agent))
+            for (const auto &variable : structure->variable_indices[agent])
+            {
+                wcsp->makeEnumeratedVariable(structure->variable_names[variable], 0, structure->individual_actions[agent].size() - 1);
+            }
+        }
+
+        // Creation of the cost network : one cost function per joint history, whose scope holds the variable of each agent
+        std::size_t num_joint_actions = structure->joint_actions.size();
+        std::vector<Cost> costs;
+        for (std::size_t o = 0; o < structure->joint_histories.size(); ++o)
+        {
+            auto scope = structure->scopes[o];
+            if (scope.size() <= 2)
+            {
+                // Full table over the tuples of individual actions (combinations that are not joint actions are forbidden)
+                costs.assign(structure->joint_action_at_tuple.size(), MAX_COST);
+                for (std::size_t tuple = 0; tuple < costs.size(); ++tuple)
+                {
+                    if (structure->joint_action_at_tuple[tuple] != WCSPStructure::NONE)
+                    {
+                        costs[tuple] = this->costs_[o * num_joint_actions + structure->joint_action_at_tuple[tuple]];
+                    }
+                }
+                if (scope.size() == 1)
+                {
+                    wcsp->postUnaryConstraint(scope[0], costs);
+                }
+                else
+                {
+                    wcsp->postBinaryConstraint(scope[0], scope[1], costs);
+                }
+            }
+            else
+            {
+                // Only the tuples that are joint actions are given
+                int ctr_index = wcsp->postNaryConstraintBegin(scope, MAX_COST, num_joint_actions);
+                for (std::size_t u = 0; u < num_joint_actions; ++u)
+                {
+                    wcsp->postNaryConstraintTuple(ctr_index, structure->joint_action_values[u], this->costs_[o * num_joint_actions + u]);
+                }
+                wcsp->postNaryConstraintEnd(ctr_index);
+            }
+        }
+
+        // Warm-start : the previous optimal assignment bounds the cost of the optimal assignment for this hyperplane
+        if (!structure->last_solution.empty())
+        {
+            Cost previous_cost = 0;
+            for (std::size_t o = 0; (o < structure->joint_histories.size()) && (previous_cost < MAX_COST); ++o)
             {
-                index = wcsp_solver->getWCSP()->makeEnumeratedVariable(this->getVarNameIndividualHistory(ihistory, agent), 0, underlying_problem->getActionSpace(agent, t)->toDiscreteSpace()->getNumItems() - 1);
-                this->variables.emplace(this->getVarNameIndividualHistory(ihistory, agent), index);
+                std::size_t u = this->getJointActionIndex(o, structure->last_solution);
+                previous_cost = (u == WCSPStructure::NONE) ? MAX_COST : previous_cost + this->costs_[o * num_joint_actions + u];
+            }
+            if (previous_cost < MAX_COST)
+            {
+                wcsp->updateUb(previous_cost + 1);
+            }
+            for (std::size_t variable = 0; variable < structure->last_solution.size(); ++variable)
+            {
+                wcsp->setBestValue(variable, structure->last_solution[variable]);
             }
         }
-        // Creation of the cost network
 
+        wcsp->sortConstraints(); // must be done before the search
 
-        // Go over all joint histories
-        for (const auto &joint_history : occupancy_state->getJointHistories())
+        bool solved = wcsp_solver->solve();
+        if (solved)
+        {
+            structure->last_solution = wcsp_solver->getSolution();
+        }
+
+        // The WCSP does not delete its last cost function, do it before the solver deletes the WCSP
+        auto tb2_wcsp = static_cast<WCSP *>(wcsp);
+        if (tb2_wcsp->numberOfConstraints() > 0)
+        {
+            delete tb2_wcsp->getCtr(tb2_wcsp->numberOfConstraints() - 1);
+        }
+        wcsp_solver.reset();
+
+        if (!solved)
         {
-            std::vector<Cost> costs;
+            throw sdm::exception::Exception("ActionSelectionMaxplanWCSP::createAndSolveWCSP : no solution was found");
+        }
 
-            // Go over all joint action
-            for (const auto &joint_action : *underlying_problem->getActionSpace(t))
+        // Creation of the joint decision rule
+        const auto &solution = structure->last_solution;
+        std::vector<std::vector<std::shared_ptr<Item>>> actions;
+        for (number agent = 0; agent < structure->individual_histories.size(); agent++)
+        {
+            std::vector<std::shared_ptr<Item>> indiv_actions;
+            for (const auto &variable : structure->variable_indices[agent])
             {
-                costs.push_back(this->getCost(this->getWeight(value_function, occupancy_state, joint_history, joint_action->toAction(), hyperplane, t)));
+                indiv_actions.push_back(structure->individual_actions[agent][solution[variable]]);
             }
+            actions.push_back(indiv_actions);
+        }
+        auto decision_rule = std::make_shared<JointDeterministicDecisionRule>(structure->individual_histories, actions, this->underlying_problem->getActionSpace(t));
 
-            // ATTENTION : CETTE FONCTION (postBinaryConstraint) ENGENDRE UNE FUITE DE MEMOIRE
-            wcsp_solver->getWCSP()->postBinaryConstraint(this->variables[this->getVarNameIndividualHistory(joint_history->getIndividualHistory(0), 0)], this->variables[this->getVarNameIndividualHistory(joint_history->getIndividualHistory(1), 1)], costs);
-            // wcsp_solver->getWCSP()->postNaryConstraintBegin(this->variables[this->getVarNameIndividualHistory(joint_history->getIndividualHistory(0), 0)], this->variables[this->getVarNameIndividualHistory(joint_history->getIndividualHistory(1), 1)], costs);
+        // The value is the sum of the weights of the selected joint actions
+        double value = 0.0;
+        for (std::size_t o = 0; o < structure->joint_histories.size(); ++o)
+        {
+            value += this->weights_[o * num_joint_actions + this->getJointActionIndex(o, solution)];
         }
 
-        wcsp_solver->getWCSP()->sortConstraints(); // must be done before the search
+        return std::make_pair(decision_rule, value);
+    }
 
-        if (wcsp_solver->solve())
+    const std::shared_ptr<ActionSelectionMaxplanWCSP::WCSPStructure> &ActionSelectionMaxplanWCSP::getStructure(const std::shared_ptr<State> &state, number t)
+    {
+        if ((this->structure_ != nullptr) && (this->structure_->state == state) && (this->structure_->t == t))
         {
-            value = 0.0;
-            std::vector<Value> sol;        // show optimal solution
-            wcsp_solver->getSolution(sol); // cost optimum
+            return this->structure_;
+        }
 
-            // Creation of the joint decision rule
+        auto occupancy_state = state->toOccupancyState();
+        auto structure = std::make_shared<WCSPStructure>();
+        structure->state = state;
+        structure->t = t;
 
-            std::vector<std::vector<std::shared_ptr<Item>>> actions;
-            std::vector<std::vector<std::shared_ptr<Item>>> joint_histories;
+        // Variables are indexed in the order of their creation
+        this->variables.clear();
+        int index = 0;
+        for (number agent = 0; agent < this->underlying_problem->getNumAgents(); ++agent)
+        {
+            auto action_space = this->underlying_problem->getActionSpace(agent, t)->toDiscreteSpace();
+            structure->individual_actions.emplace_back();
+            for (std::size_t a = 0; a < action_space->getNumItems(); ++a)
+            {
+                structure->individual_actions[agent].push_back(action_space->getItem(a));
+            }
 
-            // Go over each agent
-            for (number agent = 0; agent < underlying_problem->getNumAgents(); agent++)
+            structure->individual_histories.emplace_back();
+            structure->variable_indices.emplace_back();
+            for (const auto &ihistory : occupancy_state->getIndividualHistories(agent))
             {
-                std::vector<std::shared_ptr<Item>> indiv_actions;
-                std::vector<std::shared_ptr<Item>> indiv_histories;
+                structure->variable_names.push_back(this->getVarNameIndividualHistory(ihistory, agent));
+                this->variables.emplace(structure->variable_names.back(), index);
+                structure->individual_histories[agent].push_back(ihistory);
+                structure->variable_indices[agent].push_back(index++);
+            }
+        }
 
-                // Go over the individual history for a precise agent
-                for (const auto &indiv_history : occupancy_state->getIndividualHistories(agent))
-                {
-                    indiv_histories.push_back(indiv_history);
+        for (const auto &joint_history : occupancy_state->getJointHistories())
+        {
+            std::vector<int> scope;
+            for (number agent = 0; agent < this->underlying_problem->getNumAgents(); ++agent)
+            {
+                scope.push_back(this->variables[this->getVarNameIndividualHistory(joint_history->getIndividualHistory(agent), agent)]);
+            }
+            structure->joint_histories.push_back(joint_history);
+            structure->scopes.push_back(scope);
+        }
 
-                    // Search which action is the solution
-                    for (const auto &indiv_action : *underlying_problem->getActionSpace(agent, t))
-                    {
-                        if (indiv_action == underlying_problem->getActionSpace(agent, t)->toDiscreteSpace()->getItem(sol[this->variables[this->getVarNameIndividualHistory(indiv_history, agent)]]))
-                        {
-                            indiv_actions.push_back(indiv_action);
-                        }
-                    }
-                }
+        // Tuples of individual actions are indexed in lexicographic order (the last agent moving first)
+        std::size_t num_tuples = 1;
+        for (const auto &individual_actions : structure->individual_actions)
+        {
+            num_tuples *= individual_actions.size();
+        }
+        structure->joint_action_at_tuple.assign(num_tuples, WCSPStructure::NONE);
 
-                actions.push_back(indiv_actions);
-                joint_histories.push_back(indiv_histories);
+        for (const auto &joint_action : *this->underlying_problem->getActionSpace(t))
+        {
+            auto action = joint_action->toAction();
+            std::vector<Value> values;
+            std::size_t tuple = 0;
+            for (number agent = 0; agent < this->underlying_problem->getNumAgents(); ++agent)
+            {
+                const auto &individual_actions = structure->individual_actions[agent];
+                auto individual_action = action->toJointAction()->get(agent);
+                Value value = std::find(individual_actions.begin(), individual_actions.end(), individual_action) - individual_actions.begin();
+                if (value == (Value)individual_actions.size())
+                {
+                    throw sdm::exception::Exception("ActionSelectionMaxplanWCSP::getStructure : the joint action is not made of individual actions");
+                }
+                values.push_back(value);
+                tuple = tuple * individual_actions.size() + value;
             }
+            structure->joint_action_at_tuple[tuple] = structure->joint_actions.size();
+            structure->joint_action_values.push_back(values);
+            structure->joint_actions.push_back(action);
+        }
+
+        this->structure_ = structure;
+        return this->structure_;
+    }
 
+    std::size_t ActionSelectionMaxplanWCSP::getJointActionIndex(std::size_t joint_history_index, const std::vector<Value> &assignment) const
+    {
+        std::size_t tuple = 0;
+        for (std::size_t agent = 0; agent < this->structure_->scopes[joint_history_index].size(); ++agent)
+        {
+            tuple = tuple * this->structure_->individual_actions[agent].size() + assignment[this->structure_->scopes[joint_history_index][agent]];
+        }
+        return this->structure_->joint_action_at_tuple[tuple];
+    }
 
-            // Create JOint Deterministic Decision Rule
-            decision_rule = std::make_shared<JointDeterministicDecisionRule>(joint_histories, actions, this->underlying_problem->getActionSpace(t));
+    void ActionSelectionMaxplanWCSP::computeCosts(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<Hyperplane> &hyperplane, number t)
+    {
+        const auto &structure = this->structure_;
+        std::size_t num_joint_actions = structure->joint_actions.size();
 
+        this->weights_.resize(structure->joint_histories.size() * num_joint_actions);
+        this->costs_.resize(this->weights_.size());
 
-            for (const auto &joint_history : occupancy_state->getJointHistories())
+        this->max = std::numeric_limits<double>::lowest();
+        for (std::size_t o = 0; o < structure->joint_histories.size(); ++o)
+        {
+            for (std::size_t u = 0; u < num_joint_actions; ++u)
             {
-                auto action = occupancy_state->applyDR(decision_rule, joint_history);
-                value += this->getWeight(value_function, occupancy_state, joint_history, action, hyperplane, t);
+                this->weights_[o * num_joint_actions + u] = this->getWeight(value_function, occupancy_state, structure->joint_histories[o], structure->joint_actions[u], hyperplane, t);
+                this->max = std::max(this->max, this->weights_[o * num_joint_actions + u]);
             }
         }
-        else
+
+        for (std::size_t k = 0; k < this->weights_.size(); ++k)
         {
-            exit(-1);
+            this->costs_[k] = this->getCost(this->weights_[k]);
         }
-
-        return std::make_pair(decision_rule, value);
     }
 
     // double ActionSelectionMaxplanWCSP::getWeight(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyStateInterface> occupancy_state, const std::shared_ptr<JointHistoryInterface> joint_history, const std::shared_ptr<Action> action, number t)
@@ -144,19 +285,4 @@ namespace sdm
     {
         return (long)this->offset * (this->max - value);
     }
-
-    void ActionSelectionMaxplanWCSP::determineMaxValue(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<Hyperplane> &hyperplane, number t)
-    {
-        auto mpomdp = std::dynamic_pointer_cast<MPOMDPInterface>(this->getWorld()->getUnderlyingProblem());
-
-        this->max = std::numeric_limits<double>::lowest();
-
-        for (const auto &joint_history : occupancy_state->getJointHistories())
-        {
-            for (const auto &action : *mpomdp->getActionSpace(t))
-            {
-                this->max = std::max(max, this->getWeight(value_function, occupancy_state, joint_history, action->toAction(), hyperplane, t));
-            }
-        }
-    }
-}
\ No newline at end of file
+}
@@ -30,10 +30,56 @@ namespace sdm
         Pair<std::shared_ptr<Action>, double> createAndSolveWCSP(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &hyperplane, number t);
 
     protected:
-        
+        /**
+         * @brief The structure of the WCSP of an occupancy state at a time step.
+         *
+         * Variables (one per individual history) and scopes of the cost functions (one per joint history) are the
+         * same for all hyperplanes, only the cost tables change. The optimal assignment of the last resolution
+         * is kept to warm-start the next one.
+         */
+        struct WCSPStructure
+        {
+            static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+            std::shared_ptr<State> state;
+            number t;
+
+            /** @brief The individual histories and actions of each agent (the domain value of an action is its position). */
+            std::vector<std::vector<std::shared_ptr<Item>>> individual_histories, individual_actions;
+
+            /** @brief The WCSP variable of each individual history of each agent, and the name of each variable. */
+            std::vector<std::vector<int>> variable_indices;
+            std::vector<std::string> variable_names;
+
+            /** @brief The joint histories and the scope of each joint history (the variable of each agent). */
+            std::vector<std::shared_ptr<JointHistoryInterface>> joint_histories;
+            std::vector<std::vector<int>> scopes;
+
+            /** @brief The joint actions, in the order of the cost tables, and the domain value of each agent in each joint action. */
+            std::vector<std::shared_ptr<Action>> joint_actions;
+            std::vector<std::vector<Value>> joint_action_values;
+
+            /** @brief The position of the joint action of each tuple of individual actions (NONE if the tuple is not a joint action). */
+            std::vector<std::size_t> joint_action_at_tuple;
+
+            /** @brief The optimal assignment of the last resolution (empty if none). */
+            std::vector<Value> last_solution;
+        };
+
         std::shared_ptr<OccupancyMDP> occupancy_mdp;
         std::shared_ptr<MMDPInterface> underlying_problem;
 
+        /**
+         * @brief The structure of the current WCSP.
+         */
+        std::shared_ptr<WCSPStructure> structure_;
+
+        /**
+         * @brief The weights and costs of each pair (joint history, joint action) for the current hyperplane (reused buffers).
+         */
+        std::vector<double> weights_;
+        std::vector<Cost> costs_;
+
         /**
          * @brief defines the maximum value in the domain of the payoff function
          * 
@@ -53,6 +99,19 @@ namespace sdm
          */
         long getCost(double);
 
-        void determineMaxValue(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<Hyperplane> &hyperplane, number t);
+        /**
+         * @brief Get the structure of the WCSP for a given occupancy state and time step (built once for all hyperplanes).
+         */
+        const std::shared_ptr<WCSPStructure> &getStructure(const std::shared_ptr<State> &state, number t);
+
+        /**
+         * @brief Get the position of the joint action selected by an assignment of the WCSP variables for a joint history.
+         */
+        std::size_t getJointActionIndex(std::size_t joint_history_index, const std::vector<Value> &assignment) const;
+
+        /**
+         * @brief Compute the weights and costs of all pairs (joint history, joint action) for a hyperplane.
+         */
+        void computeCosts(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<Hyperplane> &hyperplane, number t);
     };
 }
@@ -1,4 +1,7 @@
+#include <chrono>
+
 #include <sdm/utils/value_function/prunable_structure.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 
 namespace sdm
 {
@@ -11,10 +14,18 @@ namespace sdm
     {
         if (trial  % this->getPruningFrequency() == 0)
         {
+            SDMS_TIME_PHASE(PRUNING);
+            auto value_function = dynamic_cast<ValueFunction *>(this);
+            auto start_time = std::chrono::high_resolution_clock::now();
+            this->size_before_last_pruning_ = (value_function != nullptr) ? value_function->getSize() : 0;
+
             for (number time = 0; time < this->horizon; time++)
             {
                 this->prune(time);
             }
+
+            this->size_after_last_pruning_ = (value_function != nullptr) ? value_function->getSize() : 0;
+            this->last_pruning_time_ = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
         }
     }
 
@@ -23,4 +34,19 @@ namespace sdm
         return this->freq_pruning;
     }
 
+    size_t PrunableStructure::getSizeBeforeLastPruning() const
+    {
+        return this->size_before_last_pruning_;
+    }
+
+    size_t PrunableStructure::getSizeAfterLastPruning() const
+    {
+        return this->size_after_last_pruning_;
+    }
+
+    double PrunableStructure::getLastPruningTime() const
+    {
+        return this->last_pruning_time_;
+    }
+
 } // namespace sdm
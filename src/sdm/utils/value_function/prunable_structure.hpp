@@ -28,6 +28,21 @@ namespace sdm
          */
         int getPruningFrequency() const;
 
+        /**
+         * @brief Get the size of the structure before the last pruning.
+         */
+        size_t getSizeBeforeLastPruning() const;
+
+        /**
+         * @brief Get the size of the structure after the last pruning.
+         */
+        size_t getSizeAfterLastPruning() const;
+
+        /**
+         * @brief Get the duration (in seconds) of the last pruning.
+         */
+        double getLastPruningTime() const;
+
     protected:
         /**
          * @brief Prune unecessary components of the value function.
@@ -47,5 +62,11 @@ namespace sdm
          * @brief The horizon.
          */
         number horizon;
+
+        /**
+         * @brief Statistics of the last pruning.
+         */
+        size_t size_before_last_pruning_ = 0, size_after_last_pruning_ = 0;
+        double last_pruning_time_ = 0.;
     };
 } // namespace sdm
\ No newline at end of file
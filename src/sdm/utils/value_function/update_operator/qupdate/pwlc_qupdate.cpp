@@ -20,7 +20,11 @@ namespace sdm
 
         void PWLCQUpdate::update(double learning_rate, number t)
         {
-            auto [state, action, reward, next_state, next_action] = this->experience_memory->sample(t)[0]; // 1.92
+            // Updates are scaled by the importance-sampling weight of the transition
+            double weight;
+            auto index = this->experience_memory->sampleIndex(t, weight);
+            auto [state, action, reward, next_state, next_action] = this->experience_memory->get(t, index);
+            double td_error = 0.;
 
             auto hyperplane = this->getQValueFunction()->getHyperplaneAt(state, t);           // 1.15
             auto hyperplane_ = this->getQValueFunction()->getHyperplaneAt(next_state, t + 1); // 1.15
@@ -42,28 +46,27 @@ namespace sdm
 
                     if ((pomdp->getHorizon() == 0) || (t + 1 < pomdp->getHorizon()))
                     {
-                        for (const auto &x_ : pomdp->getReachableStates(x, u, t))
+                        for (const auto &transition : pomdp->getReachableDynamics(x, u, t))
                         {
-                            for (const auto &z : pomdp->getReachableObservations(x, u, x_, t)) // 0.86
-                            {
-                                // set next-step history h' = h + u + z
-                                auto o_ = o->expand(std::static_pointer_cast<JointObservation>(z)); // 5.2
-                                auto &&c_o_ = s_->getCompressedJointHistory(o_);                    // 5.8
+                            // set next-step history h' = h + u + z
+                            auto o_ = o->expand(std::static_pointer_cast<JointObservation>(transition.observation)); // 5.2
+                            auto &&c_o_ = s_->getCompressedJointHistory(o_);                                         // 5.8
 
-                                if (s_->getProbability(c_o_) == 0) // 0.54
-                                    continue;
+                            if (s_->getProbability(c_o_) == 0) // 0.54
+                                continue;
 
-                                auto u_ = s_->applyDR(a_, c_o_); // a_->act(c_o_); // 8.39
+                            auto u_ = s_->applyDR(a_, c_o_); // a_->act(c_o_); // 8.39
 
-                                if (u_ == nullptr)
-                                    continue;
-                                delta_xou += getWorld()->getDiscount(t) * pomdp->getDynamics(x, u, x_, z, t) * hyperplane_->getValueAt(x_, c_o_, u_);
-                            }
+                            if (u_ == nullptr)
+                                continue;
+                            delta_xou += getWorld()->getDiscount(t) * transition.probability * hyperplane_->getValueAt(transition.next_state, c_o_, u_);
                         }
                     }
-                    hyperplane->setValueAt(x, o, u, hyperplane->getValueAt(x, o, u) + learning_rate * (delta_xou - hyperplane->getValueAt(x, o, u)));
+                    td_error = std::max(td_error, std::abs(delta_xou - hyperplane->getValueAt(x, o, u)));
+                    hyperplane->setValueAt(x, o, u, hyperplane->getValueAt(x, o, u) + weight * learning_rate * (delta_xou - hyperplane->getValueAt(x, o, u)));
                 }
             }
+            this->experience_memory->updatePriority(t, index, td_error);
         }
     }
 }
\ No newline at end of file
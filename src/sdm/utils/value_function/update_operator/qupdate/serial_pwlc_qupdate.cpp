@@ -22,7 +22,7 @@ namespace sdm
 
         void SerialPWLCQUpdate::update(double learning_rate, number t)
         {
-            auto [state, action, reward, next_state, next_action] = this->experience_memory->sample(t)[0]; // 1.92
+            auto [state, action, reward, next_state, next_action] = this->experience_memory->get(t, this->experience_memory->sampleIndex(t));
 
             auto hyperplane = this->getQValueFunction()->getHyperplaneAt(state, t);           // 1.15
             auto hyperplane_ = this->getQValueFunction()->getHyperplaneAt(next_state, t + 1); // 1.15
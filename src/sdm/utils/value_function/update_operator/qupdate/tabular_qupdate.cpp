@@ -24,10 +24,13 @@ namespace sdm
 
         void TabularQUpdate::update(double learning_rate, number t)
         {
-            auto [observation, action, reward, next_observation, next_action] = experience_memory->sample(t)[0];
+            double weight;
+            auto index = experience_memory->sampleIndex(t, weight);
+            auto [observation, action, reward, next_observation, next_action] = experience_memory->get(t, index);
             double delta = deltaSARSA(observation, action, reward, next_observation, next_action, t);
-            double new_value = this->getQValueFunction()->getQValueAt(observation, action, t) + learning_rate * delta;
+            double new_value = this->getQValueFunction()->getQValueAt(observation, action, t) + weight * learning_rate * delta;
             this->getQValueFunction()->setQValueAt(observation, action, new_value, t);
+            experience_memory->updatePriority(t, index, delta);
         }
     }
 }
\ No newline at end of file
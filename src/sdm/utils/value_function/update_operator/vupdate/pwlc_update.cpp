@@ -65,19 +65,14 @@ namespace sdm
                 {
                     double next_expected_value = 0.0;
 
-                    // Go over all hidden state reachable next state
-                    for (const auto &next_state : pomdp->getReachableStates(state, action->toAction(), t))
+                    // Go over all reachable pairs of next state and observation
+                    for (const auto &transition : pomdp->getReachableDynamics(state, action->toAction(), t))
                     {
-                        // Go over all observation reachable observation
-                        for (const auto &observation : pomdp->getReachableObservations(state, action->toAction(), next_state, t))
-                        {
+                        // Get the next value of an hyperplane
+                        double next_alpha_value = alpha_ao[action->toAction()][transition.observation]->getValueAt(transition.next_state, nullptr);
 
-                            // Get the next value of an hyperplane
-                            double next_alpha_value = alpha_ao[action->toAction()][observation]->getValueAt(next_state, nullptr);
-
-                            // Determine the best next hyperplan for the next belief and compute the dynamics and probability of this best next hyperplan
-                            next_expected_value += next_alpha_value * pomdp->getDynamics(state, action->toAction(), next_state, observation, t);
-                        }
+                        // Determine the best next hyperplan for the next belief and compute the dynamics and probability of this best next hyperplan
+                        next_expected_value += next_alpha_value * transition.probability;
                     }
                     // For each hidden state with associate the value \beta^{new}(x) = r(x,u) + \gamma * \sum_{x_,z_} p(x,u,z_,x_) * best_next_hyperplan(x_);
                     alpha_a->setValueAt(state, nullptr, pomdp->getReward(state, action->toAction(), t) + this->getWorld()->getDiscount(t) * next_expected_value);
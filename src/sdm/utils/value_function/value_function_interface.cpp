@@ -56,12 +56,34 @@ namespace sdm
         return shared_from_this();
     }
 
-    void ValueFunctionInterface::save(std::string)
+    void ValueFunctionInterface::save(std::string filename)
+    {
+        std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+        if (!ofs)
+        {
+            throw exception::Exception("Cannot open " + filename + " to save the value function.");
+        }
+        boost::archive::binary_oarchive output_archive(ofs);
+        this->saveCheckpoint(output_archive);
+    }
+
+    void ValueFunctionInterface::load(std::string filename)
+    {
+        std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+        if (!ifs)
+        {
+            throw exception::Exception("Cannot open " + filename + " to load the value function.");
+        }
+        boost::archive::binary_iarchive input_archive(ifs);
+        this->loadCheckpoint(input_archive);
+    }
+
+    void ValueFunctionInterface::saveCheckpoint(boost::archive::binary_oarchive &)
     {
         throw exception::Exception("This class cannot be saved.");
     }
 
-    void ValueFunctionInterface::load(std::string)
+    void ValueFunctionInterface::loadCheckpoint(boost::archive::binary_iarchive &)
     {
         throw exception::Exception("This class cannot be load.");
     }
@@ -121,9 +121,7 @@ namespace sdm
         /**
          * @brief Save a value function into a file. 
          * 
-         * The extension of the file will indicate the type of formatage for 
-         * recording (`.txt` = text format, '.xml' = XML format, other = binary 
-         * format). 
+         * By default, the value function is saved in binary format (see `saveCheckpoint`).
          * 
          * @param filename the filename
          * 
@@ -133,15 +131,33 @@ namespace sdm
         /**
          * @brief Load a value function from a file.
          * 
-         * The extension of the file will indicate the type of formatage for 
-         * reading (`.txt` = text format, '.xml' = XML format, other = binary 
-         * format). 
+         * By default, the file must have been written by `save` (see `loadCheckpoint`).
          * 
          * @param filename the filename
          * 
          */
         virtual void load(std::string);
 
+        /**
+         * @brief Save the value function in a binary archive.
+         * 
+         * States and histories are saved through the world (see `SolvableByDP::saveState`), 
+         * so that the value function can be loaded in another execution on the same problem.
+         * 
+         * @param archive the archive
+         */
+        virtual void saveCheckpoint(boost::archive::binary_oarchive &archive);
+
+        /**
+         * @brief Load the value function from a binary archive written by `saveCheckpoint`.
+         * 
+         * The value function must be built on the same problem, with the same horizon. 
+         * Its current content is replaced.
+         * 
+         * @param archive the archive
+         */
+        virtual void loadCheckpoint(boost::archive::binary_iarchive &archive);
+
         /**
          * @brief Define this function in order to be able to display the value 
          * function
@@ -11,6 +11,8 @@
 
 #include <sdm/utils/value_function/initializer/initializer.hpp>
 #include <sdm/world/base/belief_mdp_interface.hpp>
+#include <sdm/world/solvable_by_mdp.hpp>
+#include <sdm/utils/linear_programming/simplex_solver.hpp>
 
 namespace sdm
 {
@@ -31,6 +33,13 @@ namespace sdm
         this->representation = std::vector<HyperplanSet>(this->isInfiniteHorizon() ? 1 : world->getHorizon() + 1, HyperplanSet({}));
         this->all_state_updated_so_far = std::vector<std::unordered_set<std::shared_ptr<State>>>(this->isInfiniteHorizon() ? 1 : world->getHorizon() + 1, std::unordered_set<std::shared_ptr<State>>());
         this->default_values_per_horizon = std::vector<double>(this->isInfiniteHorizon() ? 1 : world->getHorizon() + 1, 0);
+        this->packed_hyperplanes_ = std::vector<std::vector<std::shared_ptr<AlphaVector>>>(this->isInfiniteHorizon() ? 1 : world->getHorizon() + 1);
+        this->packed_representation_ = std::vector<std::vector<PackedAlphaVector>>(this->isInfiniteHorizon() ? 1 : world->getHorizon() + 1);
+        this->packed_witnesses_ = std::vector<std::vector<std::shared_ptr<PackedState>>>(this->isInfiniteHorizon() ? 1 : world->getHorizon() + 1);
+        for (number t = 0; t < this->packed_representation_.size(); t++)
+        {
+            this->packed_index_spaces_.push_back(std::make_shared<PackedIndexSpace>());
+        }
         this->pomdp = std::dynamic_pointer_cast<POMDPInterface>(world->getUnderlyingProblem());
     }
 
@@ -51,17 +60,30 @@ namespace sdm
             auto iter = MaxplanPruning::TYPE_MAP.find(opt_str.value());
             this->type_of_maxplan_prunning_ = (iter != MaxplanPruning::TYPE_MAP.end()) ? iter->second : MaxplanPruning::PAIRWISE;
         }
+
+        this->setBetaCache(config.get("beta_cache", true));
     }
 
     PWLCValueFunction::PWLCValueFunction(const PWLCValueFunction &copy)
         : ValueFunctionInterface(copy.world_, copy.initializer_, copy.action_selection_),
           ValueFunction(copy.world_, copy.initializer_, copy.action_selection_),
           PWLCValueFunctionInterface(copy.world_, copy.initializer_, copy.action_selection_, copy.freq_pruning),
-          representation(copy.representation),
           default_values_per_horizon(copy.default_values_per_horizon),
           type_of_maxplan_prunning_(copy.type_of_maxplan_prunning_),
-          all_state_updated_so_far(copy.all_state_updated_so_far)
+          pomdp(copy.pomdp),
+          use_beta_cache_(copy.use_beta_cache_)
     {
+        // Each value function extends its own index spaces under its own lock
+        std::shared_lock<std::shared_mutex> lock(copy.representation_mutex_);
+        this->representation = copy.representation;
+        for (const auto &index_space : copy.packed_index_spaces_)
+        {
+            this->packed_index_spaces_.push_back(std::make_shared<PackedIndexSpace>(*index_space));
+        }
+        this->packed_hyperplanes_ = copy.packed_hyperplanes_;
+        this->packed_representation_ = copy.packed_representation_;
+        this->packed_witnesses_ = copy.packed_witnesses_;
+        this->all_state_updated_so_far = copy.all_state_updated_so_far;
     }
 
 
@@ -71,7 +93,7 @@ namespace sdm
         auto initial_state = this->getWorld()->getInitialState();
 
         // If there are not element at time t, we have to create the default State
-        if (this->representation[this->isInfiniteHorizon() ? 0 : t].size() == 0)
+        if (this->getSize(t) == 0)
         {
             // Create the default state
             std::shared_ptr<AlphaVector> default_hyperplane;
@@ -106,43 +128,97 @@ namespace sdm
 
     Pair<std::shared_ptr<Hyperplane>, double> PWLCValueFunction::evaluate(const std::shared_ptr<State> &state, number t)
     {
-        std::cout << "\n evaluate of pwlc value function";
-        std::exit(1);
-        double current, max = -std::numeric_limits<double>::max();
-        std::shared_ptr<AlphaVector> alpha_vector = nullptr;
+        number tau = this->isInfiniteHorizon() ? 0 : t;
 
-        // Go over all hyperplan in the support
-        for (const auto &plan : this->representation[this->isInfiniteHorizon() ? 0 : t])
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
+
+        // Determine the best hyperplan which give the best value for the current state
+        auto best = packed::argmax(this->packed_index_spaces_[tau]->pack(state), this->packed_representation_[tau]);
+        if (best.first < 0)
         {
-            // Determine the best hyperplan which give the best value for the current state
-            if (max < (current = state->product(plan)))
-            {
-                max = current;
-                alpha_vector = plan;
-            }
+            return {nullptr, best.second};
         }
-        return {alpha_vector, max};
+        return {this->packed_hyperplanes_[tau][best.first], best.second};
     }
 
     void PWLCValueFunction::addHyperplaneAt(const std::shared_ptr<State> &state, const std::shared_ptr<Hyperplane> &new_hyperplan, number t)
     {
-        // Add hyperplane in the hyperplane set
-        this->representation[this->isInfiniteHorizon() ? 0 : t].insert(std::static_pointer_cast<AlphaVector>(new_hyperplan));
+        number tau = this->isInfiniteHorizon() ? 0 : t;
+        auto alpha = std::static_pointer_cast<AlphaVector>(new_hyperplan);
+
+        std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+
+        // Add hyperplane in the hyperplane set (and its packed version if it is a new one)
+        if (this->representation[tau].insert(alpha).second)
+        {
+            this->packed_hyperplanes_[tau].push_back(alpha);
+            this->packed_representation_[tau].push_back(this->packed_index_spaces_[tau]->pack(alpha));
+            this->packed_witnesses_[tau].push_back(nullptr);
+        }
 
         // Add state to all state update so far, only if the prunning used is Bounded
         if (this->type_of_maxplan_prunning_ == MaxplanPruning::Type::BOUNDED)
-            this->all_state_updated_so_far[this->isInfiniteHorizon() ? 0 : t].insert(state);
+            this->all_state_updated_so_far[tau].insert(state);
     }
 
     double PWLCValueFunction::getBeta(const std::shared_ptr<Hyperplane> &hyperplane, const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &o, const std::shared_ptr<Action> &u, number t)
     {
         auto alpha = std::static_pointer_cast<AlphaVector>(hyperplane);
-        return alpha->getBetaValueAt(x, o, u, this->pomdp, t);
+        if (!this->use_beta_cache_)
+        {
+            return alpha->getBetaValueAt(x, o, u, this->pomdp, t);
+        }
+
+        // Hyperplanes are not modified once added, so their beta values can be reused until they get pruned
+        {
+            std::lock_guard<std::mutex> lock(this->beta_cache_mutex_);
+            auto &values_at_x = this->beta_cache_[hyperplane][o][x];
+            auto iter = values_at_x.find(u);
+            if (iter != values_at_x.end())
+            {
+                this->beta_cache_hits_++;
+                return iter->second;
+            }
+        }
+        this->beta_cache_misses_++;
+
+        // The value is computed outside of the lock, concurrent computations of the same value give the same result
+        double beta = alpha->getBetaValueAt(x, o, u, this->pomdp, t);
+
+        std::lock_guard<std::mutex> lock(this->beta_cache_mutex_);
+        this->beta_cache_[hyperplane][o][x].emplace(u, beta);
+        return beta;
+    }
+
+    void PWLCValueFunction::setBetaCache(bool use_beta_cache)
+    {
+        this->use_beta_cache_ = use_beta_cache;
+        if (!use_beta_cache)
+        {
+            this->clearBetaCache();
+        }
+    }
+
+    void PWLCValueFunction::clearBetaCache()
+    {
+        std::lock_guard<std::mutex> lock(this->beta_cache_mutex_);
+        this->beta_cache_.clear();
+    }
+
+    unsigned long long PWLCValueFunction::getBetaCacheHits() const
+    {
+        return this->beta_cache_hits_;
+    }
+
+    unsigned long long PWLCValueFunction::getBetaCacheMisses() const
+    {
+        return this->beta_cache_misses_;
     }
 
     std::vector<std::shared_ptr<Hyperplane>> PWLCValueFunction::getHyperplanesAt(std::shared_ptr<State>, number t)
     {
-        auto set = this->representation[this->isInfiniteHorizon() ? 0 : t];
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
+        const auto &set = this->representation[this->isInfiniteHorizon() ? 0 : t];
         return std::vector<std::shared_ptr<Hyperplane>>(set.begin(), set.end());
     }
 
@@ -168,6 +244,101 @@ namespace sdm
         return std::make_shared<PWLCValueFunction>(*casted_value);
     }
 
+    void PWLCValueFunction::saveCheckpoint(boost::archive::binary_oarchive &archive)
+    {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
+        auto mdp = this->getWorld()->getUnderlyingProblem();
+
+        std::size_t horizon = this->representation.size();
+        archive << horizon;
+        for (number t = 0; t < horizon; t++)
+        {
+            std::size_t num_hyperplanes = this->packed_hyperplanes_[t].size();
+            archive << this->default_values_per_horizon[t] << num_hyperplanes;
+            for (const auto &alpha : this->packed_hyperplanes_[t])
+            {
+                bool is_occupancy = (std::dynamic_pointer_cast<oAlpha>(alpha) != nullptr);
+                if (!is_occupancy && (std::dynamic_pointer_cast<bAlpha>(alpha) == nullptr))
+                {
+                    throw sdm::exception::TypeError("TypeError : only hyperplanes over beliefs or occupancy states can be saved");
+                }
+
+                std::vector<std::tuple<std::shared_ptr<State>, std::shared_ptr<HistoryInterface>, double>> values;
+                alpha->forEachValue([&values](const std::shared_ptr<State> &x, const std::shared_ptr<HistoryInterface> &o, double value)
+                                    { values.push_back({x, o, value}); });
+
+                std::size_t num_values = values.size();
+                archive << is_occupancy << alpha->getDefaultValue() << num_values;
+                for (const auto &[x, o, value] : values)
+                {
+                    this->getWorld()->saveHistory(archive, o);
+                    SolvableByMDP::saveItem(archive, mdp->getStateSpace(t), x);
+                    archive << value;
+                }
+            }
+        }
+    }
+
+    void PWLCValueFunction::loadCheckpoint(boost::archive::binary_iarchive &archive)
+    {
+        auto mdp = this->getWorld()->getUnderlyingProblem();
+        auto initial_state = this->getWorld()->getInitialState();
+
+        std::size_t horizon;
+        archive >> horizon;
+        if (horizon != this->representation.size())
+        {
+            throw sdm::exception::Exception("PWLCValueFunction::loadCheckpoint : the checkpoint was saved for another horizon");
+        }
+
+        // Remove the current hyperplanes and their packed version
+        {
+            std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+            for (number t = 0; t < horizon; t++)
+            {
+                this->representation[t].clear();
+                this->packed_hyperplanes_[t].clear();
+                this->packed_representation_[t].clear();
+                this->packed_witnesses_[t].clear();
+                this->packed_index_spaces_[t] = std::make_shared<PackedIndexSpace>();
+                this->all_state_updated_so_far[t].clear();
+            }
+        }
+        this->clearBetaCache();
+
+        for (number t = 0; t < horizon; t++)
+        {
+            std::size_t num_hyperplanes;
+            archive >> this->default_values_per_horizon[t] >> num_hyperplanes;
+            for (std::size_t k = 0; k < num_hyperplanes; k++)
+            {
+                bool is_occupancy;
+                double default_value;
+                std::size_t num_values;
+                archive >> is_occupancy >> default_value >> num_values;
+
+                std::shared_ptr<AlphaVector> alpha;
+                if (is_occupancy)
+                {
+                    alpha = std::make_shared<oAlpha>(default_value);
+                }
+                else
+                {
+                    alpha = std::make_shared<bAlpha>(default_value);
+                }
+                for (std::size_t i = 0; i < num_values; i++)
+                {
+                    auto o = this->getWorld()->loadHistory(archive);
+                    auto x = SolvableByMDP::loadItem(archive, mdp->getStateSpace(t))->toState();
+                    double value;
+                    archive >> value;
+                    alpha->setValueAt(x, o, value);
+                }
+                this->addHyperplaneAt(initial_state, alpha, t);
+            }
+        }
+    }
+
     double PWLCValueFunction::getDefaultValue(number t)
     {
         return this->default_values_per_horizon[this->isInfiniteHorizon() ? 0 : t];
@@ -175,6 +346,7 @@ namespace sdm
 
     void PWLCValueFunction::prune(number t)
     {
+        std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
         switch (this->type_of_maxplan_prunning_)
         {
         case MaxplanPruning::PAIRWISE:
@@ -182,9 +354,14 @@ namespace sdm
             break;
         case MaxplanPruning::BOUNDED:
             this->bounded_prune(t);
+            break;
+        case MaxplanPruning::LP:
+            this->lp_prune(t);
+            break;
         default:
             break;
         }
+        this->removePrunedPackedHyperplanes(t);
     }
 
     void PWLCValueFunction::pairwise_prune(number t)
@@ -235,51 +412,209 @@ namespace sdm
         }
 
         // Erase dominated hyperplanes
+        std::lock_guard<std::mutex> beta_cache_lock(this->beta_cache_mutex_);
         for (const auto &to_delete : hyperplan_to_delete)
         {
             all_hyperplanes.erase(std::find(all_hyperplanes.begin(), all_hyperplanes.end(), to_delete));
+            this->beta_cache_.erase(to_delete);
         }
     }
 
     void PWLCValueFunction::bounded_prune(number t)
     {
-        std::unordered_map<std::shared_ptr<Hyperplane>, number> refCount;
+        number tau = this->isInfiniteHorizon() ? 0 : t;
         auto &all_hyperplanes = this->getAlphaHyperplanesAt(t);
+        const auto &packed_alphas = this->packed_representation_[tau];
 
-        // Initialize the count
-        for (const auto &hyperplane : all_hyperplanes)
+        // Update the count depending on visited beliefs
+        std::vector<number> refCount(packed_alphas.size(), 0);
+        for (const auto &state : this->all_state_updated_so_far[tau])
         {
-            refCount[hyperplane] = 0;
+            auto best = packed::argmax(this->packed_index_spaces_[tau]->pack(state), packed_alphas);
+            if (best.first >= 0)
+            {
+                refCount[best.first]++;
+            }
         }
 
-        // Update the count depending on visited beliefs
-        std::shared_ptr<Hyperplane> max_alpha;
-        double max_value = -std::numeric_limits<double>::max(), value;
-        for (const auto &hyperplane : this->all_state_updated_so_far[t])
+        // Delete hyperplanes with a count of 0
+        std::lock_guard<std::mutex> beta_cache_lock(this->beta_cache_mutex_);
+        for (std::size_t k = 0; k < refCount.size(); k++)
         {
-            for (const auto &alpha : all_hyperplanes)
+            if (refCount[k] == 0)
             {
-                if (max_value < (value = (hyperplane->product(alpha))))
-                {
-                    max_value = value;
-                    max_alpha = alpha;
-                }
+                const auto &alpha = this->packed_hyperplanes_[tau][k];
+                this->beta_cache_.erase(alpha);
+                all_hyperplanes.erase(alpha);
             }
-            refCount.at(max_alpha)++;
         }
+    }
 
-        // Delete hyperplanes with a count of 0
-        for (auto hyperplane_iter = all_hyperplanes.begin(); hyperplane_iter != all_hyperplanes.end();)
+    void PWLCValueFunction::lp_prune(number t)
+    {
+        number tau = this->isInfiniteHorizon() ? 0 : t;
+        auto &all_hyperplanes = this->getAlphaHyperplanesAt(t);
+        auto &witnesses = this->packed_witnesses_[tau];
+
+        std::vector<bool> kept(this->packed_representation_[tau].size(), true);
+        for (std::size_t k = 0; k < kept.size(); k++)
         {
-            if (refCount.at(*hyperplane_iter) == 0)
-                hyperplane_iter = all_hyperplanes.erase(hyperplane_iter);
+            // Hyperplanes whose witness is still valid are kept without solving a linear program
+            if ((witnesses[k] != nullptr) && this->isWitness(tau, k, kept))
+            {
+                continue;
+            }
+            witnesses[k] = this->findWitness(tau, k, kept);
+            kept[k] = (witnesses[k] != nullptr);
+        }
+
+        // Delete hyperplanes without witness
+        std::lock_guard<std::mutex> beta_cache_lock(this->beta_cache_mutex_);
+        for (std::size_t k = 0; k < kept.size(); k++)
+        {
+            if (!kept[k])
+            {
+                const auto &alpha = this->packed_hyperplanes_[tau][k];
+                this->beta_cache_.erase(alpha);
+                all_hyperplanes.erase(alpha);
+            }
+        }
+    }
+
+    bool PWLCValueFunction::isWitness(number tau, std::size_t k, const std::vector<bool> &kept) const
+    {
+        const auto &packed_alphas = this->packed_representation_[tau];
+        const auto &witness = *this->packed_witnesses_[tau][k];
+
+        double value = packed::product(witness, packed_alphas[k]);
+        for (std::size_t j = 0; j < packed_alphas.size(); j++)
+        {
+            if ((j != k) && kept[j] && (packed::product(witness, packed_alphas[j]) >= value - PWLCValueFunction::PRECISION))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::shared_ptr<PackedState> PWLCValueFunction::findWitness(number tau, std::size_t k, const std::vector<bool> &kept) const
+    {
+        const auto &packed_alphas = this->packed_representation_[tau];
+
+        // The coordinates of the linear program are the indices used by kept hyperplanes, and one more coordinate
+        // gathering all other pairs (o,x) (where every hyperplane takes its default value)
+        std::vector<std::uint32_t> coordinates;
+        for (std::size_t j = 0; j < packed_alphas.size(); j++)
+        {
+            if (!kept[j])
+                continue;
+            if (packed_alphas[j].isSparse())
+            {
+                coordinates.insert(coordinates.end(), packed_alphas[j].sparse_indices.begin(), packed_alphas[j].sparse_indices.end());
+            }
             else
-                hyperplane_iter++;
+            {
+                for (std::uint32_t i = 0; i < packed_alphas[j].values.size(); i++)
+                    coordinates.push_back(packed_alphas[j].offset + i);
+            }
+        }
+        std::sort(coordinates.begin(), coordinates.end());
+        coordinates.erase(std::unique(coordinates.begin(), coordinates.end()), coordinates.end());
+
+        // max delta s.t. sum_i b(i) (alpha_j(i) - alpha_k(i)) + delta <= 0 for all other kept hyperplanes j, and b is a distribution
+        SimplexSolver solver;
+        std::vector<Pair<std::size_t, double>> distribution;
+        for (std::size_t i = 0; i <= coordinates.size(); i++)
+        {
+            distribution.push_back({solver.addVariable(), 1.});
+        }
+        solver.addConstraint(distribution, SimplexSolver::EQUAL, 1.);
+        std::size_t delta = solver.addVariable(1., -SimplexSolver::INF, SimplexSolver::INF);
+
+        bool has_competitor = false;
+        for (std::size_t j = 0; j < packed_alphas.size(); j++)
+        {
+            if ((j == k) || !kept[j])
+                continue;
+            has_competitor = true;
+
+            std::vector<Pair<std::size_t, double>> difference;
+            for (std::size_t i = 0; i < coordinates.size(); i++)
+            {
+                double coefficient = packed::valueAt(packed_alphas[j], coordinates[i]) - packed::valueAt(packed_alphas[k], coordinates[i]);
+                if (coefficient != 0.)
+                    difference.push_back({i, coefficient});
+            }
+            difference.push_back({coordinates.size(), packed_alphas[j].default_value - packed_alphas[k].default_value});
+            difference.push_back({delta, 1.});
+            solver.addConstraint(difference, SimplexSolver::LESS_EQUAL, 0.);
+        }
+
+        auto witness = std::make_shared<PackedState>();
+        witness->weight_prefix.push_back(0.);
+        if (!has_competitor)
+        {
+            // Any distribution is a witness
+            witness->unknown_weight = 1.;
+            return witness;
+        }
+
+        if (solver.maximize() != SimplexSolver::OPTIMAL)
+        {
+            // Keep the hyperplane (an empty witness is never valid, so it will be checked again)
+            return witness;
+        }
+        if (solver.getObjectiveValue() <= PWLCValueFunction::PRECISION)
+        {
+            return nullptr;
+        }
+
+        for (std::size_t i = 0; i < coordinates.size(); i++)
+        {
+            double weight = solver.getValue(i);
+            if (weight > 0.)
+            {
+                witness->indices.push_back(coordinates[i]);
+                witness->weights.push_back(weight);
+                witness->weight_prefix.push_back(witness->weight_prefix.back() + weight);
+            }
+        }
+        witness->unknown_weight = std::max(0., solver.getValue(coordinates.size()));
+        return witness;
+    }
+
+    void PWLCValueFunction::removePrunedPackedHyperplanes(number t)
+    {
+        number tau = this->isInfiniteHorizon() ? 0 : t;
+        const auto &all_hyperplanes = this->getAlphaHyperplanesAt(t);
+        auto &hyperplanes = this->packed_hyperplanes_[tau];
+        auto &packed_alphas = this->packed_representation_[tau];
+        auto &witnesses = this->packed_witnesses_[tau];
+
+        std::size_t kept = 0;
+        for (std::size_t k = 0; k < hyperplanes.size(); k++)
+        {
+            auto iter = all_hyperplanes.find(hyperplanes[k]);
+            if (iter != all_hyperplanes.end() && *iter == hyperplanes[k])
+            {
+                // Vectors moved onto themselves are left empty
+                if (kept != k)
+                {
+                    hyperplanes[kept] = std::move(hyperplanes[k]);
+                    packed_alphas[kept] = std::move(packed_alphas[k]);
+                    witnesses[kept] = std::move(witnesses[k]);
+                }
+                kept++;
+            }
         }
+        hyperplanes.resize(kept);
+        packed_alphas.resize(kept);
+        witnesses.resize(kept);
     }
 
     std::string PWLCValueFunction::str() const
     {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
         std::ostringstream res;
         res << "<pwlc_value_function horizon=\"" << ((this->isInfiniteHorizon()) ? "inf" : std::to_string(this->getHorizon())) << "\">" << std::endl;
 
@@ -301,6 +636,7 @@ namespace sdm
 
     size_t PWLCValueFunction::getSize(number t) const
     {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
         return this->representation[this->isInfiniteHorizon() ? 0 : t].size();
     }
 } // namespace sdm
\ No newline at end of file
@@ -1,12 +1,18 @@
 #pragma once
 
 #include <bits/stdc++.h>
+#include <mutex>
+#include <atomic>
+#include <shared_mutex>
+
 #include <sdm/config.hpp>
 #include <sdm/utils/config.hpp>
 #include <sdm/utils/value_function/initializer/initializer.hpp>
 #include <sdm/utils/value_function/pwlc_value_function_interface.hpp>
 #include <sdm/utils/value_function/update_operator/vupdate_operator.hpp>
 #include <sdm/utils/linear_algebra/hyperplane/alpha_vector.hpp>
+#include <sdm/utils/linear_algebra/packed_vector.hpp>
+#include <sdm/utils/struct/recursive_map.hpp>
 #include <sdm/world/base/pomdp_interface.hpp>
 
 namespace sdm
@@ -81,8 +87,33 @@ namespace sdm
 
         std::vector<std::shared_ptr<State>> getSupport(number t);
 
+        /**
+         * @brief Get the value \beta_t(x,o,u) of a hyperplane.
+         *
+         * Values are cached per hyperplane (if the cache is enabled) and evicted when the hyperplane is pruned.
+         */
         double getBeta(const std::shared_ptr<Hyperplane> &alpha, const std::shared_ptr<State> &state, const std::shared_ptr<HistoryInterface> &history, const std::shared_ptr<Action> &action, number t);
 
+        /**
+         * @brief Enable or disable the cache of beta values.
+         */
+        void setBetaCache(bool use_beta_cache);
+
+        /**
+         * @brief Remove all values stored in the cache of beta values.
+         */
+        void clearBetaCache();
+
+        /**
+         * @brief Get the number of beta values that were found in the cache.
+         */
+        unsigned long long getBetaCacheHits() const;
+
+        /**
+         * @brief Get the number of beta values that were computed because missing in the cache.
+         */
+        unsigned long long getBetaCacheMisses() const;
+
         /**
          * @brief Get the Default Value at time step t
          *
@@ -111,6 +142,22 @@ namespace sdm
          */
         std::string str() const;
 
+        /**
+         * @brief Save the hyperplanes of each time step in a binary archive.
+         *
+         * Each hyperplane is saved with its default value and the values (x,o) it explicitly stores.
+         *
+         * @param archive the archive
+         */
+        void saveCheckpoint(boost::archive::binary_oarchive &archive);
+
+        /**
+         * @brief Load the hyperplanes of each time step from a binary archive (the current hyperplanes are removed).
+         *
+         * @param archive the archive
+         */
+        void loadCheckpoint(boost::archive::binary_iarchive &archive);
+
         /**
          * @brief Copy the value function and return a reference to the copied object.
          *
@@ -126,6 +173,32 @@ namespace sdm
          */
         std::vector<HyperplanSet> representation;
 
+        /**
+         * @brief Protect the hyperplanes against concurrent accesses (shared lock to read, exclusive lock to add or prune).
+         */
+        mutable std::shared_mutex representation_mutex_;
+
+        /**
+         * @brief The index spaces over which hyperplanes and states are packed, one for each decision epoch.
+         */
+        std::vector<std::shared_ptr<PackedIndexSpace>> packed_index_spaces_;
+
+        /**
+         * @brief The hyperplanes of the representation and their packed version (in the same order), one list for each decision epoch.
+         *
+         * Evaluating a state then amounts to one gather-based product per packed hyperplane.
+         */
+        std::vector<std::vector<std::shared_ptr<AlphaVector>>> packed_hyperplanes_;
+        std::vector<std::vector<PackedAlphaVector>> packed_representation_;
+
+        /**
+         * @brief For each packed hyperplane, a state at which it is strictly better than all others (nullptr if unknown).
+         *
+         * Witnesses are found by LP pruning. A hyperplane whose witness remains valid when new hyperplanes arrive
+         * is kept without solving a new linear program.
+         */
+        std::vector<std::vector<std::shared_ptr<PackedState>>> packed_witnesses_;
+
         /**
          * @brief the default values, one for each decision epoch.
          */
@@ -149,6 +222,26 @@ namespace sdm
          */
         std::shared_ptr<POMDPInterface> pomdp;
 
+        /**
+         * @brief Whether beta values are cached or not.
+         */
+        bool use_beta_cache_ = true;
+
+        /**
+         * @brief The cache of beta values (i.e. hyperplane -> o -> x -> u -> \beta(x,o,u)).
+         */
+        RecursiveMap<std::shared_ptr<Hyperplane>, std::shared_ptr<HistoryInterface>, std::shared_ptr<State>, std::shared_ptr<Action>, double> beta_cache_;
+
+        /**
+         * @brief Statistics of the cache of beta values.
+         */
+        std::atomic<unsigned long long> beta_cache_hits_{0}, beta_cache_misses_{0};
+
+        /**
+         * @brief Protect the cache of beta values against concurrent accesses.
+         */
+        std::mutex beta_cache_mutex_;
+
         /**
          * @brief Prune dominated hyperplanes of the value function.
          *
@@ -171,6 +264,38 @@ namespace sdm
          */
         void pairwise_prune(number t);
 
+        /**
+         * @brief This method prunes hyperplanes that are dominated by the upper envelope of the others, known as LP pruning (White and Lark).
+         *
+         * For each hyperplane, a linear program looks for a witness, i.e. a distribution over pairs (o,x) where
+         * the hyperplane is strictly better than all others. Hyperplanes without witness are pruned.
+         *
+         * @param number : timestep
+         */
+        void lp_prune(number t);
+
+        /**
+         * @brief Find a witness of a packed hyperplane against the other kept hyperplanes.
+         *
+         * @param tau the index of the time step
+         * @param k the position of the hyperplane
+         * @param kept whether hyperplanes are still kept
+         * @return a witness, or nullptr if the hyperplane is dominated
+         */
+        std::shared_ptr<PackedState> findWitness(number tau, std::size_t k, const std::vector<bool> &kept) const;
+
+        /**
+         * @brief Check that a hyperplane is strictly better than all other kept hyperplanes at its witness.
+         */
+        bool isWitness(number tau, std::size_t k, const std::vector<bool> &kept) const;
+
+        /**
+         * @brief Remove the packed version of hyperplanes that are no longer in the representation.
+         *
+         * @param number : timestep
+         */
+        void removePrunedPackedHyperplanes(number t);
+
         HyperplanSet& getAlphaHyperplanesAt(number t);
     };
 
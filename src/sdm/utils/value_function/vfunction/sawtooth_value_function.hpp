@@ -1,5 +1,6 @@
 #pragma once
 
+#include <sdm/utils/linear_algebra/packed_vector.hpp>
 #include <sdm/utils/value_function/prunable_structure.hpp>
 #include <sdm/utils/value_function/vfunction/tabular_value_function.hpp>
 
@@ -26,6 +27,11 @@ namespace sdm
     public:
         using Container = typename BaseTabularValueFunction<Hash, KeyEqual>::Container;
 
+        /**
+         * @brief The default maximal number of ratios kept in the cache.
+         */
+        static constexpr std::size_t DEFAULT_RATIO_CACHE_SIZE = 1 << 20;
+
         BaseSawtoothValueFunction(const std::shared_ptr<SolvableByDP> &world,
                                   const std::shared_ptr<Initializer> &initializer,
                                   const std::shared_ptr<ActionSelectionInterface> &action_selection,
@@ -70,6 +76,13 @@ namespace sdm
          */
         double getRelaxedValueAt(const std::shared_ptr<State> &state, number t);
 
+        /**
+         * @brief Load the points from a binary archive (the index of points and the cache of ratios are reset).
+         *
+         * @param archive the archive
+         */
+        void loadCheckpoint(boost::archive::binary_iarchive &archive);
+
         /**
          * @brief Copy the value function and return a reference to the copied object.
          *
@@ -101,9 +114,53 @@ namespace sdm
         std::vector<Container> relaxation;
 
         /**
-         * @brief A data structure to store values of the relaxations.
+         * @brief A cache of the ratios between two states (used for pruning).
+         *
+         * The cache holds at most ratio_cache_size_ ratios, it is emptied when full. Ratios involving a pruned point
+         * are removed.
+         */
+        std::unordered_map<std::shared_ptr<State>, std::unordered_map<std::shared_ptr<State>, double>> ratios;
+        std::size_t num_ratios_ = 0, ratio_cache_size_ = DEFAULT_RATIO_CACHE_SIZE;
+
+        /**
+         * @brief Protect the relaxed values and the ratios against concurrent accesses.
+         */
+        mutable std::shared_mutex cache_mutex_;
+
+        /**
+         * @brief An inverted index from the pairs (o,x) to the points whose support contains them.
+         *
+         * The ratio \min_{(o,x)\in Supp(s^k)} s(o,x)/s^k(o,x) is zero unless the support of s^k is included in the support
+         * of s. Going over the points of each pair (o,x) in the support of s is enough to find these candidate points and
+         * compute their ratios, other points are never visited.
+         */
+        struct PointIndex
+        {
+            /** @brief The dense indices of the pairs (o,x). */
+            PackedIndexSpace index_space;
+
+            /** @brief The point in each slot (nullptr if the slot is free), its number of pairs (o,x) and the free slots. */
+            std::vector<std::shared_ptr<State>> points;
+            std::vector<std::uint32_t> support_sizes;
+            std::vector<std::uint32_t> free_slots;
+
+            /** @brief The slot of each point. */
+            std::unordered_map<std::shared_ptr<State>, std::uint32_t, Hash, KeyEqual> slots;
+
+            /** @brief For each pair (o,x), the slots of the points containing it with the inverse 1 / s^k(o,x). */
+            std::vector<std::vector<Pair<std::uint32_t, double>>> postings;
+
+            /** @brief The slots of points with an empty support (their ratio is always 1). */
+            std::vector<std::uint32_t> empty_supports;
+
+            /** @brief The generation of the representation held by the index (none until the index is first built). */
+            unsigned long long generation = std::numeric_limits<unsigned long long>::max();
+        };
+
+        /**
+         * @brief The index of the points of each time step (protected by the lock of the representation).
          */
-        RecursiveMap<std::shared_ptr<State>, std::shared_ptr<State>, double> ratios;
+        std::vector<std::shared_ptr<PointIndex>> point_index_;
 
         /**
          * @brief Point-wise pruning.
@@ -128,6 +185,28 @@ namespace sdm
          */
         double computeRatio(const std::shared_ptr<State> &s, const std::shared_ptr<State> &s_k);
 
+        /**
+         * @brief Add a point to the index of a time step (the lock of the representation must be held exclusively).
+         */
+        void indexPoint(PointIndex &index, const std::shared_ptr<State> &state);
+
+        /**
+         * @brief Remove a point from the index of a time step (the lock of the representation must be held exclusively).
+         */
+        void unindexPoint(PointIndex &index, const std::shared_ptr<State> &state);
+
+        /**
+         * @brief Check that the index of a time step holds the points of the representation, rebuild it otherwise.
+         *
+         * Points are indexed when added or pruned, the index is only rebuilt when the representation was modified
+         * otherwise (e.g. reset, loaded or copied), i.e. when its generation is not the one of the representation.
+         *
+         * @return whether the index holds the points of the representation (the lock of the representation must be
+         * held exclusively to rebuild it)
+         */
+        bool isIndexSynchronized(number t) const;
+        void synchronizeIndex(number t);
+
         /**
          * @brief Ratio specialized for the Occupancy case (used for the evaluate function)
          *
@@ -156,6 +235,10 @@ namespace sdm
 
             archive &make_nvp("horizon", this->horizon_);
             archive &make_nvp("representation", this->representation);
+            if (Archive::is_loading::value)
+            {
+                this->markModified();
+            }
         }
     };
 
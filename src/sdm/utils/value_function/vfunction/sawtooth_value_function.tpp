@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <sdm/core/state/interface/belief_interface.hpp>
 #include <sdm/core/state/interface/occupancy_state_interface.hpp>
 #include <sdm/world/base/pomdp_interface.hpp>
@@ -18,6 +20,10 @@ namespace sdm
           type_of_sawtooth_prunning_(type_of_sawtooth_pruning)
     {
         this->relaxation = std::vector<Container>(this->isInfiniteHorizon() ? 1 : this->horizon_ + 1, Container());
+        for (std::size_t t = 0; t < this->relaxation.size(); t++)
+        {
+            this->point_index_.push_back(std::make_shared<PointIndex>());
+        }
     }
 
     template <class Hash, class KeyEqual>
@@ -27,6 +33,7 @@ namespace sdm
                                                                          Config config)
         : BaseSawtoothValueFunction(world, initializer, action_selection, config.get("freq_pruning", -1))
     {
+        this->ratio_cache_size_ = config.get("ratio_cache_size", (int)DEFAULT_RATIO_CACHE_SIZE);
         auto opt_int = config.getOpt<int>("pruning_type");
         auto opt_str = config.getOpt<std::string>("pruning_type");
         if (opt_int.has_value())
@@ -45,8 +52,14 @@ namespace sdm
         : ValueFunctionInterface(copy.world_, copy.initializer_, copy.action_selection_),
           BaseTabularValueFunction<Hash, KeyEqual>(copy),
           PrunableStructure(copy.world_->getHorizon(), copy.freq_pruning),
-          type_of_sawtooth_prunning_(copy.type_of_sawtooth_prunning_)
+          type_of_sawtooth_prunning_(copy.type_of_sawtooth_prunning_),
+          ratio_cache_size_(copy.ratio_cache_size_)
     {
+        this->relaxation = std::vector<Container>(this->isInfiniteHorizon() ? 1 : this->horizon_ + 1, Container());
+        for (std::size_t t = 0; t < this->relaxation.size(); t++)
+        {
+            this->point_index_.push_back(std::make_shared<PointIndex>());
+        }
     }
 
     template <class Hash, class KeyEqual>
@@ -59,26 +72,141 @@ namespace sdm
     void BaseSawtoothValueFunction<Hash, KeyEqual>::setValueAt(const std::shared_ptr<State> &state, double new_value, number t)
     {
         // assert((getValueAt(state, t) >= new_value) && "New value is higher than the old");
-        BaseTabularValueFunction<Hash, KeyEqual>::setValueAt(state, new_value, t);
+        bool is_new_point;
+        {
+            std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+            auto &container = this->representation[this->isInfiniteHorizon() ? 0 : t];
+            auto &index = *this->point_index_[this->isInfiniteHorizon() ? 0 : t];
+            is_new_point = (container.find(state) == container.end());
+            bool synchronized = this->isIndexSynchronized(t);
+            if (synchronized && (index.slots.find(state) == index.slots.end()))
+            {
+                this->indexPoint(index, state);
+            }
+            container[state] = new_value;
+            if (synchronized)
+            {
+                index.generation = ++this->generations_[this->isInfiniteHorizon() ? 0 : t];
+            }
+            else
+            {
+                this->generations_[this->isInfiniteHorizon() ? 0 : t]++;
+            }
+        }
+        if (is_new_point)
+        {
+            this->pinPoint(state, true);
+        }
     }
 
     template <class Hash, class KeyEqual>
-    double BaseSawtoothValueFunction<Hash, KeyEqual>::getRelaxedValueAt(const std::shared_ptr<State> &state, number t)
+    void BaseSawtoothValueFunction<Hash, KeyEqual>::indexPoint(PointIndex &index, const std::shared_ptr<State> &state)
     {
-        double relaxed_value = 0;
-        auto iter_relax = this->relaxation[this->isInfiniteHorizon() ? 0 : t].find(state);
-        if (iter_relax == this->relaxation[this->isInfiniteHorizon() ? 0 : t].end())
+        std::uint32_t slot;
+        if (index.free_slots.empty())
         {
-            if (this->getInitFunction())
-                relaxed_value = this->getInitFunction()->operator()(state, t);
-            else
-                relaxed_value = this->representation[this->isInfiniteHorizon() ? 0 : t].getDefault();
-            this->relaxation[this->isInfiniteHorizon() ? 0 : t].emplace(state, relaxed_value);
+            slot = index.points.size();
+            index.points.emplace_back();
+            index.support_sizes.emplace_back();
         }
         else
         {
-            relaxed_value = iter_relax->second;
+            slot = index.free_slots.back();
+            index.free_slots.pop_back();
         }
+
+        auto support = index.index_space.insert(state);
+        index.points[slot] = state;
+        index.support_sizes[slot] = 0;
+        index.slots.emplace(state, slot);
+
+        if (index.postings.size() < index.index_space.size())
+        {
+            index.postings.resize(index.index_space.size());
+        }
+        for (std::size_t i = 0; i < support.indices.size(); i++)
+        {
+            // Pairs of zero probability never bound the ratio
+            if (support.weights[i] > 0.)
+            {
+                index.postings[support.indices[i]].push_back({slot, 1. / support.weights[i]});
+                index.support_sizes[slot]++;
+            }
+        }
+        if (index.support_sizes[slot] == 0)
+        {
+            index.empty_supports.push_back(slot);
+        }
+    }
+
+    template <class Hash, class KeyEqual>
+    void BaseSawtoothValueFunction<Hash, KeyEqual>::unindexPoint(PointIndex &index, const std::shared_ptr<State> &state)
+    {
+        auto iter = index.slots.find(state);
+        if (iter == index.slots.end())
+        {
+            return;
+        }
+        std::uint32_t slot = iter->second;
+        index.slots.erase(iter);
+
+        auto remove_slot = [slot](std::vector<Pair<std::uint32_t, double>> &posting)
+        {
+            posting.erase(std::remove_if(posting.begin(), posting.end(), [slot](const Pair<std::uint32_t, double> &entry)
+                                         { return entry.first == slot; }),
+                          posting.end());
+        };
+        for (const auto &i : index.index_space.pack(state).indices)
+        {
+            remove_slot(index.postings[i]);
+        }
+        index.empty_supports.erase(std::remove(index.empty_supports.begin(), index.empty_supports.end(), slot), index.empty_supports.end());
+
+        index.points[slot] = nullptr;
+        index.free_slots.push_back(slot);
+    }
+
+    template <class Hash, class KeyEqual>
+    bool BaseSawtoothValueFunction<Hash, KeyEqual>::isIndexSynchronized(number t) const
+    {
+        return this->point_index_[this->isInfiniteHorizon() ? 0 : t]->generation == this->generations_[this->isInfiniteHorizon() ? 0 : t];
+    }
+
+    template <class Hash, class KeyEqual>
+    void BaseSawtoothValueFunction<Hash, KeyEqual>::synchronizeIndex(number t)
+    {
+        if (!this->isIndexSynchronized(t))
+        {
+            auto &index = this->point_index_[this->isInfiniteHorizon() ? 0 : t];
+            index = std::make_shared<PointIndex>();
+            for (const auto &point : this->representation[this->isInfiniteHorizon() ? 0 : t])
+            {
+                this->indexPoint(*index, point.first);
+            }
+            index->generation = this->generations_[this->isInfiniteHorizon() ? 0 : t];
+        }
+    }
+
+    template <class Hash, class KeyEqual>
+    double BaseSawtoothValueFunction<Hash, KeyEqual>::getRelaxedValueAt(const std::shared_ptr<State> &state, number t)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(this->cache_mutex_);
+            auto iter_relax = this->relaxation[this->isInfiniteHorizon() ? 0 : t].find(state);
+            if (iter_relax != this->relaxation[this->isInfiniteHorizon() ? 0 : t].end())
+            {
+                return iter_relax->second;
+            }
+        }
+
+        double relaxed_value = 0;
+        if (this->getInitFunction())
+            relaxed_value = this->getInitFunction()->operator()(state, t);
+        else
+            relaxed_value = this->getRepresentation(t).getDefault();
+
+        std::unique_lock<std::shared_mutex> lock(this->cache_mutex_);
+        this->relaxation[this->isInfiniteHorizon() ? 0 : t].emplace(state, relaxed_value);
         return relaxed_value;
     }
 
@@ -86,49 +214,122 @@ namespace sdm
     Pair<std::shared_ptr<State>, double> BaseSawtoothValueFunction<Hash, KeyEqual>::evaluate(const std::shared_ptr<State> &state, number t)
     {
 
-        auto iterator_on_point = this->representation[this->isInfiniteHorizon() ? 0 : t].find(state);
-        if (iterator_on_point != this->representation[this->isInfiniteHorizon() ? 0 : t].end())
         {
-            return *iterator_on_point;
+            std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
+            auto iterator_on_point = this->representation[this->isInfiniteHorizon() ? 0 : t].find(state);
+            if (iterator_on_point != this->representation[this->isInfiniteHorizon() ? 0 : t].end())
+            {
+                return *iterator_on_point;
+            }
         }
-        else
+
+        // Compute v(s) = v^{relax}(s) + min_k min_{x\in Supp(s^k)} \frac{s(x)}{s^k(x)} \left( v^{relax}(s^k) - v^k\right)
+        double v_relax = this->getRelaxedValueAt(state, t);
+
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
+        while (!this->isIndexSynchronized(t))
         {
-            // Compute v(s) = v^{relax}(s) + min_k min_{x\in Supp(s^k)} \frac{s(x)}{s^k(x)} \left( v^{relax}(s^k) - v^k\right)
-            std::shared_ptr<State> argmin_k = state;
-            double min_k = (this->getSupport(t).size() == 0) ? 0.0 : std::numeric_limits<double>::max();
-            double v_relax = this->getRelaxedValueAt(state, t);
+            lock.unlock();
+            {
+                std::unique_lock<std::shared_mutex> unique_lock(this->representation_mutex_);
+                this->synchronizeIndex(t);
+            }
+            lock.lock();
+        }
 
-            // Go over all points in the representation
-            for (const auto &point_k : this->representation[this->isInfiniteHorizon() ? 0 : t])
+        const auto &points = this->representation[this->isInfiniteHorizon() ? 0 : t];
+        const auto &index = *this->point_index_[this->isInfiniteHorizon() ? 0 : t];
+        if (points.size() == 0)
+        {
+            return std::make_pair(state, v_relax);
+        }
+
+        // Go over the points containing each pair (o,x) of the support of s : count the pairs of each point that are
+        // in the support of s, and compute the minimal ratio s(o,x)/s^k(o,x) over these pairs
+        static thread_local std::vector<std::uint32_t> counts;
+        static thread_local std::vector<double> min_ratios;
+        static thread_local std::vector<std::uint32_t> visited;
+        counts.resize(index.points.size(), 0);
+        min_ratios.resize(index.points.size(), 1.0);
+        visited.clear();
+
+        auto packed_state = index.index_space.pack(state);
+        for (std::size_t i = 0; i < packed_state.indices.size(); i++)
+        {
+            double weight = packed_state.weights[i];
+            for (const auto &[slot, inverse] : index.postings[packed_state.indices[i]])
             {
-                // Dissociate element of the k-th point (state / value)
-                auto [s_k, v_k] = point_k;
+                if (counts[slot]++ == 0)
+                {
+                    visited.push_back(slot);
+                }
+                min_ratios[slot] = std::min(min_ratios[slot], weight * inverse);
+            }
+        }
 
-                // Determine the "value" for k-th point
-                double min_int = this->computeRatio(state, s_k) * (v_k - this->getRelaxedValueAt(s_k, t));
+        // The ratio of a point is zero unless its whole support is in the support of s (candidate point)
+        std::shared_ptr<State> argmin_k = state;
+        double min_k = std::numeric_limits<double>::max();
+        std::size_t num_candidates = 0;
+        auto evaluate_candidate = [&](std::uint32_t slot, double ratio)
+        {
+            const auto &s_k = index.points[slot];
+            double min_int = ratio * (points.at(s_k) - this->getRelaxedValueAt(s_k, t));
+            if (min_int < min_k)
+            {
+                min_k = min_int;
+                argmin_k = s_k;
+            }
+            num_candidates++;
+        };
+        for (const auto &slot : visited)
+        {
+            if (counts[slot] == index.support_sizes[slot])
+            {
+                evaluate_candidate(slot, min_ratios[slot]);
+            }
+        }
+        for (const auto &slot : index.empty_supports)
+        {
+            evaluate_candidate(slot, 1.0);
+        }
 
-                // If the "value" of k-th point is minimal, keep it
-                if (min_int < min_k)
+        // Other points all have a zero "value"
+        if ((num_candidates < points.size()) && (0.0 < min_k))
+        {
+            min_k = 0.0;
+            for (std::uint32_t slot = 0; slot < index.points.size(); slot++)
+            {
+                if ((index.points[slot] != nullptr) && (counts[slot] != index.support_sizes[slot]))
                 {
-                    min_k = min_int;
-                    argmin_k = s_k;
+                    argmin_k = index.points[slot];
+                    break;
                 }
             }
-            return std::make_pair(argmin_k, v_relax + min_k);
         }
+
+        for (const auto &slot : visited)
+        {
+            counts[slot] = 0;
+            min_ratios[slot] = 1.0;
+        }
+        return std::make_pair(argmin_k, v_relax + min_k);
     }
 
     template <class Hash, class KeyEqual>
     double BaseSawtoothValueFunction<Hash, KeyEqual>::computeRatio(const std::shared_ptr<State> &s, const std::shared_ptr<State> &s_k)
     {
         // Check available ratio in the map and return it
-        auto iter_s = ratios.find(s);
-        if (iter_s != ratios.end())
         {
-            auto iter_s_k = iter_s->second.find(s_k);
-            if (iter_s_k != iter_s->second.end())
+            std::shared_lock<std::shared_mutex> lock(this->cache_mutex_);
+            auto iter_s = this->ratios.find(s);
+            if (iter_s != this->ratios.end())
             {
-                return iter_s_k->second;
+                auto iter_s_k = iter_s->second.find(s_k);
+                if (iter_s_k != iter_s->second.end())
+                {
+                    return iter_s_k->second;
+                }
             }
         }
         double ratio = 0.;
@@ -145,7 +346,16 @@ namespace sdm
         {
             throw sdm::exception::Exception("(PointSet::computeRatio) States must inherit from 'BeliefInterface' or 'OccupancyStateInterface'");
         }
-        ratios[s][s_k] = ratio;
+        std::unique_lock<std::shared_mutex> lock(this->cache_mutex_);
+        if (this->num_ratios_ >= this->ratio_cache_size_)
+        {
+            this->ratios.clear();
+            this->num_ratios_ = 0;
+        }
+        if (this->ratios[s].emplace(s_k, ratio).second)
+        {
+            this->num_ratios_++;
+        }
         return ratio;
     }
 
@@ -241,9 +451,46 @@ namespace sdm
         }
 
         // Erase pairwise epsilon-dominated points
+        {
+            std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+            bool synchronized = this->isIndexSynchronized(t);
+            for (const auto &to_delete : point_to_delete)
+            {
+                if (synchronized)
+                {
+                    this->unindexPoint(*this->point_index_[this->isInfiniteHorizon() ? 0 : t], to_delete);
+                }
+                this->representation[this->isInfiniteHorizon() ? 0 : t].erase(to_delete);
+            }
+            this->generations_[this->isInfiniteHorizon() ? 0 : t]++;
+            if (synchronized)
+            {
+                this->point_index_[this->isInfiniteHorizon() ? 0 : t]->generation = this->generations_[this->isInfiniteHorizon() ? 0 : t];
+            }
+        }
+
         for (const auto &to_delete : point_to_delete)
         {
-            this->representation[this->isInfiniteHorizon() ? 0 : t].erase(to_delete);
+            this->pinPoint(to_delete, false);
+        }
+
+        // Invalidate the ratios involving erased points
+        std::unique_lock<std::shared_mutex> lock(this->cache_mutex_);
+        for (const auto &to_delete : point_to_delete)
+        {
+            auto iter = this->ratios.find(to_delete);
+            if (iter != this->ratios.end())
+            {
+                this->num_ratios_ -= iter->second.size();
+                this->ratios.erase(iter);
+            }
+        }
+        for (auto &ratios_s : this->ratios)
+        {
+            for (const auto &to_delete : point_to_delete)
+            {
+                this->num_ratios_ -= ratios_s.second.erase(to_delete);
+            }
         }
     }
 
@@ -254,6 +501,24 @@ namespace sdm
             this->pairwise_prune(t);
     }
 
+    template <class Hash, class KeyEqual>
+    void BaseSawtoothValueFunction<Hash, KeyEqual>::loadCheckpoint(boost::archive::binary_iarchive &archive)
+    {
+        {
+            std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+            for (auto &index : this->point_index_)
+            {
+                index = std::make_shared<PointIndex>();
+            }
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(this->cache_mutex_);
+            this->ratios.clear();
+            this->num_ratios_ = 0;
+        }
+        BaseTabularValueFunction<Hash, KeyEqual>::loadCheckpoint(archive);
+    }
+
     template <class Hash, class KeyEqual>
     std::shared_ptr<ValueFunctionInterface> BaseSawtoothValueFunction<Hash, KeyEqual>::copy()
     {
@@ -264,6 +529,7 @@ namespace sdm
     template <class Hash, class KeyEqual>
     std::string BaseSawtoothValueFunction<Hash, KeyEqual>::str() const
     {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
         std::ostringstream res;
         res << "<point_set_representation horizon=\"" << ((this->isInfiniteHorizon()) ? "inf" : std::to_string(this->getHorizon())) << "\">" << std::endl;
         for (std::size_t i = 0; i < this->representation.size(); i++)
@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <shared_mutex>
+
 #include <sdm/utils/config.hpp>
 #include <sdm/utils/linear_algebra/mapped_vector.hpp>
 #include <sdm/utils/value_function/value_function.hpp>
@@ -33,6 +36,11 @@ namespace sdm
 
         BaseTabularValueFunction(const BaseTabularValueFunction &copy);
 
+        /**
+         * @brief Unpin the points of the value function (see `BeliefMDPInterface::pinState`).
+         */
+        virtual ~BaseTabularValueFunction();
+
         /**
          * @brief Initialize the value function by using initializer.
          */
@@ -75,24 +83,20 @@ namespace sdm
         virtual Pair<std::shared_ptr<State>, double> evaluate(const std::shared_ptr<State> &state, number t);
 
         /**
-         * @brief Save a value function into a file.
-         *
-         * The extension of the file will indicate the type of formatage for recording
-         * (`.txt` = text format, '.xml' = XML format, other = binary format).
+         * @brief Save the points (state, value) of each time step in a binary archive.
          *
-         * @param filename the filename
+         * @param archive the archive
          */
-        void save(std::string filename);
+        void saveCheckpoint(boost::archive::binary_oarchive &archive);
 
         /**
-         * @brief Load a value function from a file.
+         * @brief Load the points (state, value) of each time step from a binary archive.
          * 
-         * The extension of the file will indicate the type of formatage for reading
-         * (`.txt` = text format, '.xml' = XML format, other = binary format).
+         * Points are added with `setValueAt`, so that derived representations index them.
          *
-         * @param filename the filename
+         * @param archive the archive
          */
-        void load(std::string filename);
+        void loadCheckpoint(boost::archive::binary_iarchive &archive);
 
         /**
          * @brief Copy the value function and return a reference to the copied object.
@@ -142,6 +146,32 @@ namespace sdm
          */
         std::vector<Container> representation;
 
+        /**
+         * @brief Protect the representation against concurrent accesses (shared lock to read, exclusive lock to write).
+         */
+        mutable std::shared_mutex representation_mutex_;
+
+        /**
+         * @brief The number of modifications of the representation of each time step (protected by the lock of the representation).
+         *
+         * Structures built from the representation record the generation they were built for, so that they can
+         * detect any write, including those that do not go through setValueAt (e.g. reset or load).
+         */
+        std::vector<unsigned long long> generations_;
+
+        /**
+         * @brief Pin (or unpin) a point in the world, so that a belief MDP does not evict the points kept by the value function.
+         *
+         * @param state the point
+         * @param pin whether the point is pinned or unpinned
+         */
+        void pinPoint(const std::shared_ptr<State> &state, bool pin);
+
+        /**
+         * @brief Start a new generation at all time steps (the representation was replaced as a whole, e.g. deserialized).
+         */
+        void markModified();
+
     public:
         friend class boost::serialization::access;
 
@@ -153,6 +183,10 @@ namespace sdm
 
             archive &make_nvp("horizon", this->horizon_);
             archive &make_nvp("representation", representation);
+            if (Archive::is_loading::value)
+            {
+                this->markModified();
+            }
         }
     };
 
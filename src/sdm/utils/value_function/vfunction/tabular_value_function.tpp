@@ -3,6 +3,7 @@
 #include <sdm/types.hpp>
 #include <sdm/utils/value_function/initializer/initializer.hpp>
 #include <sdm/utils/value_function/vfunction/tabular_value_function.hpp>
+#include <sdm/world/base/belief_mdp_interface.hpp>
 
 #include <sdm/utils/value_function/action_selection/exhaustive_action_selection.hpp>
 #include <sdm/utils/value_function/initializer/initializer.hpp>
@@ -19,6 +20,7 @@ namespace sdm
           TabularValueFunctionInterface(world, initializer, action_selection)
     {
         this->representation = std::vector<Container>(this->isInfiniteHorizon() ? 1 : world->getHorizon() + 1, Container());
+        this->generations_ = std::vector<unsigned long long>(this->representation.size(), 0);
     }
 
     template <class Hash, class KeyEqual>
@@ -26,7 +28,45 @@ namespace sdm
         : ValueFunctionInterface(copy.world_, copy.initializer_, copy.action_selection_),
           ValueFunction(copy),
           TabularValueFunctionInterface(copy.world_, copy.initializer_, copy.action_selection_),
-          representation(copy.representation) {}
+          representation(copy.representation),
+          generations_(copy.generations_)
+    {
+        for (const auto &container : this->representation)
+        {
+            for (const auto &pair_state_value : container)
+            {
+                this->pinPoint(pair_state_value.first, true);
+            }
+        }
+    }
+
+    template <class Hash, class KeyEqual>
+    BaseTabularValueFunction<Hash, KeyEqual>::~BaseTabularValueFunction()
+    {
+        for (const auto &container : this->representation)
+        {
+            for (const auto &pair_state_value : container)
+            {
+                this->pinPoint(pair_state_value.first, false);
+            }
+        }
+    }
+
+    template <class Hash, class KeyEqual>
+    void BaseTabularValueFunction<Hash, KeyEqual>::pinPoint(const std::shared_ptr<State> &state, bool pin)
+    {
+        if (auto belief_mdp = std::dynamic_pointer_cast<BeliefMDPInterface>(this->getWorld()))
+        {
+            if (pin)
+            {
+                belief_mdp->pinState(state);
+            }
+            else
+            {
+                belief_mdp->unpinState(state);
+            }
+        }
+    }
 
     template <class Hash, class KeyEqual>
     void BaseTabularValueFunction<Hash, KeyEqual>::initialize()
@@ -38,21 +78,32 @@ namespace sdm
     void BaseTabularValueFunction<Hash, KeyEqual>::initialize(double default_value, number t)
     {
        // std::cout << "\n tabular value function asked to initialize with default value : " << default_value;
-        this->representation[this->isInfiniteHorizon() ? 0 : t] = Container(default_value);
+        Container previous_points;
+        {
+            std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+            previous_points = std::move(this->representation[this->isInfiniteHorizon() ? 0 : t]);
+            this->representation[this->isInfiniteHorizon() ? 0 : t] = Container(default_value);
+            this->generations_[this->isInfiniteHorizon() ? 0 : t]++;
+        }
+        for (const auto &pair_state_value : previous_points)
+        {
+            this->pinPoint(pair_state_value.first, false);
+        }
     }
 
     template <class Hash, class KeyEqual>
     double BaseTabularValueFunction<Hash, KeyEqual>::getValueAt(const std::shared_ptr<State> &state, number t)
     {
-        if (this->init_function_ != nullptr && (t < this->getHorizon() || this->isInfiniteHorizon()))
         {
-            if ((this->representation[this->isInfiniteHorizon() ? 0 : t].find(state) == this->representation[this->isInfiniteHorizon() ? 0 : t].end()))
+            std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
+            auto &container = this->representation[this->isInfiniteHorizon() ? 0 : t];
+            if ((this->init_function_ == nullptr) || !(t < this->getHorizon() || this->isInfiniteHorizon()) || (container.find(state) != container.end()))
             {
-                return this->getInitFunction()->operator()(state, t);
+                return container.at(state);
             }
         }
-        double value = this->representation[this->isInfiniteHorizon() ? 0 : t].at(state);
-        return value;
+        // The init function is called outside of the lock since it may evaluate other value functions
+        return this->getInitFunction()->operator()(state, t);
     }
 
     template <class Hash, class KeyEqual>
@@ -64,29 +115,90 @@ namespace sdm
     template <class Hash, class KeyEqual>
     void BaseTabularValueFunction<Hash, KeyEqual>::setValueAt(const std::shared_ptr<State> &state, double new_value, number t)
     {
-        this->representation[this->isInfiniteHorizon() ? 0 : t][state] = new_value;
+        bool is_new_point;
+        {
+            std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+            auto &container = this->representation[this->isInfiniteHorizon() ? 0 : t];
+            is_new_point = (container.find(state) == container.end());
+            container[state] = new_value;
+            this->generations_[this->isInfiniteHorizon() ? 0 : t]++;
+        }
+        // The world is called outside of the lock (the world may evaluate the value function)
+        if (is_new_point)
+        {
+            this->pinPoint(state, true);
+        }
     }
 
     template <class Hash, class KeyEqual>
     size_t BaseTabularValueFunction<Hash, KeyEqual>::getSize(number t) const
     {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
         return this->representation[this->isInfiniteHorizon() ? 0 : t].size();
     }
 
     template <class Hash, class KeyEqual>
-    void BaseTabularValueFunction<Hash, KeyEqual>::save(std::string)
+    void BaseTabularValueFunction<Hash, KeyEqual>::saveCheckpoint(boost::archive::binary_oarchive &archive)
+    {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
+        std::size_t horizon = this->representation.size();
+        archive << horizon;
+        for (number t = 0; t < horizon; t++)
+        {
+            double default_value = this->representation[t].getDefault();
+            std::size_t size = this->representation[t].size();
+            archive << default_value << size;
+            for (const auto &pair_state_value : this->representation[t])
+            {
+                this->getWorld()->saveState(archive, pair_state_value.first, t);
+                archive << pair_state_value.second;
+            }
+        }
+    }
+
+    template <class Hash, class KeyEqual>
+    void BaseTabularValueFunction<Hash, KeyEqual>::loadCheckpoint(boost::archive::binary_iarchive &archive)
     {
-        // std::ofstream ofs("mabc.txt");
-        // boost::archive::binary_oarchive output_archive(ofs);
-        // // this->serialize(output_archive,0);
-        // this->representation[0].serialize(output_archive,0);
-        // ofs.close();
+        std::size_t horizon;
+        archive >> horizon;
+        if (horizon != this->representation.size())
+        {
+            throw sdm::exception::Exception("BaseTabularValueFunction::loadCheckpoint : the checkpoint was saved for another horizon");
+        }
+        for (number t = 0; t < horizon; t++)
+        {
+            double default_value;
+            std::size_t size;
+            archive >> default_value >> size;
+            Container previous_points;
+            {
+                std::unique_lock<std::shared_mutex> lock(this->representation_mutex_);
+                previous_points = std::move(this->representation[t]);
+                this->representation[t] = Container(default_value);
+                this->generations_[t]++;
+            }
+            for (const auto &pair_state_value : previous_points)
+            {
+                this->pinPoint(pair_state_value.first, false);
+            }
+            for (std::size_t i = 0; i < size; i++)
+            {
+                auto state = this->getWorld()->loadState(archive, t);
+                double value;
+                archive >> value;
+                this->setValueAt(state, value, t);
+            }
+        }
     }
 
     template <class Hash, class KeyEqual>
-    void BaseTabularValueFunction<Hash, KeyEqual>::load(std::string)
+    void BaseTabularValueFunction<Hash, KeyEqual>::markModified()
     {
-        // BoostSerializable<BaseTabularValueFunction>::load(filename);
+        this->generations_.resize(this->representation.size(), 0);
+        for (auto &generation : this->generations_)
+        {
+            generation++;
+        }
     }
 
     template <class Hash, class KeyEqual>
@@ -99,6 +211,7 @@ namespace sdm
     template <class Hash, class KeyEqual>
     std::string BaseTabularValueFunction<Hash, KeyEqual>::str() const
     {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
         std::ostringstream res;
 
         res << "<tabular_value_function horizon=\"" << ((this->isInfiniteHorizon()) ? "inf" : std::to_string(this->getHorizon())) << "\">" << std::endl;
@@ -123,6 +236,7 @@ namespace sdm
     template <class Hash, class KeyEqual>
     std::vector<std::shared_ptr<State>> BaseTabularValueFunction<Hash, KeyEqual>::getSupport(number t)
     {
+        std::shared_lock<std::shared_mutex> lock(this->representation_mutex_);
         return this->representation[this->isInfiniteHorizon() ? 0 : t].getIndexes();
     }
 
@@ -30,6 +30,22 @@ namespace sdm
          */
         virtual std::shared_ptr<Graph<std::shared_ptr<State>, Pair<std::shared_ptr<Action>, std::shared_ptr<Observation>>>> getMDPGraph() = 0;
 
+        /** @brief Set the memory budget (in bytes) of the stored states, transitions and rewards (0 for no limit). */
+        virtual void setMemoryBudget(std::size_t memory_budget) = 0;
+
+        /** @brief Get an estimate of the memory (in bytes) used by the stored states, transitions and rewards. */
+        virtual std::size_t getResidentBytes() const = 0;
+
+        /**
+         * @brief Pin a state : it is never evicted until it is unpinned as many times as it was pinned.
+         *
+         * Value functions pin the states they keep as points, so that these points are the states reached later.
+         */
+        virtual void pinState(const std::shared_ptr<State> &state) = 0;
+
+        /** @brief Unpin a state pinned with `pinState`. */
+        virtual void unpinState(const std::shared_ptr<State> &state) = 0;
+
         virtual double getObservationProbability(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_belief, const std::shared_ptr<Observation> &obs, number t = 0) const = 0;
     };
 } // namespace sdm
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include <sdm/core/action/action.hpp>
 #include <sdm/core/space/space.hpp>
 #include <sdm/core/distribution.hpp>
+#include <sdm/core/dynamics/transitions.hpp>
 #include <sdm/world/gym_interface.hpp>
 
 namespace sdm
@@ -117,6 +118,28 @@ namespace sdm
          */
         virtual std::set<std::shared_ptr<State>> getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const = 0;
 
+        /**
+         * @brief Get reachable states with their probabilities p(s' | s, a).
+         *
+         * Tabular models return a view over their own storage. The default implementation fills a
+         * buffer owned by the calling thread, so the view is invalidated by the next call in this thread.
+         *
+         * @param state the current state
+         * @param action the current action
+         * @param t the timestep
+         * @return a view over the transitions (s', p(s' | s, a))
+         */
+        virtual Span<StateTransition> getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const
+        {
+            thread_local std::vector<StateTransition> transitions;
+            transitions.clear();
+            for (const auto &next_state : this->getReachableStates(state, action, t))
+            {
+                transitions.push_back({next_state, this->getTransitionProbability(state, action, next_state, t)});
+            }
+            return Span<StateTransition>(transitions.data(), transitions.size());
+        }
+
         virtual void setInternalState(std::shared_ptr<State> state) = 0;
 
         virtual std::shared_ptr<State> getInternalState() const = 0;
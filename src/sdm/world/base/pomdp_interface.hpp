@@ -17,6 +17,7 @@
 
 namespace sdm
 {
+    class FlatTabularDynamics;
     /**
      * @brief The class for Discrete Markov Decision Processes. 
      * 
@@ -63,5 +64,42 @@ namespace sdm
          * @return the probability
          */
         virtual double getDynamics(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, const std::shared_ptr<Observation> &observation, number t) const = 0;
+
+        /**
+         * @brief Get reachable pairs of next state and observation with their probabilities p(s', o | s, a).
+         * 
+         * Tabular models return a view over their own storage. The default implementation fills a
+         * buffer owned by the calling thread, so the view is invalidated by the next call in this thread.
+         * 
+         * @param state the state at timestep t
+         * @param action the action
+         * @param t the timestep
+         * @return a view over the transitions (s', o, p(s', o | s, a))
+         */
+        virtual Span<DynamicsTransition> getReachableDynamics(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const
+        {
+            thread_local std::vector<DynamicsTransition> transitions;
+            transitions.clear();
+            for (const auto &next_state : this->getReachableStates(state, action, t))
+            {
+                for (const auto &observation : this->getReachableObservations(state, action, next_state, t))
+                {
+                    transitions.push_back({next_state, observation, this->getDynamics(state, action, next_state, observation, t)});
+                }
+            }
+            return Span<DynamicsTransition>(transitions.data(), transitions.size());
+        }
+
+        /**
+         * @brief Get the flat representation of the dynamics, if the model is fully tabular.
+         * 
+         * Hot loops (e.g. belief updates) use it to iterate over reachable transitions without allocations.
+         * 
+         * @return the flat dynamics or nullptr if the model has no such representation
+         */
+        virtual std::shared_ptr<FlatTabularDynamics> getFlatDynamics() const
+        {
+            return nullptr;
+        }
     };
 } // namespace sdm
\ No newline at end of file
@@ -10,7 +10,17 @@
  */
 #pragma once
 
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <random>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include <sdm/types.hpp>
+#include <sdm/common.hpp>
 #include <sdm/utils/config.hpp>
 #include <sdm/core/state/state.hpp>
 #include <sdm/core/state/belief_state.hpp>
@@ -18,6 +28,9 @@
 #include <sdm/core/action/action.hpp>
 #include <sdm/utils/struct/recursive_map.hpp>
 #include <sdm/utils/struct/graph.hpp>
+#include <sdm/utils/struct/concurrent_map.hpp>
+#include <sdm/utils/struct/concurrent_block_array.hpp>
+#include <sdm/utils/struct/concurrent_interning_table.hpp>
 #include <sdm/world/base/belief_mdp_interface.hpp>
 #include <sdm/world/solvable_by_mdp.hpp>
 #include <sdm/world/base/pomdp_interface.hpp>
@@ -39,6 +52,11 @@ namespace sdm
                            public GymInterface
     {
     public:
+        using state_id_type = std::uint32_t;
+
+        /** @brief The identifier returned for states that were never stored. */
+        static constexpr state_id_type NOT_FOUND = std::numeric_limits<state_id_type>::max();
+
         BaseBeliefMDP();
         BaseBeliefMDP(Config config);
         BaseBeliefMDP(const std::shared_ptr<POMDPInterface> &pomdp, Config config);
@@ -121,6 +139,19 @@ namespace sdm
         /** @brief Get the Observation Probability p(o | b', a) */
         virtual double getObservationProbability(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_belief, const std::shared_ptr<Observation> &obs, number t = 0) const;
 
+        /**
+         * @brief Save a belief in a binary archive (as the list of indexes of states and their probabilities).
+         */
+        virtual void saveState(boost::archive::binary_oarchive &archive, const std::shared_ptr<State> &belief, number t);
+
+        /**
+         * @brief Load a belief saved with `saveState`.
+         * 
+         * If states are stored, the belief is stored as any other belief (and the stored belief of same value
+         * is returned), so that beliefs loaded from a checkpoint are the ones reached by later explorations.
+         */
+        virtual std::shared_ptr<State> loadState(boost::archive::binary_iarchive &archive, number t);
+
         // *****************
         //    RL methods
         // *****************
@@ -129,6 +160,27 @@ namespace sdm
         virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> step(std::shared_ptr<Action> action);
         virtual std::shared_ptr<Action> getRandomAction(const std::shared_ptr<State> &state, number t);
 
+        /**
+         * @brief Do a step from a given state, without changing the current state of the environment.
+         *
+         * This function can be called concurrently, since the states and transitions are stored in
+         * thread safe structures. Inherited classes define their own dynamics here rather than in `step`.
+         *
+         * @param state the state
+         * @param action the action to execute
+         * @param t the time step
+         * @param generator the generator used to sample the next state (owned by the caller)
+         * @return the information produced. Include : next state, rewards, episode done
+         */
+        virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &generator);
+
+        /**
+         * @brief Get an environment that runs its own episodes on this belief MDP (see BeliefMDPFork).
+         *
+         * The belief MDP must be owned by a shared pointer, which the fork keeps.
+         */
+        virtual std::shared_ptr<GymInterface> fork();
+
         /**
          * @brief Get the MDP graph. 
          * 
@@ -140,10 +192,45 @@ namespace sdm
         std::shared_ptr<Graph<std::shared_ptr<State>, Pair<std::shared_ptr<Action>, std::shared_ptr<Observation>>>> getMDPGraph();
         std::vector<std::shared_ptr<State>> getStoredStates() const;
 
-        /** @brief A pointer on the bag containing all states. */
-        RecursiveMap<TBelief, std::shared_ptr<State>> state_space_;
+        /** @brief Get the number of stored states. */
+        std::size_t getNumStoredStates() const;
+
+        /**
+         * @brief Get the identifier of a stored state.
+         *
+         * Identifiers are dense (0, 1, 2, ... in order of storage) and shared by all states that are equal up
+         * to the precision of TBelief, so that they can be used as keys (or indexes) by value functions.
+         *
+         * @param state the state
+         * @return the identifier of the state or NOT_FOUND if the state was never stored
+         */
+        state_id_type getStateID(const std::shared_ptr<State> &state) const;
+
+        /** @brief Get the stored state associated to an identifier (nullptr if the state was evicted). */
+        std::shared_ptr<State> getStateFromID(state_id_type state_id) const;
+
+        /**
+         * @brief Set the memory budget of the stored states, transitions and rewards.
+         *
+         * When the estimated memory used by the stored data exceeds the budget, the least recently used
+         * states are evicted with their outgoing transitions and rewards, until 90% of the budget is used.
+         * The initial state and the pinned states (e.g. points of a value function, see `pinState`) are
+         * never evicted. Evicted data is computed again when required.
+         *
+         * The budget must be set before solving.
+         *
+         * @param memory_budget the budget in bytes (0 for no limit)
+         */
+        void setMemoryBudget(std::size_t memory_budget);
 
-        std::shared_ptr<Graph<double, Pair<std::shared_ptr<State>, std::shared_ptr<Action>>>> reward_graph_;
+        /** @brief Get the memory budget in bytes (0 for no limit). */
+        std::size_t getMemoryBudget() const;
+
+        /** @brief Get an estimate of the memory used by the stored states, transitions and rewards in bytes. */
+        std::size_t getResidentBytes() const;
+
+        void pinState(const std::shared_ptr<State> &state);
+        void unpinState(const std::shared_ptr<State> &state);
 
     public:
         /** @brief The underlying well defined POMDP */
@@ -158,15 +245,198 @@ namespace sdm
         /** @brief The current timestep (used in RL). */
         int step_;
 
+        /** @brief The generator used to sample the next states of `step` (forks have their own). */
+        std::mt19937 generator_ = std::mt19937(common::global_seed());
+
         /** @brief Hyperparameters. */
         bool store_states_ = true, store_actions_ = true;
 
-        /** @brief The probability transition. (i.e. p(o | b, a) */
-        RecursiveMap<std::shared_ptr<State>, std::shared_ptr<Action>, std::shared_ptr<Observation>, double> transition_probability;
+        /** @brief Hash a state by value (up to the precision of TBelief). */
+        struct StateHash
+        {
+            std::size_t operator()(const std::shared_ptr<State> &state) const
+            {
+                return (state == nullptr) ? 0 : state->hash(TBelief::PRECISION);
+            }
+        };
+
+        /** @brief Compare two states by value (up to the precision of TBelief). */
+        struct StateEqual
+        {
+            bool operator()(const std::shared_ptr<State> &left, const std::shared_ptr<State> &right) const
+            {
+                if ((left == nullptr) || (right == nullptr))
+                    return left == right;
+                return (left == right) || left->isEqual(right, TBelief::PRECISION);
+            }
+        };
+
+        /** @brief The identifiers of a transition (b, a, o) */
+        struct TransitionKey
+        {
+            state_id_type state;
+            std::uint32_t action;
+            std::uint32_t observation;
+
+            bool operator==(const TransitionKey &other) const
+            {
+                return (this->state == other.state) && (this->action == other.action) && (this->observation == other.observation);
+            }
+        };
+
+        struct TransitionKeyHash
+        {
+            std::size_t operator()(const TransitionKey &key) const
+            {
+                std::size_t seed = 0;
+                sdm::hash_combine(seed, key.state);
+                sdm::hash_combine(seed, key.action);
+                sdm::hash_combine(seed, key.observation);
+                return seed;
+            }
+        };
+
+        /** @brief The identifiers of a pair (b, a) */
+        struct RewardKey
+        {
+            state_id_type state;
+            std::uint32_t action;
+
+            bool operator==(const RewardKey &other) const
+            {
+                return (this->state == other.state) && (this->action == other.action);
+            }
+        };
+
+        struct RewardKeyHash
+        {
+            std::size_t operator()(const RewardKey &key) const
+            {
+                std::size_t seed = 0;
+                sdm::hash_combine(seed, key.state);
+                sdm::hash_combine(seed, key.action);
+                return seed;
+            }
+        };
+
+        /** @brief The data stored for a state, required to evict it */
+        struct StateRecord
+        {
+            /** @brief The estimated size of the state in bytes */
+            std::size_t bytes = 0;
+
+            /** @brief The number of times the state was pinned and not unpinned (pinned states are not evicted) */
+            long pins = 0;
+
+            /** @brief The outgoing transitions and rewards */
+            std::vector<TransitionKey> transitions;
+            std::vector<std::uint32_t> reward_actions;
+        };
+
+        /** @brief The identifier of the next state b' and the probability p(o | b, a) of a transition (b, a, o) */
+        struct TransitionEntry
+        {
+            state_id_type next_state;
+            double probability;
+        };
+
+        /** @brief The stored states (one per value of TBelief) */
+        ConcurrentInterningTable<std::shared_ptr<State>, StateHash, StateEqual> state_table_;
+
+        /** @brief The identifiers of the stored states, indexed by address (this avoids hashing the content of known states) */
+        ConcurrentMap<std::shared_ptr<State>, state_id_type> state_address_ids_;
+
+        /** @brief The identifiers of actions and observations, indexed by address */
+        ConcurrentInterningTable<std::shared_ptr<Action>> action_table_;
+        ConcurrentInterningTable<std::shared_ptr<Observation>> observation_table_;
+
+        /** @brief The transitions (b, a, o) -> (b', p(o | b, a)) */
+        ConcurrentMap<TransitionKey, TransitionEntry, TransitionKeyHash> transitions_;
+
+        /** @brief The rewards (b, a) -> r(b, a) */
+        ConcurrentMap<RewardKey, double, RewardKeyHash> rewards_;
+
+        /** @brief The records of the stored states (guarded by compute_mutex_) */
+        std::unordered_map<state_id_type, StateRecord> state_records_;
+
+        /** @brief The last access of each stored state (only maintained under a memory budget) */
+        ConcurrentBlockArray<std::atomic<std::uint64_t>> state_last_access_;
+        std::atomic<std::uint64_t> access_clock_{0};
+
+        /** @brief The memory budget in bytes (0 for no limit) and the estimated memory used */
+        std::size_t memory_budget_ = 0;
+        std::atomic<std::size_t> resident_bytes_{0};
+
+        /** @brief The estimated size in bytes of a stored transition or reward, and of an entry of a stored state */
+        static constexpr std::size_t BYTES_PER_ENTRY = 64;
+
+        /**
+         * @brief Store a state (if no equal state was stored) and get its identifier.
+         *
+         * The computation lock must be held.
+         *
+         * @param state the state
+         * @return the identifier of the state
+         */
+        state_id_type storeState(const std::shared_ptr<State> &state);
+
+        /** @brief Get the identifier of a stored state (the eviction lock must be held under a memory budget). */
+        state_id_type findStateID(const std::shared_ptr<State> &state) const;
+
+        /** @brief Record that a stored state was accessed. */
+        void touchState(state_id_type state_id);
+
+        /**
+         * @brief Get the stored reward of a pair (b, a).
+         *
+         * @param belief the belief
+         * @param action the action
+         * @param reward the reward (only assigned if stored)
+         * @return true if the reward is stored
+         */
+        bool findStoredReward(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, double &reward);
+
+        /** @brief Store the reward of a pair (b, a). The computation lock must be held. */
+        void storeReward(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, double reward);
+
+        /** @brief Get an estimate of the size of a state in bytes. */
+        virtual std::size_t getStateMemoryUsage(const std::shared_ptr<State> &state) const;
+
+        /** @brief Evict the least recently used states if the memory budget is exceeded. The computation lock must be held. */
+        void evictStates();
+
+        /** @brief Evict a stored state with its outgoing transitions and rewards. The computation and eviction locks must be held. */
+        void evictState(state_id_type state_id);
+
+        /** @brief Lock the stored data against evictions (the lock is only taken under a memory budget). */
+        std::shared_lock<std::shared_mutex> lockAgainstEviction() const;
 
         /** @brief the MDP Graph (graph of state transition) */
         std::shared_ptr<Graph<std::shared_ptr<State>, Pair<std::shared_ptr<Action>, std::shared_ptr<Observation>>>> mdp_graph_;
 
+        /**
+         * @brief Protect the MDP graph against concurrent accesses.
+         *
+         * The stored states, transitions and rewards are held in concurrent tables and do not require this lock.
+         */
+        mutable std::shared_mutex cache_mutex_;
+
+        /**
+         * @brief Protect the stored data against evictions.
+         *
+         * Lookups take a shared lock (only under a memory budget), evictions take an exclusive lock while
+         * holding the computation lock. The shared lock must be released before taking the computation lock.
+         */
+        mutable std::shared_mutex eviction_mutex_;
+
+        /**
+         * @brief Serialize the computation of next states and rewards missing in the graphs.
+         *
+         * The computation is not reentrant (e.g. histories are expanded in place), so concurrent
+         * solvers (see HSVI with several workers) only share the cached part of the graphs.
+         */
+        std::recursive_mutex compute_mutex_;
+
         /**
          * @brief Compute the state transition in order to return next state and associated probability.
          * 
@@ -185,6 +455,39 @@ namespace sdm
         virtual Pair<std::shared_ptr<State>, double> computeSampledNextState(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t = 0);
     };
 
+    /**
+     * @brief An environment that runs its own episodes on a belief MDP.
+     *
+     * Only the current state, time step and random generator belong to the fork. The states, transitions
+     * and rewards are those stored by the belief MDP, so that the episodes of several forks can be run
+     * concurrently and reach the same states. Each fork is seeded once when created, so that its episodes
+     * do not depend on the scheduling of the other forks.
+     */
+    template <class TBelief>
+    class BeliefMDPFork : public GymInterface
+    {
+    public:
+        BeliefMDPFork(const std::shared_ptr<BaseBeliefMDP<TBelief>> &belief_mdp, std::mt19937::result_type seed);
+
+        std::shared_ptr<Space> getActionSpaceAt(const std::shared_ptr<State> &state, number t);
+        std::shared_ptr<Action> getRandomAction(const std::shared_ptr<State> &state, number t);
+        std::shared_ptr<State> reset();
+        std::tuple<std::shared_ptr<State>, std::vector<double>, bool> step(std::shared_ptr<Action> action);
+        std::shared_ptr<GymInterface> fork();
+
+    protected:
+        std::shared_ptr<BaseBeliefMDP<TBelief>> belief_mdp_;
+
+        /** @brief The current state. */
+        std::shared_ptr<State> current_state_;
+
+        /** @brief The current timestep. */
+        number step_;
+
+        /** @brief The generator used to sample the next states of this fork. */
+        std::mt19937 generator_;
+    };
+
     using BeliefMDP = BaseBeliefMDP<Belief>;
 
 }
@@ -1,5 +1,8 @@
+#include <algorithm>
+
 #include <sdm/core/state/belief_state.hpp>
 #include <sdm/utils/struct/graph.hpp>
+#include <sdm/utils/logging/instrumentation.hpp>
 #include <sdm/world/registry.hpp>
 #include <sdm/core/state/private_br_occupancy_state.hpp>
 namespace sdm
@@ -35,21 +38,20 @@ namespace sdm
         this->mdp_graph_ = std::make_shared<Graph<std::shared_ptr<State>, Pair<std::shared_ptr<Action>, std::shared_ptr<Observation>>>>();
         this->getMDPGraph()->addNode(this->initial_state_);
 
-        this->state_space_[*initial_state] = this->initial_state_;
-
-        this->reward_graph_ = std::make_shared<Graph<double, Pair<std::shared_ptr<State>, std::shared_ptr<Action>>>>();
-        this->reward_graph_->addNode(0.0);
+        this->storeState(this->initial_state_);
     }
 
     template <class TBelief>
     BaseBeliefMDP<TBelief>::BaseBeliefMDP(const std::shared_ptr<POMDPInterface> &pomdp, Config config)
         : BaseBeliefMDP<TBelief>(pomdp, config.get("batch_size", 0))
     {
+        // The memory budget is given in MB
+        this->setMemoryBudget(config.get("memory_budget", 0.) * 1024 * 1024);
     }
 
     template <class TBelief>
     BaseBeliefMDP<TBelief>::BaseBeliefMDP(Config config)
-        : BaseBeliefMDP<TBelief>(std::dynamic_pointer_cast<POMDPInterface>(sdm::world::createFromConfig(config)), config.get("batch_size", 0))
+        : BaseBeliefMDP<TBelief>(std::dynamic_pointer_cast<POMDPInterface>(sdm::world::createFromConfig(config)), config)
     {
     }
 
@@ -85,6 +87,8 @@ namespace sdm
     template <class TBelief>
     Pair<std::shared_ptr<State>, double> BaseBeliefMDP<TBelief>::computeNextStateAndProbability(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t)
     {
+        SDMS_TIME_PHASE(COMPUTE_NEXT_STATE);
+
         //std::cout << "\n blabla i'm here\n" << std::flush;
         //std::cout << "\n belief : " << belief;
         //std::exit(1);
@@ -144,77 +148,266 @@ namespace sdm
         return std::make_pair(next_belief, eta);
     }
 
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::saveState(boost::archive::binary_oarchive &archive, const std::shared_ptr<State> &state, number t)
+    {
+        auto belief = state->toBelief();
+        auto states = belief->getStates();
+        std::size_t size = states.size();
+        archive << size;
+        for (const auto &x : states)
+        {
+            SolvableByMDP::saveState(archive, x, t);
+            double probability = belief->getProbability(x);
+            archive << probability;
+        }
+    }
+
+    template <class TBelief>
+    std::shared_ptr<State> BaseBeliefMDP<TBelief>::loadState(boost::archive::binary_iarchive &archive, number t)
+    {
+        auto belief = std::make_shared<TBelief>();
+        std::size_t size;
+        archive >> size;
+        for (std::size_t i = 0; i < size; i++)
+        {
+            auto x = SolvableByMDP::loadState(archive, t);
+            double probability;
+            archive >> probability;
+            belief->setProbability(x, probability);
+        }
+        belief->finalize();
+
+        if (this->store_states_)
+        {
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
+            std::shared_ptr<State> stored_belief = this->state_table_.getItem(this->storeState(belief));
+            this->evictStates();
+            return stored_belief;
+        }
+        return belief;
+    }
+
     // ------------------------------------------------------
     // FONCTIONS COMMON TO ALL BELIEFMDP / OCCUPANCYMDP
     // ------------------------------------------------------
 
+    template <class TBelief>
+    typename BaseBeliefMDP<TBelief>::state_id_type BaseBeliefMDP<TBelief>::storeState(const std::shared_ptr<State> &state)
+    {
+        state_id_type state_id;
+        if (this->state_address_ids_.find(state, state_id))
+        {
+            this->touchState(state_id);
+            return state_id;
+        }
+
+        // Intern the state by value, the first stored instance becomes the representative of its value
+        state_id = this->state_table_.getID(state);
+        std::shared_ptr<State> stored_state = this->state_table_.getItem(state_id);
+        if (this->state_address_ids_.insert(stored_state, state_id))
+        {
+            SDMS_COUNT(STATES_CREATED);
+
+            StateRecord &record = this->state_records_[state_id];
+            if (this->mdp_graph_ != nullptr)
+            {
+                std::unique_lock<std::shared_mutex> lock(this->cache_mutex_);
+                this->mdp_graph_->addNode(stored_state);
+            }
+            record.bytes = this->getStateMemoryUsage(stored_state);
+            this->resident_bytes_ += record.bytes;
+        }
+        this->touchState(state_id);
+        return state_id;
+    }
+
+    template <class TBelief>
+    typename BaseBeliefMDP<TBelief>::state_id_type BaseBeliefMDP<TBelief>::findStateID(const std::shared_ptr<State> &state) const
+    {
+        state_id_type state_id;
+        if (this->state_address_ids_.find(state, state_id))
+        {
+            return state_id;
+        }
+        // Fall back on a lookup by value for states that are not the stored instance
+        return this->state_table_.findID(state);
+    }
+
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::touchState(state_id_type state_id)
+    {
+        if (this->memory_budget_ > 0)
+        {
+            this->state_last_access_.at(state_id).store(this->access_clock_.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    template <class TBelief>
+    std::shared_lock<std::shared_mutex> BaseBeliefMDP<TBelief>::lockAgainstEviction() const
+    {
+        if (this->memory_budget_ > 0)
+        {
+            return std::shared_lock<std::shared_mutex>(this->eviction_mutex_);
+        }
+        return std::shared_lock<std::shared_mutex>(this->eviction_mutex_, std::defer_lock);
+    }
+
+    template <class TBelief>
+    std::size_t BaseBeliefMDP<TBelief>::getStateMemoryUsage(const std::shared_ptr<State> &state) const
+    {
+        auto belief = std::const_pointer_cast<State>(state)->toBelief();
+        return sizeof(TBelief) + ((belief == nullptr) ? 0 : belief->size() * BYTES_PER_ENTRY);
+    }
+
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::evictStates()
+    {
+        if ((this->memory_budget_ == 0) || (this->resident_bytes_ <= this->memory_budget_))
+        {
+            return;
+        }
+
+        std::unique_lock<std::shared_mutex> eviction_lock(this->eviction_mutex_);
+
+        // Candidates are the states that are neither pinned nor the initial state, oldest first
+        state_id_type initial_state_id = this->findStateID(this->initial_state_);
+        std::vector<Pair<std::uint64_t, state_id_type>> candidates;
+        for (const auto &pair_id_record : this->state_records_)
+        {
+            if ((pair_id_record.second.pins == 0) && (pair_id_record.first != initial_state_id))
+            {
+                candidates.push_back({this->state_last_access_.at(pair_id_record.first).load(std::memory_order_relaxed), pair_id_record.first});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // Evict down to 90% of the budget so that evictions are not triggered at every insertion
+        std::size_t target = this->memory_budget_ - this->memory_budget_ / 10;
+        for (const auto &candidate : candidates)
+        {
+            if (this->resident_bytes_ <= target)
+            {
+                break;
+            }
+            this->evictState(candidate.second);
+        }
+    }
+
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::evictState(state_id_type state_id)
+    {
+        auto iterator = this->state_records_.find(state_id);
+        if (iterator == this->state_records_.end())
+        {
+            return;
+        }
+        const StateRecord &record = iterator->second;
+
+        // Evict outgoing transitions and rewards. Transitions that lead to the state are kept,
+        // they are detected when accessed (the state is released) and computed again.
+        for (const auto &key : record.transitions)
+        {
+            this->transitions_.erase(key);
+        }
+        for (const auto &action_id : record.reward_actions)
+        {
+            this->rewards_.erase(RewardKey{state_id, action_id});
+        }
+        this->resident_bytes_ -= record.bytes + (record.transitions.size() + record.reward_actions.size()) * BYTES_PER_ENTRY;
+
+        std::shared_ptr<State> state = this->state_table_.getItem(state_id);
+        if (this->mdp_graph_ != nullptr)
+        {
+            std::unique_lock<std::shared_mutex> lock(this->cache_mutex_);
+            this->mdp_graph_->removeNode(state);
+        }
+        this->state_address_ids_.erase(state);
+        this->state_table_.release(state_id);
+        this->state_records_.erase(iterator);
+    }
+
     template <class TBelief>
     Pair<std::shared_ptr<State>, double> BaseBeliefMDP<TBelief>::getNextStateAndProba(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, const std::shared_ptr<Observation> &observation, number t)
     {
-        //std::cout << "\n baseBeliefMdp : action : " << action->str() << " and observation : " << observation->str()<< std::flush;
-        auto action_observation = std::make_pair(action, observation);
+        SDMS_TIME_PHASE(NEXT_STATE);
 
         // If we store data in the graph
         if (this->store_states_ && this->store_actions_)
         {
-            // Get the successor
-            auto successor = this->getMDPGraph()->getSuccessor(belief, action_observation);
-            // auto successor = this->mdp_graph_->getSuccessor(belief, action_observation);
-
-            // If already in the successor list
-            if (successor != nullptr)
+            TransitionKey key{NOT_FOUND, this->action_table_.getID(action), this->observation_table_.getID(observation)};
+            TransitionEntry entry;
             {
-                // Return the successor node
-                return {successor->getData(), this->transition_probability.at(belief).at(action).at(observation)};
+                auto eviction_lock = this->lockAgainstEviction();
+
+                // If already in the successor list, return the successor node (unless it was evicted)
+                key.state = this->findStateID(belief);
+                if ((key.state != NOT_FOUND) && this->transitions_.find(key, entry))
+                {
+                    std::shared_ptr<State> next_belief = this->state_table_.getItem(entry.next_state);
+                    if (next_belief != nullptr)
+                    {
+                        this->touchState(key.state);
+                        this->touchState(entry.next_state);
+                        SDMS_COUNT(NEXT_STATE_CACHE_HITS);
+                        return {next_belief, entry.probability};
+                    }
+                }
             }
-            else
+
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
+
+            // The successor may have been added while waiting for the computation lock
+            key.state = this->storeState(belief);
+            bool is_recorded = this->transitions_.find(key, entry);
+            if (is_recorded)
             {
-                //std::cout << "trying to compute next state and proba" << std::flush;
-
-                // Build next belief and proba
-                auto [computed_next_belief, next_belief_probability] = this->computeNextStateAndProbability(belief, action, observation, t);
-
-                // Store the probability of next belief
-                this->transition_probability[belief][action][observation] = next_belief_probability;
-
-                // Check if the next belief is already in the graph
-                //std::cout << "\n computed next belief : " << typeid(computed_next_belief).name();
-                auto bla = std::dynamic_pointer_cast<PrivateBrOccupancyState>(computed_next_belief);
-                //std::cout << "\n is bla null?"<< bla << std::flush;
-                //std::exit(1);
-                TBelief b = *std::dynamic_pointer_cast<TBelief>(computed_next_belief);
-                //std::cout << "\n is b null?" << b<<std::flush;
-                //std::exit(1);
-                if (this->state_space_.find(b) == this->state_space_.end())
+                std::shared_ptr<State> next_belief = this->state_table_.getItem(entry.next_state);
+                if (next_belief != nullptr)
                 {
-                    // Add the belief in the space of beliefs
-                    this->state_space_.emplace(b, computed_next_belief);
+                    this->touchState(entry.next_state);
+                    SDMS_COUNT(NEXT_STATE_CACHE_HITS);
+                    return {next_belief, entry.probability};
                 }
+            }
 
-                // Get the next belief
-                auto next_belief = this->state_space_.at(b);
+            // Build next belief and proba
+            auto [computed_next_belief, next_belief_probability] = this->computeNextStateAndProbability(belief, action, observation, t);
 
-                // Add the sucessor in the list of successors
-                this->getMDPGraph()->addSuccessor(belief, action_observation, next_belief);
+            // Get the stored belief equal to the next belief (the next belief is stored if none)
+            entry.next_state = this->storeState(computed_next_belief);
+            entry.probability = next_belief_probability;
+            std::shared_ptr<State> next_belief = this->state_table_.getItem(entry.next_state);
 
-                return {next_belief, next_belief_probability};
+            // Add the sucessor in the list of successors
+            this->transitions_.assign(key, entry);
+            if (!is_recorded)
+            {
+                this->state_records_[key.state].transitions.push_back(key);
+                this->resident_bytes_ += BYTES_PER_ENTRY;
+            }
+            {
+                std::unique_lock<std::shared_mutex> lock(this->cache_mutex_);
+                this->getMDPGraph()->addSuccessor(this->state_table_.getItem(key.state), std::make_pair(action, observation), next_belief);
             }
+
+            this->evictStates();
+            return {next_belief, next_belief_probability};
         }
         else if (this->store_states_)
         {
             // Return next belief without storing its value in the graph
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
             auto [computed_next_belief, proba_belief] = this->computeNextStateAndProbability(belief, action, observation, t);
-            TBelief b = *std::dynamic_pointer_cast<TBelief>(computed_next_belief);
-            if (this->state_space_.find(b) == this->state_space_.end())
-            {
-                // Add the belief in the space of beliefs
-                this->state_space_.emplace(b, computed_next_belief);
-            }
-            return {this->state_space_.at(b), proba_belief};
+            std::shared_ptr<State> next_belief = this->state_table_.getItem(this->storeState(computed_next_belief));
+
+            this->evictStates();
+            return {next_belief, proba_belief};
         }
         else
         {
             // Return next belief without storing its value in the graph
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
             return this->computeNextStateAndProbability(belief, action, observation, t);
         }
     }
@@ -227,42 +420,70 @@ namespace sdm
         return (skip_compute_next_state) ? Pair<std::shared_ptr<State>, double>({nullptr, 1.}) : this->getNextStateAndProba(belief, action, observation, t);
     }
 
+    template <class TBelief>
+    bool BaseBeliefMDP<TBelief>::findStoredReward(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, double &reward)
+    {
+        auto eviction_lock = this->lockAgainstEviction();
+        RewardKey key{this->findStateID(belief), this->action_table_.getID(action)};
+        if ((key.state != NOT_FOUND) && this->rewards_.find(key, reward))
+        {
+            this->touchState(key.state);
+            return true;
+        }
+        return false;
+    }
+
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::storeReward(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, double reward)
+    {
+        RewardKey key{this->storeState(belief), this->action_table_.getID(action)};
+        if (this->rewards_.insert(key, reward))
+        {
+            this->state_records_[key.state].reward_actions.push_back(key.action);
+            this->resident_bytes_ += BYTES_PER_ENTRY;
+        }
+        this->evictStates();
+    }
+
     template <class TBelief>
     double BaseBeliefMDP<TBelief>::getReward(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, number t)
     {
-        //std::cout<< "\n i'm in get reward from belief_mdp !" << std::flush << std::endl;
-        //std::exit(1);
         double reward = 0.;
 
         if (this->store_states_ && this->store_actions_)
         {
-            auto belief_action = std::make_pair(belief, action);
-            auto successor = this->reward_graph_->getSuccessor(0.0, belief_action);
-            if (successor != nullptr)
-            {
-                // Return the successor node
-                reward = successor->getData();
-            }
-            else
+            // Return the stored reward if any
+            if (this->findStoredReward(belief, action, reward))
             {
-                // Return the reward
-                reward = belief->getReward(this->mdp, action, t);
-                if (this->store_states_ && this->store_actions_)
-                    this->reward_graph_->addSuccessor(0.0, belief_action, reward);
+                return reward;
             }
+
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
+            reward = belief->getReward(this->mdp, action, t);
+            this->storeReward(belief, action, reward);
         }
         else
         {
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
             reward = belief->getReward(this->mdp, action, t);
         }
-        //std::cout<< "\n i'm leaving get reward from belief_mdp !" << std::flush << std::endl;
         return reward;
     }
 
     template <class TBelief>
-    double BaseBeliefMDP<TBelief>::getObservationProbability(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &, const std::shared_ptr<Observation> &observation, number) const
+    double BaseBeliefMDP<TBelief>::getObservationProbability(const std::shared_ptr<State> &belief, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &, const std::shared_ptr<Observation> &observation, number t) const
     {
-        return this->transition_probability.at(belief).at(action).at(observation);
+        {
+            auto eviction_lock = this->lockAgainstEviction();
+            TransitionKey key{this->findStateID(belief), this->action_table_.findID(action), this->observation_table_.findID(observation)};
+            TransitionEntry entry;
+            if ((key.state != NOT_FOUND) && this->transitions_.find(key, entry))
+            {
+                return entry.probability;
+            }
+        }
+        // The stored transitions are a cache : a transition that was never computed (or was evicted) is computed again
+        return const_cast<BaseBeliefMDP<TBelief> *>(this)->getNextStateAndProba(belief, action, observation, t).second;
     }
 
     template <class TBelief>
@@ -296,33 +517,39 @@ namespace sdm
 
     template <class TBelief>
     std::tuple<std::shared_ptr<State>, std::vector<double>, bool> BaseBeliefMDP<TBelief>::step(std::shared_ptr<Action> action)
+    {
+        auto [next_state, rewards, is_done] = this->stepFrom(this->current_state_, action, this->step_, this->generator_);
+        this->current_state_ = next_state;
+        this->step_++;
+        return std::make_tuple(this->current_state_, rewards, is_done);
+    }
+
+    template <class TBelief>
+    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> BaseBeliefMDP<TBelief>::stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &generator)
     {
         // Compute reward
-        double belief_reward = this->getReward(this->current_state_, action, this->step_);
+        double belief_reward = this->getReward(state, action, t);
 
         double cumul = 0.0, prob = 0.0;
         std::shared_ptr<State> candidate_state = nullptr;
 
         // Get a random number between 0 and 1
-        double epsilon = std::rand() / (double(RAND_MAX));
-
+        double epsilon = std::uniform_real_distribution<double>(0., 1.)(generator);
 
-        // Go over all observations of the lower-level agent
-        auto accessible_observation_space = this->getObservationSpaceAt(this->current_state_, action, this->step_);
+        // Go over all observations of the lower-level agent (the last candidate is kept if rounding errors prevent from reaching epsilon)
+        auto accessible_observation_space = this->getObservationSpaceAt(state, action, t);
         for (auto observation : *accessible_observation_space)
         {
-            std::tie(candidate_state, prob) = this->getNextStateAndProba(this->current_state_, action, observation->toObservation(), this->step_);
+            std::tie(candidate_state, prob) = this->getNextStateAndProba(state, action, observation->toObservation(), t);
 
             cumul += prob;
             if (epsilon < cumul)
             {
-                this->step_++;
-                this->current_state_ = candidate_state;
                 break;
             }
         }
-        bool is_done = (this->getHorizon() > 0) ? (this->step_ >= this->getHorizon()) : false;
-        return std::make_tuple(this->current_state_, std::vector<double>(this->mdp->getNumAgents(), belief_reward), is_done);
+        bool is_done = (this->getHorizon() > 0) ? (t + 1 >= this->getHorizon()) : false;
+        return std::make_tuple(candidate_state, std::vector<double>(this->mdp->getNumAgents(), belief_reward), is_done);
     }
 
     template <class TBelief>
@@ -331,6 +558,55 @@ namespace sdm
         return this->mdp->getActionSpace(t)->sample()->toAction();
     }
 
+    template <class TBelief>
+    std::shared_ptr<GymInterface> BaseBeliefMDP<TBelief>::fork()
+    {
+        // Forks are created by the calling thread, so that their seeds only depend on the global seed
+        auto belief_mdp = std::dynamic_pointer_cast<BaseBeliefMDP<TBelief>>(this->shared_from_this());
+        return std::make_shared<BeliefMDPFork<TBelief>>(belief_mdp, common::global_seed());
+    }
+
+    template <class TBelief>
+    BeliefMDPFork<TBelief>::BeliefMDPFork(const std::shared_ptr<BaseBeliefMDP<TBelief>> &belief_mdp, std::mt19937::result_type seed)
+        : belief_mdp_(belief_mdp), current_state_(nullptr), step_(0), generator_(seed)
+    {
+    }
+
+    template <class TBelief>
+    std::shared_ptr<Space> BeliefMDPFork<TBelief>::getActionSpaceAt(const std::shared_ptr<State> &state, number t)
+    {
+        return this->belief_mdp_->getActionSpaceAt(state, t);
+    }
+
+    template <class TBelief>
+    std::shared_ptr<Action> BeliefMDPFork<TBelief>::getRandomAction(const std::shared_ptr<State> &state, number t)
+    {
+        return this->belief_mdp_->getRandomAction(state, t);
+    }
+
+    template <class TBelief>
+    std::shared_ptr<State> BeliefMDPFork<TBelief>::reset()
+    {
+        this->step_ = 0;
+        this->current_state_ = this->belief_mdp_->getInitialState();
+        return this->current_state_;
+    }
+
+    template <class TBelief>
+    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> BeliefMDPFork<TBelief>::step(std::shared_ptr<Action> action)
+    {
+        auto [next_state, rewards, is_done] = this->belief_mdp_->stepFrom(this->current_state_, action, this->step_, this->generator_);
+        this->current_state_ = next_state;
+        this->step_++;
+        return std::make_tuple(this->current_state_, rewards, is_done);
+    }
+
+    template <class TBelief>
+    std::shared_ptr<GymInterface> BeliefMDPFork<TBelief>::fork()
+    {
+        return this->belief_mdp_->fork();
+    }
+
     // ------------------------------------------------------
     // ACCESSORS OF SOME SPECIAL DATA COMMON TO ALL BELIEF MDP
     // ------------------------------------------------------
@@ -344,12 +620,83 @@ namespace sdm
     template <class TBelief>
     std::vector<std::shared_ptr<State>> BaseBeliefMDP<TBelief>::getStoredStates() const
     {
+        auto eviction_lock = this->lockAgainstEviction();
         std::vector<std::shared_ptr<State>> list_states;
-        for (const auto &state : this->state_space_)
+        std::size_t num_states = this->state_table_.size();
+        list_states.reserve(num_states);
+        for (std::size_t state_id = 0; state_id < num_states; state_id++)
         {
-            list_states.push_back(state.second);
+            const auto &state = this->state_table_.getItem(state_id);
+            if (state != nullptr)
+            {
+                list_states.push_back(state);
+            }
         }
         return list_states;
     }
 
+    template <class TBelief>
+    std::size_t BaseBeliefMDP<TBelief>::getNumStoredStates() const
+    {
+        return this->state_address_ids_.size();
+    }
+
+    template <class TBelief>
+    typename BaseBeliefMDP<TBelief>::state_id_type BaseBeliefMDP<TBelief>::getStateID(const std::shared_ptr<State> &state) const
+    {
+        auto eviction_lock = this->lockAgainstEviction();
+        return this->findStateID(state);
+    }
+
+    template <class TBelief>
+    std::shared_ptr<State> BaseBeliefMDP<TBelief>::getStateFromID(state_id_type state_id) const
+    {
+        auto eviction_lock = this->lockAgainstEviction();
+        return this->state_table_.getItem(state_id);
+    }
+
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::setMemoryBudget(std::size_t memory_budget)
+    {
+        std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
+        this->memory_budget_ = memory_budget;
+        this->evictStates();
+    }
+
+    template <class TBelief>
+    std::size_t BaseBeliefMDP<TBelief>::getMemoryBudget() const
+    {
+        return this->memory_budget_;
+    }
+
+    template <class TBelief>
+    std::size_t BaseBeliefMDP<TBelief>::getResidentBytes() const
+    {
+        return this->resident_bytes_;
+    }
+
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::pinState(const std::shared_ptr<State> &state)
+    {
+        if (this->store_states_)
+        {
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
+            this->state_records_[this->storeState(state)].pins++;
+        }
+    }
+
+    template <class TBelief>
+    void BaseBeliefMDP<TBelief>::unpinState(const std::shared_ptr<State> &state)
+    {
+        if (this->store_states_)
+        {
+            std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
+            auto iterator = this->state_records_.find(this->findStateID(state));
+            if ((iterator != this->state_records_.end()) && (iterator->second.pins > 0))
+            {
+                iterator->second.pins--;
+            }
+        }
+    }
+
 } // namespace sdm
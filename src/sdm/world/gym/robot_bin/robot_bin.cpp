@@ -129,6 +129,11 @@ namespace sdm
 
                 return {this->getJointCoordinateState(this->coord_robot_, this->coord_garbage_), {reward}, is_done};
             }
+
+            std::shared_ptr<GymInterface> RobotBin::fork()
+            {
+                return std::make_shared<RobotBin>(*this);
+            }
         }
 
     } // namespace sdm
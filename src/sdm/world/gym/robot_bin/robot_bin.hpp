@@ -93,6 +93,12 @@ namespace sdm
                  */
                 std::tuple<std::shared_ptr<State>, std::vector<double>, bool> step(std::shared_ptr<Action> action);
 
+                /**
+                 * @brief Get a copy of the environment (the spaces are shared).
+                 * @return the forked environment
+                 */
+                std::shared_ptr<GymInterface> fork();
+
             protected:
                 /**
                  * @brief Dim of the grid
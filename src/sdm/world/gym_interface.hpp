@@ -12,6 +12,7 @@
 
 #include <vector>
 #include <sdm/types.hpp>
+#include <sdm/exception.hpp>
 #include <sdm/utils/struct/tuple.hpp>
 #include <sdm/core/space/discrete_space.hpp>
 
@@ -50,5 +51,18 @@ namespace sdm
          * @return the information produced. Include : next observation, rewards, episode done  
          */
         virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> step(std::shared_ptr<Action> action) = 0;
+
+        /**
+         * @brief Get an environment that runs its own episodes, independently of this one.
+         *
+         * Forks of a same environment can be stepped concurrently (see VectorEnv). They may share
+         * the data of this environment, which must outlive them.
+         *
+         * @return the forked environment
+         */
+        virtual std::shared_ptr<GymInterface> fork()
+        {
+            throw sdm::exception::Exception("GymInterface::fork : this environment cannot be forked");
+        }
     };
 } // namespace sdm
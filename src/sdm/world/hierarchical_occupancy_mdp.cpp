@@ -39,30 +39,28 @@ namespace sdm
         return (std::static_pointer_cast<JointObservation>(joint_observation)->get(this->getLowLevelAgentID()) == observation);
     }
 
-    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> HierarchicalOccupancyMDP::step(std::shared_ptr<Action> action)
+    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> HierarchicalOccupancyMDP::stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &generator)
     {
         // Compute reward
-        double occupancy_reward = this->getReward(this->current_state_, action, this->step_);
+        double occupancy_reward = this->getReward(state, action, t);
 
         double cumul = 0.0, prob = 0.0;
         std::shared_ptr<State> candidate_state = nullptr;
 
         // Get a random number between 0 and 1
-        double epsilon = std::rand() / (double(RAND_MAX));
+        double epsilon = std::uniform_real_distribution<double>(0., 1.)(generator);
 
         // Go over all observations of the lower-level agent
-        for (auto obs_n : *this->getUnderlyingMPOMDP()->getObservationSpace(this->getLowLevelAgentID(), this->step_))
+        for (auto obs_n : *this->getUnderlyingMPOMDP()->getObservationSpace(this->getLowLevelAgentID(), t))
         {
-            std::tie(candidate_state, prob) = this->getNextStateAndProba(this->current_state_, action, obs_n->toObservation(), this->step_);
+            std::tie(candidate_state, prob) = this->getNextStateAndProba(state, action, obs_n->toObservation(), t);
 
             cumul += prob;
             if (epsilon < cumul)
             {
-                this->step_++;
-                this->current_state_ = candidate_state;
                 break;
             }
         }
-        return std::make_tuple(this->current_state_, std::vector<double>(this->getUnderlyingMPOMDP()->getNumAgents(), occupancy_reward), (this->step_ > this->getUnderlyingMPOMDP()->getHorizon()));
+        return std::make_tuple(candidate_state, std::vector<double>(this->getUnderlyingMPOMDP()->getNumAgents(), occupancy_reward), (t + 1 > this->getUnderlyingMPOMDP()->getHorizon()));
     }
 } // namespace sdm
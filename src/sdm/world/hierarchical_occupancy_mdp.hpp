@@ -31,7 +31,7 @@ namespace sdm
         number getLowLevelAgentID();
 
         virtual std::shared_ptr<Space> getObservationSpaceAt(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t);
-        virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> step(std::shared_ptr<Action> action);
+        virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &generator);
         virtual bool checkCompatibility(const std::shared_ptr<Observation> &joint_observation, const std::shared_ptr<Observation> &observation);
 
     protected:
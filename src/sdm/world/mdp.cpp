@@ -58,6 +58,11 @@ namespace sdm
         this->discount_ = discount;
     }
 
+    Criterion MDP::getCriterion() const
+    {
+        return this->criterion_;
+    }
+
     number MDP::getHorizon() const
     {
         return this->horizon_;
@@ -77,6 +82,12 @@ namespace sdm
     {
         return this->state_dynamics_->getReachableStates(state, action, t);
     }
+
+    Span<StateTransition> MDP::getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const
+    {
+        return this->state_dynamics_->getReachableTransitions(state, action, t);
+    }
+
     std::shared_ptr<StateDynamicsInterface> MDP::getStateDynamics() const
     {
         return this->state_dynamics_;
@@ -68,6 +68,11 @@ namespace sdm
          */
         void setDiscount(double discount);
 
+        /**
+         * @brief Get the criterion (reward maximization or cost minimization).
+         */
+        Criterion getCriterion() const;
+
         /**
          * @brief Get the planning horizon
          * 
@@ -162,6 +167,15 @@ namespace sdm
          */
         virtual std::set<std::shared_ptr<State>> getReachableStates(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
 
+        /**
+         * @brief Get the reachable next states with their probabilities (without allocation)
+         * 
+         * @param state the state
+         * @param action the action
+         * @return a view over the transitions (s', p(s' | s, a))
+         */
+        virtual Span<StateTransition> getReachableTransitions(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
+
         /**
          * @brief Get the state dynamics
          * 
@@ -10,6 +10,7 @@
 #include <sdm/core/space/multi_discrete_space.hpp>
 #include <sdm/core/action/det_decision_rule.hpp>
 #include <sdm/core/state/occupancy_state.hpp>
+#include <sdm/core/state/dense_occupancy_state.hpp>
 #include <sdm/core/action/joint_det_decision_rule.hpp>
 
 /**
@@ -26,8 +27,7 @@ namespace sdm
          *
          */
         template <class TOccupancyState = OccupancyState>
-        class BaseOccupancyMDP : public BaseBeliefMDP<TOccupancyState>,
-                                 public std::enable_shared_from_this<BaseOccupancyMDP<TOccupancyState>>
+        class BaseOccupancyMDP : public BaseBeliefMDP<TOccupancyState>
         {
         public:
                 BaseOccupancyMDP();
@@ -88,12 +88,42 @@ namespace sdm
 
                 virtual double do_excess(double incumbent, double lb, double ub, double cost_so_far, double error, number horizon);
 
+                // *****************
+                //    Checkpoints
+                // *****************
+
+                /**
+                 * @brief Save an occupancy state in a binary archive (as the list of its joint histories, beliefs and probabilities).
+                 */
+                virtual void saveState(boost::archive::binary_oarchive &archive, const std::shared_ptr<State> &occupancy_state, number t);
+
+                /**
+                 * @brief Load an occupancy state saved with `saveState`.
+                 * 
+                 * The loaded occupancy state is its own uncompressed occupancy state, it is not stored in the 
+                 * MDP graph (it can be evaluated but transitions from it are not those of the saved state).
+                 */
+                virtual std::shared_ptr<State> loadState(boost::archive::binary_iarchive &archive, number t);
+
+                /**
+                 * @brief Save a joint history in a binary archive (as the list of joint observations from the initial history).
+                 */
+                virtual void saveHistory(boost::archive::binary_oarchive &archive, const std::shared_ptr<HistoryInterface> &history);
+
+                /**
+                 * @brief Load a joint history saved with `saveHistory`.
+                 * 
+                 * The history is expanded from the initial history, so that it is the joint history reached 
+                 * by explorations with the same joint observations.
+                 */
+                virtual std::shared_ptr<HistoryInterface> loadHistory(boost::archive::binary_iarchive &archive);
+
                 // *****************
                 //    RL methods
                 // *****************
 
                 virtual std::shared_ptr<State> reset();
-                virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> step(std::shared_ptr<Action> action);
+                virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &generator);
                 virtual std::shared_ptr<Action> getRandomAction(const std::shared_ptr<State> &observation, number t);
                 virtual std::shared_ptr<Action> computeRandomAction(const std::shared_ptr<OccupancyStateInterface> &ostate, number t);
 
@@ -119,9 +149,17 @@ namespace sdm
                 number memory = 0;
 
                 virtual std::shared_ptr<Space> computeActionSpaceAt(const std::shared_ptr<State> &occupancy_state, number t = 0);
+
+                /** @brief Get an estimate of the size of an occupancy state in bytes (joint histories and individual histories of each agent). */
+                virtual std::size_t getStateMemoryUsage(const std::shared_ptr<State> &occupancy_state) const;
         };
 
         using OccupancyMDP = BaseOccupancyMDP<OccupancyState>;
+
+        /**
+         * @brief Occupancy MDP whose occupancy states are stored as contiguous columns (see DenseOccupancyState).
+         */
+        using DenseOccupancyMDP = BaseOccupancyMDP<DenseOccupancyState>;
 } // namespace sdm
 
 #include <sdm/world/occupancy_mdp.tpp>
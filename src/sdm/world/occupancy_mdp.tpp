@@ -40,9 +40,6 @@ namespace sdm
         // Initialize Transition Graph
         this->mdp_graph_ = std::make_shared<Graph<std::shared_ptr<State>, Pair<std::shared_ptr<Action>, std::shared_ptr<Observation>>>>();
         this->mdp_graph_->addNode(this->initial_state_);
-
-        this->reward_graph_ = std::make_shared<Graph<double, Pair<std::shared_ptr<State>, std::shared_ptr<Action>>>>();
-        this->reward_graph_->addNode(0.0);
     }
 
     template <class TOccupancyState>
@@ -62,6 +59,12 @@ namespace sdm
             auto iter = STATE_TYPE_MAP.find(opt_str.value());
             this->setStateType((iter != STATE_TYPE_MAP.end()) ? iter->second : StateType::COMPRESSED);
         }
+
+        // Number of threads used to compute next occupancy states
+        OccupancyState::NUM_THREADS = config.get("num_threads", (int)OccupancyState::NUM_THREADS);
+
+        // The memory budget is given in MB
+        this->setMemoryBudget(config.get("memory_budget", 0.) * 1024 * 1024);
     }
 
     template <class TOccupancyState>
@@ -70,6 +73,13 @@ namespace sdm
     {
     }
 
+    template <class TOccupancyState>
+    std::size_t BaseOccupancyMDP<TOccupancyState>::getStateMemoryUsage(const std::shared_ptr<State> &occupancy_state) const
+    {
+        auto belief = std::const_pointer_cast<State>(occupancy_state)->toBelief();
+        return sizeof(TOccupancyState) + ((belief == nullptr) ? 0 : belief->size() * (2 + this->mdp->getNumAgents()) * BaseBeliefMDP<TOccupancyState>::BYTES_PER_ENTRY);
+    }
+
     template <class TOccupancyState>
     std::shared_ptr<Space> BaseOccupancyMDP<TOccupancyState>::getObservationSpaceAt(const std::shared_ptr<State> &, const std::shared_ptr<Action> &, number)
     {
@@ -108,6 +118,95 @@ namespace sdm
         return (ub - lb) - error / this->getWeightedDiscount(horizon);
     }
 
+    template <class TOccupancyState>
+    void BaseOccupancyMDP<TOccupancyState>::saveState(boost::archive::binary_oarchive &archive, const std::shared_ptr<State> &state, number t)
+    {
+        auto occupancy_state = state->toOccupancyState();
+        const auto &joint_histories = occupancy_state->getJointHistories();
+        std::size_t size = joint_histories.size();
+        archive << size;
+        for (const auto &joint_history : joint_histories)
+        {
+            this->saveHistory(archive, joint_history);
+            this->belief_mdp_->saveState(archive, occupancy_state->getBeliefAt(joint_history), t);
+            double probability = occupancy_state->getProbability(joint_history);
+            archive << probability;
+        }
+    }
+
+    template <class TOccupancyState>
+    std::shared_ptr<State> BaseOccupancyMDP<TOccupancyState>::loadState(boost::archive::binary_iarchive &archive, number t)
+    {
+        auto occupancy_state = std::make_shared<TOccupancyState>(this->mdp->getNumAgents(), t);
+        std::size_t size;
+        archive >> size;
+        for (std::size_t i = 0; i < size; i++)
+        {
+            auto joint_history = this->loadHistory(archive)->toJointHistory();
+            auto belief = this->belief_mdp_->loadState(archive, t)->toBelief();
+            double probability;
+            archive >> probability;
+            occupancy_state->setProbability(joint_history, belief, probability);
+        }
+        occupancy_state->finalize();
+        occupancy_state->setStateType(this->state_type);
+        return occupancy_state;
+    }
+
+    template <class TOccupancyState>
+    void BaseOccupancyMDP<TOccupancyState>::saveHistory(boost::archive::binary_oarchive &archive, const std::shared_ptr<HistoryInterface> &history)
+    {
+        bool has_history = (history != nullptr);
+        archive << has_history;
+        if (!has_history)
+        {
+            return;
+        }
+
+        auto history_tree = std::dynamic_pointer_cast<HistoryTree>(history);
+        auto initial_history_tree = std::dynamic_pointer_cast<HistoryTree>(this->initial_history_);
+        if ((history_tree == nullptr) || (history_tree->getTrie() != initial_history_tree->getTrie()))
+        {
+            throw sdm::exception::Exception("BaseOccupancyMDP::saveHistory : only joint histories expanded from the initial history can be saved");
+        }
+
+        // Go up to the origin to get the joint observations of the history
+        const auto &trie = history_tree->getTrie();
+        std::vector<std::shared_ptr<Observation>> joint_observations;
+        for (auto node = history_tree->getID(); (node != HistoryTrie::ROOT) && (node != HistoryTrie::NONE); node = trie->getParent(node))
+        {
+            joint_observations.push_back(trie->getItem(node).first);
+        }
+        std::reverse(joint_observations.begin(), joint_observations.end());
+
+        std::size_t size = joint_observations.size();
+        archive << size;
+        for (number t = 0; t < size; t++)
+        {
+            SolvableByMDP::saveItem(archive, this->decpomdp->getObservationSpace(t), joint_observations[t]);
+        }
+    }
+
+    template <class TOccupancyState>
+    std::shared_ptr<HistoryInterface> BaseOccupancyMDP<TOccupancyState>::loadHistory(boost::archive::binary_iarchive &archive)
+    {
+        bool has_history;
+        archive >> has_history;
+        if (!has_history)
+        {
+            return nullptr;
+        }
+
+        std::size_t size;
+        archive >> size;
+        auto history = this->initial_history_;
+        for (number t = 0; t < size; t++)
+        {
+            history = history->expand(SolvableByMDP::loadItem(archive, this->decpomdp->getObservationSpace(t))->toObservation());
+        }
+        return history;
+    }
+
     // -------------------
     //     RL METHODS
     // -------------------
@@ -119,20 +218,16 @@ namespace sdm
     }
 
     template <class TOccupancyState>
-    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> BaseOccupancyMDP<TOccupancyState>::step(std::shared_ptr<Action> action)
+    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> BaseOccupancyMDP<TOccupancyState>::stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &)
     {
         // Compute next reward
-        double occupancy_reward = this->getReward(this->current_state_, action, this->step_);
-
+        double occupancy_reward = this->getReward(state, action, t);
 
         // Compute next occupancy state
-        this->current_state_ = this->getNextStateAndProba(this->current_state_, action, sdm::NO_OBSERVATION, this->step_).first;
-
-        // Increment step
-        this->step_++;
+        std::shared_ptr<State> next_state = this->getNextStateAndProba(state, action, sdm::NO_OBSERVATION, t).first;
 
-        bool is_done = (this->getHorizon() > 0) ? (this->step_ >= this->getHorizon()) : false;
-        return std::make_tuple(this->current_state_, std::vector<double>(this->mdp->getNumAgents(), occupancy_reward), is_done);
+        bool is_done = (this->getHorizon() > 0) ? (t + 1 >= this->getHorizon()) : false;
+        return std::make_tuple(next_state, std::vector<double>(this->mdp->getNumAgents(), occupancy_reward), is_done);
     }
 
     // -----------------------
@@ -340,7 +435,7 @@ namespace sdm
     template <class TOccupancyState>
     std::shared_ptr<BaseOccupancyMDP<TOccupancyState>> BaseOccupancyMDP<TOccupancyState>::getptr()
     {
-        return std::enable_shared_from_this<BaseOccupancyMDP<TOccupancyState>>::shared_from_this();
+        return std::dynamic_pointer_cast<BaseOccupancyMDP<TOccupancyState>>(this->shared_from_this());
     }
 
 } // namespace sdm
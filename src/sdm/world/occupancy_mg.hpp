@@ -28,8 +28,7 @@ namespace sdm
          *
          */
         template <class TOccupancyState = OccupancyStateMG>
-        class BaseOccupancyMG : public BaseOccupancyMDP<TOccupancyState>,
-                                 public std::enable_shared_from_this<BaseOccupancyMG<TOccupancyState>>
+        class BaseOccupancyMG : public BaseOccupancyMDP<TOccupancyState>
         {
         public:
                 BaseOccupancyMG();
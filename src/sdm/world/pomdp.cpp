@@ -1,4 +1,5 @@
 #include <sdm/world/pomdp.hpp>
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
 
 namespace sdm
 {
@@ -51,6 +52,29 @@ namespace sdm
         return this->observation_dynamics_;
     }
 
+    Span<DynamicsTransition> POMDP::getReachableDynamics(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) const
+    {
+        if (this->flat_dynamics_ != nullptr)
+        {
+            auto state_index = this->flat_dynamics_->getStateIndex(state), action_index = this->flat_dynamics_->getActionIndex(action);
+            if ((state_index != FlatTabularDynamics::NOT_FOUND) && (action_index != FlatTabularDynamics::NOT_FOUND))
+            {
+                return this->flat_dynamics_->getDynamicsTransitions(state_index, action_index);
+            }
+        }
+        return POMDPInterface::getReachableDynamics(state, action, t);
+    }
+
+    std::shared_ptr<FlatTabularDynamics> POMDP::getFlatDynamics() const
+    {
+        return this->flat_dynamics_;
+    }
+
+    void POMDP::setFlatDynamics(const std::shared_ptr<FlatTabularDynamics> &flat_dynamics)
+    {
+        this->flat_dynamics_ = flat_dynamics;
+    }
+
     std::shared_ptr<Observation> POMDP::sampleNextObservation(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t)
     {
         MDP::sampleNextObservation(state, action, t);
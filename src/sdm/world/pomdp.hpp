@@ -80,12 +80,37 @@ namespace sdm
          */
         virtual double getDynamics(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, const std::shared_ptr<State> &next_state, const std::shared_ptr<Observation> &observation, number t = 0) const;
 
+        /**
+         * @brief Get reachable pairs of next state and observation with their probabilities p(s', o | s, a).
+         * 
+         * The view points to the flat dynamics when they are set.
+         * 
+         * @param state the state at timestep t
+         * @param action the action
+         * @param t the timestep
+         * @return a view over the transitions (s', o, p(s', o | s, a))
+         */
+        virtual Span<DynamicsTransition> getReachableDynamics(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0) const;
+
         std::shared_ptr<ObservationDynamicsInterface> getObservationDynamics() const;
 
+        /**
+         * @brief Get the flat representation of the dynamics (nullptr if it was not set).
+         */
+        std::shared_ptr<FlatTabularDynamics> getFlatDynamics() const;
+
+        /**
+         * @brief Set the flat representation of the dynamics.
+         * 
+         * It must describe the same dynamics as the state and observation dynamics of the model.
+         */
+        void setFlatDynamics(const std::shared_ptr<FlatTabularDynamics> &flat_dynamics);
+
         std::shared_ptr<Observation> sampleNextObservation(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t);
 
     protected:
         std::shared_ptr<Space> observation_space_;
         std::shared_ptr<ObservationDynamicsInterface> observation_dynamics_;
+        std::shared_ptr<FlatTabularDynamics> flat_dynamics_;
     };
 } // namespace sdm
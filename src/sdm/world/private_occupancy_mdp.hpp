@@ -27,8 +27,7 @@ namespace sdm
          *
          */
         template <class TOccupancyState = PrivateBrOccupancyState>
-        class BasePrivateOccupancyMDP : public BaseBeliefMDP<TOccupancyState>,
-                                 public std::enable_shared_from_this<BasePrivateOccupancyMDP<TOccupancyState>>
+        class BasePrivateOccupancyMDP : public BaseBeliefMDP<TOccupancyState>
         {
         public:
                 BasePrivateOccupancyMDP();
@@ -102,7 +101,7 @@ namespace sdm
                 // *****************
 
                 virtual std::shared_ptr<State> reset();
-                virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> step(std::shared_ptr<Action> action);
+                virtual std::tuple<std::shared_ptr<State>, std::vector<double>, bool> stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &generator);
                 virtual std::shared_ptr<Action> getRandomAction(const std::shared_ptr<State> &observation, number t);
                 virtual std::shared_ptr<Action> computeRandomAction(const std::shared_ptr<OccupancyStateInterface> &ostate, number t);
 
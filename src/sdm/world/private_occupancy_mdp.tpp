@@ -40,9 +40,6 @@ namespace sdm
         // Initialize Transition Graph
         this->mdp_graph_ = std::make_shared<Graph<std::shared_ptr<State>, Pair<std::shared_ptr<Action>, std::shared_ptr<Observation>>>>();
         this->mdp_graph_->addNode(this->initial_state_);
-
-        this->reward_graph_ = std::make_shared<Graph<double, Pair<std::shared_ptr<State>, std::shared_ptr<Action>>>>();
-        this->reward_graph_->addNode(0.0);
         
         this->num_player_ = num_player_;
 
@@ -74,9 +71,6 @@ namespace sdm
         // Initialize Transition Graph
         this->mdp_graph_ = std::make_shared<Graph<std::shared_ptr<State>, Pair<std::shared_ptr<Action>, std::shared_ptr<Observation>>>>();
         this->mdp_graph_->addNode(this->initial_state_);
-
-        this->reward_graph_ = std::make_shared<Graph<double, Pair<std::shared_ptr<State>, std::shared_ptr<Action>>>>();
-        this->reward_graph_->addNode(0.0);
         
         this->num_player_ = num_player_;
 
@@ -166,23 +160,17 @@ namespace sdm
     }
 
     template <class TOccupancyState>
-    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> BasePrivateOccupancyMDP<TOccupancyState>::step(std::shared_ptr<Action> action)
+    std::tuple<std::shared_ptr<State>, std::vector<double>, bool> BasePrivateOccupancyMDP<TOccupancyState>::stepFrom(const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t, std::mt19937 &)
     {
         // Compute next reward
         //needs to be redefined to include opponent's strategy because here, action is single action
-        double occupancy_reward = this->getReward(this->current_state_, action, this->step_);
-        //double occupancy_reward = 0.0;
-
-        //std::cout << " trying getting next state and probas " << std::flush<<std::endl;
+        double occupancy_reward = this->getReward(state, action, t);
 
         // Compute next occupancy state
-        this->current_state_ = this->getNextStateAndProba(this->current_state_, action, sdm::NO_OBSERVATION, this->step_).first;
-        //std::cout << " after getting next state and probas " << std::flush << std::endl;
-        // Increment step
-        this->step_++;
+        std::shared_ptr<State> next_state = this->getNextStateAndProba(state, action, sdm::NO_OBSERVATION, t).first;
 
-        bool is_done = (this->getHorizon() > 0) ? (this->step_ >= this->getHorizon()) : false;
-        return std::make_tuple(this->current_state_, std::vector<double>(this->mdp->getNumAgents(), occupancy_reward), is_done);
+        bool is_done = (this->getHorizon() > 0) ? (t + 1 >= this->getHorizon()) : false;
+        return std::make_tuple(next_state, std::vector<double>(this->mdp->getNumAgents(), occupancy_reward), is_done);
     }
 
     template <class TOccupancyState>
@@ -193,19 +181,12 @@ namespace sdm
        double reward = std::dynamic_pointer_cast<PrivateBrOccupancyState>(belief)->reward;
         if (this->store_states_ && this->store_actions_)
         {
-            auto belief_action = std::make_pair(belief, action);
-            auto successor = this->reward_graph_->getSuccessor(0.0, belief_action);
-            if (successor != nullptr)
-            {
-                // Return the successor node
-                reward = successor->getData();
-            }
-            else
+            if (!this->findStoredReward(belief, action, reward))
             {
                 // Return the reward
+                std::lock_guard<std::recursive_mutex> compute_lock(this->compute_mutex_);
                 reward = belief->getReward(this->mdp, action, t);
-                if (this->store_states_ && this->store_actions_)
-                    this->reward_graph_->addSuccessor(0.0, belief_action, reward);
+                this->storeReward(belief, action, reward);
             }
         }
         else
@@ -311,7 +292,7 @@ namespace sdm
     template <class TOccupancyState>
     std::shared_ptr<BasePrivateOccupancyMDP<TOccupancyState>> BasePrivateOccupancyMDP<TOccupancyState>::getptr()
     {
-        return std::enable_shared_from_this<BasePrivateOccupancyMDP<TOccupancyState>>::shared_from_this();
+        return std::dynamic_pointer_cast<BasePrivateOccupancyMDP<TOccupancyState>>(this->shared_from_this());
     }
 
 } // namespace sdm
@@ -10,10 +10,12 @@ SDMS_REGISTRY(formalism)
 SDMS_REGISTER("MDP", SolvableByMDP)
 SDMS_REGISTER("BeliefMDP", BeliefMDP)
 SDMS_REGISTER("OccupancyMDP", OccupancyMDP)
+SDMS_REGISTER("DenseOccupancyMDP", DenseOccupancyMDP)
 SDMS_REGISTER("SerialOccupancyMDP", SerialOccupancyMDP)
 SDMS_REGISTER("HierarchicalOccupancyMDP", HierarchicalOccupancyMDP)
 SDMS_REGISTER("bMDP", BeliefMDP)
 SDMS_REGISTER("oMDP", OccupancyMDP)
+SDMS_REGISTER("doMDP", DenseOccupancyMDP)
 SDMS_REGISTER("soMDP", SerialOccupancyMDP)
 SDMS_REGISTER("hoMDP", HierarchicalOccupancyMDP)
 SDMS_END_REGISTRY()
@@ -5,6 +5,8 @@
 #include <sdm/exception.hpp>
 #include <sdm/core/distribution.hpp>
 #include <sdm/core/space/discrete_space.hpp>
+#include <sdm/core/state/interface/history_interface.hpp>
+#include <sdm/public/boost_serializable.hpp>
 #include <sdm/world/base/mdp_interface.hpp>
 
 /**
@@ -134,6 +136,45 @@ namespace sdm
          */
         virtual double getExpectedNextValue(const std::shared_ptr<ValueFunction> &value_function, const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t) = 0;
 
+        /** ---------- FOR CHECKPOINTS -------------- */
+
+        /**
+         * @brief Save a state of the problem in a binary archive.
+         * 
+         * States are saved relatively to the underlying problem (i.e. indexes in its spaces), 
+         * so that they can be loaded in another execution solving the same problem.
+         * 
+         * @param archive the archive
+         * @param state the state
+         * @param t the time step
+         */
+        virtual void saveState(boost::archive::binary_oarchive &archive, const std::shared_ptr<State> &state, number t) = 0;
+
+        /**
+         * @brief Load a state saved with `saveState`.
+         * 
+         * @param archive the archive
+         * @param t the time step
+         * @return the state
+         */
+        virtual std::shared_ptr<State> loadState(boost::archive::binary_iarchive &archive, number t) = 0;
+
+        /**
+         * @brief Save a history of the problem (possibly nullptr) in a binary archive.
+         * 
+         * @param archive the archive
+         * @param history the history
+         */
+        virtual void saveHistory(boost::archive::binary_oarchive &archive, const std::shared_ptr<HistoryInterface> &history) = 0;
+
+        /**
+         * @brief Load a history saved with `saveHistory`.
+         * 
+         * @param archive the archive
+         * @return the history
+         */
+        virtual std::shared_ptr<HistoryInterface> loadHistory(boost::archive::binary_iarchive &archive) = 0;
+
         /**
          * @brief Checks if the problem has a finite horizon.
          * 
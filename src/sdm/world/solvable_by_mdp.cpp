@@ -68,6 +68,64 @@ namespace sdm
         return state->getReward(this->mdp, action, t);
     }
 
+    void SolvableByMDP::saveItem(boost::archive::binary_oarchive &archive, const std::shared_ptr<Space> &space, const std::shared_ptr<Item> &item)
+    {
+        auto discrete_space = std::dynamic_pointer_cast<DiscreteSpace>(space);
+        if (discrete_space == nullptr)
+        {
+            throw sdm::exception::Exception("SolvableByMDP::saveItem : only items of discrete spaces can be saved");
+        }
+        number index = discrete_space->getItemIndex(item);
+        archive << index;
+    }
+
+    std::shared_ptr<Item> SolvableByMDP::loadItem(boost::archive::binary_iarchive &archive, const std::shared_ptr<Space> &space)
+    {
+        auto discrete_space = std::dynamic_pointer_cast<DiscreteSpace>(space);
+        if (discrete_space == nullptr)
+        {
+            throw sdm::exception::Exception("SolvableByMDP::loadItem : only items of discrete spaces can be loaded");
+        }
+        number index;
+        archive >> index;
+        if (index >= discrete_space->getNumItems())
+        {
+            throw sdm::exception::Exception("SolvableByMDP::loadItem : the index does not belong to the space");
+        }
+        return discrete_space->getItem(index);
+    }
+
+    void SolvableByMDP::saveState(boost::archive::binary_oarchive &archive, const std::shared_ptr<State> &state, number t)
+    {
+        SolvableByMDP::saveItem(archive, this->mdp->getStateSpace(t), state);
+    }
+
+    std::shared_ptr<State> SolvableByMDP::loadState(boost::archive::binary_iarchive &archive, number t)
+    {
+        return SolvableByMDP::loadItem(archive, this->mdp->getStateSpace(t))->toState();
+    }
+
+    void SolvableByMDP::saveHistory(boost::archive::binary_oarchive &archive, const std::shared_ptr<HistoryInterface> &history)
+    {
+        if (history != nullptr)
+        {
+            throw sdm::exception::Exception("SolvableByMDP::saveHistory : states of this problem do not depend on histories");
+        }
+        bool has_history = false;
+        archive << has_history;
+    }
+
+    std::shared_ptr<HistoryInterface> SolvableByMDP::loadHistory(boost::archive::binary_iarchive &archive)
+    {
+        bool has_history;
+        archive >> has_history;
+        if (has_history)
+        {
+            throw sdm::exception::Exception("SolvableByMDP::loadHistory : states of this problem do not depend on histories");
+        }
+        return nullptr;
+    }
+
     double SolvableByMDP::getExpectedNextValue(const std::shared_ptr<ValueFunction> &value_function, const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t)
     {
         double tmp = 0.0;
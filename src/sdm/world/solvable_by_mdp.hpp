@@ -104,6 +104,36 @@ namespace sdm
          */
         double getExpectedNextValue(const std::shared_ptr<ValueFunction> &value_function, const std::shared_ptr<State> &state, const std::shared_ptr<Action> &action, number t = 0);
 
+        /**
+         * @brief Save a state of the underlying MDP (as its index in the state space).
+         */
+        virtual void saveState(boost::archive::binary_oarchive &archive, const std::shared_ptr<State> &state, number t);
+
+        /**
+         * @brief Load a state of the underlying MDP.
+         */
+        virtual std::shared_ptr<State> loadState(boost::archive::binary_iarchive &archive, number t);
+
+        /**
+         * @brief Save a history (states of an MDP do not depend on histories, only nullptr can be saved).
+         */
+        virtual void saveHistory(boost::archive::binary_oarchive &archive, const std::shared_ptr<HistoryInterface> &history);
+
+        /**
+         * @brief Load a history.
+         */
+        virtual std::shared_ptr<HistoryInterface> loadHistory(boost::archive::binary_iarchive &archive);
+
+        /**
+         * @brief Save an item of a discrete space as its index in the space.
+         */
+        static void saveItem(boost::archive::binary_oarchive &archive, const std::shared_ptr<Space> &space, const std::shared_ptr<Item> &item);
+
+        /**
+         * @brief Load an item of a discrete space saved with `saveItem`.
+         */
+        static std::shared_ptr<Item> loadItem(boost::archive::binary_iarchive &archive, const std::shared_ptr<Space> &space);
+
         /**
          * @brief Get the well defined underlying problem.
          * Some problems are solvable by DP algorithms even if they are not well defined. Usually, they simply are reformulation of an underlying well defined problem.
@@ -0,0 +1,81 @@
+#include <cassert>
+#include <algorithm>
+
+#include <sdm/exception.hpp>
+#include <sdm/world/vector_env.hpp>
+#include <sdm/utils/parallel/thread_pool.hpp>
+
+namespace sdm
+{
+    number VectorEnv::NUM_THREADS = 1;
+
+    VectorEnv::VectorEnv(const std::shared_ptr<GymInterface> &env, number num_envs, number num_threads)
+        : env_(env), num_threads_(std::max<number>(num_threads, 1))
+    {
+        if (num_envs == 0)
+        {
+            throw sdm::exception::Exception("VectorEnv : the number of environments must be positive");
+        }
+        for (number k = 0; k < num_envs; k++)
+        {
+            this->envs_.push_back(env->fork());
+        }
+        this->observations_ = std::vector<std::shared_ptr<State>>(num_envs, nullptr);
+        this->is_done_ = std::vector<char>(num_envs, true);
+    }
+
+    number VectorEnv::getNumEnvs() const
+    {
+        return this->envs_.size();
+    }
+
+    std::shared_ptr<GymInterface> VectorEnv::getEnv(number k) const
+    {
+        return this->envs_[k];
+    }
+
+    std::vector<std::shared_ptr<State>> VectorEnv::reset()
+    {
+        for (number k = 0; k < this->getNumEnvs(); k++)
+        {
+            this->observations_[k] = this->envs_[k]->reset();
+            this->is_done_[k] = false;
+        }
+        return this->observations_;
+    }
+
+    std::tuple<std::vector<std::shared_ptr<State>>, std::vector<std::vector<double>>, std::vector<bool>> VectorEnv::step(const std::vector<std::shared_ptr<Action>> &actions)
+    {
+        assert(actions.size() == this->getNumEnvs());
+
+        std::vector<std::vector<double>> rewards(this->getNumEnvs());
+
+        // Each copy only writes at its own index, so that results do not depend on the scheduling
+        ThreadPool::get(this->num_threads_)->parallel_for(this->getNumEnvs(), [&](std::size_t begin, std::size_t end)
+                                                           {
+                                                               for (std::size_t k = begin; k < end; k++)
+                                                               {
+                                                                   if (this->is_done_[k])
+                                                                       continue;
+
+                                                                   auto [next_observation, reward, is_done] = this->envs_[k]->step(actions[k]);
+                                                                   this->observations_[k] = next_observation;
+                                                                   rewards[k] = reward;
+                                                                   this->is_done_[k] = is_done;
+                                                               }
+                                                           });
+
+        return std::make_tuple(this->observations_, rewards, std::vector<bool>(this->is_done_.begin(), this->is_done_.end()));
+    }
+
+    bool VectorEnv::isDone(number k) const
+    {
+        return this->is_done_[k];
+    }
+
+    bool VectorEnv::isDone() const
+    {
+        return std::all_of(this->is_done_.begin(), this->is_done_.end(), [](char is_done)
+                           { return is_done; });
+    }
+} // namespace sdm
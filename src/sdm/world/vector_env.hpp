@@ -0,0 +1,99 @@
+/**
+ * @file vector_env.hpp
+ * @brief Run the episodes of several copies of an environment in lockstep.
+ * @version 1.0
+ *
+ */
+#pragma once
+
+#include <tuple>
+#include <vector>
+
+#include <sdm/types.hpp>
+#include <sdm/core/state/state.hpp>
+#include <sdm/core/action/action.hpp>
+#include <sdm/world/gym_interface.hpp>
+
+namespace sdm
+{
+    /**
+     * @class VectorEnv
+     *
+     * @brief A vector of independent copies of an environment, stepped in lockstep.
+     *
+     * The copies are obtained with `GymInterface::fork`. At each step, the copies whose episode is not
+     * done execute their action concurrently on a thread pool. The episodes of all copies start
+     * together (see `reset`) and the vector is done once all episodes are done.
+     *
+     * Basic Usage:
+     *
+     * ```cpp
+     * VectorEnv envs(env, 8);
+     * auto observations = envs.reset();
+     * while (!envs.isDone())
+     * {
+     *     std::vector<std::shared_ptr<Action>> actions = ...; // one action by copy
+     *     auto [next_observations, rewards, dones] = envs.step(actions);
+     * }
+     * ```
+     *
+     */
+    class VectorEnv
+    {
+    public:
+        /** @brief The default number of threads used to step the copies. */
+        static number NUM_THREADS;
+
+        /**
+         * @brief Construct a vector of environments.
+         *
+         * @param env the environment (it must outlive the vector)
+         * @param num_envs the number of copies of the environment
+         * @param num_threads the number of threads used to step the copies
+         */
+        VectorEnv(const std::shared_ptr<GymInterface> &env, number num_envs, number num_threads = VectorEnv::NUM_THREADS);
+
+        /** @brief Get the number of copies. */
+        number getNumEnvs() const;
+
+        /** @brief Get a copy of the environment. */
+        std::shared_ptr<GymInterface> getEnv(number k) const;
+
+        /**
+         * @brief Reset all copies.
+         * @return the initial observation of each copy
+         */
+        std::vector<std::shared_ptr<State>> reset();
+
+        /**
+         * @brief Do a step on each copy whose episode is not done.
+         *
+         * The copies whose episode is done keep their last observation and get no reward.
+         *
+         * @param actions the action executed by each copy (ignored when the episode of the copy is done)
+         * @return the information produced. Include : next observations, rewards, episodes done
+         */
+        std::tuple<std::vector<std::shared_ptr<State>>, std::vector<std::vector<double>>, std::vector<bool>> step(const std::vector<std::shared_ptr<Action>> &actions);
+
+        /** @brief Check whether the episode of a copy is done. */
+        bool isDone(number k) const;
+
+        /** @brief Check whether the episodes of all copies are done. */
+        bool isDone() const;
+
+    protected:
+        /** @brief The forked environment */
+        std::shared_ptr<GymInterface> env_;
+
+        /** @brief The copies */
+        std::vector<std::shared_ptr<GymInterface>> envs_;
+
+        number num_threads_;
+
+        /** @brief The current observation of each copy */
+        std::vector<std::shared_ptr<State>> observations_;
+
+        /** @brief Whether the episode of each copy is done (chars rather than bools, copies are written concurrently) */
+        std::vector<char> is_done_;
+    };
+} // namespace sdm
@@ -0,0 +1,366 @@
+/**
+ * @file bench_hot_paths.cpp
+ * @brief Micro-benchmarks of the hot paths of the solvers.
+ *
+ * For each problem and each planning horizon, a few HSVI trials (maxplan lower bound, sawtooth upper bound)
+ * populate the bounds, then the operations the solvers spend their time in are timed on the occupancy
+ * states stored in the upper bound. Results are written in JSON, so that two releases can be compared.
+ *
+ * Usage :
+ *   bench_hot_paths --problems ../data/world/dpomdp/tiger.dpomdp ../data/world/dpomdp/mabc.dpomdp --horizons 3 5 --output bench.json
+ */
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <boost/program_options.hpp>
+
+#include <sdm/config.hpp>
+#include <sdm/exception.hpp>
+#include <sdm/algorithms.hpp>
+#include <sdm/parser/parser.hpp>
+#include <sdm/world/occupancy_mdp.hpp>
+#include <sdm/core/state/belief_state.hpp>
+#include <sdm/core/state/occupancy_state.hpp>
+#include <sdm/core/observation/default_observation.hpp>
+#include <sdm/utils/linear_programming/lp_problem.hpp>
+#include <sdm/utils/value_function/vfunction/pwlc_value_function.hpp>
+#include <sdm/utils/value_function/vfunction/sawtooth_value_function.hpp>
+#include <sdm/utils/value_function/action_selection/lp/action_maxplan_lp.hpp>
+#include <sdm/utils/value_function/action_selection/wcsp/action_maxplan_wcsp.hpp>
+
+using namespace sdm;
+namespace po = boost::program_options;
+
+/**
+ * @brief Timings of a benchmark : each sample is the duration of a run over all inputs and the number of calls in the run.
+ */
+struct BenchmarkResult
+{
+    std::string problem, name;
+    number horizon;
+    std::vector<Pair<double, unsigned long long>> samples;
+};
+
+/**
+ * @brief Gives access to the weights w(o,u) computed by maxplan action selections.
+ */
+class WeightSelection : public ActionSelectionMaxplanWCSP
+{
+public:
+    using ActionSelectionMaxplanWCSP::ActionSelectionMaxplanWCSP;
+
+    double weight(const std::shared_ptr<ValueFunctionInterface> &value_function, const std::shared_ptr<OccupancyStateInterface> &occupancy_state, const std::shared_ptr<JointHistoryInterface> &joint_history, const std::shared_ptr<Action> &action, const std::shared_ptr<Hyperplane> &hyperplane, number t)
+    {
+        this->pwlc_vf = std::dynamic_pointer_cast<PWLCValueFunctionInterface>(value_function);
+        return this->getWeight(value_function, occupancy_state, joint_history, action, hyperplane, t);
+    }
+};
+
+std::string escape(const std::string &str)
+{
+    std::string res;
+    for (char c : str)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            res += '\\';
+        }
+        res += c;
+    }
+    return res;
+}
+
+/**
+ * @brief Run a benchmark several times.
+ *
+ * @param run a run over all inputs, returning the number of calls to the benchmarked operation
+ */
+BenchmarkResult measure(const std::string &problem, number horizon, const std::string &name, number repeat, const std::function<unsigned long long()> &run)
+{
+    BenchmarkResult result = {problem, name, horizon, {}};
+    for (number r = 0; r < repeat; r++)
+    {
+        auto start_time = std::chrono::steady_clock::now();
+        auto num_calls = run();
+        double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        if (num_calls > 0)
+        {
+            result.samples.push_back({duration, num_calls});
+        }
+    }
+    std::cout << "[" << name << "] " << problem << " h=" << horizon << " : " << result.samples.size() << " run(s)" << std::endl;
+    return result;
+}
+
+void writeJSON(std::ostream &os, const std::vector<BenchmarkResult> &results, number repeat)
+{
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n";
+    os << "  \"date\": \"" << date << "\",\n";
+    os << "  \"compiler\": \"" << escape(__VERSION__) << "\",\n";
+#if defined(__AVX512F__)
+    os << "  \"simd\": \"avx512\",\n";
+#elif defined(__AVX2__)
+    os << "  \"simd\": \"avx2\",\n";
+#else
+    os << "  \"simd\": \"none\",\n";
+#endif
+    os << "  \"repeat\": " << repeat << ",\n";
+    os << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const auto &result = results[i];
+
+        double total_time = 0., min_time = std::numeric_limits<double>::max(), max_time = 0.;
+        unsigned long long num_calls = 0;
+        for (const auto &[duration, calls] : result.samples)
+        {
+            total_time += duration;
+            num_calls += calls;
+            min_time = std::min(min_time, duration / calls);
+            max_time = std::max(max_time, duration / calls);
+        }
+        double mean_time = (num_calls > 0) ? total_time / num_calls : 0.;
+        if (result.samples.empty())
+        {
+            min_time = 0.;
+        }
+
+        os << ((i == 0) ? "\n" : ",\n");
+        os << "    {\"problem\": \"" << escape(result.problem) << "\", \"horizon\": " << result.horizon << ", \"benchmark\": \"" << result.name << "\", "
+           << "\"runs\": " << result.samples.size() << ", \"calls\": " << num_calls << ", \"total_s\": " << total_time << ", "
+           << "\"mean_ns\": " << mean_time * 1e9 << ", \"min_ns\": " << min_time * 1e9 << ", \"max_ns\": " << max_time * 1e9 << "}";
+    }
+    os << "\n  ]\n}" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> problems;
+    std::vector<number> horizons;
+    std::string output;
+    number repeat, warmup_trials;
+    double warmup_time;
+
+    po::options_description options("Options");
+    options.add_options()
+    ("help", "produce help message")
+    ("problems,p", po::value<std::vector<std::string>>(&problems)->multitoken(), "the problems (.dpomdp files)")
+    ("horizons,h", po::value<std::vector<number>>(&horizons)->multitoken(), "the planning horizons")
+    ("repeat,r", po::value<number>(&repeat)->default_value(5), "the number of runs of each benchmark")
+    ("warmup_trials", po::value<number>(&warmup_trials)->default_value(20), "the number of HSVI trials used to populate the bounds")
+    ("warmup_time", po::value<double>(&warmup_time)->default_value(60), "the maximal time (in seconds) spent populating the bounds")
+    ("lp_solver", po::value<std::string>(&LPBase::LP_SOLVER)->default_value(LPBase::LP_SOLVER), "the solver used for linear programs (simplex or cplex)")
+    ("output,o", po::value<std::string>(&output)->default_value(""), "the JSON file where results are written (standard output if empty)");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, options), vm);
+    po::notify(vm);
+
+    if (vm.count("help") || problems.empty() || horizons.empty())
+    {
+        std::cout << options << std::endl;
+        return vm.count("help") ? 0 : 1;
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const auto &problem : problems)
+    {
+        // Parsing
+        results.push_back(measure(problem, 0, "parse", repeat, [&problem]()
+                                  { sdm::parser::parse_file(problem); return 1ULL; }));
+
+        for (const auto &horizon : horizons)
+        {
+            auto formalism = algo::makeFormalism(problem, "OccupancyMDP", 1.0, horizon, -1, COMPRESSED, true, true, 0);
+            auto omdp = std::dynamic_pointer_cast<OccupancyMDP>(formalism);
+            auto mpomdp = std::dynamic_pointer_cast<MDPInterface>(omdp->getUnderlyingMPOMDP());
+
+            // Populate the bounds
+            auto hsvi = algo::makeHSVI(formalism, 0.0, warmup_trials, true, true, "bench", warmup_time,
+                                       "maxplan_wcsp", "sawtooth", "Min", "Max", 1, 1, "", "", 1, 1, "pairwise", "none");
+            hsvi->initialize();
+            hsvi->solve();
+
+            auto lower_bound = std::dynamic_pointer_cast<PWLCValueFunction>(hsvi->getLowerBound());
+            auto upper_bound = std::dynamic_pointer_cast<SawtoothValueFunction>(hsvi->getUpperBound());
+
+            // The occupancy states reached by the trials, and an arbitrary decision rule for each of them
+            std::vector<std::vector<std::shared_ptr<OccupancyState>>> states(horizon);
+            std::vector<std::vector<std::shared_ptr<Action>>> decision_rules(horizon);
+            for (number t = 0; t < horizon; t++)
+            {
+                for (const auto &state : upper_bound->getSupport(t))
+                {
+                    if (auto occupancy_state = std::dynamic_pointer_cast<OccupancyState>(state))
+                    {
+                        states[t].push_back(occupancy_state);
+                        decision_rules[t].push_back(omdp->getRandomAction(occupancy_state, t));
+                    }
+                }
+            }
+
+            results.push_back(measure(problem, horizon, "OccupancyState::next", repeat, [&]()
+                                      {
+                                          unsigned long long num_calls = 0;
+                                          for (number t = 0; t + 1 < horizon; t++)
+                                          {
+                                              for (std::size_t i = 0; i < states[t].size(); i++, num_calls++)
+                                              {
+                                                  states[t][i]->next(mpomdp, decision_rules[t][i], sdm::NO_OBSERVATION, t);
+                                              }
+                                          }
+                                          return num_calls;
+                                      }));
+
+            results.push_back(measure(problem, horizon, "Belief::next", repeat, [&]()
+                                      {
+                                          unsigned long long num_calls = 0;
+                                          for (number t = 0; t + 1 < horizon; t++)
+                                          {
+                                              auto action = omdp->getUnderlyingMPOMDP()->getActionSpace(t)->sample()->toAction();
+                                              for (const auto &occupancy_state : states[t])
+                                              {
+                                                  for (const auto &joint_history : occupancy_state->getJointHistories())
+                                                  {
+                                                      auto belief = occupancy_state->getBeliefAt(joint_history);
+                                                      for (const auto &observation : *omdp->getUnderlyingMPOMDP()->getObservationSpace(t))
+                                                      {
+                                                          belief->next(mpomdp, action, observation->toObservation(), t);
+                                                          num_calls++;
+                                                      }
+                                                  }
+                                              }
+                                          }
+                                          return num_calls;
+                                      }));
+
+            results.push_back(measure(problem, horizon, "OccupancyState::hash", repeat, [&]()
+                                      {
+                                          unsigned long long num_calls = 0;
+                                          for (const auto &states_t : states)
+                                          {
+                                              for (const auto &occupancy_state : states_t)
+                                              {
+                                                  occupancy_state->hash();
+                                                  num_calls++;
+                                              }
+                                          }
+                                          return num_calls;
+                                      }));
+
+            results.push_back(measure(problem, horizon, "OccupancyState::isEqual", repeat, [&]()
+                                      {
+                                          unsigned long long num_calls = 0;
+                                          for (const auto &states_t : states)
+                                          {
+                                              for (const auto &occupancy_state_1 : states_t)
+                                              {
+                                                  for (const auto &occupancy_state_2 : states_t)
+                                                  {
+                                                      occupancy_state_1->isEqual(*occupancy_state_2);
+                                                      num_calls++;
+                                                  }
+                                              }
+                                          }
+                                          return num_calls;
+                                      }));
+
+            auto weight_selection = std::make_shared<WeightSelection>(formalism);
+            results.push_back(measure(problem, horizon, "MaxPlanSelectionBase::getWeight", repeat, [&]()
+                                      {
+                                          unsigned long long num_calls = 0;
+                                          for (number t = 0; t + 1 < horizon; t++)
+                                          {
+                                              auto hyperplanes = lower_bound->getHyperplanesAt(nullptr, t + 1);
+                                              for (const auto &occupancy_state : states[t])
+                                              {
+                                                  for (const auto &joint_history : occupancy_state->getJointHistories())
+                                                  {
+                                                      for (const auto &action : *omdp->getUnderlyingMPOMDP()->getActionSpace(t))
+                                                      {
+                                                          for (const auto &hyperplane : hyperplanes)
+                                                          {
+                                                              weight_selection->weight(lower_bound, occupancy_state, joint_history, action->toAction(), hyperplane, t);
+                                                              num_calls++;
+                                                          }
+                                                      }
+                                                  }
+                                              }
+                                          }
+                                          return num_calls;
+                                      }));
+
+            results.push_back(measure(problem, horizon, "PWLCValueFunction::evaluate", repeat, [&]()
+                                      {
+                                          unsigned long long num_calls = 0;
+                                          for (number t = 0; t < horizon; t++)
+                                          {
+                                              for (const auto &occupancy_state : states[t])
+                                              {
+                                                  lower_bound->evaluate(occupancy_state, t);
+                                                  num_calls++;
+                                              }
+                                          }
+                                          return num_calls;
+                                      }));
+
+            results.push_back(measure(problem, horizon, "SawtoothValueFunction::evaluate", repeat, [&]()
+                                      {
+                                          unsigned long long num_calls = 0;
+                                          for (number t = 0; t < horizon; t++)
+                                          {
+                                              for (const auto &occupancy_state : states[t])
+                                              {
+                                                  upper_bound->evaluate(occupancy_state, t);
+                                                  num_calls++;
+                                              }
+                                          }
+                                          return num_calls;
+                                      }));
+
+            std::vector<Pair<std::string, std::shared_ptr<ActionSelectionInterface>>> selections = {
+                {"ActionSelectionMaxplanWCSP::getGreedyActionAndValue", std::make_shared<ActionSelectionMaxplanWCSP>(formalism)},
+                {"ActionSelectionMaxplanLP::getGreedyActionAndValue", std::make_shared<ActionSelectionMaxplanLP>(formalism)}};
+            for (const auto &[name, selection] : selections)
+            {
+                results.push_back(measure(problem, horizon, name, repeat, [&, selection = selection]()
+                                          {
+                                              unsigned long long num_calls = 0;
+                                              for (number t = 0; t + 1 < horizon; t++)
+                                              {
+                                                  for (const auto &occupancy_state : states[t])
+                                                  {
+                                                      selection->getGreedyActionAndValue(lower_bound, occupancy_state, t);
+                                                      num_calls++;
+                                                  }
+                                              }
+                                              return num_calls;
+                                          }));
+            }
+
+            // Pruning modifies the lower bound : it is run once, after the other benchmarks
+            results.push_back(measure(problem, horizon, "PWLCValueFunction::prune", 1, [&]()
+                                      {
+                                          lower_bound->doPruning(lower_bound->getPruningFrequency());
+                                          return 1ULL;
+                                      }));
+        }
+    }
+
+    if (output.empty())
+    {
+        writeJSON(std::cout, results, repeat);
+    }
+    else
+    {
+        std::ofstream file(output);
+        writeJSON(file, results, repeat);
+    }
+    return 0;
+} // END main
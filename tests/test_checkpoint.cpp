@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE CheckpointTest
+
+#include <cstdio>
+#include <boost/test/unit_test.hpp>
+
+#include <sdm/algorithms.hpp>
+#include <sdm/algorithms/planning/hsvi.hpp>
+#include <sdm/world/solvable_by_hsvi.hpp>
+#include <sdm/utils/value_function/vfunction/pwlc_value_function.hpp>
+#include <sdm/utils/value_function/vfunction/sawtooth_value_function.hpp>
+
+/**
+ * HSVI is stopped after a few trials (bounds are not converged yet), its checkpoint is loaded by another
+ * solver on the same world, and both bounds of this solver must be the same as the saved ones.
+ */
+namespace
+{
+    const std::string CHECKPOINT = "test_checkpoint.bin";
+    const sdm::number HORIZON = 3, NUM_TRIALS = 3;
+    const double ERROR = 0.001, TOLERANCE = 1e-9;
+
+    std::shared_ptr<sdm::HSVI> makeHSVI(const std::shared_ptr<sdm::SolvableByHSVI> &formalism, int trials)
+    {
+        auto hsvi = sdm::algo::makeHSVI(formalism, ERROR, trials, true, true, "test_checkpoint", 600,
+                                        "maxplan", "sawtooth", "Min", "Max", 1, 1, "", "", 1, 1, "bounded", "pairwise");
+        hsvi->initialize();
+        return hsvi;
+    }
+
+    /** Check that two lower bounds (PWLC) and two upper bounds (sawtooth) are the same on the points of the saved upper bound. */
+    void checkSameBounds(const std::shared_ptr<sdm::HSVI> &saved, const std::shared_ptr<sdm::HSVI> &loaded)
+    {
+        auto saved_lb = std::dynamic_pointer_cast<sdm::PWLCValueFunction>(saved->getLowerBound()), loaded_lb = std::dynamic_pointer_cast<sdm::PWLCValueFunction>(loaded->getLowerBound());
+        auto saved_ub = std::dynamic_pointer_cast<sdm::SawtoothValueFunction>(saved->getUpperBound()), loaded_ub = std::dynamic_pointer_cast<sdm::SawtoothValueFunction>(loaded->getUpperBound());
+        BOOST_REQUIRE(saved_lb && loaded_lb && saved_ub && loaded_ub);
+
+        for (sdm::number t = 0; t < HORIZON; t++)
+        {
+            BOOST_CHECK_EQUAL(loaded_lb->getSize(t), saved_lb->getSize(t));
+            BOOST_CHECK_EQUAL(loaded_ub->getSize(t), saved_ub->getSize(t));
+
+            for (const auto &state : saved_ub->getSupport(t))
+            {
+                BOOST_CHECK_CLOSE(loaded_lb->evaluate(state, t).second, saved_lb->evaluate(state, t).second, TOLERANCE);
+                BOOST_CHECK_CLOSE(loaded_ub->evaluate(state, t).second, saved_ub->evaluate(state, t).second, TOLERANCE);
+                BOOST_CHECK_CLOSE(loaded_lb->getValueAt(state, t), saved_lb->getValueAt(state, t), TOLERANCE);
+                BOOST_CHECK_CLOSE(loaded_ub->getValueAt(state, t), saved_ub->getValueAt(state, t), TOLERANCE);
+            }
+        }
+    }
+
+    void checkRoundTrip(const std::string &problem, const std::string &formalism_name)
+    {
+        // Hyperplanes of occupancy states are defined over the uncompressed histories, kept along compressed states
+        auto formalism = sdm::algo::makeFormalism(problem, formalism_name, 1.0, HORIZON, -1, sdm::COMPRESSED_KEEP_ALL, true, true, 0);
+
+        auto saved = makeHSVI(formalism, NUM_TRIALS);
+        saved->solve();
+        saved->saveCheckpoint(CHECKPOINT);
+
+        auto loaded = makeHSVI(formalism, NUM_TRIALS);
+        loaded->loadCheckpoint(CHECKPOINT);
+        BOOST_CHECK_EQUAL(loaded->getTrial(), saved->getTrial());
+        checkSameBounds(saved, loaded);
+
+        // Solving resumes from the loaded bounds
+        auto resumed = makeHSVI(formalism, 10000);
+        resumed->loadCheckpoint(CHECKPOINT);
+        resumed->solve();
+        auto initial_state = formalism->getInitialState();
+        BOOST_CHECK_LE(resumed->getUpperBound()->getValueAt(initial_state, 0) - resumed->getLowerBound()->getValueAt(initial_state, 0), ERROR + 1e-6);
+
+        std::remove(CHECKPOINT.c_str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BeliefCheckpointTest)
+{
+    checkRoundTrip("../data/world/pomdp/tiger.pomdp", "BeliefMDP");
+}
+
+BOOST_AUTO_TEST_CASE(OccupancyCheckpointTest)
+{
+    checkRoundTrip("../data/world/dpomdp/tiger.dpomdp", "OccupancyMDP");
+}
@@ -0,0 +1,169 @@
+#define BOOST_TEST_MODULE ExperienceMemoryTest
+
+#include <cmath>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <sdm/utils/rl/sum_tree.hpp>
+#include <sdm/utils/rl/experience_memory.hpp>
+
+using sdm::ExperienceMemory;
+using sdm::SumTree;
+
+namespace
+{
+    const double TOLERANCE = 1e-9;
+
+    /** Transitions are told apart by their reward (other items are not needed here) */
+    void pushReward(ExperienceMemory &memory, double reward, sdm::number t = 0)
+    {
+        memory.push(nullptr, nullptr, reward, nullptr, nullptr, t);
+    }
+
+    double getReward(const ExperienceMemory &memory, std::size_t index, sdm::number t = 0)
+    {
+        return std::get<2>(memory.get(t, index));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SumTreeUpdateTest)
+{
+    // Five leaves (not a power of two)
+    SumTree tree(5);
+    BOOST_CHECK_EQUAL(tree.getCapacity(), 5);
+    BOOST_CHECK_SMALL(tree.getTotal(), TOLERANCE);
+    BOOST_CHECK(std::isinf(tree.getMin()));
+
+    std::vector<double> priorities = {1., 2., 3., 4., 5.};
+    for (std::size_t i = 0; i < priorities.size(); i++)
+    {
+        tree.setPriority(i, priorities[i]);
+    }
+    BOOST_CHECK_CLOSE(tree.getTotal(), 15., TOLERANCE);
+    BOOST_CHECK_CLOSE(tree.getMin(), 1., TOLERANCE);
+
+    // Updating a leaf updates the sum and the minimum
+    tree.setPriority(0, 6.);
+    BOOST_CHECK_CLOSE(tree.getPriority(0), 6., TOLERANCE);
+    BOOST_CHECK_CLOSE(tree.getTotal(), 20., TOLERANCE);
+    BOOST_CHECK_CLOSE(tree.getMin(), 2., TOLERANCE);
+
+    tree.setPriority(3, 0.5);
+    BOOST_CHECK_CLOSE(tree.getTotal(), 16.5, TOLERANCE);
+    BOOST_CHECK_CLOSE(tree.getMin(), 0.5, TOLERANCE);
+}
+
+BOOST_AUTO_TEST_CASE(SumTreeFindTest)
+{
+    // Prefix sums of (1, 2, 3, 4, 5) are 1, 3, 6, 10, 15
+    SumTree tree(5);
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        tree.setPriority(i, i + 1.);
+    }
+
+    std::vector<std::pair<double, std::size_t>> expected = {{0., 0}, {0.99, 0}, {1., 1}, {2.99, 1}, {3., 2}, {5.99, 2}, {6., 3}, {9.99, 3}, {10., 4}, {14.99, 4}};
+    for (const auto &[value, index] : expected)
+    {
+        BOOST_CHECK_EQUAL(tree.find(value), index);
+    }
+
+    // Leaves without priority are never found, even past the total (rounding errors)
+    tree.setPriority(2, 0.);
+    BOOST_CHECK_EQUAL(tree.find(3.), 3);
+    BOOST_CHECK_EQUAL(tree.find(tree.getTotal()), 4);
+
+    SumTree partial(6);
+    partial.setPriority(0, 1.);
+    partial.setPriority(1, 1.);
+    BOOST_CHECK_EQUAL(partial.find(1.5), 1);
+    BOOST_CHECK_EQUAL(partial.find(2.), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RingBufferTest)
+{
+    ExperienceMemory memory(2, 3);
+    BOOST_CHECK_EQUAL(memory.getCapacity(), 3);
+
+    // Once the capacity is reached, the oldest transitions are overwritten
+    for (int k = 0; k < 5; k++)
+    {
+        pushReward(memory, k);
+    }
+    BOOST_CHECK_EQUAL(memory.size(), 3);
+    BOOST_CHECK_EQUAL(getReward(memory, 0), 3.);
+    BOOST_CHECK_EQUAL(getReward(memory, 1), 4.);
+    BOOST_CHECK_EQUAL(getReward(memory, 2), 2.);
+
+    // Time steps have their own buffers
+    pushReward(memory, 10., 1);
+    BOOST_CHECK_EQUAL(getReward(memory, 0, 1), 10.);
+    BOOST_CHECK_EQUAL(getReward(memory, 0), 3.);
+
+    // Only stored transitions are sampled
+    std::vector<std::size_t> indices;
+    memory.sampleIndices(1, 20, indices);
+    BOOST_CHECK_EQUAL(indices.size(), 20);
+    for (const auto &index : indices)
+    {
+        BOOST_CHECK_EQUAL(index, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PrioritizedSamplingTest)
+{
+    ExperienceMemory memory(1, 4, 1., 0.5);
+    BOOST_REQUIRE(memory.isPrioritized());
+    for (int k = 0; k < 4; k++)
+    {
+        pushReward(memory, k);
+    }
+
+    // Priorities (|td_error| + eps)^alpha with alpha = 1
+    std::vector<double> td_errors = {1., 3., -2., 4.};
+    for (std::size_t i = 0; i < td_errors.size(); i++)
+    {
+        memory.updatePriority(0, i, td_errors[i]);
+    }
+
+    std::vector<std::size_t> indices;
+    std::vector<double> weights;
+    std::vector<int> counts(4, 0);
+    const int n = 8000;
+    memory.sampleIndices(0, n, indices, weights);
+    BOOST_REQUIRE_EQUAL(indices.size(), n);
+    BOOST_REQUIRE_EQUAL(weights.size(), n);
+    for (int k = 0; k < n; k++)
+    {
+        counts[indices[k]]++;
+        // Weights (p_i / p_min)^-beta, the smallest priority being the one of transition 0
+        double priority = std::abs(td_errors[indices[k]]) + ExperienceMemory::PRIORITY_EPSILON;
+        BOOST_CHECK_CLOSE(weights[k], std::pow(priority / (1. + ExperienceMemory::PRIORITY_EPSILON), -0.5), 1e-6);
+    }
+
+    // Stratified sampling : frequencies are close to the priorities (1, 3, 2, 4) / 10
+    BOOST_CHECK_CLOSE((double)counts[0] / n, 0.1, 1.);
+    BOOST_CHECK_CLOSE((double)counts[1] / n, 0.3, 1.);
+    BOOST_CHECK_CLOSE((double)counts[2] / n, 0.2, 1.);
+    BOOST_CHECK_CLOSE((double)counts[3] / n, 0.4, 1.);
+
+    // With beta = 1, sampling is unbiased once weighted (all transitions get the same weighted frequency)
+    memory.setImportanceExponent(1.);
+    memory.sampleIndices(0, n, indices, weights);
+    std::vector<double> weighted(4, 0.);
+    for (int k = 0; k < n; k++)
+    {
+        weighted[indices[k]] += weights[k];
+    }
+    for (int i = 1; i < 4; i++)
+    {
+        BOOST_CHECK_CLOSE(weighted[i], weighted[0], 2.);
+    }
+
+    // Uniform sampling has unit weights
+    ExperienceMemory uniform(1, 4);
+    pushReward(uniform, 0.);
+    double weight = 0.;
+    BOOST_CHECK_EQUAL(uniform.sampleIndex(0, weight), 0);
+    BOOST_CHECK_EQUAL(weight, 1.);
+}
@@ -0,0 +1,161 @@
+#define BOOST_TEST_MODULE HistoryTrieTest
+
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include <sdm/types.hpp>
+#include <sdm/core/joint.hpp>
+#include <sdm/core/observation/base_observation.hpp>
+#include <sdm/core/state/history_tree.hpp>
+#include <sdm/core/state/jhistory_tree.hpp>
+
+namespace
+{
+    const sdm::number NUM_OBSERVATIONS = 3, DEPTH = 4, NUM_THREADS = 8;
+
+    std::vector<std::shared_ptr<sdm::Observation>> makeObservations()
+    {
+        std::vector<std::shared_ptr<sdm::Observation>> observations;
+        for (sdm::number o = 0; o < NUM_OBSERVATIONS; o++)
+        {
+            observations.push_back(std::make_shared<sdm::DiscreteObservation>(o));
+        }
+        return observations;
+    }
+
+    /** Expand all histories of a given depth, the leaves are stored in the order of a counter in base NUM_OBSERVATIONS. */
+    void expandAll(const std::shared_ptr<sdm::HistoryInterface> &history, const std::vector<std::shared_ptr<sdm::Observation>> &observations, sdm::number depth, std::vector<std::shared_ptr<sdm::HistoryInterface>> &leaves)
+    {
+        if (depth == 0)
+        {
+            leaves.push_back(history);
+            return;
+        }
+        for (const auto &observation : observations)
+        {
+            expandAll(history->expand(observation), observations, depth - 1, leaves);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ExpansionIdentityTest)
+{
+    auto observations = makeObservations();
+    auto origin = std::make_shared<sdm::HistoryTree>();
+
+    // Expanding twice with backup gives the same history
+    auto h1 = origin->expand(observations[0]), h2 = origin->expand(observations[0]);
+    BOOST_CHECK(h1 == h2);
+    BOOST_CHECK(h1->expand(observations[1]) == h2->expand(observations[1]));
+
+    // Distinct items give distinct histories
+    BOOST_CHECK(origin->expand(observations[1]) != h1);
+
+    // The parent of an expanded history is the history it was expanded from
+    auto tree = std::dynamic_pointer_cast<sdm::HistoryTree>(h1->expand(observations[2]));
+    BOOST_CHECK(tree->getParent() == h1);
+    BOOST_CHECK_EQUAL(tree->getDepth(), 2);
+    BOOST_CHECK_EQUAL(origin->getNumChildren(), 2);
+
+    // Expansions without backup are not children of their parent
+    auto no_backup = std::dynamic_pointer_cast<sdm::HistoryTree>(origin->expand(observations[0], nullptr, false));
+    BOOST_CHECK(no_backup != h1);
+    BOOST_CHECK(no_backup->getParent() == origin);
+    BOOST_CHECK_EQUAL(origin->getNumChildren(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ExpansionUniquenessTest)
+{
+    auto observations = makeObservations();
+    auto origin = std::make_shared<sdm::HistoryTree>();
+
+    std::vector<std::shared_ptr<sdm::HistoryInterface>> leaves;
+    expandAll(origin, observations, DEPTH, leaves);
+
+    // All nodes of the complete tree are created once
+    std::size_t num_nodes = 1, num_leaves = 1;
+    for (sdm::number d = 0; d < DEPTH; d++)
+    {
+        num_leaves *= NUM_OBSERVATIONS;
+        num_nodes += num_leaves;
+    }
+    BOOST_CHECK_EQUAL(origin->getTrie()->size(), num_nodes);
+
+    std::vector<sdm::HistoryTrie::id_type> ids;
+    for (const auto &leaf : leaves)
+    {
+        ids.push_back(std::dynamic_pointer_cast<sdm::HistoryTree>(leaf)->getID());
+    }
+    std::sort(ids.begin(), ids.end());
+    BOOST_CHECK(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentExpansionTest)
+{
+    auto observations = makeObservations();
+    auto origin = std::make_shared<sdm::HistoryTree>();
+
+    // All threads expand the same tree, they must get the same histories
+    std::vector<std::vector<std::shared_ptr<sdm::HistoryInterface>>> leaves(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (sdm::number k = 0; k < NUM_THREADS; k++)
+    {
+        threads.emplace_back([&, k]()
+                             { expandAll(origin, observations, DEPTH, leaves[k]); });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (sdm::number k = 1; k < NUM_THREADS; k++)
+    {
+        BOOST_CHECK(leaves[k] == leaves[0]);
+    }
+
+    std::vector<std::shared_ptr<sdm::HistoryInterface>> sequential_leaves;
+    expandAll(origin, observations, DEPTH, sequential_leaves);
+    BOOST_CHECK(sequential_leaves == leaves[0]);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentJointExpansionTest)
+{
+    auto observations = makeObservations();
+    auto origin = std::make_shared<sdm::JointHistoryTree>(2);
+
+    std::vector<std::shared_ptr<sdm::Observation>> joint_observations;
+    for (const auto &o1 : observations)
+    {
+        for (const auto &o2 : observations)
+        {
+            joint_observations.push_back(std::make_shared<sdm::JointObservation>(std::vector<std::shared_ptr<sdm::Observation>>{o1, o2}));
+        }
+    }
+
+    std::vector<std::vector<std::shared_ptr<sdm::HistoryInterface>>> leaves(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (sdm::number k = 0; k < NUM_THREADS; k++)
+    {
+        threads.emplace_back([&, k]()
+                             { expandAll(origin, joint_observations, 2, leaves[k]); });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (sdm::number k = 1; k < NUM_THREADS; k++)
+    {
+        BOOST_CHECK(leaves[k] == leaves[0]);
+    }
+
+    // Each joint history holds one individual history per agent, and can be found from them
+    for (const auto &leaf : leaves[0])
+    {
+        auto joint_history = std::dynamic_pointer_cast<sdm::JointHistoryTree>(leaf);
+        BOOST_REQUIRE_EQUAL(joint_history->getNumAgents(), 2);
+        BOOST_CHECK(origin->getJointHistory(joint_history->getIndividualHistories()) == joint_history);
+    }
+}
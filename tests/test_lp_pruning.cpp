@@ -0,0 +1,125 @@
+#define BOOST_TEST_MODULE LPPruningTest
+
+#include <set>
+#include <boost/test/unit_test.hpp>
+
+#include <sdm/algorithms.hpp>
+#include <sdm/core/state/belief_state.hpp>
+#include <sdm/utils/linear_algebra/hyperplane/balpha.hpp>
+#include <sdm/utils/value_function/vfunction/pwlc_value_function.hpp>
+
+/**
+ * Hyperplanes over the beliefs of the tiger problem (two hidden states). The value function prunes
+ * its hyperplanes with linear programs (MaxplanPruning::LP) at each call to doPruning.
+ */
+namespace
+{
+    const std::string PROBLEM = "../data/world/pomdp/tiger.pomdp";
+
+    struct TigerBeliefs
+    {
+        std::shared_ptr<sdm::SolvableByHSVI> world;
+        std::vector<std::shared_ptr<sdm::State>> states;
+
+        TigerBeliefs()
+        {
+            world = sdm::algo::makeFormalism(PROBLEM, "BeliefMDP", 1.0, 2, -1, sdm::COMPRESSED, true, true, 0);
+            for (const auto &state : *world->getUnderlyingProblem()->getStateSpace(0))
+            {
+                states.push_back(state->toState());
+            }
+        }
+
+        std::shared_ptr<sdm::PWLCValueFunction> makeValueFunction() const
+        {
+            return std::make_shared<sdm::PWLCValueFunction>(world, nullptr, nullptr, 1, sdm::MaxplanPruning::LP);
+        }
+
+        /** The hyperplane alpha(x0) = v0, alpha(x1) = v1 */
+        std::shared_ptr<sdm::AlphaVector> makeHyperplane(double v0, double v1) const
+        {
+            auto alpha = std::make_shared<sdm::bAlpha>(0.);
+            alpha->setValueAt(states[0], nullptr, v0);
+            alpha->setValueAt(states[1], nullptr, v1);
+            return alpha;
+        }
+
+        /** The belief b(x0) = p, b(x1) = 1 - p */
+        std::shared_ptr<sdm::State> makeBelief(double p) const
+        {
+            return std::make_shared<sdm::Belief>(states, std::vector<double>{p, 1. - p});
+        }
+    };
+
+    std::set<std::shared_ptr<sdm::Hyperplane>> getHyperplanes(const std::shared_ptr<sdm::PWLCValueFunction> &value_function)
+    {
+        auto hyperplanes = value_function->getHyperplanesAt(nullptr, 0);
+        return std::set<std::shared_ptr<sdm::Hyperplane>>(hyperplanes.begin(), hyperplanes.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WitnessHyperplanesAreKeptTest)
+{
+    TigerBeliefs tiger;
+    auto value_function = tiger.makeValueFunction();
+
+    // Each hyperplane is the best one on some beliefs (around b(x0) = 1, 0.5 and 0)
+    auto alpha_0 = tiger.makeHyperplane(10., 0.), alpha_1 = tiger.makeHyperplane(0., 10.), alpha_2 = tiger.makeHyperplane(6., 6.);
+    for (const auto &alpha : {alpha_0, alpha_1, alpha_2})
+    {
+        value_function->addHyperplaneAt(nullptr, alpha, 0);
+    }
+    value_function->doPruning(0);
+
+    BOOST_CHECK(getHyperplanes(value_function) == (std::set<std::shared_ptr<sdm::Hyperplane>>{alpha_0, alpha_1, alpha_2}));
+}
+
+BOOST_AUTO_TEST_CASE(DominatedHyperplaneIsRemovedTest)
+{
+    TigerBeliefs tiger;
+    auto value_function = tiger.makeValueFunction();
+
+    // (4, 4) is below the upper envelope of (10, 0) and (0, 10), though neither of them dominates it pointwise
+    auto alpha_0 = tiger.makeHyperplane(10., 0.), alpha_1 = tiger.makeHyperplane(0., 10.), dominated = tiger.makeHyperplane(4., 4.);
+    for (const auto &alpha : {alpha_0, dominated, alpha_1})
+    {
+        value_function->addHyperplaneAt(nullptr, alpha, 0);
+    }
+    value_function->doPruning(0);
+
+    BOOST_CHECK(getHyperplanes(value_function) == (std::set<std::shared_ptr<sdm::Hyperplane>>{alpha_0, alpha_1}));
+    BOOST_CHECK_EQUAL(value_function->getSizeBeforeLastPruning(), 3);
+    BOOST_CHECK_EQUAL(value_function->getSizeAfterLastPruning(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalPruningTest)
+{
+    TigerBeliefs tiger;
+    std::vector<std::shared_ptr<sdm::AlphaVector>> hyperplanes = {tiger.makeHyperplane(10., 0.), tiger.makeHyperplane(4., 4.), tiger.makeHyperplane(0., 10.),
+                                                                  tiger.makeHyperplane(6., 6.), tiger.makeHyperplane(8., 3.), tiger.makeHyperplane(5., 5.),
+                                                                  tiger.makeHyperplane(9., 2.), tiger.makeHyperplane(1., 9.5)};
+
+    // Pruning after each new hyperplane (witnesses of kept hyperplanes are reused) ...
+    auto incremental = tiger.makeValueFunction();
+    for (const auto &alpha : hyperplanes)
+    {
+        incremental->addHyperplaneAt(nullptr, alpha, 0);
+        incremental->doPruning(0);
+    }
+
+    // ... or once at the end gives the same hyperplanes and values
+    auto batch = tiger.makeValueFunction();
+    for (const auto &alpha : hyperplanes)
+    {
+        batch->addHyperplaneAt(nullptr, alpha, 0);
+    }
+    batch->doPruning(0);
+
+    BOOST_CHECK(getHyperplanes(incremental) == getHyperplanes(batch));
+    BOOST_CHECK_LT(getHyperplanes(batch).size(), hyperplanes.size());
+    for (double p = 0.; p <= 1.; p += 0.1)
+    {
+        auto belief = tiger.makeBelief(p);
+        BOOST_CHECK_CLOSE(incremental->getValueAt(belief, 0), batch->getValueAt(belief, 0), 1e-9);
+    }
+}
@@ -0,0 +1,52 @@
+#define BOOST_TEST_MODULE ParallelHSVITest
+
+#include <cmath>
+#include <boost/test/unit_test.hpp>
+
+#include <sdm/algorithms.hpp>
+#include <sdm/algorithms/planning/hsvi.hpp>
+#include <sdm/world/solvable_by_hsvi.hpp>
+
+/**
+ * Workers share the bounds, the histories and the occupancy states of the world. Races do not always
+ * show up in the values, so that this test is meant to be also run in a build with ThreadSanitizer
+ * (-DSDMS_SANITIZE_THREAD=ON), where each repetition gives the sanitizer another interleaving to check.
+ */
+namespace
+{
+    const std::string PROBLEM = "../data/world/dpomdp/tiger.dpomdp";
+    const sdm::number HORIZON = 3, NUM_WORKERS = 4, NUM_REPEATS = 10;
+    const double ERROR = 0.001;
+
+    /**
+     * Solve the problem with HSVI (maxplan lower bound, sawtooth upper bound) and return the bounds at the initial state.
+     * Hyperplanes are defined over the uncompressed histories, which are kept along compressed occupancy states.
+     */
+    std::pair<double, double> solve(sdm::number num_workers)
+    {
+        auto formalism = sdm::algo::makeFormalism(PROBLEM, "OccupancyMDP", 1.0, HORIZON, -1, sdm::COMPRESSED_KEEP_ALL, true, true, 0);
+        auto hsvi = sdm::algo::makeHSVI(formalism, ERROR, 10000, true, true, "test_parallel_hsvi", 600,
+                                        "maxplan_wcsp", "sawtooth", "Min", "Max", 1, 1, "", "", 1, 1, "bounded", "pairwise");
+        hsvi->setNumWorkers(num_workers);
+        hsvi->initialize();
+        hsvi->solve();
+
+        auto initial_state = formalism->getInitialState();
+        return {hsvi->getLowerBound()->getValueAt(initial_state, 0), hsvi->getUpperBound()->getValueAt(initial_state, 0)};
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ParallelWorkersTest)
+{
+    auto [sequential_lb, sequential_ub] = solve(1);
+    BOOST_REQUIRE_LE(sequential_ub - sequential_lb, ERROR + 1e-6);
+
+    for (sdm::number repeat = 0; repeat < NUM_REPEATS; repeat++)
+    {
+        // Workers converge to the same value as the sequential algorithm, within the error
+        auto [lower_bound, upper_bound] = solve(NUM_WORKERS);
+        BOOST_CHECK_LE(upper_bound - lower_bound, ERROR + 1e-6);
+        BOOST_CHECK_LE(lower_bound, sequential_ub + 1e-6);
+        BOOST_CHECK_GE(upper_bound, sequential_lb - 1e-6);
+    }
+}
@@ -1,8 +1,14 @@
 #define BOOST_TEST_MODULE ParserTest
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <boost/test/unit_test.hpp>
 #include <sdm/config.hpp>
+#include <sdm/exception.hpp>
 #include <sdm/parser/parser.hpp>
+#include <sdm/parser/compiled_model.hpp>
+#include <sdm/core/dynamics/flat_tabular_dynamics.hpp>
 
 BOOST_AUTO_TEST_CASE(dpomdpParser)
 {
@@ -23,4 +29,49 @@ BOOST_AUTO_TEST_CASE(zsposgParser)
     // BOOST_CHECK_EQUAL(zs_posg1.getNumStates(), 1);
     // BOOST_CHECK_EQUAL(zs_posg1.getNumJActions(), 4);
     // BOOST_CHECK_EQUAL(zs_posg1.getNumJObservations(), 1);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(compiledModelParser)
+{
+    auto model = sdm::parser::parse_file("../data/world/dpomdp/tiger.dpomdp");
+    sdm::parser::write_compiled_file(model, "test_parser_tiger.sdmb");
+    auto compiled_model = sdm::parser::parse_file("test_parser_tiger.sdmb");
+
+    // The compiled model has the same dynamics, read from the mapped file
+    auto flat_dynamics = model->getFlatDynamics(), compiled_flat_dynamics = compiled_model->getFlatDynamics();
+    BOOST_REQUIRE_EQUAL(compiled_flat_dynamics->getNumStates(), flat_dynamics->getNumStates());
+    BOOST_REQUIRE_EQUAL(compiled_flat_dynamics->getNumActions(), flat_dynamics->getNumActions());
+    BOOST_REQUIRE_EQUAL(compiled_flat_dynamics->getNumObservations(), flat_dynamics->getNumObservations());
+    for (sdm::number x = 0; x < flat_dynamics->getNumStates(); x++)
+    {
+        for (sdm::number u = 0; u < flat_dynamics->getNumActions(); u++)
+        {
+            const auto &state = compiled_flat_dynamics->getState(x), &next_state = compiled_flat_dynamics->getState(0);
+            const auto &action = compiled_flat_dynamics->getAction(u);
+            BOOST_CHECK_CLOSE(compiled_model->getTransitionProbability(state, action, next_state, 0), flat_dynamics->getTransitionProbability(x, u, 0), 1e-9);
+
+            double total_probability = 0.;
+            for (const auto &transition : compiled_model->getReachableDynamics(state, action, 0))
+            {
+                auto y = compiled_flat_dynamics->getStateIndex(transition.next_state), z = compiled_flat_dynamics->getObservationIndex(transition.observation);
+                BOOST_CHECK_CLOSE(transition.probability, flat_dynamics->getDynamics(x, u, y, z), 1e-9);
+                BOOST_CHECK_CLOSE(compiled_model->getObservationProbability(state, action, transition.next_state, transition.observation, 0) * compiled_model->getTransitionProbability(state, action, transition.next_state, 0), transition.probability, 1e-9);
+                total_probability += transition.probability;
+            }
+            // Probabilities of the problem file are only read in single precision
+            BOOST_CHECK_CLOSE(total_probability, 1., 1e-5);
+        }
+    }
+
+    // Row offsets out of range are rejected (the table of section offsets starts at byte 48, the offsets of the rows are the fifth section)
+    std::ifstream input("test_parser_tiger.sdmb", std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::uint64_t row_offsets_position;
+    std::memcpy(&row_offsets_position, bytes.data() + 48 + 4 * 16, sizeof(row_offsets_position));
+    std::size_t corrupted_offset = 1000000;
+    std::memcpy(bytes.data() + row_offsets_position + sizeof(std::size_t), &corrupted_offset, sizeof(corrupted_offset));
+    std::ofstream output("test_parser_corrupted.sdmb", std::ios::binary);
+    output.write(bytes.data(), bytes.size());
+    output.close();
+    BOOST_CHECK_THROW(sdm::parser::parse_file("test_parser_corrupted.sdmb"), sdm::exception::Exception);
+}
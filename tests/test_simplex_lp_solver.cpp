@@ -0,0 +1,144 @@
+#define BOOST_TEST_MODULE SimplexLPSolverTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <sdm/utils/linear_programming/simplex_lp_solver.hpp>
+
+using sdm::LPSolverInterface;
+using sdm::SimplexLPSolver;
+
+namespace
+{
+    const double TOLERANCE = 1e-6;
+
+    /**
+     * The Wyndor Glass program : max 3x + 5y s.t. x <= 4, 2y <= 12, 3x + 2y <= 18, x, y >= 0.
+     * Its optimum is 36 at (2, 6).
+     */
+    struct Wyndor
+    {
+        SimplexLPSolver lp;
+        std::size_t x, y, c1, c2, c3;
+
+        Wyndor()
+        {
+            x = lp.addVariable("x", 0., LPSolverInterface::INF);
+            y = lp.addVariable("y", 0., LPSolverInterface::INF);
+            c1 = lp.addConstraint({{x, 1.}}, -LPSolverInterface::INF, 4.);
+            c2 = lp.addConstraint({{y, 2.}}, -LPSolverInterface::INF, 12.);
+            c3 = lp.addConstraint({{x, 3.}, {y, 2.}}, -LPSolverInterface::INF, 18.);
+            lp.setObjectiveCoefficient(x, 3.);
+            lp.setObjectiveCoefficient(y, 5.);
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(LinearProgramTest)
+{
+    Wyndor wyndor;
+    BOOST_REQUIRE(wyndor.lp.maximize());
+    BOOST_CHECK_CLOSE(wyndor.lp.getObjectiveValue(), 36., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.x), 2., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.y), 6., TOLERANCE);
+
+    // Infeasible programs have no solution
+    SimplexLPSolver infeasible;
+    auto x = infeasible.addVariable("x", 0., LPSolverInterface::INF);
+    infeasible.addConstraint({{x, 1.}}, 5., LPSolverInterface::INF);
+    infeasible.addConstraint({{x, 1.}}, -LPSolverInterface::INF, 3.);
+    infeasible.setObjectiveCoefficient(x, 1.);
+    BOOST_CHECK(!infeasible.maximize());
+}
+
+BOOST_AUTO_TEST_CASE(WarmStartTest)
+{
+    Wyndor wyndor;
+    BOOST_REQUIRE(wyndor.lp.maximize());
+
+    // A new objective is solved from the previous basis : max 5x + 2y is 26 at (4, 3)
+    wyndor.lp.setObjectiveCoefficient(wyndor.x, 5.);
+    wyndor.lp.setObjectiveCoefficient(wyndor.y, 2.);
+    BOOST_REQUIRE(wyndor.lp.maximize());
+    BOOST_CHECK_CLOSE(wyndor.lp.getObjectiveValue(), 26., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.x), 4., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.y), 3., TOLERANCE);
+
+    // Tighter bounds make the previous basis infeasible (the dual simplex restores it) : x <= 1 gives 17 at (1, 6)
+    wyndor.lp.setVariableBounds(wyndor.x, 0., 1.);
+    BOOST_REQUIRE(wyndor.lp.maximize());
+    BOOST_CHECK_CLOSE(wyndor.lp.getObjectiveValue(), 17., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.x), 1., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.y), 6., TOLERANCE);
+
+    // So does a tighter right-hand side : 3x + 2y <= 10 gives 12 at (1, 3.5)
+    wyndor.lp.setConstraintBounds(wyndor.c3, -LPSolverInterface::INF, 10.);
+    BOOST_REQUIRE(wyndor.lp.maximize());
+    BOOST_CHECK_CLOSE(wyndor.lp.getObjectiveValue(), 12., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.x), 1., TOLERANCE);
+    BOOST_CHECK_CLOSE(wyndor.lp.getValue(wyndor.y), 3.5, TOLERANCE);
+
+    // The warm-started resolution gives the same optimum as a resolution from scratch
+    Wyndor cold;
+    cold.lp.setObjectiveCoefficient(cold.x, 5.);
+    cold.lp.setObjectiveCoefficient(cold.y, 2.);
+    cold.lp.setVariableBounds(cold.x, 0., 1.);
+    cold.lp.setConstraintBounds(cold.c3, -LPSolverInterface::INF, 10.);
+    BOOST_REQUIRE(cold.lp.maximize());
+    BOOST_CHECK_CLOSE(cold.lp.getObjectiveValue(), wyndor.lp.getObjectiveValue(), TOLERANCE);
+}
+
+BOOST_AUTO_TEST_CASE(BranchAndBoundTest)
+{
+    // A knapsack : max 5a + 4b + 3c s.t. 2a + 3b + c <= 5 with binary a, b, c. Its relaxation (32 / 3) is fractional, the optimum is 9.
+    SimplexLPSolver lp;
+    auto a = lp.addVariable("a", 0., 1., true), b = lp.addVariable("b", 0., 1., true), c = lp.addVariable("c", 0., 1., true);
+    lp.addConstraint({{a, 2.}, {b, 3.}, {c, 1.}}, -LPSolverInterface::INF, 5.);
+    lp.setObjectiveCoefficient(a, 5.);
+    lp.setObjectiveCoefficient(b, 4.);
+    lp.setObjectiveCoefficient(c, 3.);
+
+    BOOST_REQUIRE(lp.maximize());
+    BOOST_CHECK_CLOSE(lp.getObjectiveValue(), 9., TOLERANCE);
+    BOOST_CHECK_CLOSE(lp.getValue(a), 1., TOLERANCE);
+    BOOST_CHECK_CLOSE(lp.getValue(b), 1., TOLERANCE);
+    BOOST_CHECK_SMALL(lp.getValue(c), TOLERANCE);
+    BOOST_CHECK_GT(lp.getNumNodes(), 1);
+
+    // A general integer variable : max x + y s.t. 2x + 2y <= 7 is 3 (the relaxation is 3.5)
+    SimplexLPSolver integer_lp;
+    auto x = integer_lp.addVariable("x", 0., LPSolverInterface::INF, true), y = integer_lp.addVariable("y", 0., LPSolverInterface::INF, true);
+    integer_lp.addConstraint({{x, 2.}, {y, 2.}}, -LPSolverInterface::INF, 7.);
+    integer_lp.setObjectiveCoefficient(x, 1.);
+    integer_lp.setObjectiveCoefficient(y, 1.);
+    BOOST_REQUIRE(integer_lp.maximize());
+    BOOST_CHECK_CLOSE(integer_lp.getObjectiveValue(), 3., TOLERANCE);
+}
+
+BOOST_AUTO_TEST_CASE(IndicatorConstraintTest)
+{
+    // max x + 5z with x in [0, 10] and z = 1 => x <= 2 : leaving the indicator off is better (10 at x = 10, z = 0)
+    SimplexLPSolver lp;
+    auto x = lp.addVariable("x", 0., 10.), z = lp.addVariable("z", 0., 1., true);
+    lp.addIndicatorConstraint(z, {{x, 1.}}, 2.);
+    lp.setObjectiveCoefficient(x, 1.);
+    lp.setObjectiveCoefficient(z, 5.);
+
+    BOOST_REQUIRE(lp.maximize());
+    BOOST_CHECK_CLOSE(lp.getObjectiveValue(), 10., TOLERANCE);
+    BOOST_CHECK_CLOSE(lp.getValue(x), 10., TOLERANCE);
+    BOOST_CHECK_SMALL(lp.getValue(z), TOLERANCE);
+
+    // With max x + 9z, the indicator is on and its slack is fixed to zero (11 at x = 2, z = 1)
+    lp.setObjectiveCoefficient(z, 9.);
+    BOOST_REQUIRE(lp.maximize());
+    BOOST_CHECK_CLOSE(lp.getObjectiveValue(), 11., TOLERANCE);
+    BOOST_CHECK_CLOSE(lp.getValue(x), 2., TOLERANCE);
+    BOOST_CHECK_CLOSE(lp.getValue(z), 1., TOLERANCE);
+
+    // Forcing the binary variable enforces the constraint without branching
+    lp.setObjectiveCoefficient(z, 0.);
+    lp.setVariableBounds(z, 1., 1.);
+    BOOST_REQUIRE(lp.maximize());
+    BOOST_CHECK_CLOSE(lp.getObjectiveValue(), 2., TOLERANCE);
+    BOOST_CHECK_EQUAL(lp.getNumNodes(), 1);
+}